@@ -1,6 +1,18 @@
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <sstream>
 #include <string>
 #include <sys/stat.h>
+#include <thread>
+#include <tuple>
 #include <utility>
+#include <vector>
+
+#include <boost/property_tree/info_parser.hpp>
 
 #include "baldr/connectivity_map.h"
 #include "baldr/curl_tilegetter.h"
@@ -19,11 +31,128 @@ constexpr size_t DEFAULT_MAX_CACHE_SIZE = 1073741824; // 1 gig
 constexpr size_t AVERAGE_TILE_SIZE = 2097152;         // 2 megs
 constexpr size_t AVERAGE_MM_TILE_SIZE = 1024;         // 1k
 
-struct tile_index_entry {
-  uint64_t offset;  // byte offset from the beginning of the tar
-  uint32_t tile_id; // just level and tileindex hence fitting in 32bits
-  uint32_t size;    // size of the tile in bytes
+#if defined(__linux__) && !defined(MADV_POPULATE_READ)
+#define MADV_POPULATE_READ 22 // since linux 5.14, older headers don't have it
+#endif
+
+size_t page_size() {
+#ifdef _WIN32
+  return 4096;
+#else
+  static const size_t size = sysconf(_SC_PAGESIZE);
+  return size;
+#endif
+}
+
+// asks for transparent huge pages over the whole map, only linux has them for file backed maps
+void advise_hugepages(const mem_map<char>& mm) {
+#ifdef __linux__
+  if (madvise(mm.get(), mm.size(), MADV_HUGEPAGE) != 0) {
+    LOG_WARN("Unable to use huge pages for " + mm.name() + ": " + strerror(errno));
+  }
+#else
+  LOG_WARN("Huge pages are not supported for " + mm.name() + " on this platform");
+#endif
+}
+
+// an index of a tile extract without an index.bin, kept in a side file so that other processes
+// don't have to scan the extract again. it only fits the very tar it was made from
+struct side_index_header_t {
+  char magic[8];
+  uint64_t tar_size;
+  int64_t tar_mtime;
+  uint64_t count;
 };
+constexpr char kSideIndexMagic[8] = "VHIDX01";
+
+bool stat_tar(const std::string& tar_file, uint64_t& size, int64_t& mtime) {
+  struct stat s;
+  if (stat(tar_file.c_str(), &s)) {
+    return false;
+  }
+  size = s.st_size;
+  mtime = s.st_mtime;
+  return true;
+}
+
+// the tar header right in front of an entry has to agree with it
+bool matches_tar(const valhalla::baldr::tile_index_entry& entry,
+                 const char* tar_begin,
+                 const uint64_t tar_size) {
+  if (entry.offset < sizeof(tar::header_t) || entry.offset + entry.size > tar_size) {
+    return false;
+  }
+  const auto* header = reinterpret_cast<const tar::header_t*>(tar_begin + entry.offset) - 1;
+  return header->verify() && header->get_file_size() == entry.size;
+}
+
+std::vector<valhalla::baldr::tile_index_entry>
+read_side_index(const std::string& index_file, const std::string& tar_file, const char* tar_begin) {
+  std::ifstream in(index_file, std::ios::binary);
+  side_index_header_t header{};
+  uint64_t tar_size;
+  int64_t tar_mtime;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      memcmp(header.magic, kSideIndexMagic, sizeof(header.magic)) ||
+      !stat_tar(tar_file, tar_size, tar_mtime) || header.tar_size != tar_size ||
+      header.tar_mtime != tar_mtime || header.count > tar_size / sizeof(tar::header_t)) {
+    return {};
+  }
+  std::vector<valhalla::baldr::tile_index_entry> entries(header.count);
+  if (!in.read(reinterpret_cast<char*>(entries.data()),
+               entries.size() * sizeof(valhalla::baldr::tile_index_entry)) ||
+      entries.empty() || !matches_tar(entries.front(), tar_begin, tar_size) ||
+      !matches_tar(entries.back(), tar_begin, tar_size)) {
+    LOG_WARN("Ignoring tile extract index " + index_file + " which does not match " + tar_file);
+    return {};
+  }
+  LOG_INFO("Loading tile extract index " + index_file);
+  return entries;
+}
+
+void write_side_index(const std::string& index_file,
+                      const std::string& tar_file,
+                      const std::vector<valhalla::baldr::tile_index_entry>& entries) {
+  side_index_header_t header{};
+  memcpy(header.magic, kSideIndexMagic, sizeof(header.magic));
+  header.count = entries.size();
+  if (!stat_tar(tar_file, header.tar_size, header.tar_mtime)) {
+    return;
+  }
+  // other processes may be reading it, so they only ever see a whole one
+  const auto tmp_file = index_file + ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              entries.size() * sizeof(valhalla::baldr::tile_index_entry));
+    if (!out) {
+      LOG_WARN("Unable to write tile extract index " + index_file);
+      return;
+    }
+  }
+  if (!filesystem::rename(tmp_file, index_file)) {
+    LOG_WARN("Unable to write tile extract index " + index_file);
+    filesystem::remove(tmp_file);
+    return;
+  }
+  LOG_INFO("Wrote tile extract index " + index_file);
+}
+
+// the size and modification time of the extracts tell different versions of them apart
+std::string extract_identity(const boost::property_tree::ptree& pt) {
+  std::string identity;
+  for (const auto* key : {"tile_extract", "traffic_extract"}) {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    auto file = pt.get<std::string>(key, "");
+    if (!file.empty()) {
+      stat_tar(file, size, mtime);
+    }
+    identity += file + '\0' + std::to_string(size) + '\0' + std::to_string(mtime) + '\0';
+  }
+  return identity;
+}
 
 } // namespace
 
@@ -39,22 +168,138 @@ tile_gone_error_t::tile_gone_error_t(std::string prefix, baldr::GraphId edgeid)
                          std::to_string(edgeid.Tile_Base())) {
 }
 
+// the extracts are mapped again here rather than borrowing the mapping of the reader that started
+// the warm-up, so pages we lock stay locked as long as any reader of the same extracts is around
+struct GraphReader::extract_warmup_t {
+  extract_warmup_t(const tile_extract_t& extract, bool lock) : lock(lock) {
+    // highway tiles are used by nearly every route so they go first, then arterial and local. the
+    // traffic for a level is read along with it
+    std::vector<std::tuple<uint32_t, const mem_map<char>*, size_t, size_t>> order;
+    auto add = [&order](const std::shared_ptr<midgard::tar>& archive, mem_map<char>& mm,
+                        const std::unordered_map<uint64_t, std::pair<char*, size_t>>& tiles) {
+      if (!archive || tiles.empty()) {
+        return;
+      }
+      mm.map_readonly(archive->mm.name(), archive->mm.size());
+      for (const auto& tile : tiles) {
+        order.emplace_back(GraphId(tile.first).level(), &mm, tile.second.first - archive->mm.get(),
+                           tile.second.second);
+      }
+    };
+    add(extract.archive, tile_map, extract.tiles);
+    add(extract.traffic_archive, traffic_map, extract.traffic_tiles);
+    // within a level go through the file front to back, which is what readahead is best at
+    std::sort(order.begin(), order.end());
+    ranges.reserve(order.size());
+    for (const auto& range : order) {
+      ranges.emplace_back(std::get<1>(range), std::get<2>(range), std::get<3>(range));
+      total += std::get<3>(range);
+    }
+  }
+
+  ~extract_warmup_t() {
+    cancel = true;
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
+  void start(bool background) {
+    LOG_INFO("Warming up " + std::to_string(total) + " bytes of tile extracts" +
+             (background ? " in the background" : ""));
+    if (background) {
+      thread = std::thread(&extract_warmup_t::run, this);
+    } else {
+      run();
+    }
+  }
+
+  void run() {
+    for (const auto& range : ranges) {
+      if (cancel) {
+        return;
+      }
+      // widen the tile to whole pages
+      const auto& mm = *std::get<0>(range);
+      size_t begin = std::get<1>(range) / page_size() * page_size();
+      size_t end = std::min(std::get<1>(range) + std::get<2>(range), mm.size());
+      char* pages = mm.get() + begin;
+      size_t length = end - begin;
+#ifndef _WIN32
+      if (lock && mlock(pages, length) != 0) {
+        LOG_WARN("Unable to lock the tile extracts in memory, continuing without locking. Check "
+                 "the memlock limit (ulimit -l): " +
+                 std::string(strerror(errno)));
+        lock = false;
+      }
+      if (!lock) {
+        populate(pages, length);
+      }
+#else
+      populate(pages, length);
+#endif
+      bytes += std::get<2>(range);
+    }
+    done = true;
+    LOG_INFO("Finished warming up tile extracts");
+  }
+
+  // reads a range into the page cache and maps it without locking it
+  void populate(char* pages, size_t length) {
+#ifdef __linux__
+    // does it in one call without copying anything, if the kernel is new enough
+    if (populate_read && madvise(pages, length, MADV_POPULATE_READ) == 0) {
+      return;
+    }
+    populate_read = false;
+#endif
+    volatile char sum = 0;
+    for (size_t offset = 0; offset < length; offset += page_size()) {
+      sum += pages[offset];
+    }
+  }
+
+  float progress() const {
+    return done || total == 0 ? 1.f : static_cast<float>(bytes) / total;
+  }
+
+  mem_map<char> tile_map;
+  mem_map<char> traffic_map;
+  // the map, offset and size of each tile in the order they are read
+  std::vector<std::tuple<const mem_map<char>*, size_t, size_t>> ranges;
+  bool lock;
+  bool populate_read = true;
+  uint64_t total = 0;
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<bool> done{false};
+  std::atomic<bool> cancel{false};
+  std::thread thread;
+};
+
 GraphReader::tile_extract_t::tile_extract_t(const boost::property_tree::ptree& pt,
                                             bool traffic_readonly) {
   // A lambda for loading the contents of a graph tile tar from an index file
   bool traffic_from_index = false;
-  auto index_loader = [this, &traffic_from_index](const std::string& filename,
-                                                  const char* index_begin, const char* file_begin,
-                                                  size_t size) -> decltype(midgard::tar::contents) {
-    // has to be our specially named index.bin file
-    if (filename != "index.bin")
-      return {};
-
-    // get the info
-    decltype(midgard::tar::contents) contents;
+  const auto side_index = pt.get<std::string>("tile_extract_index", "");
+  auto index_loader = [&, this](const std::string& filename, const char* index_begin,
+                                const char* file_begin,
+                                size_t size) -> decltype(midgard::tar::contents) {
+    // has to be our specially named index.bin file or else an index we made of the tar before
+    std::vector<tile_index_entry> side_entries;
     auto entries = midgard::iterable_t<tile_index_entry>(reinterpret_cast<tile_index_entry*>(
                                                              const_cast<char*>(index_begin)),
                                                          size / sizeof(tile_index_entry));
+    if (filename != "index.bin") {
+      if (traffic_from_index || side_index.empty())
+        return {};
+      side_entries = read_side_index(side_index, pt.get<std::string>("tile_extract"), file_begin);
+      if (side_entries.empty())
+        return {};
+      entries = midgard::iterable_t<tile_index_entry>(side_entries.data(), side_entries.size());
+    }
+
+    // get the info
+    decltype(midgard::tar::contents) contents;
     for (const auto& entry : entries) {
       contents.insert(
           std::make_pair(std::to_string(entry.tile_id),
@@ -74,13 +319,31 @@ GraphReader::tile_extract_t::tile_extract_t(const boost::property_tree::ptree& p
   };
 
   bool scan_tar = pt.get<bool>("data_processing.scan_tar", false);
+  // threads for going through an extract without an index or with scan_tar
+  const unsigned int concurrency =
+      pt.get<unsigned int>("concurrency", std::max(1u, std::thread::hardware_concurrency()));
+
+  // how the kernel should read ahead in the extract. with tiles in hilbert order the default
+  // readahead tends to bring in neighbouring tiles, otherwise it mostly reads pages we won't use
+  static const std::unordered_map<std::string, int> advices{
+      {"normal", POSIX_MADV_NORMAL},
+      {"random", POSIX_MADV_RANDOM},
+      {"sequential", POSIX_MADV_SEQUENTIAL},
+  };
+  auto advice_name = pt.get<std::string>("tile_extract_advice", "normal");
+  auto advice = advices.find(advice_name);
+  if (advice == advices.cend()) {
+    throw std::runtime_error("Unknown tile_extract_advice: " + advice_name);
+  }
+  prefetch = pt.get<bool>("tile_extract_prefetch", false);
 
   // if you really meant to load it
   if (pt.get_optional<std::string>("tile_extract")) {
     try {
       // load the tar
       // TODO: use the "scan" to iterate over tar
-      archive.reset(new midgard::tar(pt.get<std::string>("tile_extract"), true, true, index_loader));
+      archive.reset(new midgard::tar(pt.get<std::string>("tile_extract"), true, true, index_loader,
+                                     advice->second, concurrency));
       // map files to graph ids
       if (tiles.empty()) {
         for (const auto& c : archive->contents) {
@@ -95,11 +358,41 @@ GraphReader::tile_extract_t::tile_extract_t(const boost::property_tree::ptree& p
             // checks lower down will warn on that.
           }
         }
+        // so the next process doesn't have to scan it again
+        if (!side_index.empty() && !tiles.empty()) {
+          std::vector<tile_index_entry> entries;
+          entries.reserve(tiles.size());
+          for (const auto& t : tiles) {
+            entries.push_back({static_cast<uint64_t>(t.second.first - archive->mm.get()),
+                               static_cast<uint32_t>(t.first),
+                               static_cast<uint32_t>(t.second.second)});
+          }
+          std::sort(entries.begin(), entries.end(),
+                    [](const tile_index_entry& a, const tile_index_entry& b) {
+                      return a.offset < b.offset;
+                    });
+          write_side_index(side_index, archive->tar_file, entries);
+        }
       } else if (scan_tar) {
-        checksum = 0;
+        // touch every tile, spread over threads to have more of them read in at once
+        std::vector<const char*> firsts;
+        firsts.reserve(tiles.size());
         for (const auto& kv : tiles) {
-          checksum += *const_cast<char*>(kv.second.first);
+          firsts.push_back(kv.second.first);
+        }
+        std::vector<uint64_t> sums(std::max(1u, concurrency), 0);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < sums.size(); ++i) {
+          threads.emplace_back([&firsts, &sums, i]() {
+            for (size_t j = i; j < firsts.size(); j += sums.size()) {
+              sums[i] += *firsts[j];
+            }
+          });
+        }
+        for (auto& thread : threads) {
+          thread.join();
         }
+        checksum = std::accumulate(sums.begin(), sums.end(), uint64_t(0));
       }
       // couldn't load it
       if (tiles.empty()) {
@@ -159,6 +452,48 @@ GraphReader::tile_extract_t::tile_extract_t(const boost::property_tree::ptree& p
       LOG_WARN("Traffic tile extract could not be loaded");
     }
   }
+
+  // huge pages are a property of each mapping so every reader asks for them
+  if (pt.get<bool>("tile_extract_hugepages", false)) {
+    for (const auto& a : {archive, traffic_archive}) {
+      if (a) {
+        advise_hugepages(a->mm);
+      }
+    }
+  }
+
+  // reading the extracts into memory ahead of use. locking them only makes sense once they are read
+  // so it implies a warm-up too
+  auto warmup_mode = pt.get<std::string>("tile_extract_warmup", "none");
+  if (warmup_mode != "none" && warmup_mode != "background" && warmup_mode != "blocking") {
+    throw std::runtime_error("Unknown tile_extract_warmup: " + warmup_mode);
+  }
+  bool lock = pt.get<bool>("tile_extract_lock", false);
+  if (lock && warmup_mode == "none") {
+    warmup_mode = "blocking";
+  }
+  if (warmup_mode == "none" || (tiles.empty() && traffic_tiles.empty())) {
+    return;
+  }
+
+  // every reader of the same extracts in the process shares one warm-up, there's no point in
+  // reading them in more than once. a rebuilt extract at the same path is a different one though
+  static std::mutex warmups_lock;
+  static std::unordered_map<std::string, std::weak_ptr<extract_warmup_t>> warmups;
+  auto key = extract_identity(pt) + std::to_string(lock);
+  std::unique_lock<std::mutex> guard(warmups_lock);
+  warmup = warmups[key].lock();
+  if (!warmup) {
+    try {
+      warmup = std::make_shared<extract_warmup_t>(*this, lock);
+      warmups[key] = warmup;
+    } catch (const std::exception& e) {
+      LOG_WARN("Tile extracts could not be warmed up: " + std::string(e.what()));
+      return;
+    }
+    // other readers wait for a blocking warm-up rather than reporting a partial one
+    warmup->start(warmup_mode == "background");
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -321,7 +656,8 @@ size_t TileCacheLRU::TrimToFit(const size_t required_size) {
   while ((OverCommitted() || (max_cache_size_ - cache_size_) < required_size) &&
          !key_val_lru_list_.empty()) {
     const KeyValue& entry_to_evict = key_val_lru_list_.back();
-    const auto tile_size = entry_to_evict.tile->header()->end_offset();
+    const auto tile_size =
+        entry_to_evict.tile->header()->end_offset() + entry_to_evict.tile->overhead_size();
     cache_size_ -= tile_size;
     freed_space += tile_size;
     cache_.erase(entry_to_evict.id);
@@ -353,7 +689,8 @@ graph_tile_ptr TileCacheLRU::Put(const GraphId& graphid, graph_tile_ptr tile, si
     //  do we need to take it into account here? (can dramatically simplify the code)
     // note: SimpleTileCache does not handle the overwrite at the moment
     auto& entry_iter = cached->second;
-    const auto old_tile_size = entry_iter->tile->header()->end_offset();
+    const auto old_tile_size =
+        entry_iter->tile->header()->end_offset() + entry_iter->tile->overhead_size();
 
     // do it before TrimToFit avoid its eviction to free space
     MoveToLruHead(entry_iter);
@@ -469,11 +806,43 @@ TileCache* TileCacheFactory::createTileCache(const boost::property_tree::ptree&
   return new FlatTileCache(max_cache_size);
 }
 
+// Readers of the same extracts with the same config share them, so only the first reader in a
+// process has to map and index them
+std::shared_ptr<const GraphReader::tile_extract_t>
+GraphReader::get_extract_instance(const boost::property_tree::ptree& pt, bool traffic_readonly) {
+  // nothing to share
+  if (!pt.get_optional<std::string>("tile_extract") &&
+      !pt.get_optional<std::string>("traffic_extract")) {
+    return std::make_shared<const tile_extract_t>(pt, traffic_readonly);
+  }
+
+  std::stringstream key;
+  boost::property_tree::write_info(key, pt);
+  key << extract_identity(pt) << traffic_readonly;
+
+  // the lock is held while loading so that readers starting at the same time wait for the first
+  static std::mutex extracts_lock;
+  static std::unordered_map<std::string, std::weak_ptr<const tile_extract_t>> extracts;
+  std::lock_guard<std::mutex> guard(extracts_lock);
+  const auto name = key.str();
+  auto& extract = extracts[name];
+  auto shared = extract.lock();
+  if (!shared) {
+    // forget the ones nobody uses anymore, like older versions of the extracts
+    for (auto it = extracts.begin(); it != extracts.end();) {
+      it = it->second.expired() && it->first != name ? extracts.erase(it) : std::next(it);
+    }
+    shared = std::make_shared<const tile_extract_t>(pt, traffic_readonly);
+    extract = shared;
+  }
+  return shared;
+}
+
 // Constructor using separate tile files
 GraphReader::GraphReader(const boost::property_tree::ptree& pt,
                          std::unique_ptr<tile_getter_t>&& tile_getter,
                          bool traffic_readonly)
-    : tile_extract_(new tile_extract_t(pt, traffic_readonly)),
+    : tile_extract_(get_extract_instance(pt, traffic_readonly)),
       tile_dir_(tile_extract_->tiles.empty() ? pt.get<std::string>("tile_dir", "") : ""),
       tile_getter_(std::move(tile_getter)),
       max_concurrent_users_(pt.get<size_t>("max_concurrent_reader_users", 1)),
@@ -555,10 +924,12 @@ graph_tile_ptr GraphReader::GetGraphTile(const GraphId& graphid) {
 
   // Check if the level/tileid combination is in the cache
   auto base = graphid.Tile_Base();
+  ++tiles_fetched_;
   if (const auto& cached = cache_->Get(base)) {
     // LOG_DEBUG("Memory cache hit " + GraphTile::FileSuffix(base));
     return cached;
   }
+  ++tile_cache_misses_;
 
   // Try getting it from the memmapped tar extract
   if (!tile_extract_->tiles.empty()) {
@@ -568,6 +939,11 @@ graph_tile_ptr GraphReader::GetGraphTile(const GraphId& graphid) {
       // LOG_DEBUG("Memory map cache miss " + GraphTile::FileSuffix(base));
       return nullptr;
     }
+    // read the whole tile in one go rather than faulting it in a page at a time
+    if (tile_extract_->prefetch) {
+      const auto& archive = tile_extract_->archive;
+      archive->mm.advise(t->second.first - archive->mm.get(), t->second.second, POSIX_MADV_WILLNEED);
+    }
     auto memory = std::make_unique<TarballGraphMemory>(tile_extract_->archive, t->second);
 
     auto traffic_ptr = tile_extract_->traffic_tiles.find(base);
@@ -585,7 +961,8 @@ graph_tile_ptr GraphReader::GetGraphTile(const GraphId& graphid) {
     // LOG_DEBUG("Memory map cache hit " + GraphTile::FileSuffix(base));
 
     // Keep a copy in the cache and return it
-    const size_t size = AVERAGE_MM_TILE_SIZE; // tile.end_offset();  // TODO what size??
+    // the tile data is mapped rather than read into memory, but what it decompresses isnt
+    const size_t size = AVERAGE_MM_TILE_SIZE + tile->overhead_size();
     return cache_->Put(base, std::move(tile), size);
   } // Try getting it from flat file
   else {
@@ -624,11 +1001,99 @@ graph_tile_ptr GraphReader::GetGraphTile(const GraphId& graphid) {
     }
 
     // Keep a copy in the cache and return it
-    const size_t size = tile->header()->end_offset();
+    const size_t size = tile->header()->end_offset() + tile->overhead_size();
     return cache_->Put(base, std::move(tile), size);
   }
 }
 
+// Load a batch of tiles into the cache, fetching the ones we dont have locally in parallel
+size_t GraphReader::PrefetchTiles(const std::vector<GraphId>& tile_ids, size_t concurrency) {
+  // figure out which tiles we dont already have in the cache, loading the cheap ones right away
+  size_t available = 0;
+  std::vector<GraphId> missing;
+  std::unordered_set<GraphId> seen;
+  for (const auto& id : tile_ids) {
+    if (!id.Is_Valid() || id.level() > TileHierarchy::get_max_level())
+      continue;
+    auto base = id.Tile_Base();
+    if (!seen.insert(base).second)
+      continue;
+    // extracts and caches are memory already so theres nothing to gain from going wide
+    if (cache_->Contains(base) || !tile_extract_->tiles.empty() || !tile_getter_) {
+      available += GetGraphTile(base) != nullptr;
+      if (OverCommitted()) {
+        Trim();
+      }
+      continue;
+    }
+    // skip the ones we already know are not available
+    std::lock_guard<std::mutex> lock(_404s_lock);
+    if (_404s.find(base) == _404s.end())
+      missing.push_back(base);
+  }
+  if (missing.empty())
+    return available;
+
+  // each worker claims the next tile and either reads it from disk or fetches it from the url. the
+  // tile getter blocks when all of its curlers are busy so we dont bother with more workers than that
+  concurrency = std::min(concurrency ? concurrency : max_concurrent_users_, missing.size());
+  std::vector<graph_tile_ptr> fetched(missing.size());
+  std::atomic<size_t> next_tile(0);
+  auto fetch = [&]() {
+    for (size_t i = next_tile++; i < missing.size(); i = next_tile++) {
+      const auto& base = missing[i];
+      // a tile we cant read from disk may still be had from the url
+      if (!tile_dir_.empty()) {
+        try {
+          auto traffic_ptr = tile_extract_->traffic_tiles.find(base);
+          auto traffic_memory =
+              traffic_ptr != tile_extract_->traffic_tiles.end()
+                  ? std::make_unique<TarballGraphMemory>(tile_extract_->traffic_archive,
+                                                         traffic_ptr->second)
+                  : nullptr;
+          fetched[i] = GraphTile::Create(tile_dir_, base, std::move(traffic_memory));
+        } catch (const std::exception& e) {
+          LOG_WARN("Failed to read " + GraphTile::FileSuffix(base) + ": " + e.what());
+          fetched[i] = nullptr;
+        }
+      }
+      try {
+        if (!fetched[i] || !fetched[i]->header()) {
+          fetched[i] = GraphTile::CacheTileURL(tile_url_, base, tile_getter_.get(), tile_dir_);
+        }
+      } catch (const std::exception& e) {
+        LOG_WARN("Failed to prefetch " + GraphTile::FileSuffix(base) + ": " + e.what());
+        fetched[i] = nullptr;
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(concurrency - 1);
+  for (size_t i = 1; i < concurrency; ++i) {
+    workers.emplace_back(fetch);
+  }
+  fetch();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // the cache isnt thread safe so we fill it from this thread only
+  for (size_t i = 0; i < missing.size(); ++i) {
+    if (!fetched[i] || !fetched[i]->header()) {
+      std::lock_guard<std::mutex> lock(_404s_lock);
+      _404s.insert(missing[i]);
+      continue;
+    }
+    const size_t size = fetched[i]->header()->end_offset() + fetched[i]->overhead_size();
+    cache_->Put(missing[i], std::move(fetched[i]), size);
+    ++available;
+    if (OverCommitted()) {
+      Trim();
+    }
+  }
+  return available;
+}
+
 // Convenience method to get an opposing directed edge graph Id.
 GraphId GraphReader::GetOpposingEdgeId(const GraphId& edgeid, graph_tile_ptr& opp_tile) {
   // If you cant get the tile you get an invalid id
@@ -877,6 +1342,13 @@ std::string GraphReader::encoded_edge_shape(const valhalla::baldr::GraphId& edge
   return midgard::encode(shape);
 }
 
+std::optional<float> GraphReader::GetExtractWarmupProgress() const {
+  if (!tile_extract_->warmup) {
+    return std::nullopt;
+  }
+  return tile_extract_->warmup->progress();
+}
+
 // Note: this will grab all road tiles and transit tiles.
 std::unordered_set<GraphId> GraphReader::GetTileSet() const {
   // either mmap'd tiles
@@ -235,16 +235,23 @@ graph_tile_ptr GraphTile::CacheTileURL(const std::string& tile_url,
   if (result.status_ != tile_getter_t::status_code_t::SUCCESS) {
     return nullptr;
   }
-  // try to cache it on disk so we dont have to keep fetching it from url
-  store(cache_location, graphid, tile_getter, result.bytes_);
-
-  // turn the memory into a tile
+  // turn the memory into a tile first so that we never cache a corrupt or truncated tile to disk
+  graph_tile_ptr tile;
   if (tile_getter->gzipped()) {
-    return DecompressTile(graphid, result.bytes_);
+    tile = DecompressTile(graphid, result.bytes_);
+  } else {
+    // only keep a copy of the raw bytes around if we are going to write them to disk
+    auto bytes = cache_location.empty() ? std::move(result.bytes_) : result.bytes_;
+    tile = graph_tile_ptr{
+        new GraphTile(graphid, std::make_unique<const VectorGraphMemory>(std::move(bytes)))};
   }
 
-  return graph_tile_ptr{
-      new GraphTile(graphid, std::make_unique<const VectorGraphMemory>(std::move(result.bytes_)))};
+  // try to cache it on disk so we dont have to keep fetching it from url
+  if (tile) {
+    store(cache_location, graphid, tile_getter, result.bytes_);
+  }
+
+  return tile;
 }
 
 GraphTile::~GraphTile() = default;
@@ -360,6 +367,7 @@ void GraphTile::Initialize(const GraphId& graphid) {
     char* ptr2 = ptr1 + (header_->directededgecount() * sizeof(int32_t));
     predictedspeeds_.set_offset(reinterpret_cast<uint32_t*>(ptr1));
     predictedspeeds_.set_profiles(reinterpret_cast<int16_t*>(ptr2));
+    predictedspeeds_.reserve_cache(header_->predictedspeeds_count());
 
     lane_connectivity_size_ = header_->predictedspeeds_offset() - header_->lane_connectivity_offset();
   } else {
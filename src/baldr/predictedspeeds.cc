@@ -1,5 +1,7 @@
 #include "baldr/predictedspeeds.h"
 
+#include <cstring>
+
 namespace valhalla {
 namespace baldr {
 
@@ -11,6 +13,12 @@ constexpr float kSpeedNormalization = 0.031497039f; // sqrt(2.0f / 2016.0f);
 // Size of the cos table for the buckets
 constexpr uint32_t kCosBucketTableSize = kCoefficientCount * kBucketsPerWeek;
 
+// Number of independent partial sums used for the DCT dot products. Without them every addition
+// depends on the previous one which keeps the compiler from vectorizing the loop (it is not allowed
+// to reorder float additions on its own). With them the inner loop maps directly onto SIMD lanes
+constexpr uint32_t kDctLanes = 8;
+static_assert(kCoefficientCount % kDctLanes == 0, "DCT lanes must evenly divide the coefficients");
+
 // Precompute a cos table for each bucket of the week as a singleton.
 class BucketCosTable final {
 public:
@@ -32,10 +40,13 @@ public:
 private:
   // Construct the cos table
   BucketCosTable() {
-    // Fill out the table in bucket order.
+    // Fill out the table in bucket order. The first coefficient is scaled by 1/sqrt(2) in both the
+    // forward and inverse transform, since cos(0) = 1 we bake that into the table so that the DCTs
+    // are plain dot products
     float* t = &table_[0];
     for (uint32_t bucket = 0; bucket < kBucketsPerWeek; ++bucket) {
-      for (uint32_t c = 0; c < kCoefficientCount; ++c) {
+      *t++ = k1OverSqrt2;
+      for (uint32_t c = 1; c < kCoefficientCount; ++c) {
         *t++ = cosf(kPiBucketConstant * (bucket + 0.5f) * c);
       }
     }
@@ -55,11 +66,14 @@ std::array<int16_t, kCoefficientCount> compress_speed_buckets(const float* speed
   std::array<float, kCoefficientCount> coefficients;
   coefficients.fill(0.f);
 
-  // DCT-II with speed normalization
+  // DCT-II with speed normalization. The first coefficient is summed unscaled and scaled once at
+  // the end rather than using the table, so that compression rounds exactly as it always has and
+  // existing speed profiles keep encoding to the same coefficients
   for (uint32_t bucket = 0; bucket < kBucketsPerWeek; ++bucket) {
     // Get a pointer to the precomputed cos values for this bucket
     const float* cos_values = BucketCosTable::GetInstance().get(bucket);
-    for (uint32_t c = 0; c < kCoefficientCount; ++c) {
+    coefficients[0] += speeds[bucket];
+    for (uint32_t c = 1; c < kCoefficientCount; ++c) {
       coefficients[c] += cos_values[c] * speeds[bucket];
     }
   }
@@ -76,13 +90,59 @@ float decompress_speed_bucket(const int16_t* coefficients, uint32_t bucket_idx)
   // Get a pointer to the precomputed cos values for this bucket
   const float* b = BucketCosTable::GetInstance().get(bucket_idx);
 
-  // DCT-III with speed normalization
-  float speed = *coefficients * k1OverSqrt2;
-  const auto* coef_end = coefficients + kCoefficientCount;
-  for (++b, ++coefficients; coefficients < coef_end; ++coefficients, ++b) {
-    speed += *coefficients * *b;
+  // DCT-III with speed normalization, accumulated in independent lanes so it vectorizes
+  float lanes[kDctLanes] = {};
+  for (uint32_t c = 0; c < kCoefficientCount; c += kDctLanes) {
+    for (uint32_t l = 0; l < kDctLanes; ++l) {
+      lanes[l] += static_cast<float>(coefficients[c + l]) * b[c + l];
+    }
+  }
+
+  // pairwise reduction of the lanes
+  for (uint32_t width = kDctLanes / 2; width > 0; width /= 2) {
+    for (uint32_t l = 0; l < width; ++l) {
+      lanes[l] += lanes[l + width];
+    }
+  }
+  return lanes[0] * kSpeedNormalization;
+}
+
+float PredictedSpeeds::decompress_speed(const uint32_t idx, const uint32_t bucket) const {
+  // Get a pointer to the compressed speed profile for this edge. Assume the edge Id is valid
+  // (otherwise an exception would be thrown when getting the directed edge) and the profile
+  // offset is valid. If there is no predicted speed profile this method will not be called due
+  // to DirectedEdge::has_predicted_speed being false.
+  const int16_t* coefficients = profiles_ + offset_[idx];
+  float speed = decompress_speed_bucket(coefficients, bucket);
+  if (!cache_) {
+    return speed;
+  }
+
+  // Remember it, whatever was in its entry before is overwritten
+  const uint32_t key = (idx << kBucketBits) | bucket;
+  uint32_t speed_bits;
+  std::memcpy(&speed_bits, &speed, sizeof(speed));
+  auto& entry = cache_[(key * kCacheHashMultiplier) >> (32 - cache_bits_)];
+  entry.store((static_cast<uint64_t>(key) << 32) | speed_bits, std::memory_order_relaxed);
+  return speed;
+}
+
+void PredictedSpeeds::reserve_cache(const uint32_t profile_count) {
+  cache_.reset();
+  cache_bits_ = 0;
+  if (profile_count == 0) {
+    return;
+  }
+
+  // Enough room for a couple of buckets per profile but never more than the max
+  while (cache_bits_ < kMaxCacheBits && (1u << cache_bits_) < profile_count * 2) {
+    ++cache_bits_;
+  }
+  const size_t size = size_t(1) << cache_bits_;
+  cache_.reset(new std::atomic<uint64_t>[size]);
+  for (size_t i = 0; i < size; ++i) {
+    cache_[i].store(kEmptyCacheEntry, std::memory_order_relaxed);
   }
-  return speed * kSpeedNormalization;
 }
 
 std::string encode_compressed_speeds(const int16_t* coefficients) {
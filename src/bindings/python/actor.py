@@ -1,5 +1,5 @@
 import json
-from typing import Union
+from typing import List, Union
 
 try:
     from .python_valhalla import _Actor
@@ -25,6 +25,26 @@ def dict_or_str(func):
 
 
 class Actor(_Actor):
+    """
+    Runs requests without holding the GIL. Give it a concurrency above 1 to run that many requests
+    at once, be it from several python threads or in a batch, on actors that share one tile cache.
+    """
+
+    def batch(self, action: str, reqs: List[Union[str, dict]]) -> list:
+        """
+        Runs the requests of one action, e.g. "route", in parallel and returns their results in the
+        same order. A failed request gets its error response rather than raising.
+        """
+        if not all(isinstance(req, (str, dict)) for req in reqs):
+            raise ValueError("Requests must be either of type str or dict")
+        results = super().batch(
+            action, [json.dumps(req) if isinstance(req, dict) else req for req in reqs]
+        )
+        return [
+            json.loads(result) if isinstance(req, dict) else result
+            for req, result in zip(reqs, results)
+        ]
+
     @dict_or_str
     def route(self, req: Union[str, dict]):
         return super().route(req)
@@ -1,15 +1,27 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 #include "baldr/rapidjson_utils.h"
 #include <boost/make_shared.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "baldr/rapidjson_utils.h"
 #include "midgard/logging.h"
 #include "midgard/util.h"
 #include "tyr/actor.h"
+#include "worker.h"
 
 namespace vt = valhalla::tyr;
 namespace {
@@ -33,50 +45,235 @@ const boost::property_tree::ptree configure(const std::string& config) {
 
   return pt;
 }
+
+using action_t = std::string (vt::actor_t::*)(const std::string&,
+                                              const std::function<void()>*,
+                                              valhalla::Api*);
+
+// the actions a batch can run, by the names of the methods that run them one at a time
+const std::unordered_map<std::string, action_t> actions{
+    {"route", &vt::actor_t::route},
+    {"locate", &vt::actor_t::locate},
+    {"optimized_route", &vt::actor_t::optimized_route},
+    {"matrix", &vt::actor_t::matrix},
+    {"isochrone", &vt::actor_t::isochrone},
+    {"trace_route", &vt::actor_t::trace_route},
+    {"trace_attributes", &vt::actor_t::trace_attributes},
+    {"height", &vt::actor_t::height},
+    {"transit_available", &vt::actor_t::transit_available},
+    {"expansion", &vt::actor_t::expansion},
+    {"centroid", &vt::actor_t::centroid},
+    {"status", &vt::actor_t::status},
+};
+
+// actors to run requests from several python threads, or a batch of requests, at once. an actor
+// isn't thread safe so each request gets one to itself. they are made as they are needed, up to
+// the concurrency, and each has its own graph reader but with more than one they share the tiles
+// of a single synchronized cache
+class actor_pool_t {
+public:
+  actor_pool_t(const std::string& config, const size_t concurrency)
+      : config_(configure(config)), concurrency_(std::max<size_t>(concurrency, 1)) {
+    if (concurrency_ > 1) {
+      config_.put("mjolnir.global_synchronized_cache", true);
+    }
+    // the first actor is made right away so a bad config fails here
+    idle_.emplace_back(new vt::actor_t(config_, true));
+    created_ = 1;
+  }
+
+  // an actor that goes back to the pool when the request is done with it
+  class lease_t {
+  public:
+    lease_t(actor_pool_t& pool) : pool_(pool), actor_(pool.acquire()) {
+    }
+    ~lease_t() {
+      pool_.release(std::move(actor_));
+    }
+    std::string act(const action_t action, const std::string& request, valhalla::Api* api) {
+      return ((*actor_).*action)(request, nullptr, api);
+    }
+
+  protected:
+    actor_pool_t& pool_;
+    std::unique_ptr<vt::actor_t> actor_;
+  };
+
+  // runs one request, failures are thrown like they are by the actor
+  std::string act(const action_t action, const std::string& request) {
+    return lease_t(*this).act(action, request, nullptr);
+  }
+
+  // runs the requests on as many actors at once as the pool allows, the results come back in the
+  // order of the requests. a failed request gets the error the service would respond with
+  std::vector<std::string> batch(const std::string& action_name,
+                                 const std::vector<std::string>& requests) {
+    auto action = actions.find(action_name);
+    if (action == actions.cend()) {
+      throw std::invalid_argument("Unknown action: " + action_name);
+    }
+
+    std::vector<std::string> results(requests.size());
+    std::atomic<size_t> next{0};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+    auto work = [&]() {
+      try {
+        lease_t actor(*this);
+        for (size_t i = next++; i < requests.size(); i = next++) {
+          valhalla::Api api;
+          try {
+            results[i] = actor.act(action->second, requests[i], &api);
+          } catch (const valhalla::valhalla_exception_t& e) {
+            results[i] = valhalla::serialize_error(e, api);
+          } catch (const std::exception& e) {
+            results[i] = valhalla::serialize_error({499, std::string(e.what())}, api);
+          }
+        }
+      } catch (...) {
+        // only making an actor can fail, the others finish the batch without this one
+        std::lock_guard<std::mutex> lock(failure_mutex);
+        failure = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < std::min(concurrency_, requests.size()); ++i) {
+      threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    if (failure && next < requests.size()) {
+      std::rethrow_exception(failure);
+    }
+    return results;
+  }
+
+protected:
+  std::unique_ptr<vt::actor_t> acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    available_.wait(lock, [this]() { return !idle_.empty() || created_ < concurrency_; });
+    if (!idle_.empty()) {
+      auto actor = std::move(idle_.back());
+      idle_.pop_back();
+      return actor;
+    }
+    ++created_;
+    lock.unlock();
+    try {
+      return std::make_unique<vt::actor_t>(config_, true);
+    } catch (...) {
+      lock.lock();
+      --created_;
+      available_.notify_one();
+      throw;
+    }
+  }
+
+  void release(std::unique_ptr<vt::actor_t> actor) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.emplace_back(std::move(actor));
+    available_.notify_one();
+  }
+
+  boost::property_tree::ptree config_;
+  size_t concurrency_;
+  std::mutex mutex_;
+  std::condition_variable available_;
+  std::vector<std::unique_ptr<vt::actor_t>> idle_;
+  size_t created_;
+};
+
 } // namespace
 
 namespace py = pybind11;
 
 PYBIND11_MODULE(python_valhalla, m) {
-  py::class_<vt::actor_t>(m, "_Actor", "Valhalla Actor class")
-      .def(py::init<>([](std::string config) { return vt::actor_t(configure(config), true); }))
+  // the requests run without the GIL so other python threads can run meanwhile, be it python code
+  // or requests of their own on the other actors of the pool
+  using release_gil = py::call_guard<py::gil_scoped_release>;
+  py::class_<actor_pool_t>(m, "_Actor", "Valhalla Actor class")
+      .def(py::init<const std::string&, size_t>(), py::arg("config"), py::arg("concurrency") = 1)
       .def(
-          "route", [](vt::actor_t& self, std::string& req) { return self.route(req); },
-          "Calculates a route.")
+          "route",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::route, req);
+          },
+          "Calculates a route.", release_gil())
       .def(
-          "locate", [](vt::actor_t& self, std::string& req) { return self.locate(req); },
-          "Provides information about nodes and edges.")
+          "locate",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::locate, req);
+          },
+          "Provides information about nodes and edges.", release_gil())
       .def(
           "optimized_route",
-          [](vt::actor_t& self, std::string& req) { return self.optimized_route(req); },
-          "Optimizes the order of a set of waypoints by time.")
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::optimized_route, req);
+          },
+          "Optimizes the order of a set of waypoints by time.", release_gil())
       .def(
-          "matrix", [](vt::actor_t& self, std::string& req) { return self.matrix(req); },
-          "Computes the time and distance between a set of locations and returns them as a matrix table.")
+          "matrix",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::matrix, req);
+          },
+          "Computes the time and distance between a set of locations and returns them as a matrix table.",
+          release_gil())
       .def(
-          "isochrone", [](vt::actor_t& self, std::string& req) { return self.isochrone(req); },
-          "Calculates isochrones and isodistances.")
+          "isochrone",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::isochrone, req);
+          },
+          "Calculates isochrones and isodistances.", release_gil())
       .def(
-          "trace_route", [](vt::actor_t& self, std::string& req) { return self.trace_route(req); },
-          "Map-matching for a set of input locations, e.g. from a GPS.")
+          "trace_route",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::trace_route, req);
+          },
+          "Map-matching for a set of input locations, e.g. from a GPS.", release_gil())
       .def(
           "trace_attributes",
-          [](vt::actor_t& self, std::string& req) { return self.trace_attributes(req); },
-          "Returns detailed attribution along each portion of a route calculated from a set of input locations, e.g. from a GPS trace.")
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::trace_attributes, req);
+          },
+          "Returns detailed attribution along each portion of a route calculated from a set of input locations, e.g. from a GPS trace.",
+          release_gil())
       .def(
-          "height", [](vt::actor_t& self, std::string& req) { return self.height(req); },
-          "Provides elevation data for a set of input geometries.")
+          "height",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::height, req);
+          },
+          "Provides elevation data for a set of input geometries.", release_gil())
       .def(
           "transit_available",
-          [](vt::actor_t& self, std::string& req) { return self.transit_available(req); },
-          "Lookup if transit stops are available in a defined radius around a set of input locations.")
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::transit_available, req);
+          },
+          "Lookup if transit stops are available in a defined radius around a set of input locations.",
+          release_gil())
       .def(
-          "expansion", [](vt::actor_t& self, std::string& req) { return self.expansion(req); },
-          "Returns all road segments which were touched by the routing algorithm during the graph traversal.")
+          "expansion",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::expansion, req);
+          },
+          "Returns all road segments which were touched by the routing algorithm during the graph traversal.",
+          release_gil())
       .def(
-          "centroid", [](vt::actor_t& self, std::string& req) { return self.centroid(req); },
-          "Returns routes from all the input locations to the minimum cost meeting point of those paths.")
+          "centroid",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::centroid, req);
+          },
+          "Returns routes from all the input locations to the minimum cost meeting point of those paths.",
+          release_gil())
       .def(
-          "status", [](vt::actor_t& self, std::string& req) { return self.status(req); },
-          "Returns nothing or optionally details about Valhalla's configuration.");
+          "status",
+          [](actor_pool_t& self, const std::string& req) {
+            return self.act(&vt::actor_t::status, req);
+          },
+          "Returns nothing or optionally details about Valhalla's configuration.", release_gil())
+      .def("batch", &actor_pool_t::batch, py::arg("action"), py::arg("requests"),
+           "Runs a list of requests of one action, as many at once as the concurrency allows, and returns the list of their results. A failed request gets its error response instead.",
+           release_gil());
 }
@@ -2,6 +2,7 @@
 #include "config.h"
 #include "filesystem.h"
 #include "loki/worker.h"
+#include "midgard/metrics.h"
 #include "proto/status.pb.h"
 
 using namespace valhalla::baldr;
@@ -51,6 +52,11 @@ void loki_worker_t::status(Api& request) const {
     *action_pbf = Options_Action_Enum_Name(action);
   }
 
+  // cheap to get and what a load balancer wants to know about a freshly started instance
+  if (auto progress = reader->GetExtractWarmupProgress()) {
+    status->set_warmup_progress(*progress);
+  }
+
   // only return more info if explicitly asked for (can be very expensive)
   if (!request.options().verbose() || !allow_verbose)
     return;
@@ -73,6 +79,20 @@ void loki_worker_t::status(Api& request) const {
   status->set_has_timezones(tile && tile->node(0)->timezone() > 0);
   status->set_has_live_traffic(reader->HasLiveTraffic());
   status->set_osm_changeset(tile ? tile->header()->dataset_id() : 0);
+
+  // the histograms of the stats of the requests so far, if they are kept
+  if (midgard::metrics::enabled()) {
+    for (const auto& histogram : midgard::metrics::snapshot()) {
+      auto* metric = status->mutable_metrics()->Add();
+      metric->set_key(histogram.first);
+      metric->set_count(histogram.second.count);
+      metric->set_sum(histogram.second.sum);
+      metric->set_max(histogram.second.max);
+      metric->set_p50(histogram.second.quantile(.5));
+      metric->set_p90(histogram.second.quantile(.9));
+      metric->set_p99(histogram.second.quantile(.99));
+    }
+  }
 }
 } // namespace loki
 } // namespace valhalla
@@ -3,11 +3,13 @@
 #include <functional>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <unordered_set>
 
 #include "baldr/json.h"
 #include "baldr/rapidjson_utils.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "sif/autocost.h"
 #include "sif/bicyclecost.h"
 #include "sif/motorcyclecost.h"
@@ -308,6 +310,12 @@ void loki_worker_t::set_interrupt(const std::function<void()>* interrupt_functio
   reader->SetInterrupt(interrupt);
 }
 
+work_counters_t loki_worker_t::counters() const {
+  work_counters_t counters;
+  std::tie(counters.tiles_fetched, counters.tile_cache_misses) = reader->GetTileCounts();
+  return counters;
+}
+
 // Check if total arc distance exceeds the max distance limit for disable_hierarchy_pruning.
 // If true, add a warning and set the disable_hierarchy_pruning costing option to false.
 void loki_worker_t::check_hierarchy_distance(Api& request) {
@@ -365,13 +373,22 @@ loki_worker_t::work(const std::list<zmq::message_t>& job,
   // grab the request info and make sure to record any metrics before we are done
   auto& info = *static_cast<prime_server::http_request_info_t*>(request_info);
   LOG_INFO("Got Loki Request " + std::to_string(info.id));
-  Api request;
+  auto& request = request_arena.next();
   prime_server::worker_t::result_t result{true, {}, ""};
   try {
     // request parsing
     auto http_request =
         prime_server::http_request_t::from_string(static_cast<const char*>(job.front().data()),
                                                   job.front().size());
+
+    // the metrics of the process for prometheus to scrape, if they are kept
+    if (http_request.path == "/metrics" && midgard::metrics::enabled()) {
+      prime_server::http_response_t response(200, "OK", metrics_to_prometheus(),
+                                             prime_server::headers_t{worker::PROMETHEUS_MIME});
+      response.from_info(info);
+      return {false, {response.to_string()}, ""};
+    }
+
     ParseApi(http_request, request);
     const auto& options = request.options();
 
@@ -1,14 +1,18 @@
 #include "midgard/logging.h"
 #include "filesystem.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -50,6 +54,17 @@ std::string TimeStamp() {
   return buffer;
 }
 
+// returns the line to log: 'year/mo/dy hr:mn:sc.xxxxxx [LEVEL] message\n'
+std::string Record(const std::string& message, const std::string& custom_directive) {
+  std::string output;
+  output.reserve(message.length() + 64);
+  output.append(TimeStamp());
+  output.append(custom_directive);
+  output.append(message);
+  output.push_back('\n');
+  return output;
+}
+
 // the Log levels we support
 struct EnumHasher {
   template <typename T> std::size_t operator()(T t) const {
@@ -118,6 +133,10 @@ Logger::Logger(const LoggingConfig& /*config*/){};
 Logger::~Logger(){};
 void Logger::Log(const std::string&, const LogLevel){};
 void Logger::Log(const std::string&, const std::string&){};
+void Logger::Write(const std::string&){};
+size_t Logger::DroppedCount() const {
+  return 0;
+};
 bool logger_registered = RegisterLogger("", [](const LoggingConfig& config) {
   Logger* l = new Logger(config);
   return l;
@@ -145,17 +164,18 @@ public:
     std::string tmp = custom_directive; // to prevent -Wunused-parameter
     __android_log_print(ANDROID_LOG_INFO, "valhalla", "%s", message.c_str());
 #else
-    std::string output;
-    output.reserve(message.length() + 64);
-    output.append(TimeStamp());
-    output.append(custom_directive);
-    output.append(message);
-    output.push_back('\n');
+    Write(Record(message, custom_directive));
+#endif
+  }
+  virtual void Write(const std::string& records) {
+#ifdef __ANDROID__
+    __android_log_print(ANDROID_LOG_INFO, "valhalla", "%s", records.c_str());
+#else
     // cout is thread safe, to avoid multiple threads interleaving on one line
     // though, we make sure to only call the << operator once on std::cout
     // otherwise the << operators from different threads could interleave
     // obviously we dont care if flushes interleave
-    std::cout << output;
+    std::cout << records;
     std::cout.flush();
 #endif
   }
@@ -175,13 +195,14 @@ class StdErrLogger : public StdOutLogger {
     std::string tmp = custom_directive; // to prevent -Wunused-parameter
     __android_log_print(ANDROID_LOG_ERROR, "valhalla", "%s", message.c_str());
 #else
-    std::string output;
-    output.reserve(message.length() + 64);
-    output.append(TimeStamp());
-    output.append(custom_directive);
-    output.append(message);
-    output.push_back('\n');
-    std::cerr << output;
+    Write(Record(message, custom_directive));
+#endif
+  }
+  virtual void Write(const std::string& records) {
+#ifdef __ANDROID__
+    __android_log_print(ANDROID_LOG_ERROR, "valhalla", "%s", records.c_str());
+#else
+    std::cerr << records;
     std::cerr.flush();
 #endif
   }
@@ -222,14 +243,11 @@ public:
     Log(message, uncolored.find(level)->second);
   }
   virtual void Log(const std::string& message, const std::string& custom_directive = " [TRACE] ") {
-    std::string output;
-    output.reserve(message.length() + 64);
-    output.append(TimeStamp());
-    output.append(custom_directive);
-    output.append(message);
-    output.push_back('\n');
+    Write(Record(message, custom_directive));
+  }
+  virtual void Write(const std::string& records) {
     lock.lock();
-    file << output;
+    file << records;
     file.flush();
     lock.unlock();
     ReOpen();
@@ -279,6 +297,193 @@ bool file_logger_registered = RegisterLogger("file", [](const LoggingConfig& con
   return l;
 });
 
+// logger that formats messages on the calling thread and queues them for a background thread to
+// write with another logger, so the callers never wait on the output. the queue is a ring of slots
+// that each carry a sequence number saying whose turn it is to use the slot, so logging threads
+// only ever race on one atomic increment and never take a lock
+class AsyncLogger : public Logger {
+public:
+  AsyncLogger() = delete;
+  AsyncLogger(const LoggingConfig& config) : Logger(config) {
+    // the logger doing the writing gets the same config but with its own type
+    auto writer_config = config;
+    auto type = config.find("async_type");
+    writer_config["type"] = type == config.end() ? "std_out" : type->second;
+    if (writer_config["type"] == "async") {
+      throw std::runtime_error("The async logger can't write to another async logger");
+    }
+    auto color = config.find("color");
+    levels = writer_config["type"] != "file" && color != config.end() && color->second == "true"
+                 ? &colored
+                 : &uncolored;
+
+    // the queue holds a power of 2 messages so the slot of a position is a mask away
+    size_t queue_size = 4096;
+    auto size = config.find("queue_size");
+    if (size != config.end()) {
+      try {
+        queue_size = std::stoul(size->second);
+      } catch (...) { queue_size = 0; }
+      if (queue_size == 0) {
+        throw std::runtime_error(size->second + " is not a valid queue size");
+      }
+    }
+    size_t capacity = 1;
+    while (capacity < queue_size) {
+      capacity <<= 1;
+    }
+
+    // when the queue is full we either drop the message or wait until the writer made room
+    auto overflow = config.find("overflow");
+    if (overflow != config.end() && overflow->second != "drop" && overflow->second != "block") {
+      throw std::runtime_error(overflow->second + " is not a valid overflow, use drop or block");
+    }
+    block = overflow != config.end() && overflow->second == "block";
+
+    writer.reset(GetFactory().Produce(writer_config));
+    slots.reset(new slot_t[capacity]);
+    for (size_t i = 0; i < capacity; ++i) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask = capacity - 1;
+    drainer = std::thread(&AsyncLogger::Drain, this);
+  }
+  virtual ~AsyncLogger() {
+    done.store(true, std::memory_order_release);
+    drainer.join();
+  }
+  virtual void Log(const std::string& message, const LogLevel level) {
+    Log(message, levels->find(level)->second);
+  }
+  virtual void Log(const std::string& message, const std::string& custom_directive = " [TRACE] ") {
+    Enqueue(Record(message, custom_directive));
+  }
+  virtual void Write(const std::string& records) {
+    Enqueue(records);
+  }
+  virtual size_t DroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+protected:
+  // how much the writer collects before writing it all at once
+  static constexpr size_t kBatchSize = 64 * 1024;
+  // how often the writer yields when there is nothing to write before it starts to sleep, and how
+  // long it sleeps then, backing off up to the max
+  static constexpr size_t kIdleYields = 64;
+  static constexpr std::chrono::milliseconds kMinIdle{1};
+  static constexpr std::chrono::milliseconds kMaxIdle{16};
+
+  // a slot is free to write for the producer at position p when its sequence is p and has a
+  // record for the consumer at position p when its sequence is p + 1
+  struct slot_t {
+    std::atomic<size_t> sequence;
+    std::string record;
+  };
+
+  void Enqueue(std::string record) {
+    while (!TryPush(record)) {
+      if (!block) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  bool TryPush(std::string& record) {
+    auto position = enqueue_position.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = slots[position & mask];
+      auto sequence = slot.sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+      if (lag == 0) {
+        // the slot is free, try to claim it before another thread does
+        if (enqueue_position.compare_exchange_weak(position, position + 1,
+                                                   std::memory_order_relaxed)) {
+          slot.record = std::move(record);
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        // the writer hasn't taken the record from a lap ago yet, so the queue is full
+        return false;
+      } else {
+        // another thread claimed the slot first
+        position = enqueue_position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // only the writer thread pops so its position needs no synchronization
+  bool TryPop(std::string& record) {
+    auto& slot = slots[dequeue_position & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeue_position + 1) {
+      return false;
+    }
+    record = std::move(slot.record);
+    slot.sequence.store(dequeue_position + mask + 1, std::memory_order_release);
+    ++dequeue_position;
+    return true;
+  }
+
+  // writes out what is queued in batches until the logger goes away
+  void Drain() {
+    std::string records, record;
+    size_t reported = 0, yields = 0;
+    auto idle = kMinIdle;
+    while (true) {
+      // everything queued before the logger went away is still written
+      auto finishing = done.load(std::memory_order_acquire);
+      while (records.size() < kBatchSize && TryPop(record)) {
+        records.append(record);
+      }
+      auto dropped_now = dropped.load(std::memory_order_relaxed);
+      if (dropped_now != reported) {
+        records.append(Record(std::to_string(dropped_now - reported) +
+                                  " log messages were dropped because the queue was full",
+                              levels->find(LogLevel::LogWarn)->second));
+        reported = dropped_now;
+      }
+      if (!records.empty()) {
+        // nobody is there to hear about a failed write
+        try {
+          writer->Write(records);
+        } catch (...) {}
+        records.clear();
+        yields = 0;
+        idle = kMinIdle;
+        continue;
+      }
+      if (finishing) {
+        break;
+      }
+      // blocked loggers are likely about to queue more, so only sleep once it has been quiet
+      if (yields++ < kIdleYields) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::this_thread::sleep_for(idle);
+      idle = std::min(idle * 2, kMaxIdle);
+    }
+  }
+
+  const std::unordered_map<LogLevel, std::string, EnumHasher>* levels;
+  std::unique_ptr<Logger> writer;
+  bool block;
+  std::unique_ptr<slot_t[]> slots;
+  size_t mask;
+  alignas(64) std::atomic<size_t> enqueue_position{0};
+  alignas(64) size_t dequeue_position{0};
+  std::atomic<size_t> dropped{0};
+  std::atomic<bool> done{false};
+  std::thread drainer;
+};
+bool async_logger_registered = RegisterLogger("async", [](const LoggingConfig& config) {
+  Logger* l = new AsyncLogger(config);
+  return l;
+});
+
 } // namespace logging
 
 // statically get a logger using the factory
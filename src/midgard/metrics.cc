@@ -0,0 +1,96 @@
+#include "midgard/metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace {
+
+std::atomic<bool> metrics_enabled{false};
+std::mutex histograms_mutex;
+std::map<std::string, valhalla::midgard::metrics::histogram_t> histograms;
+
+} // namespace
+
+namespace valhalla {
+namespace midgard {
+
+namespace metrics {
+
+const std::array<double, kBucketCount>& bucket_bounds() {
+  static const std::array<double, kBucketCount> bounds = []() {
+    std::array<double, kBucketCount> bounds{};
+    double decade = 0.01;
+    for (size_t i = 0; i < kBucketCount; i += 3, decade *= 10) {
+      bounds[i] = decade;
+      if (i + 1 < kBucketCount)
+        bounds[i + 1] = 2 * decade;
+      if (i + 2 < kBucketCount)
+        bounds[i + 2] = 5 * decade;
+    }
+    return bounds;
+  }();
+  return bounds;
+}
+
+void histogram_t::observe(double value) {
+  const auto& bounds = bucket_bounds();
+  auto bucket = std::lower_bound(bounds.cbegin(), bounds.cend(), value) - bounds.cbegin();
+  ++counts[bucket];
+  max = count ? std::max(max, value) : value;
+  ++count;
+  sum += value;
+}
+
+double histogram_t::quantile(double fraction) const {
+  if (count == 0) {
+    return 0;
+  }
+  // find the bucket the value is in
+  const auto& bounds = bucket_bounds();
+  auto target = std::max(std::min(fraction, 1.), 0.) * count;
+  uint64_t below = 0;
+  size_t bucket = 0;
+  while (bucket < counts.size() - 1 && below + counts[bucket] < target) {
+    below += counts[bucket++];
+  }
+  if (counts[bucket] == 0) {
+    return 0;
+  }
+  // and guess where in it, none of the values can be past the max though
+  double lower = bucket == 0 ? 0 : bounds[bucket - 1];
+  double upper = bucket < bounds.size() ? std::min(bounds[bucket], max) : max;
+  lower = std::min(lower, upper);
+  return lower + (upper - lower) * (target - below) / counts[bucket];
+}
+
+void enable(bool enabled) {
+  metrics_enabled = enabled;
+}
+
+bool enabled() {
+  return metrics_enabled.load(std::memory_order_relaxed);
+}
+
+void observe(const std::string& key, double value) {
+  if (!enabled()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(histograms_mutex);
+  histograms[key].observe(value);
+}
+
+std::map<std::string, histogram_t> snapshot() {
+  std::lock_guard<std::mutex> lock(histograms_mutex);
+  return histograms;
+}
+
+void clear() {
+  std::lock_guard<std::mutex> lock(histograms_mutex);
+  histograms.clear();
+}
+
+} // namespace metrics
+
+} // namespace midgard
+} // namespace valhalla
@@ -3,14 +3,191 @@
 #include "filesystem.h"
 #include "midgard/logging.h"
 #include "mjolnir/util.h"
+#include <algorithm>
+#include <limits>
 #include <sqlite3.h>
 #include <unordered_map>
 
 #include <spatialite.h>
 
+namespace {
+
+// edges further than this east or west of a tile are too far from any point in it for rounding to
+// change on which side of the point they cross its latitude
+constexpr double kEdgeMargin = 1e-9;
+
+// how many of the edges near a tile go into a band on average and how many bands a ring gets at
+// most
+constexpr size_t kEdgesPerBand = 4;
+constexpr size_t kMaxBands = 256;
+
+// whether an edge toggles the inside state of a point, this is exactly the test done by
+// bg::strategy::within::crossings_multiply so we come to the same answers
+inline bool crosses(double tx, double ty, double x0, double y0, double x1, double y1) {
+  bool yflag0 = y0 >= ty;
+  bool yflag1 = y1 >= ty;
+  return yflag0 != yflag1 && (((y1 - ty) * (x0 - x1) >= (x1 - tx) * (y0 - y1)) == yflag1);
+}
+
+// the band a latitude falls in, never decreasing with the latitude
+inline size_t band_of(double y, double miny, double height, size_t count) {
+  double band = (y - miny) / height;
+  if (!(band > 0)) {
+    return 0;
+  }
+  return band >= count ? count - 1 : static_cast<size_t>(band);
+}
+
+} // namespace
+
 namespace valhalla {
 namespace mjolnir {
 
+MultiPolyIndex::MultiPolyIndex(const std::multimap<uint32_t, multi_polygon_type>& polys,
+                               const AABB2<PointLL>& bounds)
+    : minx_(bounds.minx()), miny_(bounds.miny()), maxx_(bounds.maxx()), maxy_(bounds.maxy()) {
+  multi_polygons_.reserve(polys.size());
+  for (const auto& poly : polys) {
+    multi_polygon_t multi{poly.first, &poly.second, static_cast<uint32_t>(polygons_.size()), 0};
+    for (const auto& polygon : poly.second) {
+      polygon_t prepared{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                         std::numeric_limits<double>::lowest(),
+                         std::numeric_limits<double>::lowest()};
+      for (const auto& point : polygon.outer()) {
+        prepared.minx = std::min(prepared.minx, point.x());
+        prepared.miny = std::min(prepared.miny, point.y());
+        prepared.maxx = std::max(prepared.maxx, point.x());
+        prepared.maxy = std::max(prepared.maxy, point.y());
+      }
+      // polygons that can't cover any point of the tile get no rings
+      prepared.rings_begin = prepared.rings_end = static_cast<uint32_t>(rings_.size());
+      if (prepared.maxy >= miny_ && prepared.miny <= maxy_ &&
+          prepared.maxx >= minx_ - kEdgeMargin) {
+        add_ring(polygon.outer());
+        for (const auto& inner : polygon.inners()) {
+          add_ring(inner);
+        }
+        prepared.rings_end = static_cast<uint32_t>(rings_.size());
+      }
+      polygons_.push_back(prepared);
+    }
+    multi.polygons_end = static_cast<uint32_t>(polygons_.size());
+    multi_polygons_.push_back(multi);
+  }
+}
+
+void MultiPolyIndex::add_ring(const polygon_type::ring_type& ring) {
+  ring_t prepared{};
+  // a closed ring needs at least 4 points, boost takes the point to be outside of anything less
+  prepared.degenerate = ring.size() < 4;
+  prepared.east_begin = static_cast<uint32_t>(east_mins_.size());
+
+  std::vector<edge_t> near;
+  for (size_t i = 1; i < ring.size(); ++i) {
+    edge_t edge{ring[i - 1].x(), ring[i - 1].y(), ring[i].x(), ring[i].y()};
+    double lo = std::min(edge.y0, edge.y1);
+    double hi = std::max(edge.y0, edge.y1);
+    // never spans the latitude of a point in the tile or is never crossed going east from one
+    if (hi < miny_ || lo >= maxy_ || std::max(edge.x0, edge.x1) < minx_ - kEdgeMargin) {
+      continue;
+    }
+    // always crossed when it spans the latitude of the point
+    if (std::min(edge.x0, edge.x1) > maxx_ + kEdgeMargin) {
+      east_mins_.push_back(lo);
+      east_maxs_.push_back(hi);
+      continue;
+    }
+    near.push_back(edge);
+  }
+  prepared.east_end = static_cast<uint32_t>(east_mins_.size());
+  std::sort(east_mins_.begin() + prepared.east_begin, east_mins_.end());
+  std::sort(east_maxs_.begin() + prepared.east_begin, east_maxs_.end());
+
+  // put each of the other edges into all the bands it spans
+  prepared.band_count = static_cast<uint32_t>(
+      std::max<size_t>(1, std::min(kMaxBands, near.size() / kEdgesPerBand)));
+  prepared.band_height = (maxy_ - miny_) / prepared.band_count;
+  if (!(prepared.band_height > 0)) {
+    prepared.band_count = 1;
+    prepared.band_height = 1;
+  }
+  prepared.bands_begin = static_cast<uint32_t>(band_offsets_.size());
+  std::vector<uint32_t> counts(prepared.band_count + 1, 0);
+  for (const auto& edge : near) {
+    auto first = band_of(std::min(edge.y0, edge.y1), miny_, prepared.band_height,
+                         prepared.band_count);
+    auto last = band_of(std::max(edge.y0, edge.y1), miny_, prepared.band_height,
+                        prepared.band_count);
+    for (auto band = first; band <= last; ++band) {
+      ++counts[band + 1];
+    }
+  }
+  uint32_t offset = static_cast<uint32_t>(edges_.size());
+  for (auto& count : counts) {
+    offset += count;
+    band_offsets_.push_back(offset);
+  }
+  edges_.resize(band_offsets_.back());
+  std::vector<uint32_t> next(band_offsets_.begin() + prepared.bands_begin, band_offsets_.end() - 1);
+  for (const auto& edge : near) {
+    auto first = band_of(std::min(edge.y0, edge.y1), miny_, prepared.band_height,
+                         prepared.band_count);
+    auto last = band_of(std::max(edge.y0, edge.y1), miny_, prepared.band_height,
+                        prepared.band_count);
+    for (auto band = first; band <= last; ++band) {
+      edges_[next[band]++] = edge;
+    }
+  }
+  rings_.push_back(prepared);
+}
+
+bool MultiPolyIndex::ring_covers(const ring_t& ring, double x, double y) const {
+  if (ring.degenerate) {
+    return false;
+  }
+  // the edges east of the tile whose latitudes span the point's
+  auto mins = east_mins_.begin() + ring.east_begin;
+  auto maxs = east_maxs_.begin() + ring.east_begin;
+  auto east_count = ring.east_end - ring.east_begin;
+  auto crossings = (std::lower_bound(mins, mins + east_count, y) - mins) -
+                   (std::lower_bound(maxs, maxs + east_count, y) - maxs);
+  bool inside = crossings % 2;
+  // and the ones near the point
+  auto band = ring.bands_begin + band_of(y, miny_, ring.band_height, ring.band_count);
+  for (auto i = band_offsets_[band]; i < band_offsets_[band + 1]; ++i) {
+    const auto& edge = edges_[i];
+    inside ^= crosses(x, y, edge.x0, edge.y0, edge.x1, edge.y1);
+  }
+  return inside;
+}
+
+bool MultiPolyIndex::covers(size_t index, const PointLL& ll) const {
+  const auto& multi = multi_polygons_[index];
+  double x = ll.lng();
+  double y = ll.lat();
+  if (x < minx_ || x > maxx_ || y < miny_ || y > maxy_) {
+    return bg::covered_by(point_type(x, y), *multi.geometry,
+                          bg::strategy::within::crossings_multiply<point_type>());
+  }
+
+  // inside the outer ring and not inside any of the holes of any of the polygons
+  for (auto p = multi.polygons_begin; p < multi.polygons_end; ++p) {
+    const auto& polygon = polygons_[p];
+    if (polygon.rings_begin == polygon.rings_end || y < polygon.miny || y > polygon.maxy ||
+        x > polygon.maxx + kEdgeMargin || !ring_covers(rings_[polygon.rings_begin], x, y)) {
+      continue;
+    }
+    bool in_hole = false;
+    for (auto r = polygon.rings_begin + 1; r < polygon.rings_end && !in_hole; ++r) {
+      in_hole = ring_covers(rings_[r], x, y);
+    }
+    if (!in_hole) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Get the dbhandle of a sqlite db.  Used for timezones and admins DBs.
 sqlite3* GetDBHandle(const std::string& database) {
 
@@ -62,6 +239,32 @@ uint32_t GetMultiPolyId(const std::multimap<uint32_t, multi_polygon_type>& polys
   return index;
 }
 
+// Get the polygon index using the polygons prepared for the tile the point is in.
+uint32_t
+GetMultiPolyId(const MultiPolyIndex& polys, const PointLL& ll, GraphTileBuilder& graphtile) {
+  uint32_t index = 0;
+  for (size_t i = 0; i < polys.size(); ++i) {
+    if (polys.covers(i, ll)) {
+      const auto& admin = graphtile.admins_builder(polys.id(i));
+      if (!admin.state_offset())
+        index = polys.id(i);
+      else
+        return polys.id(i);
+    }
+  }
+  return index;
+}
+
+// Get the polygon index using the polygons prepared for the tile the point is in.
+uint32_t GetMultiPolyId(const MultiPolyIndex& polys, const PointLL& ll) {
+  for (size_t i = 0; i < polys.size(); ++i) {
+    if (polys.covers(i, ll)) {
+      return polys.id(i);
+    }
+  }
+  return 0;
+}
+
 // This function returns a vector pairs.  The pair is a string and boolean {language,
 // is_default_language}. The function takes a LL and checks if it is covered by a linguistic,
 // state/providence, and country polygon. If the LL is covered by the polygon, then the language is
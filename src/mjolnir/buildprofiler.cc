@@ -0,0 +1,281 @@
+#include "mjolnir/buildprofiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "baldr/graphtile.h"
+#include "midgard/logging.h"
+
+using namespace valhalla::baldr;
+
+namespace {
+
+double since_epoch(const std::chrono::steady_clock::time_point& time) {
+  return std::chrono::duration<double>(time.time_since_epoch()).count();
+}
+
+// cpu time the calling thread has used so far
+double thread_cpu_seconds() {
+#ifndef _WIN32
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+#endif
+  return 0;
+}
+
+#ifdef __linux__
+// calls back with the key and numeric value of each "key: value" line of a /proc file
+void read_proc(const char* file, const std::function<void(const std::string&, uint64_t)>& callback) {
+  std::ifstream stream(file);
+  std::string line;
+  while (std::getline(stream, line)) {
+    auto colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    std::istringstream value(line.substr(colon + 1));
+    uint64_t number;
+    if (value >> number) {
+      callback(line.substr(0, colon), number);
+    }
+  }
+}
+#endif
+
+valhalla::baldr::json::fixed_t seconds(const double value) {
+  return valhalla::baldr::json::fixed_t{value, 3};
+}
+
+} // namespace
+
+namespace valhalla {
+namespace mjolnir {
+
+BuildProfiler& BuildProfiler::Get() {
+  static BuildProfiler profiler;
+  return profiler;
+}
+
+void BuildProfiler::Enable(const std::string& report_file) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  report_file_ = report_file;
+  stages_.clear();
+  in_stage_ = false;
+  enabled_.store(!report_file.empty(), std::memory_order_relaxed);
+}
+
+BuildProfiler::Resources BuildProfiler::Measure(const bool reset_peak) {
+  Resources resources;
+  resources.wall_seconds = since_epoch(std::chrono::steady_clock::now());
+#ifndef _WIN32
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    resources.user_seconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6;
+    resources.system_seconds = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+#ifdef __APPLE__
+    resources.peak_rss_bytes = usage.ru_maxrss;
+#else
+    resources.peak_rss_bytes = usage.ru_maxrss * 1024;
+#endif
+  }
+#endif
+#ifdef __linux__
+  // resetting the high water mark lets each stage report its own peak rather than the process one
+  if (reset_peak) {
+    std::ofstream("/proc/self/clear_refs") << "5";
+  }
+  read_proc("/proc/self/status", [&resources](const std::string& key, uint64_t value) {
+    if (key == "VmHWM") {
+      resources.peak_rss_bytes = value * 1024;
+    }
+  });
+  read_proc("/proc/self/io", [&resources](const std::string& key, uint64_t value) {
+    if (key == "read_bytes") {
+      resources.read_bytes = value;
+    } else if (key == "write_bytes") {
+      resources.write_bytes = value;
+    } else if (key == "rchar") {
+      resources.read_chars = value;
+    } else if (key == "wchar") {
+      resources.written_chars = value;
+    }
+  });
+#endif
+  return resources;
+}
+
+void BuildProfiler::StartStage(const BuildStage stage) {
+  auto start = Measure(true);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stages_.emplace_back();
+  stages_.back().stage = stage;
+  stages_.back().start = start;
+  in_stage_ = true;
+}
+
+void BuildProfiler::EndStage() {
+  auto end = Measure(false);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (in_stage_) {
+    stages_.back().end = end;
+    in_stage_ = false;
+  }
+}
+
+void BuildProfiler::RecordTile(const GraphId& tile_id,
+                               const double seconds,
+                               const double cpu_seconds) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!in_stage_) {
+    return;
+  }
+  auto& stage = stages_.back();
+  ++stage.tiles;
+  stage.tile_seconds += seconds;
+
+  auto ms = seconds * 1000;
+  size_t bucket = ms < 1 ? 0 : static_cast<size_t>(std::log2(ms)) + 1;
+  ++stage.histogram[std::min(bucket, kHistogramBuckets - 1)];
+
+  auto greater = [](const std::pair<double, GraphId>& a, const std::pair<double, GraphId>& b) {
+    return a.first > b.first;
+  };
+  if (stage.slowest.size() < kSlowestTiles) {
+    stage.slowest.emplace_back(seconds, tile_id);
+    std::push_heap(stage.slowest.begin(), stage.slowest.end(), greater);
+  } else if (seconds > stage.slowest.front().first) {
+    std::pop_heap(stage.slowest.begin(), stage.slowest.end(), greater);
+    stage.slowest.back() = {seconds, tile_id};
+    std::push_heap(stage.slowest.begin(), stage.slowest.end(), greater);
+  }
+
+  auto inserted = stage.threads.emplace(std::this_thread::get_id(), ThreadProfile{});
+  auto& thread = inserted.first->second;
+  if (inserted.second) {
+    thread.index = stage.threads.size() - 1;
+  }
+  ++thread.tiles;
+  thread.seconds += seconds;
+  thread.cpu_seconds += cpu_seconds;
+}
+
+json::MapPtr BuildProfiler::Report() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto stages = json::array({});
+  for (const auto& stage : stages_) {
+    // a stage that is still running is reported up to now
+    const auto& end = &stage == &stages_.back() && in_stage_ ? Measure(false) : stage.end;
+
+    auto histogram = json::array({});
+    for (size_t i = 0; i < stage.histogram.size(); ++i) {
+      if (stage.histogram[i]) {
+        histogram->emplace_back(json::map({
+            {"min_ms", static_cast<uint64_t>(i == 0 ? 0 : 1ull << (i - 1))},
+            {"count", stage.histogram[i]},
+        }));
+      }
+    }
+
+    auto slowest = stage.slowest;
+    std::sort(slowest.begin(), slowest.end(), [](const auto& a, const auto& b) {
+      return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+    auto slowest_tiles = json::array({});
+    for (const auto& tile : slowest) {
+      slowest_tiles->emplace_back(json::map({
+          {"tile", GraphTile::FileSuffix(tile.second)},
+          {"seconds", seconds(tile.first)},
+      }));
+    }
+
+    std::vector<const ThreadProfile*> thread_profiles;
+    for (const auto& thread : stage.threads) {
+      thread_profiles.push_back(&thread.second);
+    }
+    std::sort(thread_profiles.begin(), thread_profiles.end(),
+              [](const ThreadProfile* a, const ThreadProfile* b) { return a->index < b->index; });
+    auto threads = json::array({});
+    for (const auto* thread : thread_profiles) {
+      threads->emplace_back(json::map({
+          {"thread", static_cast<uint64_t>(thread->index)},
+          {"tiles", thread->tiles},
+          {"seconds", seconds(thread->seconds)},
+          {"cpu_seconds", seconds(thread->cpu_seconds)},
+      }));
+    }
+
+    stages->emplace_back(json::map({
+        {"stage", to_string(stage.stage)},
+        {"seconds", seconds(end.wall_seconds - stage.start.wall_seconds)},
+        {"user_seconds", seconds(end.user_seconds - stage.start.user_seconds)},
+        {"system_seconds", seconds(end.system_seconds - stage.start.system_seconds)},
+        {"peak_rss_bytes", end.peak_rss_bytes},
+        {"read_bytes", end.read_bytes - stage.start.read_bytes},
+        {"write_bytes", end.write_bytes - stage.start.write_bytes},
+        {"read_chars", end.read_chars - stage.start.read_chars},
+        {"written_chars", end.written_chars - stage.start.written_chars},
+        {"tiles", json::map({
+                      {"count", stage.tiles},
+                      {"seconds", seconds(stage.tile_seconds)},
+                      {"histogram", histogram},
+                      {"slowest", slowest_tiles},
+                      {"threads", threads},
+                  })},
+    }));
+  }
+  return json::map({{"stages", stages}});
+}
+
+void BuildProfiler::WriteReport() const {
+  if (!enabled()) {
+    return;
+  }
+  std::ofstream file(report_file_);
+  if (!file.is_open()) {
+    LOG_WARN("Unable to write the build profile to " + report_file_);
+    return;
+  }
+  file << *Report() << std::endl;
+  LOG_INFO("Wrote the build profile to " + report_file_);
+}
+
+BuildProfiler::Stage::Stage(const BuildStage stage) : enabled_(BuildProfiler::Get().enabled()) {
+  if (enabled_) {
+    BuildProfiler::Get().StartStage(stage);
+  }
+}
+
+BuildProfiler::Stage::~Stage() {
+  if (enabled_) {
+    BuildProfiler::Get().EndStage();
+  }
+}
+
+BuildProfiler::TileTimer::TileTimer(const GraphId& tile_id)
+    : tile_id_(tile_id), enabled_(BuildProfiler::Get().enabled()), cpu_start_(0) {
+  if (enabled_) {
+    start_ = std::chrono::steady_clock::now();
+    cpu_start_ = thread_cpu_seconds();
+  }
+}
+
+BuildProfiler::TileTimer::~TileTimer() {
+  if (enabled_) {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    BuildProfiler::Get().RecordTile(tile_id_, std::chrono::duration<double>(elapsed).count(),
+                                    thread_cpu_seconds() - cpu_start_);
+  }
+}
+
+} // namespace mjolnir
+} // namespace valhalla
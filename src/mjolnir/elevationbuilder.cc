@@ -15,6 +15,7 @@
 #include "midgard/pointll.h"
 #include "midgard/polyline2.h"
 #include "midgard/util.h"
+#include "mjolnir/buildprofiler.h"
 #include "mjolnir/graphtilebuilder.h"
 #include "mjolnir/util.h"
 #include "skadi/sample.h"
@@ -290,6 +291,7 @@ void add_elevations_to_multiple_tiles(const boost::property_tree::ptree& pt,
     tilequeue.pop_front();
     lock.unlock();
 
+    BuildProfiler::TileTimer timer(tile_id);
     add_elevations_to_single_tile(graphreader, lock, geo_attribute_cache, sample, tile_id);
   }
 }
@@ -23,6 +23,7 @@
 #include "midgard/tiles.h"
 #include "midgard/util.h"
 #include "mjolnir/admin.h"
+#include "mjolnir/buildprofiler.h"
 #include "mjolnir/edgeinfobuilder.h"
 #include "mjolnir/ferry_connections.h"
 #include "mjolnir/graphbuilder.h"
@@ -42,22 +43,26 @@ namespace {
  * we also need to then update the edges that pointed to them
  *
  */
-std::map<GraphId, size_t> SortGraph(const std::string& nodes_file, const std::string& edges_file) {
+std::map<GraphId, size_t> SortGraph(const std::string& nodes_file,
+                                    const std::string& edges_file,
+                                    unsigned int concurrency) {
   LOG_INFO("Sorting graph...");
 
   // Sort nodes by graphid then by grid within the tile. This sorts nodes geo-spatially which
   // helps performance by improving memory coherence.
   sequence<Node> nodes(nodes_file, false);
-  nodes.sort([](const Node& a, const Node& b) {
-    if (a.graph_id == b.graph_id) {
-      if (a.grid_id == b.grid_id) {
-        return a.node.osmid_ < b.node.osmid_;
-      } else {
-        return a.grid_id < b.grid_id;
-      }
-    }
-    return a.graph_id < b.graph_id;
-  });
+  nodes.sort(
+      [](const Node& a, const Node& b) {
+        if (a.graph_id == b.graph_id) {
+          if (a.grid_id == b.grid_id) {
+            return a.node.osmid_ < b.node.osmid_;
+          } else {
+            return a.grid_id < b.grid_id;
+          }
+        }
+        return a.graph_id < b.graph_id;
+      },
+      nodes.sort_buffer_size, concurrency);
 
   // run through the sorted nodes, going back to the edges they reference and updating each edge
   // to point to the first (out of the duplicates) nodes index. at the end of this there will be
@@ -485,6 +490,7 @@ void BuildTileSet(const std::string& ways_file,
     try {
       // What actually writes the tile
       GraphId tile_id = tile.first.Tile_Base();
+      BuildProfiler::TileTimer timer(tile_id);
       GraphTileBuilder graphtile(tile_dir, tile_id, false);
 
       // Information about tile creation
@@ -519,6 +525,13 @@ void BuildTileSet(const std::string& ways_file,
         tile_within_one_tz = true;
       }
 
+      // prepare the polygons once for all the nodes of the tile, unless there's nothing to look up
+      const decltype(admin_polys) no_polys;
+      const MultiPolyIndex admin_poly_index(tile_within_one_admin ? no_polys : admin_polys,
+                                            tiling.TileBounds(id));
+      const MultiPolyIndex tz_poly_index(tile_within_one_tz ? no_polys : tz_polys,
+                                         tiling.TileBounds(id));
+
       // Iterate through the nodes
       uint32_t idx = 0; // Current directed edge index
 
@@ -551,8 +564,9 @@ void BuildTileSet(const std::string& ways_file,
         std::vector<std::pair<std::string, bool>> default_languages;
 
         if (use_admin_db) {
-          admin_index = (tile_within_one_admin) ? admin_polys.begin()->first
-                                                : GetMultiPolyId(admin_polys, node_ll, graphtile);
+          admin_index = (tile_within_one_admin)
+                            ? admin_polys.begin()->first
+                            : GetMultiPolyId(admin_poly_index, node_ll, graphtile);
           dor = drive_on_right[admin_index];
           default_languages = GetMultiPolyIndexes(language_polys, node_ll);
 
@@ -1274,7 +1288,7 @@ void BuildTileSet(const std::string& ways_file,
 
         // Set the time zone index
         uint32_t tz_index =
-            (tile_within_one_tz) ? tz_polys.begin()->first : GetMultiPolyId(tz_polys, node_ll);
+            (tile_within_one_tz) ? tz_polys.begin()->first : GetMultiPolyId(tz_poly_index, node_ll);
 
         graphtile.nodes().back().set_timezone(tz_index);
 
@@ -1445,7 +1459,9 @@ std::map<GraphId, size_t> GraphBuilder::BuildEdges(const boost::property_tree::p
       },
       pt.get<bool>("mjolnir.data_processing.infer_turn_channels", true));
 
-  return SortGraph(nodes_file, edges_file);
+  return SortGraph(nodes_file, edges_file,
+                   std::max(1u, pt.get<unsigned int>("mjolnir.concurrency",
+                                                     std::thread::hardware_concurrency())));
 }
 
 // Build the graph from the input
@@ -1,5 +1,6 @@
 #include "mjolnir/graphenhancer.h"
 #include "mjolnir/admin.h"
+#include "mjolnir/buildprofiler.h"
 #include "mjolnir/countryaccess.h"
 #include "mjolnir/graphtilebuilder.h"
 #include "mjolnir/util.h"
@@ -55,11 +56,7 @@ typedef boost::geometry::model::d2::point_xy<double> point_type;
 typedef boost::geometry::model::polygon<point_type> polygon_type;
 typedef boost::geometry::model::multi_polygon<polygon_type> multi_polygon_type;
 
-// Number of tries when determining not thru edges
-constexpr uint32_t kMaxNoThruTries = 256;
-
-// Radius (km) to use for density
-constexpr float kDensityRadius = 2.0f;
+// Squared radius and latitude extent of the density search
 constexpr float kDensityRadius2 = kDensityRadius * kDensityRadius;
 constexpr float kDensityLatDeg = (kDensityRadius * kMetersPerKm) / kMetersPerDegreeLat;
 
@@ -1323,6 +1320,7 @@ void enhance(const boost::property_tree::ptree& pt,
     }
     GraphId tile_id = tilequeue.front();
     tilequeue.pop();
+    BuildProfiler::TileTimer timer(tile_id);
 
     // Get a readable tile.If the tile is empty, skip it. Empty tiles are
     // added where ways go through a tile but no end not is within the tile.
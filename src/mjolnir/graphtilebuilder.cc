@@ -64,10 +64,6 @@ GraphTileBuilder::GraphTileBuilder(const std::string& tile_dir,
 
   // Done if not deserializing and creating builders for everything
   if (!deserialize) {
-    textlistbuilder_.emplace_back("");
-    text_offset_map_.emplace("", 0);
-    text_list_offset_ = 1;
-
     // Add a dummy admin record at index 0 to be used if admin records are
     // not used/created or if none is found.
     // TODO: do we really want to hardcode "None" for country and state?
@@ -214,19 +210,16 @@ GraphTileBuilder::GraphTileBuilder(const std::string& tile_dir,
     edgeinfo_offset_map_[offset] = &edgeinfo_list_.back();
   }
 
-  // Text list
+  // Text list. The entries keep their offsets so we take the bytes as they are
+  textlistbuilder_.Assign(textlist_, textlist_size_);
   for (auto ni = name_info.begin(); ni != name_info.end(); ++ni) {
     // compute the width of the entry by looking at the next offset or the end if its the last one
     auto next = std::next(ni);
     auto width = next != name_info.end() ? (next->name_offset_ - ni->name_offset_)
                                          : (textlist_size_ - ni->name_offset_);
 
-    // Keep the bytes for this entry....remove null terminating char as it is added in StoreTileData
-    textlistbuilder_.emplace_back(textlist_ + ni->name_offset_, width - 1);
-    // Remember what offset they had
-    text_offset_map_.emplace(textlistbuilder_.back(), ni->name_offset_);
-    // Keep track of how large it is for storing it back to disk later
-    text_list_offset_ += textlistbuilder_.back().length() + 1;
+    // Remember what offset they had, without the null terminating char
+    textlistbuilder_.Index(ni->name_offset_, width - 1);
   }
 
   // Lane connectivity
@@ -371,9 +364,7 @@ void GraphTileBuilder::StoreTileData() {
 
     // Write the names
     header_builder_.set_textlist_offset(header_builder_.edgeinfo_offset() + edge_info_size);
-    for (const auto& text : textlistbuilder_) {
-      in_mem << text << '\0';
-    }
+    in_mem.write(textlistbuilder_.data(), textlistbuilder_.size());
 
     // Add padding (if needed) to align to 8-byte word.
     int tmp = in_mem.tellp() % 8;
@@ -384,7 +375,7 @@ void GraphTileBuilder::StoreTileData() {
 
     // Write lane connections
     header_builder_.set_lane_connectivity_offset(header_builder_.textlist_offset() +
-                                                 text_list_offset_ + padding);
+                                                 textlistbuilder_.size() + padding);
     std::sort(lane_connectivity_builder_.begin(), lane_connectivity_builder_.end());
     in_mem.write(reinterpret_cast<const char*>(lane_connectivity_builder_.data()),
                  lane_connectivity_builder_.size() * sizeof(LaneConnectivity));
@@ -405,7 +396,7 @@ void GraphTileBuilder::StoreTileData() {
     LOG_DEBUG((boost::format("Write: %1% nodes = %2% directededges = %3% signs %4% edgeinfo offset "
                              "= %5% textlist offset = %6% lane connections = %7%") %
                filename % nodes_builder_.size() % directededges_builder_.size() %
-               signs_builder_.size() % edge_info_offset_ % text_list_offset_ %
+               signs_builder_.size() % edge_info_offset_ % textlistbuilder_.size() %
                lane_connectivity_builder_.size())
                   .str());
     LOG_DEBUG((boost::format("   admins = %1%  departures = %2% stops = %3% routes = %4%") %
@@ -886,22 +877,7 @@ uint32_t GraphTileBuilder::AddName(const std::string& name) {
     return 0;
   }
 
-  // If nothing already used this name
-  auto existing_text_offset = text_offset_map_.find(name);
-  if (existing_text_offset == text_offset_map_.end()) {
-    // Save the current offset and add name to text list
-    uint32_t offset = text_list_offset_;
-    textlistbuilder_.emplace_back(name);
-
-    // Add name/offset pair to map and update text offset value
-    // to length of string plus null terminator
-    text_offset_map_.emplace(name, text_list_offset_);
-    text_list_offset_ += (name.length() + 1);
-    return offset;
-  } else {
-    // Return the offset to the existing name
-    return existing_text_offset->second;
-  }
+  return textlistbuilder_.Add(name);
 }
 
 // Add admin
@@ -1,4 +1,5 @@
 #include "mjolnir/graphvalidator.h"
+#include "mjolnir/buildprofiler.h"
 #include "mjolnir/graphtilebuilder.h"
 #include "mjolnir/util.h"
 
@@ -275,6 +276,7 @@ void validate(
     GraphId tile_id = tilequeue.front();
     tilequeue.pop_front();
     lock.unlock();
+    BuildProfiler::TileTimer timer(tile_id);
 
     // Point tiles to the set we need for current level
     const auto& tiles = tile_id.level() == TileHierarchy::GetTransitLevel().level
@@ -0,0 +1,367 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include "baldr/graphconstants.h"
+#include "baldr/tilehierarchy.h"
+#include "midgard/aabb2.h"
+#include "midgard/constants.h"
+#include "midgard/distanceapproximator.h"
+#include "midgard/logging.h"
+#include "mjolnir/graphenhancer.h"
+#include "mjolnir/osmchange.h"
+#include "mjolnir/osmpbfparser.h"
+
+using namespace valhalla::baldr;
+using namespace valhalla::midgard;
+
+namespace {
+
+// how far around a changed node we look for tiles, a node that moved further than this across a
+// tile boundary is only caught through the ways using it
+constexpr double kNodeMargin = 0.01;
+
+// calls back with the name and value of each attribute in the body of an xml tag
+template <class callback_t> void for_each_attribute(std::string_view tag, const callback_t& callback) {
+  size_t pos = 0;
+  while (true) {
+    auto equals = tag.find('=', pos);
+    if (equals == std::string_view::npos || equals + 1 >= tag.size()) {
+      return;
+    }
+    auto start = tag.find_first_not_of(" \t\r\n", pos);
+    auto name = tag.substr(start, tag.find_last_not_of(" \t\r\n", equals - 1) + 1 - start);
+    auto quote = tag.find_first_of("\"'", equals + 1);
+    if (quote == std::string_view::npos) {
+      return;
+    }
+    auto end = tag.find(tag[quote], quote + 1);
+    if (end == std::string_view::npos) {
+      return;
+    }
+    callback(name, tag.substr(quote + 1, end - quote - 1));
+    pos = end + 1;
+  }
+}
+
+template <class T> bool parse_number(std::string_view value, T& number) {
+  auto result = std::from_chars(value.data(), value.data() + value.size(), number);
+  return result.ec == std::errc() && result.ptr == value.data() + value.size();
+}
+
+// lat and lon don't always come with a from_chars for doubles so we use a stream
+bool parse_coordinate(std::string_view value, double& coordinate) {
+  std::istringstream stream{std::string(value)};
+  stream.imbue(std::locale::classic());
+  return static_cast<bool>(stream >> coordinate);
+}
+
+// remembers where the changed nodes were before the change and which ways used them
+struct previous_state_callback : public OSMPBF::Callback {
+  explicit previous_state_callback(valhalla::mjolnir::OSMChange& change) : change_(change) {
+  }
+
+  void node_callback(const uint64_t osmid,
+                     const double lng,
+                     const double lat,
+                     const OSMPBF::Tags& /*tags*/) override {
+    if (change_.nodes.count(osmid)) {
+      change_.locations.emplace_back(lng, lat);
+    }
+  }
+
+  void way_callback(const uint64_t osmid,
+                    const OSMPBF::Tags& /*tags*/,
+                    const std::vector<uint64_t>& nodes) override {
+    for (const auto node : nodes) {
+      if (change_.nodes.count(node)) {
+        change_.ways.insert(osmid);
+        return;
+      }
+    }
+  }
+
+  void relation_callback(const uint64_t /*osmid*/,
+                         const OSMPBF::Tags& /*tags*/,
+                         const std::vector<OSMPBF::Member>& /*members*/) override {
+  }
+
+  void changeset_callback(const uint64_t /*changeset_id*/) override {
+  }
+
+  valhalla::mjolnir::OSMChange& change_;
+};
+
+} // namespace
+
+namespace valhalla {
+namespace mjolnir {
+
+// Add the contents of an osc file to the change
+void ParseOSMChange(const std::string& file, OSMChange& change) {
+  std::ifstream stream(file, std::ios::binary);
+  if (!stream.is_open()) {
+    throw std::runtime_error("Unable to open: " + file);
+  }
+  std::string xml((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+  bool in_relation = false;
+  for (size_t pos = xml.find('<'); pos != std::string::npos; pos = xml.find('<', pos)) {
+    auto end = xml.find('>', pos);
+    if (end == std::string::npos) {
+      break;
+    }
+    std::string_view tag(xml.data() + pos + 1, end - pos - 1);
+    pos = end + 1;
+
+    // closing tags only matter for relations so we know when their members end
+    if (!tag.empty() && tag.front() == '/') {
+      in_relation = in_relation && tag.substr(1, 8) != "relation";
+      continue;
+    }
+    bool self_closing = !tag.empty() && tag.back() == '/';
+    auto name_end = tag.find_first_of(" \t\r\n/");
+    auto name = tag.substr(0, name_end);
+    auto attributes = name_end == std::string_view::npos ? std::string_view() : tag.substr(name_end);
+
+    if (name == "node") {
+      uint64_t id = 0;
+      double lat = 0, lon = 0;
+      bool has_id = false, has_lat = false, has_lon = false;
+      for_each_attribute(attributes, [&](std::string_view key, std::string_view value) {
+        if (key == "id") {
+          has_id = parse_number(value, id);
+        } else if (key == "lat") {
+          has_lat = parse_coordinate(value, lat);
+        } else if (key == "lon") {
+          has_lon = parse_coordinate(value, lon);
+        }
+      });
+      if (has_id) {
+        change.nodes.insert(id);
+      }
+      // deletions often come without a location, then only the ways using the node tell us where
+      if (has_lat && has_lon) {
+        change.locations.emplace_back(lon, lat);
+      }
+    } else if (name == "way" || name == "relation") {
+      uint64_t id = 0;
+      for_each_attribute(attributes, [&](std::string_view key, std::string_view value) {
+        if (key == "id" && parse_number(value, id)) {
+          (name == "way" ? change.ways : change.relations).insert(id);
+        }
+      });
+      in_relation = name == "relation" && !self_closing;
+    } else if (name == "member" && in_relation) {
+      std::string_view type;
+      uint64_t ref = 0;
+      bool has_ref = false;
+      for_each_attribute(attributes, [&](std::string_view key, std::string_view value) {
+        if (key == "type") {
+          type = value;
+        } else if (key == "ref") {
+          has_ref = parse_number(value, ref);
+        }
+      });
+      if (has_ref && type == "way") {
+        change.ways.insert(ref);
+      } else if (has_ref && type == "node") {
+        change.nodes.insert(ref);
+      }
+    }
+  }
+
+  LOG_INFO("Read " + file + ": " + std::to_string(change.nodes.size()) + " nodes, " +
+           std::to_string(change.ways.size()) + " ways and " +
+           std::to_string(change.relations.size()) + " relations changed so far");
+}
+
+// Add what the data before the change knew about the changed nodes
+void ParsePreviousState(const std::vector<std::string>& files, OSMChange& change) {
+  previous_state_callback callback(change);
+  for (const auto& file : files) {
+    std::ifstream stream(file, std::ios::in | std::ios::binary);
+    if (!stream.is_open()) {
+      throw std::runtime_error("Unable to open: " + file);
+    }
+    OSMPBF::Parser::parse(stream,
+                          static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES |
+                                                        OSMPBF::Interest::WAYS),
+                          callback);
+  }
+  LOG_INFO("Read the data from before the change: " + std::to_string(change.ways.size()) +
+           " ways changed including those using changed nodes");
+}
+
+// Find the tiles a rebuild with the change applied can alter
+std::unordered_set<GraphId> AffectedTiles(GraphReader& reader, const OSMChange& change) {
+  const auto transit_level = TileHierarchy::GetTransitLevel().level;
+  std::unordered_set<GraphId> tiles;
+  auto add_area = [&tiles, transit_level](const AABB2<PointLL>& bbox) {
+    for (const auto& tile_id : TileHierarchy::GetGraphIds(bbox)) {
+      if (tile_id.level() != transit_level) {
+        tiles.insert(tile_id);
+      }
+    }
+  };
+
+  // the road tiles of the existing tileset
+  std::vector<GraphId> tileset;
+  for (const auto& tile_id : reader.GetTileSet()) {
+    if (tile_id.level() != transit_level) {
+      tileset.push_back(tile_id);
+    }
+  }
+
+  // tiles holding edges of changed ways, along with where those edges are and the nodes they join
+  std::vector<AABB2<PointLL>> areas;
+  std::unordered_set<GraphId> changed_nodes;
+  for (const auto& tile_id : tileset) {
+    auto tile = reader.GetGraphTile(tile_id);
+    for (const auto& edge : tile->GetDirectedEdges()) {
+      if (!edge.is_shortcut() && change.ways.count(tile->edgeinfo(&edge).wayid())) {
+        tiles.insert(tile_id);
+        areas.emplace_back(tile->edgeinfo(&edge).shape());
+        changed_nodes.insert(edge.endnode());
+      }
+    }
+    if (reader.OverCommitted()) {
+      reader.Trim();
+    }
+  }
+  LOG_INFO(std::to_string(tiles.size()) + " tiles contain edges of changed ways");
+
+  // tiles around the changed nodes and the nodes of the tileset right there
+  for (const auto& location : change.locations) {
+    AABB2<PointLL> area{location.lng() - kNodeMargin, location.lat() - kNodeMargin,
+                        location.lng() + kNodeMargin, location.lat() + kNodeMargin};
+    add_area(area);
+    areas.push_back(area);
+    for (const auto& tile_id : TileHierarchy::GetGraphIds(area)) {
+      auto tile = tile_id.level() != transit_level ? reader.GetGraphTile(tile_id) : nullptr;
+      for (uint32_t i = 0; tile && i < tile->header()->nodecount(); ++i) {
+        if (area.Contains(tile->node(i)->latlng(tile->header()->base_ll()))) {
+          changed_nodes.insert(tile_id + i);
+        }
+      }
+    }
+  }
+  LOG_INFO(std::to_string(tiles.size()) + " tiles after adding changed node locations");
+
+  // the enhancer gives every node the density of the roads within kDensityRadius of it, which
+  // goes into the edges leaving it, so tiles that close to the change can get different edges
+  for (const auto& area : areas) {
+    const double lat_margin = kDensityRadius * kMetersPerKm / kMetersPerDegreeLat + kNodeMargin;
+    const double lat = std::min(std::max(std::abs(area.miny()), std::abs(area.maxy())), 85.0);
+    const double lng_margin =
+        kDensityRadius * kMetersPerKm / DistanceApproximator<PointLL>::MetersPerLngDegree(lat) +
+        kNodeMargin;
+    add_area({area.minx() - lng_margin, area.miny() - lat_margin, area.maxx() + lng_margin,
+              area.maxy() + lat_margin});
+  }
+  LOG_INFO(std::to_string(tiles.size()) + " tiles after adding the road density radius");
+
+  // the enhancer marks an edge not thru when a search from its end node runs out of roads within
+  // kMaxNoThruTries expansions without reaching a better road than residential. so any edge ending
+  // that many hops from the change can come out differently, unless a better road on the way there
+  // already ends the search. we walk out from the changed nodes over all levels to find them
+  std::unordered_set<GraphId> reached(changed_nodes.begin(), changed_nodes.end());
+  std::vector<GraphId> hop_nodes(changed_nodes.begin(), changed_nodes.end()), next_hop_nodes;
+  for (uint32_t hop = 0; hop <= kMaxNoThruTries && !hop_nodes.empty(); ++hop) {
+    for (size_t i = 0; i < hop_nodes.size(); ++i) {
+      // the tile of this node holds the edges leaving it, which are the ones ending at a node one
+      // hop closer to the change (all edges come in pairs)
+      const auto node_id = hop_nodes[i];
+      tiles.insert(node_id.Tile_Base());
+      auto tile = hop < kMaxNoThruTries ? reader.GetGraphTile(node_id) : nullptr;
+      if (!tile) {
+        continue;
+      }
+      // the same node on the other levels is the same distance from the change
+      const auto* node = tile->node(node_id);
+      for (const auto& transition : tile->GetNodeTransitions(node)) {
+        if (reached.insert(transition.endnode()).second) {
+          hop_nodes.push_back(transition.endnode());
+        }
+      }
+      // a search expanding a node with a better road stops there, the changed nodes themselves may
+      // no longer have theirs though
+      const auto edges = tile->GetDirectedEdges(node);
+      if (hop > 0 && std::any_of(edges.begin(), edges.end(), [](const DirectedEdge& edge) {
+            return !edge.is_shortcut() && edge.classification() < RoadClass::kTertiary;
+          })) {
+        continue;
+      }
+      for (const auto& edge : edges) {
+        if (!edge.is_shortcut() && edge.endnode().level() != transit_level &&
+            reached.insert(edge.endnode()).second) {
+          next_hop_nodes.push_back(edge.endnode());
+        }
+      }
+    }
+    hop_nodes.swap(next_hop_nodes);
+    next_hop_nodes.clear();
+    if (reader.OverCommitted()) {
+      reader.Trim();
+    }
+  }
+  LOG_INFO(std::to_string(tiles.size()) + " tiles after adding the reach of the not thru search");
+
+  // tiles of the other levels over the same area. the hierarchy builder moves nodes between levels
+  // and renumbers them, so a change at one level can move graph ids in the tiles above or below it
+  std::vector<GraphId> changed(tiles.begin(), tiles.end());
+  for (const auto& tile_id : changed) {
+    auto bbox = TileHierarchy::GetGraphIdBoundingBox(tile_id);
+    // shrink it a little so we don't pick up the neighbours that just touch the edge of the tile
+    auto margin_x = bbox.Width() * 0.01, margin_y = bbox.Height() * 0.01;
+    add_area({bbox.minx() + margin_x, bbox.miny() + margin_y, bbox.maxx() - margin_x,
+              bbox.maxy() - margin_y});
+  }
+  LOG_INFO(std::to_string(tiles.size()) + " tiles after adding the other hierarchy levels");
+
+  // tiles that point into the changed ones, either with edges ending there, shortcuts that are made
+  // of edges there or transitions to nodes there. they keep their own graph ids but their
+  // references need to be refreshed
+  std::unordered_set<GraphId> dependents;
+  for (const auto& tile_id : tileset) {
+    if (tiles.count(tile_id)) {
+      continue;
+    }
+    auto tile = reader.GetGraphTile(tile_id);
+    bool dependent = false;
+    for (const auto& edge : tile->GetDirectedEdges()) {
+      dependent = tiles.count(edge.endnode().Tile_Base()) > 0;
+      if (!dependent && edge.is_shortcut()) {
+        for (const auto& point : tile->edgeinfo(&edge).shape()) {
+          if (tiles.count(TileHierarchy::GetGraphId(point, tile_id.level()))) {
+            dependent = true;
+            break;
+          }
+        }
+      }
+      if (dependent) {
+        break;
+      }
+    }
+    for (uint32_t i = 0; !dependent && i < tile->header()->transitioncount(); ++i) {
+      dependent = tiles.count(tile->transition(i)->endnode().Tile_Base()) > 0;
+    }
+    if (dependent) {
+      dependents.insert(tile_id);
+    }
+    if (reader.OverCommitted()) {
+      reader.Trim();
+    }
+  }
+  tiles.insert(dependents.begin(), dependents.end());
+  LOG_INFO(std::to_string(tiles.size()) + " tiles after adding the tiles leading into them");
+
+  return tiles;
+}
+
+} // namespace mjolnir
+} // namespace valhalla
@@ -0,0 +1,190 @@
+#ifndef VALHALLA_MJOLNIR_OSMNODESTORE_H
+#define VALHALLA_MJOLNIR_OSMNODESTORE_H
+
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "filesystem.h"
+#include "midgard/sequence.h"
+#include "mjolnir/osmnode.h"
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * A memory mapped store of the OSMNodes referenced by ways, addressed directly by osm id. A bit set
+ * over the range of referenced ids marks which nodes are referenced and every 512 ids we keep a
+ * running count of the bits set before them. The slot of a node is then the number of referenced
+ * ids below it, so there is exactly one record per referenced node and finding it is a popcount
+ * over at most 8 words. The bit sets are sparse files so ranges of ids no way references cost no
+ * disk, and since they start at the smallest referenced id an extract pays nothing for the ids
+ * below its own. Negative osm ids (which the pbf parser hands us as huge unsigned ones) have no
+ * place in the range and must not be referenced.
+ */
+class OSMNodeStore final {
+public:
+  // the largest osm id the store takes, anything above it was a negative id in the pbf
+  static constexpr uint64_t kMaxId = std::numeric_limits<int64_t>::max();
+
+  /**
+   * Constructor. Creates the backing files with room for the ids from min_id to max_id inclusive.
+   * @param file_prefix  path prefix for the temporary files backing the store
+   * @param min_id       the smallest osm id that will be referenced
+   * @param max_id       the largest osm id that will be referenced
+   */
+  OSMNodeStore(const std::string& file_prefix, const uint64_t min_id, const uint64_t max_id)
+      : file_prefix_(file_prefix), min_id_(min_id), size_(0) {
+    if (min_id > max_id || max_id > kMaxId) {
+      throw std::invalid_argument("Invalid osm node id range " + std::to_string(min_id) + " to " +
+                                  std::to_string(max_id));
+    }
+    word_count_ = (max_id - min_id) / 64 + 1;
+    referenced_.create(fresh_file(".referenced.tmp"), word_count_);
+    intersections_.create(fresh_file(".intersections.tmp"), word_count_);
+  }
+
+  /**
+   * Destructor. Removes the backing files.
+   */
+  ~OSMNodeStore() {
+    referenced_.unmap();
+    intersections_.unmap();
+    ranks_.unmap();
+    nodes_.unmap();
+    for (const auto* suffix : {".referenced.tmp", ".intersections.tmp", ".ranks.tmp", ".nodes.tmp"}) {
+      filesystem::remove(file_prefix_ + suffix);
+    }
+  }
+
+  OSMNodeStore(const OSMNodeStore&) = delete;
+  OSMNodeStore& operator=(const OSMNodeStore&) = delete;
+
+  /**
+   * Marks the OSM Id as referenced by a way. If it was already referenced, or the way marked it as
+   * one of its ends, it is marked as an intersection. Must be called before freeze.
+   * @param  id            OSM Id of the node, within the range the store was created for.
+   * @param  intersection  whether the way already knows the node is an intersection
+   */
+  inline void reference(const uint64_t id, const bool intersection = false) {
+    const uint64_t offset = id - min_id_;
+    uint64_t& word = referenced_.get()[offset / 64];
+    const uint64_t bit = static_cast<uint64_t>(1) << (offset % 64);
+    if (intersection || (word & bit)) {
+      intersections_.get()[offset / 64] |= bit;
+    }
+    word |= bit;
+  }
+
+  /**
+   * Test if the OSM Id is referenced by any way.
+   * @param  id  OSM Id of the node.
+   * @return Returns true if a way references the node.
+   */
+  inline bool referenced(const uint64_t id) const {
+    const uint64_t offset = id - min_id_;
+    return id >= min_id_ && offset / 64 < word_count_ &&
+           (referenced_.get()[offset / 64] & (static_cast<uint64_t>(1) << (offset % 64)));
+  }
+
+  /**
+   * Test if the OSM Id is an intersection, ie. it is referenced more than once (by multiple ways or
+   * by the same way) or a way marked it as one of its ends.
+   * @param  id  OSM Id of the node.
+   * @return Returns true if the node is known to be an intersection.
+   */
+  inline bool intersection(const uint64_t id) const {
+    const uint64_t offset = id - min_id_;
+    return id >= min_id_ && offset / 64 < word_count_ &&
+           (intersections_.get()[offset / 64] & (static_cast<uint64_t>(1) << (offset % 64)));
+  }
+
+  /**
+   * Counts the referenced ids and makes room to store a node for each of them. After this no more
+   * ids may be referenced.
+   */
+  void freeze() {
+    ranks_.create(fresh_file(".ranks.tmp"), word_count_ / kWordsPerBlock + 1);
+    size_ = 0;
+    for (uint64_t i = 0; i < word_count_; ++i) {
+      if (i % kWordsPerBlock == 0) {
+        ranks_.get()[i / kWordsPerBlock] = size_;
+      }
+      size_ += popcount(referenced_.get()[i]);
+    }
+    if (size_ > 0) {
+      nodes_.create(fresh_file(".nodes.tmp"), size_);
+    }
+  }
+
+  /**
+   * Stores the node in the slot of its OSM Id, which must be referenced. Storing a node for an id
+   * that already has one overwrites it, use get first to keep the first one.
+   * @param  node  the node to store.
+   */
+  inline void set(const OSMNode& node) {
+    nodes_.get()[rank(node.osmid_)] = node;
+  }
+
+  /**
+   * Gets the node stored for the OSM Id. Since empty slots read as id 0, OSM Ids start at 1.
+   * @param  id  OSM Id of the node.
+   * @return Returns the node or nullptr if it is not referenced or was never stored.
+   */
+  inline const OSMNode* get(const uint64_t id) const {
+    if (!referenced(id)) {
+      return nullptr;
+    }
+    const OSMNode* node = nodes_.get() + rank(id);
+    return node->osmid_ == id ? node : nullptr;
+  }
+
+  /**
+   * @return Returns the number of referenced nodes, only valid after freeze.
+   */
+  uint64_t size() const {
+    return size_;
+  }
+
+private:
+  static constexpr uint64_t kWordsPerBlock = 8;
+
+  static uint64_t popcount(const uint64_t bits) {
+    return std::bitset<64>(bits).count();
+  }
+
+  // number of referenced ids smaller than this one
+  inline uint64_t rank(const uint64_t id) const {
+    const uint64_t offset = id - min_id_;
+    const uint64_t word = offset / 64;
+    const uint64_t* words = referenced_.get();
+    uint64_t count = ranks_.get()[word / kWordsPerBlock];
+    for (uint64_t i = word - word % kWordsPerBlock; i < word; ++i) {
+      count += popcount(words[i]);
+    }
+    return count + popcount(words[word] & ((static_cast<uint64_t>(1) << (offset % 64)) - 1));
+  }
+
+  // mem_map::create keeps an existing file of the right size, we need ours zeroed
+  std::string fresh_file(const std::string& suffix) const {
+    auto file_name = file_prefix_ + suffix;
+    filesystem::remove(file_name);
+    return file_name;
+  }
+
+  std::string file_prefix_;
+  uint64_t min_id_;
+  uint64_t word_count_;
+  uint64_t size_;
+  midgard::mem_map<uint64_t> referenced_;
+  midgard::mem_map<uint64_t> intersections_;
+  midgard::mem_map<uint64_t> ranks_;
+  midgard::mem_map<OSMNode> nodes_;
+};
+
+} // namespace mjolnir
+} // namespace valhalla
+
+#endif // VALHALLA_MJOLNIR_OSMNODESTORE_H
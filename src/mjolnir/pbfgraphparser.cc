@@ -23,6 +23,7 @@
 #include "mjolnir/pbfgraphparser.h"
 #include "mjolnir/timeparsing.h"
 #include "mjolnir/util.h"
+#include "osmnodestore.h"
 #include "proto/common.pb.h"
 
 using namespace valhalla::midgard;
@@ -31,6 +32,11 @@ using namespace valhalla::mjolnir;
 
 namespace {
 
+// How many chunks of a sequence to sort at once. Each one is up to 512MB of the sequence
+size_t sort_concurrency(const boost::property_tree::ptree& pt) {
+  return std::max(1u, pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency()));
+}
+
 // Convenience method to get a number from a string. Uses try/catch in case
 // stoi throws an exception
 int get_number(const std::string& tag, const std::string& value) { // NOLINT
@@ -148,7 +154,7 @@ public:
 
   graph_callback(const boost::property_tree::ptree& pt, OSMData& osmdata)
       : lua_(get_lua(pt)), osmdata_(osmdata) {
-    current_way_node_index_ = last_node_ = last_way_ = last_relation_ = 0;
+    last_node_ = last_way_ = last_relation_ = 0;
 
     highway_cutoff_rc_ = RoadClass::kPrimary;
     for (auto& level : TileHierarchy::levels()) {
@@ -2003,26 +2009,9 @@ public:
       return; // we are done.
     }
 
-    // if we found all of the node ids we were looking for already we can bail
-    if (current_way_node_index_ >= way_nodes_->size()) {
-      return;
-    }
-
-    // if the current osmid of this node of this pbf file is greater than the waynode we are looking
-    // for then it must be in another pbf file. so we need to move on to the next waynode that could
-    // possibly actually be in this pbf file
-    if (osmid > (*(*way_nodes_)[current_way_node_index_]).node.osmid_) {
-      current_way_node_index_ = way_nodes_->find_first_of(
-          OSMWayNode{{osmid}},
-          [](const OSMWayNode& a, const OSMWayNode& b) { return a.node.osmid_ <= b.node.osmid_; },
-          current_way_node_index_);
-    }
-
-    // if this nodes id is less than the waynode we are looking for then we know its a node we can
-    // skip because it means there were no ways that we kept that referenced it. also we could run out
-    // of waynodes to look for and in that case we are done as well
-    if (current_way_node_index_ >= way_nodes_->size() ||
-        osmid < (*(*way_nodes_)[current_way_node_index_]).node.osmid_) {
+    // skip the nodes that no way we kept references and the ones we already got from another pbf
+    // (extracts that overlap share their border nodes), the first copy of a node wins
+    if (!node_store_->referenced(osmid) || node_store_->get(osmid) != nullptr) {
       return;
     }
 
@@ -2268,14 +2257,9 @@ public:
     // Different types of named nodes are tagged as a named intersection
     n.set_named_intersection(named_junction || named_toll_node);
 
-    // If way parsing marked it as the beginning or end of a way (dead ends) we'll keep that too
-    sequence<OSMWayNode>::iterator element = (*way_nodes_)[current_way_node_index_];
-    auto way_node = *element;
-    intersection = intersection || way_node.node.intersection_;
-
-    // If multiple ways reference this its also an intersection
-    if (!intersection && current_way_node_index_ < way_nodes_->size() - 1 &&
-        osmid == (*(*way_nodes_)[current_way_node_index_ + 1]).node.osmid_) {
+    // If multiple ways reference this its also an intersection, as is it if way parsing marked it
+    // as the beginning or end of a way (dead ends)
+    if (node_store_->intersection(osmid)) {
       intersection = true;
     }
 
@@ -2285,16 +2269,8 @@ public:
       osmdata_.node_count++;
     }
 
-    // Update all copies of this node that various ways referenced
-    while (current_way_node_index_ < way_nodes_->size() &&
-           (way_node = element = (*way_nodes_)[current_way_node_index_]).node.osmid_ == osmid) {
-      // we need to keep the duplicate flag that way parsing set
-      n.flat_loop_ = way_node.node.flat_loop_;
-      way_node.node = n;
-      element = way_node;
-      ++current_way_node_index_;
-      osmdata_.edge_count += intersection;
-    }
+    // Keep it for all the copies of this node that various ways referenced
+    node_store_->set(n);
     if (++osmdata_.osm_node_count % 5000000 == 0) {
       LOG_DEBUG("Processed " + std::to_string(osmdata_.osm_node_count) + " nodes on ways");
     }
@@ -4993,9 +4969,8 @@ public:
   // Ways and nodes written to file, nodes are written in the order they appear in way (shape)
   std::unique_ptr<sequence<OSMWay>> ways_;
   std::unique_ptr<sequence<OSMWayNode>> way_nodes_;
-  // When updating the references with the node information we keep the last index we looked at
-  // this lets us only have to iterate over the whole set once
-  size_t current_way_node_index_;
+  // When parsing nodes, the ids referenced by ways and the storage for the nodes we parse for them
+  OSMNodeStore* node_store_ = nullptr;
   uint64_t last_node_, last_way_, last_relation_;
   std::unordered_map<uint64_t, size_t> loop_nodes_;
 
@@ -5078,8 +5053,7 @@ OSMData PBFGraphParser::ParseWays(const boost::property_tree::ptree& pt,
   // way's node list. Iterate through each pbf input file.
   LOG_INFO("Parsing ways...");
   for (auto& file_handle : file_handles) {
-    callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ =
-        callback.last_relation_ = 0;
+    callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
     OSMPBF::Parser::parse(file_handle,
                           static_cast<OSMPBF::Interest>(OSMPBF::Interest::WAYS |
                                                         OSMPBF::Interest::CHANGESETS),
@@ -5097,7 +5071,8 @@ OSMData PBFGraphParser::ParseWays(const boost::property_tree::ptree& pt,
   LOG_INFO("Sorting osm access tags by way id...");
   {
     sequence<OSMAccess> access(access_file, false);
-    access.sort([](const OSMAccess& a, const OSMAccess& b) { return a.way_id() < b.way_id(); });
+    access.sort([](const OSMAccess& a, const OSMAccess& b) { return a.way_id() < b.way_id(); },
+                access.sort_buffer_size, sort_concurrency(pt));
   }
 
   LOG_INFO("Finished");
@@ -5145,8 +5120,7 @@ void PBFGraphParser::ParseRelations(const boost::property_tree::ptree& pt,
   // Parse relations.
   LOG_INFO("Parsing relations...");
   for (auto& file_handle : file_handles) {
-    callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ =
-        callback.last_relation_ = 0;
+    callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
     OSMPBF::Parser::parse(file_handle,
                           static_cast<OSMPBF::Interest>(OSMPBF::Interest::RELATIONS |
                                                         OSMPBF::Interest::CHANGESETS),
@@ -5164,7 +5138,8 @@ void PBFGraphParser::ParseRelations(const boost::property_tree::ptree& pt,
   {
     sequence<OSMRestriction> complex_restrictions_from(complex_restriction_from_file, false);
     complex_restrictions_from.sort(
-        [](const OSMRestriction& a, const OSMRestriction& b) { return a < b; });
+        [](const OSMRestriction& a, const OSMRestriction& b) { return a < b; },
+        complex_restrictions_from.sort_buffer_size, sort_concurrency(pt));
   }
 
   // Sort complex restrictions. Keep this scoped so the file handles are closed when done sorting.
@@ -5172,7 +5147,8 @@ void PBFGraphParser::ParseRelations(const boost::property_tree::ptree& pt,
   {
     sequence<OSMRestriction> complex_restrictions_to(complex_restriction_to_file, false);
     complex_restrictions_to.sort(
-        [](const OSMRestriction& a, const OSMRestriction& b) { return a < b; });
+        [](const OSMRestriction& a, const OSMRestriction& b) { return a < b; },
+        complex_restrictions_to.sort_buffer_size, sort_concurrency(pt));
   }
   LOG_INFO("Finished");
 }
@@ -5214,8 +5190,7 @@ void PBFGraphParser::ParseNodes(const boost::property_tree::ptree& pt,
 
     bool create = true;
     for (auto& file_handle : file_handles) {
-      callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ =
-          callback.last_relation_ = 0;
+      callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
       // we send a null way_nodes file so that only the bike share stations are parsed
       callback.reset(nullptr, nullptr, nullptr, nullptr, nullptr,
                      new sequence<OSMNode>(bss_nodes_file, create), nullptr);
@@ -5230,50 +5205,68 @@ void PBFGraphParser::ParseNodes(const boost::property_tree::ptree& pt,
   }
   callback.reset(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
 
-  // we need to sort the refs so that we can easily (sequentially) update them
-  // during node processing, we use memory mapping here because otherwise we aren't
-  // using much mem, the scoping makes sure to let it go when done sorting
-  LOG_INFO("Sorting osm way node references by node id...");
-  {
-    sequence<OSMWayNode> way_nodes(way_nodes_file, false);
-    way_nodes.sort(
-        [](const OSMWayNode& a, const OSMWayNode& b) { return a.node.osmid_ < b.node.osmid_; });
+  // mark all the node ids that ways reference so that node parsing can find the ones it needs and
+  // give each of them a slot to store its node in. the way nodes stay in way order the whole time
+  LOG_INFO("Indexing osm way node references...");
+  // negative ids (edited extracts use them for new nodes) are not valid osm ids so we dont look
+  // for them, the ways referencing them are left with unresolved nodes as if they were missing
+  sequence<OSMWayNode> way_nodes(way_nodes_file, false);
+  uint64_t min_way_node_id = OSMNodeStore::kMaxId, max_way_node_id = 0, negative_ids = 0;
+  for (const auto& way_node : way_nodes) {
+    const uint64_t id = way_node.node.osmid_;
+    if (id > OSMNodeStore::kMaxId) {
+      ++negative_ids;
+      continue;
+    }
+    min_way_node_id = std::min(min_way_node_id, id);
+    max_way_node_id = std::max(max_way_node_id, id);
+  }
+  if (negative_ids > 0) {
+    LOG_WARN("Ignoring " + std::to_string(negative_ids) +
+             " references to negative osm node ids, they cannot be resolved");
+  }
+  OSMNodeStore node_store(way_nodes_file, std::min(min_way_node_id, max_way_node_id),
+                          max_way_node_id);
+  for (const auto& way_node : way_nodes) {
+    if (way_node.node.osmid_ <= OSMNodeStore::kMaxId) {
+      node_store.reference(way_node.node.osmid_, way_node.node.intersection_);
+    }
   }
+  node_store.freeze();
 
   // Parse node in all the input files. Skip any that are not marked from
   // being used in a way.
   // TODO: we know how many knows we expect, stop early once we have that many
   LOG_INFO("Parsing nodes...");
+  callback.node_store_ = &node_store;
   for (auto& file_handle : file_handles) {
-    // each time we parse nodes we have to run through the way nodes file from the beginning because
-    // because osm node ids are only sorted at the single pbf file level
-    callback.reset(nullptr, new sequence<OSMWayNode>(way_nodes_file, false), nullptr, nullptr,
-                   nullptr, nullptr, new sequence<OSMNodeLinguistic>(linguistic_node_file, true));
-    callback.current_way_node_index_ = callback.last_node_ = callback.last_way_ =
-        callback.last_relation_ = 0;
+    callback.reset(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                   new sequence<OSMNodeLinguistic>(linguistic_node_file, true));
+    callback.last_node_ = callback.last_way_ = callback.last_relation_ = 0;
     OSMPBF::Parser::parse(file_handle,
                           static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES |
                                                         OSMPBF::Interest::CHANGESETS),
                           callback);
   }
   uint64_t max_osm_id = callback.last_node_;
+  callback.node_store_ = nullptr;
   callback.reset(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
   LOG_INFO("Finished with " + std::to_string(osmdata.osm_node_count) +
            " nodes contained in routable ways");
 
-  // we need to sort the refs so that we easily iterate over them for building edges
-  // so we line them first by way index then by shape index of the node
-  LOG_INFO("Sorting osm way node references by way index and node shape index...");
-  {
-    sequence<OSMWayNode> way_nodes(way_nodes_file, false);
-    way_nodes.sort([](const OSMWayNode& a, const OSMWayNode& b) {
-      if (a.way_index == b.way_index) {
-        // TODO: if its equal we have screwed something up, should we check and throw here?
-        return a.way_shape_node_index < b.way_shape_node_index;
-      }
-      return a.way_index < b.way_index;
-    });
-  }
+  // update all copies of the nodes that various ways referenced
+  LOG_INFO("Updating osm way node references...");
+  way_nodes.transform([&node_store, &osmdata](OSMWayNode& way_node) {
+    const auto* node = node_store.get(way_node.node.osmid_);
+    if (node == nullptr) {
+      return;
+    }
+    // we need to keep the duplicate flag that way parsing set
+    auto flat_loop = way_node.node.flat_loop_;
+    way_node.node = *node;
+    way_node.node.flat_loop_ = flat_loop;
+    osmdata.edge_count += node->intersection_;
+  });
 
   // Some OSM extracts do not have changeset Ids. For these set the max changeset Id
   // to the max OSM Id
@@ -5293,6 +5286,10 @@ void PBFGraphParser::ParseNodes(const boost::property_tree::ptree& pt,
   LOG_INFO("Number of reverse way refs = " + std::to_string(osmdata.way_ref_rev.size()));
   LOG_INFO("Unique Node Strings (names, refs, etc.) = " + std::to_string(osmdata.node_names.Size()));
   LOG_INFO("Unique Strings (names, refs, etc.) = " + std::to_string(osmdata.name_offset_map.Size()));
+  LOG_INFO("Memory used by unique strings = " +
+           std::to_string((osmdata.node_names.MemoryUsage() + osmdata.name_offset_map.MemoryUsage()) /
+                          (1024 * 1024)) +
+           " MB");
 }
 
 } // namespace mjolnir
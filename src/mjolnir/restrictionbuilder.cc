@@ -1,4 +1,5 @@
 #include "mjolnir/restrictionbuilder.h"
+#include "mjolnir/buildprofiler.h"
 #include "mjolnir/complexrestrictionbuilder.h"
 #include "mjolnir/dataquality.h"
 #include "mjolnir/graphtilebuilder.h"
@@ -343,6 +344,7 @@ void build(const std::string& complex_restriction_from_file,
     }
     GraphId tile_id = tilequeue.front();
     tilequeue.pop();
+    BuildProfiler::TileTimer timer(tile_id);
 
     // Get a readable tile. If the tile is empty, skip it. Empty tiles are
     // added where ways go through a tile but no end not is within the tile.
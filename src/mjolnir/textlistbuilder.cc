@@ -0,0 +1,106 @@
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#include "mjolnir/textlistbuilder.h"
+
+namespace valhalla {
+namespace mjolnir {
+
+namespace {
+
+// keep the table at most this full, as a fraction of 8
+constexpr uint32_t kMaxLoadEighths = 6;
+
+constexpr uint32_t kInitialSlots = 256;
+
+} // namespace
+
+// Constructor, the text list always starts with the empty string
+TextListBuilder::TextListBuilder()
+    : text_(1, '\0'), slots_(kInitialSlots, {0, kEmpty, 0}), count_(0) {
+  Index(0, 0);
+}
+
+// Replace the text list with that of an existing tile
+void TextListBuilder::Assign(const char* text, const size_t size) {
+  text_.assign(text, text + size);
+  slots_.assign(kInitialSlots, {0, kEmpty, 0});
+  count_ = 0;
+}
+
+// Make a string already in the text list findable
+void TextListBuilder::Index(const uint32_t offset, const uint32_t length) {
+  if (static_cast<size_t>(offset) + length >= text_.size()) {
+    throw std::runtime_error("Text list entry is outside of the text list");
+  }
+  std::string_view text(text_.data() + offset, length);
+  auto hash = Hash(text);
+  auto& slot = Find(text, hash);
+  // the first of identical strings is the one we hand out
+  if (slot.length == kEmpty) {
+    Insert(slot, offset, length, hash);
+  }
+}
+
+// Add text unless its already there and return where it is
+uint32_t TextListBuilder::Add(const std::string_view text) {
+  auto hash = Hash(text);
+  auto& slot = Find(text, hash);
+  if (slot.length != kEmpty) {
+    return slot.offset;
+  }
+
+  // append it null terminated
+  uint32_t offset = size();
+  text_.insert(text_.end(), text.begin(), text.end());
+  text_.push_back('\0');
+  Insert(slot, offset, static_cast<uint32_t>(text.size()), hash);
+  return offset;
+}
+
+uint32_t TextListBuilder::Hash(const std::string_view text) {
+  auto hash = std::hash<std::string_view>{}(text);
+  return static_cast<uint32_t>(hash ^ (static_cast<uint64_t>(hash) >> 32));
+}
+
+// Linear probing, the number of slots is always a power of 2
+TextListBuilder::Slot& TextListBuilder::Find(const std::string_view text, const uint32_t hash) {
+  const uint32_t mask = slots_.size() - 1;
+  for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+    auto& slot = slots_[i];
+    if (slot.length == kEmpty ||
+        (slot.hash == hash && slot.length == text.size() &&
+         std::memcmp(text_.data() + slot.offset, text.data(), text.size()) == 0)) {
+      return slot;
+    }
+  }
+}
+
+void TextListBuilder::Insert(Slot& slot,
+                             const uint32_t offset,
+                             const uint32_t length,
+                             const uint32_t hash) {
+  slot = {offset, length, hash};
+  if (++count_ * 8 < slots_.size() * kMaxLoadEighths) {
+    return;
+  }
+
+  // rehash everything into twice as many slots
+  std::vector<Slot> slots(slots_.size() * 2, {0, kEmpty, 0});
+  slots.swap(slots_);
+  const uint32_t mask = slots_.size() - 1;
+  for (const auto& old : slots) {
+    if (old.length == kEmpty) {
+      continue;
+    }
+    uint32_t i = old.hash & mask;
+    while (slots_[i].length != kEmpty) {
+      i = (i + 1) & mask;
+    }
+    slots_[i] = old;
+  }
+}
+
+} // namespace mjolnir
+} // namespace valhalla
@@ -0,0 +1,239 @@
+#include "mjolnir/tileextractbuilder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "baldr/graphreader.h"
+#include "baldr/graphtile.h"
+#include "baldr/tilehierarchy.h"
+#include "filesystem.h"
+#include "midgard/logging.h"
+#include "midgard/sequence.h"
+
+using namespace valhalla::baldr;
+using namespace valhalla::midgard;
+
+namespace {
+
+constexpr size_t kBlockSize = sizeof(tar::header_t);
+static_assert(valhalla::mjolnir::TileExtractBuilder::kAlignment % kBlockSize == 0,
+              "Tiles have to be aligned to tar blocks");
+
+// the hilbert curve covers the world with a grid of this many cells on each side
+constexpr uint32_t kHilbertCells = 1 << 16;
+
+// writes a ustar header for a file of the given size and type
+void write_header(std::ofstream& out,
+                  const std::string& name,
+                  const uint64_t size,
+                  const char typeflag,
+                  const std::time_t mtime) {
+  if (name.size() >= sizeof(tar::header_t::name)) {
+    throw std::runtime_error("Name too long for a tar header: " + name);
+  }
+  tar::header_t header{};
+  std::memcpy(header.name, name.data(), name.size());
+  std::snprintf(header.mode, sizeof(header.mode), "%07o", 0644);
+  std::snprintf(header.uid, sizeof(header.uid), "%07o", 0);
+  std::snprintf(header.gid, sizeof(header.gid), "%07o", 0);
+  std::snprintf(header.size, sizeof(header.size), "%011llo", static_cast<unsigned long long>(size));
+  std::snprintf(header.mtime, sizeof(header.mtime), "%011llo",
+                static_cast<unsigned long long>(mtime));
+  header.typeflag = typeflag;
+  std::memcpy(header.magic, "ustar", 6);
+  std::memcpy(header.version, "00", 2);
+
+  // the checksum is computed with the checksum field itself filled with spaces
+  std::memset(header.chksum, ' ', sizeof(header.chksum));
+  uint64_t checksum = 0;
+  for (size_t i = 0; i < sizeof(header); ++i) {
+    checksum += reinterpret_cast<const unsigned char*>(&header)[i];
+  }
+  std::snprintf(header.chksum, sizeof(header.chksum), "%06o", static_cast<unsigned>(checksum));
+  header.chksum[7] = ' ';
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+// pads the file with zeros up to the next multiple of the block size
+void pad_block(std::ofstream& out, const uint64_t size) {
+  static const std::vector<char> zeros(kBlockSize, 0);
+  if (size % kBlockSize) {
+    out.write(zeros.data(), kBlockSize - size % kBlockSize);
+  }
+}
+
+// moves the next file's data to a multiple of the alignment. a tar can't hold holes so the gap is
+// filled with a pax extended header holding only a comment, which tar tools skip over. with a
+// regular file instead extracting the tar would leave filler files around
+void align(std::ofstream& out, const std::time_t mtime) {
+  auto position = static_cast<uint64_t>(out.tellp());
+  // where the next file's data starts if we don't pad
+  auto misalignment = (position + kBlockSize) % valhalla::mjolnir::TileExtractBuilder::kAlignment;
+  if (misalignment == 0) {
+    return;
+  }
+  auto blocks = (valhalla::mjolnir::TileExtractBuilder::kAlignment - misalignment) / kBlockSize;
+
+  // a pax record is "<length> <keyword>=<value>\n" where the length counts its own digits too
+  std::string record;
+  size_t size = (blocks - 1) * kBlockSize;
+  if (size > 0) {
+    std::string body = " comment=";
+    auto digits = std::to_string(size).size();
+    record = std::to_string(size) + body + std::string(size - digits - body.size() - 1, ' ') + "\n";
+  }
+  write_header(out, "PaxHeader/padding", record.size(), 'x', mtime);
+  out.write(record.data(), record.size());
+}
+
+// distance along a hilbert curve through a grid of kHilbertCells^2 cells
+uint64_t hilbert_distance(uint32_t x, uint32_t y) {
+  uint64_t distance = 0;
+  for (uint32_t s = kHilbertCells / 2; s > 0; s /= 2) {
+    uint32_t rx = (x & s) > 0;
+    uint32_t ry = (y & s) > 0;
+    distance += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+    // rotate the quadrant so the curve inside it is in the canonical orientation
+    if (ry == 0) {
+      if (rx == 1) {
+        x = kHilbertCells - 1 - x;
+        y = kHilbertCells - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return distance;
+}
+
+} // namespace
+
+namespace valhalla {
+namespace mjolnir {
+
+uint64_t TileExtractBuilder::HilbertIndex(const GraphId& tile_id) {
+  const auto& tiles = tile_id.level() == TileHierarchy::GetTransitLevel().level
+                          ? TileHierarchy::GetTransitLevel().tiles
+                          : TileHierarchy::levels()[tile_id.level()].tiles;
+  auto center = tiles.TileBounds(tile_id.tileid()).Center();
+  auto x = static_cast<uint32_t>(
+      std::min((center.lng() + 180.0) / 360.0 * kHilbertCells, kHilbertCells - 1.0));
+  auto y = static_cast<uint32_t>(
+      std::min((center.lat() + 90.0) / 180.0 * kHilbertCells, kHilbertCells - 1.0));
+  return hilbert_distance(x, y);
+}
+
+TileExtractBuilder::TileOrder TileExtractBuilder::ParseTileOrder(const std::string& name) {
+  static const std::unordered_map<std::string, TileOrder> orders{
+      {"id", TileOrder::kGraphId},
+      {"hilbert", TileOrder::kHilbert},
+      {"hilbert_level", TileOrder::kHilbertPerLevel},
+  };
+  auto order = orders.find(name);
+  if (order == orders.cend()) {
+    throw std::runtime_error("Unknown tile order: " + name);
+  }
+  return order->second;
+}
+
+size_t TileExtractBuilder::Build(const boost::property_tree::ptree& config,
+                                 const std::string& extract_file,
+                                 const TileOrder order) {
+  // only ever look at the tiles on disk
+  auto mjolnir_config = config.get_child("mjolnir");
+  mjolnir_config.erase("tile_extract");
+  mjolnir_config.erase("tile_url");
+  GraphReader reader(mjolnir_config);
+  const auto& tile_dir = reader.tile_dir();
+
+  // the tiles in the order we want them in the tar
+  auto tile_set = reader.GetTileSet();
+  std::vector<std::pair<uint64_t, GraphId>> tiles;
+  tiles.reserve(tile_set.size());
+  for (const auto& tile_id : tile_set) {
+    // compressed tiles are left out like the python extract builder does
+    auto suffix = GraphTile::FileSuffix(tile_id);
+    if (!filesystem::exists(tile_dir + filesystem::path::preferred_separator + suffix)) {
+      LOG_WARN("Skipping " + suffix + ", only uncompressed tiles are supported");
+      continue;
+    }
+    // by id its all the tiles of a level before those of the next
+    uint64_t key = (static_cast<uint64_t>(tile_id.level()) << 32) | tile_id.tileid();
+    if (order == TileOrder::kHilbert) {
+      key = HilbertIndex(tile_id);
+    } else if (order == TileOrder::kHilbertPerLevel) {
+      // the curve only takes 32 bits so the level can go above it
+      key = (static_cast<uint64_t>(tile_id.level()) << 32) | HilbertIndex(tile_id);
+    }
+    tiles.emplace_back(key, tile_id);
+  }
+  std::sort(tiles.begin(), tiles.end());
+  if (tiles.empty()) {
+    throw std::runtime_error("No tiles found in " + tile_dir);
+  }
+  LOG_INFO("Writing " + std::to_string(tiles.size()) + " tiles to " + extract_file);
+
+  // write next to the final file and swap it in when done so readers never see half an extract
+  auto parent = filesystem::path(extract_file).parent_path();
+  if (!parent.empty()) {
+    filesystem::create_directories(parent);
+  }
+  const std::string tmp_file = extract_file + ".tmp";
+  std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Unable to open " + tmp_file + " for writing");
+  }
+  auto mtime = std::time(nullptr);
+
+  // the index goes first so readers find it without scanning, we fill it in as the tiles go in
+  std::vector<tile_index_entry> index;
+  index.reserve(tiles.size());
+  const uint64_t index_size = tiles.size() * sizeof(tile_index_entry);
+  write_header(out, "index.bin", index_size, '0', mtime);
+  const auto index_offset = out.tellp();
+  out.write(std::string(index_size, '\0').data(), index_size);
+  pad_block(out, index_size);
+
+  std::vector<char> buffer;
+  for (const auto& tile : tiles) {
+    const auto& tile_id = tile.second;
+    std::ifstream in(tile_dir + filesystem::path::preferred_separator +
+                         GraphTile::FileSuffix(tile_id),
+                     std::ios::binary | std::ios::ate);
+    // names inside a tar always use forward slashes
+    auto name = GraphTile::FileSuffix(tile_id, SUFFIX_NON_COMPRESSED, false);
+    if (!in.is_open()) {
+      throw std::runtime_error("Unable to read " + name);
+    }
+    buffer.resize(in.tellg());
+    in.seekg(0);
+    in.read(buffer.data(), buffer.size());
+
+    align(out, mtime);
+    write_header(out, name, buffer.size(), '0', mtime);
+    index.push_back({static_cast<uint64_t>(out.tellp()), static_cast<uint32_t>(tile_id.value),
+                     static_cast<uint32_t>(buffer.size())});
+    out.write(buffer.data(), buffer.size());
+    pad_block(out, buffer.size());
+  }
+
+  // the end of archive marker
+  out.write(std::string(2 * kBlockSize, '\0').data(), 2 * kBlockSize);
+  out.seekp(index_offset);
+  out.write(reinterpret_cast<const char*>(index.data()), index_size);
+  out.close();
+  if (!out || !filesystem::rename(tmp_file, extract_file)) {
+    throw std::runtime_error("Failed writing " + extract_file);
+  }
+
+  LOG_INFO("Finished writing " + extract_file);
+  return tiles.size();
+}
+
+} // namespace mjolnir
+} // namespace valhalla
@@ -7,6 +7,7 @@
 #include "midgard/point2.h"
 #include "midgard/polyline2.h"
 #include "mjolnir/bssbuilder.h"
+#include "mjolnir/buildprofiler.h"
 #include "mjolnir/elevationbuilder.h"
 #include "mjolnir/graphbuilder.h"
 #include "mjolnir/graphenhancer.h"
@@ -17,11 +18,15 @@
 #include "mjolnir/pbfgraphparser.h"
 #include "mjolnir/restrictionbuilder.h"
 #include "mjolnir/shortcutbuilder.h"
+#include "mjolnir/tileextractbuilder.h"
 #include "mjolnir/transitbuilder.h"
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <regex>
 
 using namespace valhalla::midgard;
@@ -60,6 +65,16 @@ const std::string old_to_new_file = "old_nodes_to_new_nodes.bin";
 const std::string intersections_file = "intersections.bin";
 const std::string shapes_file = "shapes.bin";
 
+// from_chars neither skips whitespace nor allows a plus sign, stoi and stoul do both
+template <typename number_t>
+std::from_chars_result parse_number(const char* begin, const char* end, number_t& value) {
+  while (begin != end && std::isspace(static_cast<unsigned char>(*begin)))
+    ++begin;
+  if (end - begin > 1 && *begin == '+' && std::isdigit(static_cast<unsigned char>(begin[1])))
+    ++begin;
+  return std::from_chars(begin, end, value);
+}
+
 } // namespace
 
 namespace valhalla {
@@ -97,6 +112,46 @@ std::string remove_double_quotes(const std::string& s) {
   return ret;
 }
 
+size_t split_csv_row(const char* begin,
+                     const char* end,
+                     std::pair<const char*, const char*>* fields,
+                     size_t max_fields) {
+  size_t field_count = 0;
+  while (field_count < max_fields) {
+    const char* comma = std::find(begin, end, ',');
+    if (comma != begin)
+      fields[field_count++] = {begin, comma};
+    if (comma == end)
+      break;
+    begin = comma + 1;
+  }
+  return field_count;
+}
+
+bool parse_graph_id(const char* begin, const char* end, uint32_t& id) {
+  uint32_t values[3];
+  for (size_t i = 0; i < 3; ++i) {
+    auto parsed = parse_number(begin, end, values[i]);
+    if (parsed.ec != std::errc() || (i < 2 && (parsed.ptr == end || *parsed.ptr != '/')) ||
+        (i == 2 && parsed.ptr != end))
+      return false;
+    begin = parsed.ptr + (i < 2);
+  }
+  // validates the ranges of each of the parts
+  try {
+    id = baldr::GraphId(values[1], values[0], values[2]).id();
+  } catch (...) { return false; }
+  return true;
+}
+
+bool parse_speed(const char* begin, const char* end, uint8_t& speed) {
+  int value = 0;
+  if (parse_number(begin, end, value).ec != std::errc())
+    return false;
+  speed = static_cast<uint8_t>(value);
+  return true;
+}
+
 /**
  * Compute a curvature metric given an edge shape. The final value is from 0 to 15 it is computed by
  * taking each pair of 3 points in the shape and finding the radius of the circle for which all 3
@@ -257,6 +312,10 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
     tile_dir.push_back(filesystem::path::preferred_separator);
   }
 
+  // Profile the stages if asked to
+  auto& profiler = BuildProfiler::Get();
+  profiler.Enable(config.get<std::string>("mjolnir.build_profile", ""));
+
   // During the initialize stage the tile directory will be purged (if it already exists)
   // and will be created if it does not already exist
   if (start_stage == BuildStage::kInitialize) {
@@ -300,6 +359,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
 
   // Parse the ways
   if (start_stage <= BuildStage::kParseWays && BuildStage::kParseWays <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kParseWays);
     // Read the OSM protocol buffer file. Callbacks for ways are defined within the PBFParser class
     osm_data = PBFGraphParser::ParseWays(config.get_child("mjolnir"), input_files, ways_bin,
                                          way_nodes_bin, access_bin);
@@ -317,6 +377,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
 
   // Parse OSM data
   if (start_stage <= BuildStage::kParseRelations && BuildStage::kParseRelations <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kParseRelations);
 
     // Read the OSM protocol buffer file. Callbacks for relations are defined within the PBFParser
     // class
@@ -336,6 +397,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
 
   // Parse OSM data
   if (start_stage <= BuildStage::kParseNodes && BuildStage::kParseNodes <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kParseNodes);
     // Read the OSM protocol buffer file. Callbacks for nodes
     // are defined within the PBFParser class
     PBFGraphParser::ParseNodes(config.get_child("mjolnir"), input_files, way_nodes_bin, bss_nodes_bin,
@@ -355,6 +417,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
   // Construct edges
   std::map<baldr::GraphId, size_t> tiles;
   if (start_stage <= BuildStage::kConstructEdges && BuildStage::kConstructEdges <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kConstructEdges);
 
     // Read OSMData from files if construct edges is the first stage
     if (start_stage == BuildStage::kConstructEdges)
@@ -368,6 +431,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
 
   // Build Valhalla routing tiles
   if (start_stage <= BuildStage::kBuild && BuildStage::kBuild <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kBuild);
     if (start_stage == BuildStage::kBuild) {
       // Read OSMData from files if building tiles is the first stage
       osm_data.read_from_temp_files(tile_dir);
@@ -390,6 +454,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
   // level that is usable across all levels (density, administrative
   // information (and country based attribution), edge transition logic, etc.
   if (start_stage <= BuildStage::kEnhance && BuildStage::kEnhance <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kEnhance);
     // Read OSMData names from file if enhancing tiles is the first stage
     if (start_stage == BuildStage::kEnhance) {
       osm_data.read_from_unique_names_file(tile_dir);
@@ -399,16 +464,19 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
 
   // Perform optional edge filtering (remove edges and nodes for specific access modes)
   if (start_stage <= BuildStage::kFilter && BuildStage::kFilter <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kFilter);
     GraphFilter::Filter(config);
   }
 
   // Add transit
   if (start_stage <= BuildStage::kTransit && BuildStage::kTransit <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kTransit);
     TransitBuilder::Build(config);
   }
 
   // Build bike share stations
   if (start_stage <= BuildStage::kBss && BuildStage::kBss <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kBss);
     if (start_stage == BuildStage::kBss) {
       osm_data.read_from_unique_names_file(tile_dir);
     }
@@ -420,6 +488,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
   auto build_hierarchy = config.get<bool>("mjolnir.hierarchy", true);
   if (build_hierarchy) {
     if (start_stage <= BuildStage::kHierarchy && BuildStage::kHierarchy <= end_stage) {
+      BuildProfiler::Stage profile(BuildStage::kHierarchy);
       HierarchyBuilder::Build(config, new_to_old_bin, old_to_new_bin);
     }
 
@@ -428,6 +497,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
     auto build_shortcuts = config.get<bool>("mjolnir.shortcuts", true);
     if (build_shortcuts) {
       if (start_stage <= BuildStage::kShortcuts && BuildStage::kShortcuts <= end_stage) {
+        BuildProfiler::Stage profile(BuildStage::kShortcuts);
         ShortcutBuilder::Build(config);
       }
     } else {
@@ -439,6 +509,7 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
 
   // Add elevation to the tiles
   if (start_stage <= BuildStage::kElevation && BuildStage::kElevation <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kElevation);
     ElevationBuilder::Build(config);
   }
 
@@ -447,16 +518,19 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
   // elevation into the tiles reads each tile and serializes the data to "builders"
   // within the tile. However, there is no serialization currently available for complex restrictions.
   if (start_stage <= BuildStage::kRestrictions && BuildStage::kRestrictions <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kRestrictions);
     RestrictionBuilder::Build(config, cr_from_bin, cr_to_bin);
   }
 
   // Validate the graph and add information that cannot be added until full graph is formed.
   if (start_stage <= BuildStage::kValidate && BuildStage::kValidate <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kValidate);
     GraphValidator::Validate(config);
   }
 
   // Cleanup bin files
   if (start_stage <= BuildStage::kCleanup && BuildStage::kCleanup <= end_stage) {
+    BuildProfiler::Stage profile(BuildStage::kCleanup);
     LOG_INFO("Cleaning up temporary *.bin files within " + tile_dir);
     remove_temp_file(ways_bin);
     remove_temp_file(way_nodes_bin);
@@ -471,7 +545,21 @@ bool build_tile_set(const boost::property_tree::ptree& original_config,
     remove_temp_file(old_to_new_bin);
     remove_temp_file(tile_manifest);
     OSMData::cleanup_temp_files(tile_dir);
+
+    // Pack the tiles into the tile extract, saving a separate pass over the tile_dir afterwards
+    if (config.get<bool>("mjolnir.build_extract", false)) {
+      auto tile_extract = original_config.get_optional<std::string>("mjolnir.tile_extract");
+      if (tile_extract) {
+        auto order = TileExtractBuilder::ParseTileOrder(
+            config.get<std::string>("mjolnir.extract_tile_order", "id"));
+        TileExtractBuilder::Build(config, *tile_extract, order);
+      } else {
+        LOG_WARN("Skipping the tile extract since there is no mjolnir.tile_extract to write");
+      }
+    }
   }
+
+  profiler.WriteReport();
   return true;
 }
 
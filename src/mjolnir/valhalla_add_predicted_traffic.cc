@@ -1,7 +1,12 @@
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <future>
+#include <iomanip>
 #include <optional>
 #include <random>
 #include <string>
@@ -11,7 +16,6 @@
 #include <boost/archive/iterators/binary_from_base64.hpp>
 #include <boost/archive/iterators/transform_width.hpp>
 #include <boost/property_tree/ptree.hpp>
-#include <boost/tokenizer.hpp>
 #include <cxxopts.hpp>
 
 #include "baldr/graphreader.h"
@@ -57,94 +61,101 @@ struct TrafficSpeeds {
 };
 
 /**
- * Read speed CSV file and update the tile_speeds in unique_data
+ * Read speed CSV file and update the tile_speeds in unique_data. Each file is read in one go and
+ * its rows are split in place rather than going through getline and a tokenizer per row
  */
 std::unordered_map<uint32_t, TrafficSpeeds>
 ParseTrafficFile(const std::vector<std::string>& filenames, stats& stat) {
-  typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
-  boost::char_separator<char> sep{","};
   std::unordered_map<uint32_t, TrafficSpeeds> ts;
+  std::string buffer;
 
   // for each traffic tile
   for (const auto& full_filename : filenames) {
-    // Open file
-    std::string line;
-    std::ifstream file(full_filename);
+    // Open file and slurp it, a single tiles worth of csv is small enough to hold in memory
+    std::ifstream file(full_filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+      LOG_ERROR("Could not open file: " + full_filename);
+      continue;
+    }
+    auto size = file.tellg();
+    buffer.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    file.seekg(0, std::ios::beg);
+    file.read(&buffer[0], buffer.size());
+    buffer.resize(file.gcount());
+    file.close();
+    ts.reserve(ts.size() + std::count(buffer.begin(), buffer.end(), '\n') + 1);
+
+    // for each row in the file
     uint32_t line_num = 0;
-    if (file.is_open()) {
-      // for each row in the file
-      while (getline(file, line) && ++line_num) {
-        decltype(ts)::iterator traffic = ts.end();
-        tokenizer tok{line, sep};
-        uint32_t field_num = 0;
-        bool has_error = false;
-        // for each column in the row
-        for (const auto& t : tok) {
-          if (has_error)
-            break;
-          // parse each column
-          switch (field_num) {
-            case 0: {
-              try {
-                auto inserted = ts.insert(decltype(ts)::value_type(GraphId(t).id(), {}));
-                traffic = inserted.first;
-                // skip duplicates
-                if (!inserted.second) {
-                  ++stat.dup_count;
-                  has_error = true;
-                  traffic = ts.end();
-                }
-              } catch (std::exception& e) {
-                LOG_WARN("Invalid GraphId in file: " + full_filename + " line number " +
-                         std::to_string(line_num));
-                has_error = true;
-              }
-            } break;
-            case 1: {
-              try {
-                traffic->second.free_flow_speed = std::stoi(t);
-                stat.free_flow_count++;
-              } catch (std::exception& e) {
-                LOG_WARN("Invalid free flow speed in file: " + full_filename + " line number " +
-                         std::to_string(line_num));
-                has_error = true;
-              }
-            } break;
-            case 2: {
-              try {
-                traffic->second.constrained_flow_speed = std::stoi(t);
-                stat.constrained_count++;
-              } catch (std::exception& e) {
-                LOG_WARN("Invalid constrained flow speed in file: " + full_filename +
-                         " line number " + std::to_string(line_num));
-                has_error = true;
-              }
-            } break;
-            case 3: {
-              if (t.size()) {
-                try {
-                  // Decode the base64 predicted speeds
-                  traffic->second.coefficients = decode_compressed_speeds(t);
-                  stat.compressed_count++;
-                } catch (std::exception& e) {
-                  LOG_WARN("Invalid compressed speeds in file: " + full_filename + " line number " +
-                           std::to_string(line_num) + "; error='" + e.what() + "'");
-                  has_error = true;
-                }
-              }
-            } break;
-            default:
-              break;
-          }
-          field_num++;
+    const char* pos = buffer.data();
+    const char* const buffer_end = pos + buffer.size();
+    for (const char* eol = pos; pos < buffer_end; pos = eol + 1) {
+      eol = static_cast<const char*>(std::memchr(pos, '\n', buffer_end - pos));
+      if (eol == nullptr)
+        eol = buffer_end;
+      const char* line_end = eol;
+      if (line_end != pos && *(line_end - 1) == '\r')
+        --line_end;
+      ++line_num;
+
+      // split the row into its columns: graph id, free flow, constrained flow, predicted speeds.
+      // like the tokenizer this used to go through, empty columns are skipped
+      std::array<std::pair<const char*, const char*>, 4> fields;
+      size_t field_count = vj::split_csv_row(pos, line_end, fields.data(), fields.size());
+      if (field_count == 0)
+        continue;
+
+      // parse each column
+      uint32_t edge_id = 0;
+      if (!vj::parse_graph_id(fields[0].first, fields[0].second, edge_id)) {
+        LOG_WARN("Invalid GraphId in file: " + full_filename + " line number " +
+                 std::to_string(line_num));
+        continue;
+      }
+
+      auto inserted = ts.insert(decltype(ts)::value_type(edge_id, {}));
+      // skip duplicates
+      if (!inserted.second) {
+        ++stat.dup_count;
+        continue;
+      }
+      auto& traffic = inserted.first->second;
+
+      bool has_error = false;
+      if (field_count > 1) {
+        if (vj::parse_speed(fields[1].first, fields[1].second, traffic.free_flow_speed)) {
+          stat.free_flow_count++;
+        } else {
+          LOG_WARN("Invalid free flow speed in file: " + full_filename + " line number " +
+                   std::to_string(line_num));
+          has_error = true;
         }
-        // if this one was erroneous lets not keep it
-        if (has_error && traffic != ts.end())
-          ts.erase(traffic);
       }
-      file.close();
-    } else {
-      LOG_ERROR("Could not open file: " + full_filename);
+      if (!has_error && field_count > 2) {
+        if (vj::parse_speed(fields[2].first, fields[2].second, traffic.constrained_flow_speed)) {
+          stat.constrained_count++;
+        } else {
+          LOG_WARN("Invalid constrained flow speed in file: " + full_filename + " line number " +
+                   std::to_string(line_num));
+          has_error = true;
+        }
+      }
+      if (!has_error && field_count > 3) {
+        try {
+          // Decode the base64 predicted speeds
+          traffic.coefficients =
+              decode_compressed_speeds(std::string(fields[3].first, fields[3].second));
+          stat.compressed_count++;
+        } catch (std::exception& e) {
+          LOG_WARN("Invalid compressed speeds in file: " + full_filename + " line number " +
+                   std::to_string(line_num) + "; error='" + e.what() + "'");
+          has_error = true;
+        }
+      }
+
+      // if this one was erroneous lets not keep it
+      if (has_error)
+        ts.erase(inserted.first);
     }
   }
 
@@ -205,27 +216,29 @@ void update_tile(const std::string& tile_dir,
  * Read both the constrained and freeflow speed CSV files
  * We expect the files to be named as <quadtreeID>.constrained.csv and
  * <quadtreeID>.freeflow.csv. (e.g., 1202021.constrained.csv and 1202021.freeflow.csv)
+ * Each thread pulls the next tile to work on from the shared list until there are none left so
+ * that a few very dense tiles dont leave the other threads idle
  */
-void update_tiles(
-    const std::string& tile_dir,
-    std::vector<std::pair<GraphId, std::vector<std::string>>>::const_iterator tile_start,
-    std::vector<std::pair<GraphId, std::vector<std::string>>>::const_iterator tile_end,
-    std::promise<stats>& result) {
+void update_tiles(const std::string& tile_dir,
+                  const std::vector<std::pair<GraphId, std::vector<std::string>>>& traffic_tiles,
+                  std::atomic<size_t>& next_tile,
+                  std::atomic<size_t>& finished_tiles,
+                  std::promise<stats>& result) {
 
   std::stringstream thread_name;
   thread_name << std::this_thread::get_id();
 
   // Iterate through the tiles and parse them
-  size_t total = tile_end - tile_start;
-  double count = 0;
+  const double total = traffic_tiles.size();
   stats stat{};
-  for (; tile_start != tile_end; ++tile_start) {
-    LOG_INFO(thread_name.str() + " parsing traffic data for " + std::to_string(tile_start->first));
-    auto traffic = ParseTrafficFile(tile_start->second, stat);
-    LOG_INFO(thread_name.str() + " add traffic data to " + std::to_string(tile_start->first));
-    update_tile(tile_dir, tile_start->first, traffic, stat);
-    LOG_INFO(thread_name.str() + " finished " + std::to_string(tile_start->first) + "(" +
-             std::to_string(++count / total * 100.0) + ")");
+  for (size_t i = next_tile++; i < traffic_tiles.size(); i = next_tile++) {
+    const auto& traffic_tile = traffic_tiles[i];
+    LOG_INFO(thread_name.str() + " parsing traffic data for " + std::to_string(traffic_tile.first));
+    auto traffic = ParseTrafficFile(traffic_tile.second, stat);
+    LOG_INFO(thread_name.str() + " add traffic data to " + std::to_string(traffic_tile.first));
+    update_tile(tile_dir, traffic_tile.first, traffic, stat);
+    LOG_INFO(thread_name.str() + " finished " + std::to_string(traffic_tile.first) + "(" +
+             std::to_string(++finished_tiles / total * 100.0) + ")");
   }
 
   result.set_value(stat);
@@ -300,22 +313,18 @@ int main(int argc, char** argv) {
   std::vector<std::shared_ptr<std::thread>> threads(config.get<uint32_t>("mjolnir.concurrency"));
 
   LOG_INFO("Parsing speeds from " + std::to_string(traffic_tiles.size()) + " tiles.");
-  size_t floor = traffic_tiles.size() / threads.size();
-  size_t at_ceiling = traffic_tiles.size() - (threads.size() * floor);
-  decltype(traffic_tiles)::const_iterator tile_start, tile_end = traffic_tiles.begin();
+  auto start_time = std::chrono::steady_clock::now();
   auto tile_dir = config.get<std::string>("mjolnir.tile_dir");
   // A place to hold the results of those threads (exceptions, stats)
   std::list<std::promise<stats>> results;
-  // Atomically pass around stats info
+  // The threads share the work through the index of the next tile to process
+  std::atomic<size_t> next_tile(0), finished_tiles(0);
   for (size_t i = 0; i < threads.size(); ++i) {
-    // Where the range begins
-    tile_start = tile_end;
-    // Where the range ends
-    tile_end += (i < at_ceiling ? floor + 1 : floor);
     // Make the thread
     results.emplace_back();
-    threads[i].reset(
-        new std::thread(update_tiles, tile_dir, tile_start, tile_end, std::ref(results.back())));
+    threads[i].reset(new std::thread(update_tiles, std::cref(tile_dir), std::cref(traffic_tiles),
+                                     std::ref(next_tile), std::ref(finished_tiles),
+                                     std::ref(results.back())));
   }
 
   // wait for it to finish
@@ -343,6 +352,11 @@ int main(int argc, char** argv) {
   LOG_INFO("Parsed " + std::to_string(compressed_count) + " compressed records.");
   LOG_INFO("Updated " + std::to_string(updated_count) + " directed edges.");
   LOG_INFO("Duplicate count " + std::to_string(duplicate_count) + ".");
+  auto elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  std::stringstream rate;
+  rate << std::setprecision(1) << std::fixed << updated_count / std::max(elapsed, 1e-3);
+  LOG_INFO("Updated edges at " + rate.str() + " edges/sec.");
   LOG_INFO("Finished");
 
   if (!summary)
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <cxxopts.hpp>
+
+#include "baldr/graphreader.h"
+#include "baldr/graphtile.h"
+#include "filesystem.h"
+#include "midgard/logging.h"
+#include "mjolnir/osmchange.h"
+
+#include "argparse_utils.h"
+
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+
+int main(int argc, char** argv) {
+  const auto program = filesystem::path(__FILE__).stem().string();
+  // args
+  std::vector<std::string> change_files;
+  std::vector<std::string> previous_files;
+  boost::property_tree::ptree config;
+
+  try {
+    // clang-format off
+    cxxopts::Options options(
+      program,
+      program + " " + VALHALLA_VERSION + "\n\n"
+      "valhalla_affected_tiles is a program that reads one or more uncompressed OSM change (.osc)\n"
+      "files and prints the tiles of the configured (pre change) tileset which a rebuild with the\n"
+      "changes applied can alter, one tile path per line relative to the tile directory. All the\n"
+      "tiles within reach of what the graph enhancer and the hierarchy builder derive from the\n"
+      "changed roads are included. Pass the pbf file(s) the tileset was built from with -p so\n"
+      "that the previous locations of changed nodes and the ways using them are accounted for.\n\n");
+
+    options.add_options()
+      ("h,help", "Print this help message.")
+      ("v,version", "Print the version of this software.")
+      ("c,config", "Path to the json configuration file.", cxxopts::value<std::string>())
+      ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>())
+      ("p,previous", "OSM pbf file(s) the tileset was built from, before the changes.", cxxopts::value<std::vector<std::string>>(previous_files))
+      ("change_files", "positional arguments", cxxopts::value<std::vector<std::string>>(change_files));
+    // clang-format on
+
+    options.parse_positional({"change_files"});
+    options.positional_help("OSM change file(s)");
+    auto result = options.parse(argc, argv);
+    if (!parse_common_args(program, options, result, config, "mjolnir.logging"))
+      return EXIT_SUCCESS;
+
+    if (!result.count("change_files")) {
+      throw cxxopts::exceptions::exception("Change file is required\n\n" + options.help());
+    }
+  } catch (cxxopts::exceptions::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+
+  OSMChange change;
+  try {
+    for (const auto& change_file : change_files) {
+      ParseOSMChange(change_file, change);
+    }
+    if (!previous_files.empty()) {
+      ParsePreviousState(previous_files, change);
+    }
+  } catch (const std::exception& e) {
+    LOG_ERROR(e.what());
+    return EXIT_FAILURE;
+  }
+
+  GraphReader reader(config.get_child("mjolnir"));
+  auto tiles = AffectedTiles(reader, change);
+  std::vector<GraphId> sorted(tiles.begin(), tiles.end());
+  std::sort(sorted.begin(), sorted.end());
+  for (const auto& tile_id : sorted) {
+    std::cout << GraphTile::FileSuffix(tile_id) << "\n";
+  }
+  LOG_INFO(std::to_string(sorted.size()) + " tiles affected");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <cxxopts.hpp>
+
+#include "filesystem.h"
+#include "midgard/logging.h"
+#include "mjolnir/osmpbfparser.h"
+#include "mjolnir/uniquenames.h"
+
+#include "argparse_utils.h"
+
+using namespace valhalla::mjolnir;
+
+namespace {
+
+// collects the values of the tags that end up in the unique names during parsing
+struct names_callback : public OSMPBF::Callback {
+  void node_callback(const uint64_t, const double, const double, const OSMPBF::Tags& tags) override {
+    add(tags);
+  }
+  void way_callback(const uint64_t, const OSMPBF::Tags& tags, const std::vector<uint64_t>&) override {
+    add(tags);
+  }
+  void relation_callback(const uint64_t,
+                         const OSMPBF::Tags& tags,
+                         const std::vector<OSMPBF::Member>&) override {
+    add(tags);
+  }
+  void changeset_callback(const uint64_t) override {
+  }
+
+  void add(const OSMPBF::Tags& tags) {
+    for (const auto& tag : tags) {
+      if (tag.first.find("name") != std::string::npos || tag.first == "ref" ||
+          tag.first == "int_ref" || tag.first.find("destination") == 0) {
+        names.push_back(tag.second);
+      }
+    }
+  }
+
+  std::vector<std::string> names;
+};
+
+// interns all the names using the given number of threads, each taking every nth name
+double intern(const std::vector<std::string>& names, const uint32_t concurrency) {
+  UniqueNames unique_names;
+  auto start = std::chrono::high_resolution_clock::now();
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < concurrency; ++t) {
+    threads.emplace_back([&names, &unique_names, concurrency, t]() {
+      for (size_t i = t; i < names.size(); i += concurrency) {
+        unique_names.index(names[i]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  double secs = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start)
+                    .count();
+  LOG_INFO(std::to_string(concurrency) + " thread(s) interned " + std::to_string(names.size()) +
+           " names (" + std::to_string(unique_names.Size()) + " unique) in " +
+           std::to_string(secs) + " secs using " +
+           std::to_string(unique_names.MemoryUsage() / (1024 * 1024)) + " MB");
+  return secs;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const auto program = filesystem::path(__FILE__).stem().string();
+  // args
+  std::vector<std::string> input_files;
+  boost::property_tree::ptree config;
+
+  try {
+    // clang-format off
+    cxxopts::Options options(
+      program,
+      program + " " + VALHALLA_VERSION + "\n\n"
+      "valhalla_benchmark_names is a program to time interning the name strings of one or\n"
+      "multiple osm.pbf files into the unique names used during graph building, first with a\n"
+      "single thread and then with the configured number of threads.\n");
+
+    options.add_options()
+      ("h,help", "Print this help message.")
+      ("v,version", "Print the version of this software.")
+      ("c,config", "Path to the json configuration file.", cxxopts::value<std::string>())
+      ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>())
+      ("j,concurrency", "Number of threads to use. Defaults to all threads.", cxxopts::value<uint32_t>())
+      ("input_files", "positional arguments", cxxopts::value<std::vector<std::string>>(input_files));
+    // clang-format on
+
+    options.parse_positional({"input_files"});
+    options.positional_help("OSM PBF file(s)");
+    auto result = options.parse(argc, argv);
+    if (!parse_common_args(program, options, result, config, "mjolnir.logging", true))
+      return EXIT_SUCCESS;
+
+    // input files are positional
+    if (!result.count("input_files")) {
+      throw cxxopts::exceptions::exception("Input file is required\n\n" + options.help());
+    }
+  } catch (cxxopts::exceptions::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // gather the names up front so that only the interning is timed
+  names_callback callback;
+  for (const auto& input_file : input_files) {
+    std::ifstream file(input_file, std::ios::binary);
+    if (!file.is_open()) {
+      LOG_ERROR("Unable to open: " + input_file);
+      return EXIT_FAILURE;
+    }
+    OSMPBF::Parser::parse(file,
+                          static_cast<OSMPBF::Interest>(OSMPBF::Interest::NODES |
+                                                        OSMPBF::Interest::WAYS |
+                                                        OSMPBF::Interest::RELATIONS),
+                          callback);
+  }
+  OSMPBF::Parser::free();
+  LOG_INFO("Read " + std::to_string(callback.names.size()) + " names");
+
+  auto serial = intern(callback.names, 1);
+  auto concurrency = config.get<uint32_t>("mjolnir.concurrency");
+  if (concurrency > 1) {
+    auto parallel = intern(callback.names, concurrency);
+    LOG_INFO("Speedup = " + std::to_string(serial / parallel));
+  }
+
+  return EXIT_SUCCESS;
+}
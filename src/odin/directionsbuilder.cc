@@ -25,6 +25,7 @@ namespace odin {
 // trip directions.
 void DirectionsBuilder::Build(Api& api, const MarkupFormatter& markup_formatter) {
   const auto& options = api.options();
+  const bool has_maneuvers = HasManeuvers(options);
   for (auto& trip_route : *api.mutable_trip()->mutable_routes()) {
     auto& directions_route = *api.mutable_directions()->mutable_routes()->Add();
     for (auto& trip_path : *trip_route.mutable_legs()) {
@@ -38,12 +39,15 @@ void DirectionsBuilder::Build(Api& api, const MarkupFormatter& markup_formatter)
       // Create an enhanced trip path from the specified trip_path
       EnhancedTripLeg etp(trip_path);
 
-      // Produce maneuvers if desired
-      std::list<Maneuver> maneuvers;
+      // Update the heading of ~0 length edges, the trip keeps them whether or not there are
+      // maneuvers made from it
       if (options.directions_type() != DirectionsType::none) {
-        // Update the heading of ~0 length edges
         UpdateHeading(&etp);
+      }
 
+      // Produce maneuvers if desired
+      std::list<Maneuver> maneuvers;
+      if (has_maneuvers) {
         ManeuversBuilder maneuversBuilder(options, &etp);
         maneuvers = maneuversBuilder.Build();
 
@@ -61,6 +65,19 @@ void DirectionsBuilder::Build(Api& api, const MarkupFormatter& markup_formatter)
   }
 }
 
+bool DirectionsBuilder::HasManeuvers(const Options& options) {
+  if (options.directions_type() == DirectionsType::none || options.format() == Options::gpx) {
+    return false;
+  }
+  return options.format() != Options::pbf || !options.has_pbf_field_selector() ||
+         options.pbf_field_selector().directions();
+}
+
+bool DirectionsBuilder::HasVerbalInstructions(const Options& options) {
+  return options.directions_type() == DirectionsType::instructions &&
+         (options.format() != Options::osrm || options.voice_instructions());
+}
+
 // Update the heading of ~0 length edges.
 void DirectionsBuilder::UpdateHeading(EnhancedTripLeg* etp) {
 
@@ -1,3 +1,5 @@
+#include <string_view>
+
 #include <boost/property_tree/ptree.hpp>
 
 #include "midgard/logging.h"
@@ -28,6 +30,40 @@ std::unordered_map<K, V> as_unordered_map(boost::property_tree::ptree const& pt,
   return items;
 }
 
+using valhalla::odin::PhraseTag;
+
+const std::unordered_map<std::string_view, PhraseTag> kPhraseTags = {
+    {kCardinalDirectionTag, PhraseTag::kCardinalDirection},
+    {kRelativeDirectionTag, PhraseTag::kRelativeDirection},
+    {kOrdinalValueTag, PhraseTag::kOrdinalValue},
+    {kStreetNamesTag, PhraseTag::kStreetNames},
+    {kPreviousStreetNamesTag, PhraseTag::kPreviousStreetNames},
+    {kBeginStreetNamesTag, PhraseTag::kBeginStreetNames},
+    {kCrossStreetNamesTag, PhraseTag::kCrossStreetNames},
+    {kRoundaboutExitStreetNamesTag, PhraseTag::kRoundaboutExitStreetNames},
+    {kRoundaboutExitBeginStreetNamesTag, PhraseTag::kRoundaboutExitBeginStreetNames},
+    {kRampExitNumbersVisualTag, PhraseTag::kRampExitNumbersVisual},
+    {kObjectLabelTag, PhraseTag::kObjectLabel},
+    {kLengthTag, PhraseTag::kLength},
+    {kDestinationTag, PhraseTag::kDestination},
+    {kCurrentVerbalCueTag, PhraseTag::kCurrentVerbalCue},
+    {kNextVerbalCueTag, PhraseTag::kNextVerbalCue},
+    {kNumberSignTag, PhraseTag::kNumberSign},
+    {kBranchSignTag, PhraseTag::kBranchSign},
+    {kTowardSignTag, PhraseTag::kTowardSign},
+    {kNameSignTag, PhraseTag::kNameSign},
+    {kJunctionNameTag, PhraseTag::kJunctionName},
+    {kFerryLabelTag, PhraseTag::kFerryLabel},
+    {kTransitPlatformTag, PhraseTag::kTransitPlatform},
+    {kStationLabelTag, PhraseTag::kStationLabel},
+    {kTimeTag, PhraseTag::kTime},
+    {kTransitNameTag, PhraseTag::kTransitName},
+    {kTransitHeadSignTag, PhraseTag::kTransitHeadSign},
+    {kTransitPlatformCountTag, PhraseTag::kTransitPlatformCount},
+    {kTransitPlatformCountLabelTag, PhraseTag::kTransitPlatformCountLabel},
+    {kLevelTag, PhraseTag::kLevel},
+};
+
 } // namespace
 
 namespace valhalla {
@@ -342,7 +378,13 @@ void NarrativeDictionary::Load(const boost::property_tree::ptree& narrative_pt)
 void NarrativeDictionary::Load(PhraseSet& phrase_handle,
                                const boost::property_tree::ptree& phrase_pt) {
 
-  phrase_handle.phrases = as_unordered_map<std::string, std::string>(phrase_pt, kPhrasesKey);
+  // Split the phrases at their tags up front
+  const auto& phrases = phrase_pt.get_child(kPhrasesKey);
+  phrase_handle.templates.reserve(phrases.size());
+  for (const auto& phrase : phrases) {
+    phrase_handle.templates.emplace(std::stoul(phrase.first),
+                                    PhraseTemplate(phrase.second.get_value<std::string>()));
+  }
 }
 
 void NarrativeDictionary::Load(StartSubset& start_handle,
@@ -603,6 +645,61 @@ void NarrativeDictionary::Load(ExitBuildingSubset& exit_building_handle,
       as_vector<std::string>(exit_building_subset_pt, kEmptyStreetNameLabelsKey);
 }
 
+PhraseTemplate::PhraseTemplate(const std::string& phrase) : phrase_(phrase) {
+  // Adds literal text, merging it into the previous piece when that is literal too
+  auto add_literal = [this](size_t offset, size_t length) {
+    if (length == 0) {
+      return;
+    }
+    if (!pieces_.empty() && pieces_.back().tag == PhraseTag::kNone &&
+        pieces_.back().offset + pieces_.back().length == offset) {
+      pieces_.back().length += length;
+    } else {
+      pieces_.push_back({static_cast<uint32_t>(offset), static_cast<uint32_t>(length),
+                         PhraseTag::kNone});
+    }
+  };
+
+  size_t literal = 0;
+  size_t open = phrase_.find('<');
+  while (open != std::string::npos) {
+    size_t close = phrase_.find('>', open);
+    if (close == std::string::npos) {
+      break;
+    }
+    // A '<' that doesn't start a known tag is literal text
+    auto found = kPhraseTags.find(std::string_view(phrase_).substr(open, close - open + 1));
+    if (found == kPhraseTags.cend()) {
+      open = phrase_.find('<', open + 1);
+      continue;
+    }
+    add_literal(literal, open - literal);
+    pieces_.push_back({static_cast<uint32_t>(open), static_cast<uint32_t>(close - open + 1),
+                       found->second});
+    literal = close + 1;
+    open = phrase_.find('<', literal);
+  }
+  add_literal(literal, phrase_.size() - literal);
+}
+
+void PhraseTemplate::Render(
+    std::string& output,
+    std::initializer_list<std::pair<PhraseTag, std::string_view>> values) const {
+  output.clear();
+  for (const auto& piece : pieces_) {
+    std::string_view text(phrase_.data() + piece.offset, piece.length);
+    if (piece.tag != PhraseTag::kNone) {
+      for (const auto& value : values) {
+        if (value.first == piece.tag) {
+          text = value.second;
+          break;
+        }
+      }
+    }
+    output.append(text.data(), text.size());
+  }
+}
+
 const std::locale& NarrativeDictionary::GetLocale() const {
   return locale;
 }
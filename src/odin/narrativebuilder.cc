@@ -9,6 +9,7 @@
 #include "baldr/verbal_text_formatter.h"
 #include "midgard/constants.h"
 
+#include "odin/directionsbuilder.h"
 #include "odin/enhancedtrippath.h"
 #include "odin/maneuver.h"
 #include "odin/markup_formatter.h"
@@ -45,496 +46,511 @@ NarrativeBuilder::NarrativeBuilder(const Options& options,
                                    const NarrativeDictionary& dictionary,
                                    const MarkupFormatter& markup_formatter)
     : options_(options), trip_path_(trip_path), dictionary_(dictionary),
-      markup_formatter_(markup_formatter), articulated_preposition_enabled_(false) {
+      markup_formatter_(markup_formatter), articulated_preposition_enabled_(false),
+      verbal_instructions_(DirectionsBuilder::HasVerbalInstructions(options)) {
 }
 
 void NarrativeBuilder::Build(std::list<Maneuver>& maneuvers) {
   Maneuver* prev_maneuver = nullptr;
   for (auto& maneuver : maneuvers) {
-    switch (maneuver.type()) {
-      case DirectionsLeg_Maneuver_Type_kStartRight:
-      case DirectionsLeg_Maneuver_Type_kStart:
-      case DirectionsLeg_Maneuver_Type_kStartLeft:
-      case DirectionsLeg_Maneuver_Type_kFerryExit:
-      case DirectionsLeg_Maneuver_Type_kPostTransitConnectionDestination: {
-        // Set instruction
-        maneuver.set_instruction(FormStartInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctStartTransitionInstruction(maneuver));
+    // Set the instructions and then the verbal ones, which may reuse them
+    FormInstructions(maneuver, prev_maneuver);
+    if (verbal_instructions_) {
+      FormVerbalInstructions(maneuver, prev_maneuver);
+    }
+    maneuver.set_instruction(FormBssManeuverType(maneuver.bss_maneuver_type()) +
+                             maneuver.instruction());
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalStartInstruction(maneuver));
+    // Update previous maneuver
+    prev_maneuver = &maneuver;
+  }
 
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
-        break;
+  // Iterate over maneuvers to form verbal multi-cue instructions
+  if (verbal_instructions_) {
+    FormVerbalMultiCue(maneuvers);
+  }
+}
+
+void NarrativeBuilder::FormInstructions(Maneuver& maneuver, Maneuver* prev_maneuver) {
+  switch (maneuver.type()) {
+    case DirectionsLeg_Maneuver_Type_kStartRight:
+    case DirectionsLeg_Maneuver_Type_kStart:
+    case DirectionsLeg_Maneuver_Type_kStartLeft:
+    case DirectionsLeg_Maneuver_Type_kFerryExit:
+    case DirectionsLeg_Maneuver_Type_kPostTransitConnectionDestination:
+      maneuver.set_instruction(FormStartInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kDestinationRight:
+    case DirectionsLeg_Maneuver_Type_kDestination:
+    case DirectionsLeg_Maneuver_Type_kDestinationLeft:
+      maneuver.set_instruction(FormDestinationInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kBecomes:
+      if (prev_maneuver) {
+        maneuver.set_instruction(FormBecomesInstruction(maneuver, prev_maneuver));
       }
-      case DirectionsLeg_Maneuver_Type_kDestinationRight:
-      case DirectionsLeg_Maneuver_Type_kDestination:
-      case DirectionsLeg_Maneuver_Type_kDestinationLeft: {
-        // Set instruction
-        maneuver.set_instruction(FormDestinationInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kSlightRight:
+    case DirectionsLeg_Maneuver_Type_kSlightLeft:
+    case DirectionsLeg_Maneuver_Type_kRight:
+    case DirectionsLeg_Maneuver_Type_kSharpRight:
+    case DirectionsLeg_Maneuver_Type_kSharpLeft:
+    case DirectionsLeg_Maneuver_Type_kLeft:
+      maneuver.set_instruction(FormTurnInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kUturnRight:
+    case DirectionsLeg_Maneuver_Type_kUturnLeft:
+      maneuver.set_instruction(FormUturnInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kRampStraight:
+      maneuver.set_instruction(FormRampStraightInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kRampRight:
+    case DirectionsLeg_Maneuver_Type_kRampLeft:
+      maneuver.set_instruction(FormRampInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kExitRight:
+    case DirectionsLeg_Maneuver_Type_kExitLeft:
+      maneuver.set_instruction(FormExitInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kStayStraight:
+    case DirectionsLeg_Maneuver_Type_kStayRight:
+    case DirectionsLeg_Maneuver_Type_kStayLeft:
+      maneuver.set_instruction(maneuver.to_stay_on() ? FormKeepToStayOnInstruction(maneuver)
+                                                     : FormKeepInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kMerge:
+    case DirectionsLeg_Maneuver_Type_kMergeRight:
+    case DirectionsLeg_Maneuver_Type_kMergeLeft:
+      maneuver.set_instruction(FormMergeInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kRoundaboutEnter:
+      maneuver.set_instruction(FormEnterRoundaboutInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kRoundaboutExit:
+      maneuver.set_instruction(FormExitRoundaboutInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kFerryEnter:
+      maneuver.set_instruction(FormEnterFerryInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionStart:
+      maneuver.set_instruction(FormTransitConnectionStartInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionTransfer:
+      maneuver.set_instruction(FormTransitConnectionTransferInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionDestination:
+      maneuver.set_instruction(FormTransitConnectionDestinationInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kTransit:
+      maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
+      maneuver.set_instruction(FormTransitInstruction(maneuver));
+      maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kTransitRemainOn:
+      maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
+      maneuver.set_instruction(FormTransitRemainOnInstruction(maneuver));
+      maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kTransitTransfer:
+      maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
+      maneuver.set_instruction(FormTransitTransferInstruction(maneuver));
+      maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kElevatorEnter:
+      maneuver.set_instruction(FormElevatorInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kStepsEnter:
+      maneuver.set_instruction(FormStepsInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kEscalatorEnter:
+      maneuver.set_instruction(FormEscalatorInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kBuildingEnter:
+      maneuver.set_instruction(FormEnterBuildingInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kBuildingExit:
+      maneuver.set_instruction(FormExitBuildingInstruction(maneuver));
+      break;
+    case DirectionsLeg_Maneuver_Type_kContinue:
+    default:
+      maneuver.set_instruction(maneuver.has_node_type() ? FormPassInstruction(maneuver)
+                                                        : FormContinueInstruction(maneuver));
+      break;
+  }
+}
 
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            FormVerbalAlertDestinationInstruction(maneuver));
+void NarrativeBuilder::FormVerbalInstructions(Maneuver& maneuver, Maneuver* prev_maneuver) {
+  switch (maneuver.type()) {
+    case DirectionsLeg_Maneuver_Type_kStartRight:
+    case DirectionsLeg_Maneuver_Type_kStart:
+    case DirectionsLeg_Maneuver_Type_kStartLeft:
+    case DirectionsLeg_Maneuver_Type_kFerryExit:
+    case DirectionsLeg_Maneuver_Type_kPostTransitConnectionDestination: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctStartTransitionInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalStartInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kDestinationRight:
+    case DirectionsLeg_Maneuver_Type_kDestination:
+    case DirectionsLeg_Maneuver_Type_kDestinationLeft: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(
+          FormVerbalAlertDestinationInstruction(maneuver));
 
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalDestinationInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kBecomes: {
+      if (prev_maneuver) {
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalDestinationInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kBecomes: {
-        if (prev_maneuver) {
-          // Set instruction
-          maneuver.set_instruction(FormBecomesInstruction(maneuver, prev_maneuver));
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(
-              FormVerbalBecomesInstruction(maneuver, prev_maneuver));
-        }
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver,
-                                                maneuver
-                                                    .HasBeginStreetNames())); // Set verbal succinct
-                                                                              // transition
-                                                                              // instruction
-        break;
+        maneuver.set_verbal_pre_transition_instruction(
+            FormVerbalBecomesInstruction(maneuver, prev_maneuver));
       }
-      case DirectionsLeg_Maneuver_Type_kSlightRight:
-      case DirectionsLeg_Maneuver_Type_kSlightLeft:
-      case DirectionsLeg_Maneuver_Type_kRight:
-      case DirectionsLeg_Maneuver_Type_kSharpRight:
-      case DirectionsLeg_Maneuver_Type_kSharpLeft:
-      case DirectionsLeg_Maneuver_Type_kLeft: {
-        // Set instruction
-        maneuver.set_instruction(FormTurnInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctTurnTransitionInstruction(maneuver));
 
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertTurnInstruction(maneuver));
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kSlightRight:
+    case DirectionsLeg_Maneuver_Type_kSlightLeft:
+    case DirectionsLeg_Maneuver_Type_kRight:
+    case DirectionsLeg_Maneuver_Type_kSharpRight:
+    case DirectionsLeg_Maneuver_Type_kSharpLeft:
+    case DirectionsLeg_Maneuver_Type_kLeft: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctTurnTransitionInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalTurnInstruction(maneuver));
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertTurnInstruction(maneuver));
 
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kUturnRight:
-      case DirectionsLeg_Maneuver_Type_kUturnLeft: {
-        // Set instruction
-        maneuver.set_instruction(FormUturnInstruction(maneuver));
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalTurnInstruction(maneuver));
 
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctUturnTransitionInstruction(maneuver));
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kUturnRight:
+    case DirectionsLeg_Maneuver_Type_kUturnLeft: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctUturnTransitionInstruction(maneuver));
 
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertUturnInstruction(maneuver));
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertUturnInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalUturnInstruction(maneuver));
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalUturnInstruction(maneuver));
 
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kRampStraight: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(
+          FormVerbalAlertRampStraightInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalRampStraightInstruction(maneuver));
+
+      // Only set verbal post if > min ramp length
+      // or contains obvious maneuver
+      // or has collapsed merge maneuver
+      if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
+          maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
         // Set verbal post transition instruction
         maneuver.set_verbal_post_transition_instruction(
             FormVerbalPostTransitionInstruction(maneuver));
-        break;
       }
-      case DirectionsLeg_Maneuver_Type_kRampStraight: {
-        // Set instruction
-        maneuver.set_instruction(FormRampStraightInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            FormVerbalAlertRampStraightInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalRampStraightInstruction(maneuver));
-
-        // Only set verbal post if > min ramp length
-        // or contains obvious maneuver
-        // or has collapsed merge maneuver
-        if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
-            maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
-        }
-        break;
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kRampRight:
+    case DirectionsLeg_Maneuver_Type_kRampLeft: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertRampInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalRampInstruction(maneuver));
+
+      // Only set verbal post if > min ramp length
+      // or contains obvious maneuver
+      // or has collapsed merge maneuver
+      if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
+          maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
+        // Set verbal post transition instruction
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver));
       }
-      case DirectionsLeg_Maneuver_Type_kRampRight:
-      case DirectionsLeg_Maneuver_Type_kRampLeft: {
-        // Set instruction
-        maneuver.set_instruction(FormRampInstruction(maneuver));
-
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kExitRight:
+    case DirectionsLeg_Maneuver_Type_kExitLeft: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertExitInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalExitInstruction(maneuver));
+
+      // Only set verbal post if > min ramp length
+      // or contains obvious maneuver
+      // or has collapsed merge maneuver
+      if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
+          maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
+        // Set verbal post transition instruction
+        maneuver.set_verbal_post_transition_instruction(
+            FormVerbalPostTransitionInstruction(maneuver));
+      }
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kStayStraight:
+    case DirectionsLeg_Maneuver_Type_kStayRight:
+    case DirectionsLeg_Maneuver_Type_kStayLeft: {
+      if (maneuver.to_stay_on()) {
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertRampInstruction(maneuver));
+        maneuver.set_verbal_transition_alert_instruction(
+            FormVerbalAlertKeepToStayOnInstruction(maneuver));
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalRampInstruction(maneuver));
+        maneuver.set_verbal_pre_transition_instruction(FormVerbalKeepToStayOnInstruction(maneuver));
 
-        // Only set verbal post if > min ramp length
-        // or contains obvious maneuver
-        // or has collapsed merge maneuver
-        if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
-            maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
+        // For a ramp - only set verbal post if > min ramp length
+        if (maneuver.ramp() && !maneuver.has_collapsed_merge_maneuver()) {
+          if (maneuver.length() > kVerbalPostMinimumRampLength) {
+            // Set verbal post transition instruction
+            maneuver.set_verbal_post_transition_instruction(
+                FormVerbalPostTransitionInstruction(maneuver));
+          }
+        } else {
           // Set verbal post transition instruction
           maneuver.set_verbal_post_transition_instruction(
               FormVerbalPostTransitionInstruction(maneuver));
         }
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kExitRight:
-      case DirectionsLeg_Maneuver_Type_kExitLeft: {
-        // Set instruction
-        maneuver.set_instruction(FormExitInstruction(maneuver));
-
+      } else {
         // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertExitInstruction(maneuver));
+        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertKeepInstruction(maneuver));
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalExitInstruction(maneuver));
+        maneuver.set_verbal_pre_transition_instruction(FormVerbalKeepInstruction(maneuver));
 
-        // Only set verbal post if > min ramp length
-        // or contains obvious maneuver
-        // or has collapsed merge maneuver
-        if ((maneuver.length() > kVerbalPostMinimumRampLength) ||
-            maneuver.contains_obvious_maneuver() || maneuver.has_collapsed_merge_maneuver()) {
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
-        }
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kStayStraight:
-      case DirectionsLeg_Maneuver_Type_kStayRight:
-      case DirectionsLeg_Maneuver_Type_kStayLeft: {
-        if (maneuver.to_stay_on()) {
-          // Set stay on instruction
-          maneuver.set_instruction(FormKeepToStayOnInstruction(maneuver));
-
-          // Set verbal transition alert instruction
-          maneuver.set_verbal_transition_alert_instruction(
-              FormVerbalAlertKeepToStayOnInstruction(maneuver));
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(FormVerbalKeepToStayOnInstruction(maneuver));
-
-          // For a ramp - only set verbal post if > min ramp length
-          if (maneuver.ramp() && !maneuver.has_collapsed_merge_maneuver()) {
-            if (maneuver.length() > kVerbalPostMinimumRampLength) {
-              // Set verbal post transition instruction
-              maneuver.set_verbal_post_transition_instruction(
-                  FormVerbalPostTransitionInstruction(maneuver));
-            }
-          } else {
+        // For a ramp - only set verbal post if > min ramp length
+        if (maneuver.ramp() && !maneuver.has_collapsed_merge_maneuver()) {
+          if (maneuver.length() > kVerbalPostMinimumRampLength) {
             // Set verbal post transition instruction
             maneuver.set_verbal_post_transition_instruction(
                 FormVerbalPostTransitionInstruction(maneuver));
           }
         } else {
-          // Set instruction
-          maneuver.set_instruction(FormKeepInstruction(maneuver));
-
-          // Set verbal transition alert instruction
-          maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertKeepInstruction(maneuver));
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(FormVerbalKeepInstruction(maneuver));
-
-          // For a ramp - only set verbal post if > min ramp length
-          if (maneuver.ramp() && !maneuver.has_collapsed_merge_maneuver()) {
-            if (maneuver.length() > kVerbalPostMinimumRampLength) {
-              // Set verbal post transition instruction
-              maneuver.set_verbal_post_transition_instruction(
-                  FormVerbalPostTransitionInstruction(maneuver));
-            }
-          } else {
-            // Set verbal post transition instruction
-            maneuver.set_verbal_post_transition_instruction(
-                FormVerbalPostTransitionInstruction(maneuver));
-          }
-        }
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kMerge:
-      case DirectionsLeg_Maneuver_Type_kMergeRight:
-      case DirectionsLeg_Maneuver_Type_kMergeLeft: {
-        // Set instruction
-        maneuver.set_instruction(FormMergeInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctMergeTransitionInstruction(maneuver));
-
-        // Set verbal transition alert instruction if previous maneuver
-        // is greater than 2 km
-        if (prev_maneuver && (prev_maneuver->length(Options::kilometers) >
-                              kVerbalAlertMergePriorManeuverMinimumLength)) {
-          maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertMergeInstruction(maneuver));
-        }
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalMergeInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kRoundaboutEnter: {
-        // Set instruction
-        maneuver.set_instruction(FormEnterRoundaboutInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctEnterRoundaboutTransitionInstruction(maneuver));
-
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            FormVerbalAlertEnterRoundaboutInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalEnterRoundaboutInstruction(maneuver));
-
-        // If the maneuver has a combined enter exit roundabout instruction
-        // then set verbal post transition instruction
-        if (maneuver.has_combined_enter_exit_roundabout()) {
+          // Set verbal post transition instruction
           maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver,
-                                                  maneuver.HasRoundaboutExitBeginStreetNames()));
+              FormVerbalPostTransitionInstruction(maneuver));
         }
-        break;
       }
-      case DirectionsLeg_Maneuver_Type_kRoundaboutExit: {
-        // Set instruction
-        maneuver.set_instruction(FormExitRoundaboutInstruction(maneuver));
-
-        // Set verbal succinct transition instruction
-        maneuver.set_verbal_succinct_transition_instruction(
-            FormVerbalSuccinctExitRoundaboutTransitionInstruction(maneuver));
-
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalExitRoundaboutInstruction(maneuver));
-
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
-        break;
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kMerge:
+    case DirectionsLeg_Maneuver_Type_kMergeRight:
+    case DirectionsLeg_Maneuver_Type_kMergeLeft: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctMergeTransitionInstruction(maneuver));
+
+      // Set verbal transition alert instruction if previous maneuver
+      // is greater than 2 km
+      if (prev_maneuver && (prev_maneuver->length(Options::kilometers) >
+                            kVerbalAlertMergePriorManeuverMinimumLength)) {
+        maneuver.set_verbal_transition_alert_instruction(FormVerbalAlertMergeInstruction(maneuver));
       }
-      case DirectionsLeg_Maneuver_Type_kFerryEnter: {
-        // Set instruction
-        maneuver.set_instruction(FormEnterFerryInstruction(maneuver));
 
-        // Set verbal transition alert instruction
-        maneuver.set_verbal_transition_alert_instruction(
-            FormVerbalAlertEnterFerryInstruction(maneuver));
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalMergeInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalEnterFerryInstruction(maneuver));
-
-        // Set verbal post transition instruction
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kRoundaboutEnter: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctEnterRoundaboutTransitionInstruction(maneuver));
+
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(
+          FormVerbalAlertEnterRoundaboutInstruction(maneuver));
+
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalEnterRoundaboutInstruction(maneuver));
+
+      // If the maneuver has a combined enter exit roundabout instruction
+      // then set verbal post transition instruction
+      if (maneuver.has_combined_enter_exit_roundabout()) {
         maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
-        break;
+            FormVerbalPostTransitionInstruction(maneuver,
+                                                maneuver.HasRoundaboutExitBeginStreetNames()));
       }
-      case DirectionsLeg_Maneuver_Type_kTransitConnectionStart: {
-        // Set instruction
-        maneuver.set_instruction(FormTransitConnectionStartInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kRoundaboutExit: {
+      // Set verbal succinct transition instruction
+      maneuver.set_verbal_succinct_transition_instruction(
+          FormVerbalSuccinctExitRoundaboutTransitionInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitConnectionStartInstruction(maneuver));
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalExitRoundaboutInstruction(maneuver));
 
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kTransitConnectionTransfer: {
-        // Set instruction
-        maneuver.set_instruction(FormTransitConnectionTransferInstruction(maneuver));
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver, maneuver.HasBeginStreetNames()));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kFerryEnter: {
+      // Set verbal transition alert instruction
+      maneuver.set_verbal_transition_alert_instruction(
+          FormVerbalAlertEnterFerryInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitConnectionTransferInstruction(maneuver));
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalEnterFerryInstruction(maneuver));
 
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kTransitConnectionDestination: {
-        // Set instruction
-        maneuver.set_instruction(FormTransitConnectionDestinationInstruction(maneuver));
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionStart: {
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitConnectionStartInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionTransfer: {
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitConnectionTransferInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitConnectionDestination: {
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitConnectionDestinationInstruction(maneuver));
+
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransit: {
+      // Set verbal depart instruction
+      maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitConnectionDestinationInstruction(maneuver));
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(FormVerbalTransitInstruction(maneuver));
 
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kTransit: {
-        // Set depart instruction
-        maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionTransitInstruction(maneuver));
 
-        // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
+      // Set verbal arrive instruction
+      maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
 
-        // Set instruction
-        maneuver.set_instruction(FormTransitInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitRemainOn: {
+      // Set verbal depart instruction
+      maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
 
-        // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(FormVerbalTransitInstruction(maneuver));
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitRemainOnInstruction(maneuver));
 
-        // Set verbal post transition instruction
-        maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionTransitInstruction(maneuver));
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionTransitInstruction(maneuver));
 
-        // Set arrive instruction
-        maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
+      // Set verbal arrive instruction
+      maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
 
-        // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kTransitTransfer: {
+      // Set verbal depart instruction
+      maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
 
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kTransitRemainOn: {
-        // Set depart instruction
-        maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
+      // Set verbal pre transition instruction
+      maneuver.set_verbal_pre_transition_instruction(
+          FormVerbalTransitTransferInstruction(maneuver));
 
-        // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
+      // Set verbal post transition instruction
+      maneuver.set_verbal_post_transition_instruction(
+          FormVerbalPostTransitionTransitInstruction(maneuver));
 
-        // Set instruction
-        maneuver.set_instruction(FormTransitRemainOnInstruction(maneuver));
+      // Set verbal arrive instruction
+      maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kElevatorEnter: {
+      if (maneuver.has_node_type() && maneuver.node_type() == TripLeg_Node_Type_kElevator) {
+        maneuver.set_verbal_transition_alert_instruction(maneuver.instruction());
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitRemainOnInstruction(maneuver));
+        maneuver.set_verbal_pre_transition_instruction(maneuver.instruction());
 
         // Set verbal post transition instruction
         maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionTransitInstruction(maneuver));
-
-        // Set arrive instruction
-        maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
-
-        // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
-
-        break;
+            FormVerbalPostTransitionInstruction(maneuver));
       }
-      case DirectionsLeg_Maneuver_Type_kTransitTransfer: {
-        // Set depart instruction
-        maneuver.set_depart_instruction(FormDepartInstruction(maneuver));
-
-        // Set verbal depart instruction
-        maneuver.set_verbal_depart_instruction(FormVerbalDepartInstruction(maneuver));
-
-        // Set instruction
-        maneuver.set_instruction(FormTransitTransferInstruction(maneuver));
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kStepsEnter:
+    case DirectionsLeg_Maneuver_Type_kEscalatorEnter:
+    case DirectionsLeg_Maneuver_Type_kBuildingEnter:
+    case DirectionsLeg_Maneuver_Type_kBuildingExit: {
+      // These have no verbal instructions
+      break;
+    }
+    case DirectionsLeg_Maneuver_Type_kContinue:
+    default: {
+      if (maneuver.has_node_type()) {
+        // Set verbal pre transition instruction
+        maneuver.set_verbal_pre_transition_instruction(maneuver.instruction());
+      } else {
+        // Set verbal transition alert instruction
+        maneuver.set_verbal_transition_alert_instruction(
+            FormVerbalAlertContinueInstruction(maneuver));
 
         // Set verbal pre transition instruction
-        maneuver.set_verbal_pre_transition_instruction(
-            FormVerbalTransitTransferInstruction(maneuver));
+        maneuver.set_verbal_pre_transition_instruction(FormVerbalContinueInstruction(maneuver));
 
         // Set verbal post transition instruction
         maneuver.set_verbal_post_transition_instruction(
-            FormVerbalPostTransitionTransitInstruction(maneuver));
-
-        // Set arrive instruction
-        maneuver.set_arrive_instruction(FormArriveInstruction(maneuver));
-
-        // Set verbal arrive instruction
-        maneuver.set_verbal_arrive_instruction(FormVerbalArriveInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kElevatorEnter: {
-        // Set instruction
-        auto instr = FormElevatorInstruction(maneuver);
-        maneuver.set_instruction(instr);
-
-        if (maneuver.has_node_type() && maneuver.node_type() == TripLeg_Node_Type_kElevator) {
-          maneuver.set_verbal_transition_alert_instruction(instr);
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(instr);
-
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
-        }
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kStepsEnter: {
-        // Set instruction
-        maneuver.set_instruction(FormStepsInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kEscalatorEnter: {
-        // Set instruction
-        maneuver.set_instruction(FormEscalatorInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kBuildingEnter: {
-        // Set instruction
-        maneuver.set_instruction(FormEnterBuildingInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kBuildingExit: {
-        // Set instruction
-        maneuver.set_instruction(FormExitBuildingInstruction(maneuver));
-        break;
-      }
-      case DirectionsLeg_Maneuver_Type_kContinue:
-      default: {
-        if (maneuver.has_node_type()) {
-          std::string instr = FormPassInstruction(maneuver);
-          // Set instruction
-          maneuver.set_instruction(instr);
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(instr);
-        } else {
-          // Set instruction
-          maneuver.set_instruction(FormContinueInstruction(maneuver));
-
-          // Set verbal transition alert instruction
-          maneuver.set_verbal_transition_alert_instruction(
-              FormVerbalAlertContinueInstruction(maneuver));
-
-          // Set verbal pre transition instruction
-          maneuver.set_verbal_pre_transition_instruction(FormVerbalContinueInstruction(maneuver));
-
-          // Set verbal post transition instruction
-          maneuver.set_verbal_post_transition_instruction(
-              FormVerbalPostTransitionInstruction(maneuver));
-        }
-        break;
+            FormVerbalPostTransitionInstruction(maneuver));
       }
+      break;
     }
-    maneuver.set_instruction(FormBssManeuverType(maneuver.bss_maneuver_type()) +
-                             maneuver.instruction());
-
-    // Update previous maneuver
-    prev_maneuver = &maneuver;
   }
-
-  // Iterate over maneuvers to form verbal multi-cue instructions
-  FormVerbalMultiCue(maneuvers);
 }
 
 std::string NarrativeBuilder::FormVerbalAlertApproachInstruction(float distance,
@@ -544,13 +560,14 @@ std::string NarrativeBuilder::FormVerbalAlertApproachInstruction(float distance,
   uint8_t phrase_id = 0;
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.approach_verbal_alert_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.approach_verbal_alert_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(distance, dictionary_.approach_verbal_alert_subset.metric_lengths,
-                                dictionary_.approach_verbal_alert_subset.us_customary_lengths));
-  boost::replace_all(instruction, kCurrentVerbalCueTag, verbal_cue);
+  const std::string length =
+      FormLength(distance, dictionary_.approach_verbal_alert_subset.metric_lengths,
+                 dictionary_.approach_verbal_alert_subset.us_customary_lengths);
+  phrase.Render(instruction, {{PhraseTag::kLength, length},
+                              {PhraseTag::kCurrentVerbalCue, verbal_cue}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -609,12 +626,12 @@ std::string NarrativeBuilder::FormStartInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.start_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  phrase.Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -696,15 +713,15 @@ std::string NarrativeBuilder::FormVerbalStartInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.start_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
-                                dictionary_.start_verbal_subset.us_customary_lengths));
+  const std::string length = FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
+                                        dictionary_.start_verbal_subset.us_customary_lengths);
+  phrase.Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kLength, length}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -749,13 +766,11 @@ std::string NarrativeBuilder::FormDestinationInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.destination_subset.phrase(phrase_id);
 
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Replace phrase tags with values
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -805,13 +820,11 @@ std::string NarrativeBuilder::FormVerbalAlertDestinationInstruction(Maneuver& ma
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_verbal_alert_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.destination_verbal_alert_subset.phrase(phrase_id);
 
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Replace phrase tags with values
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -861,13 +874,11 @@ std::string NarrativeBuilder::FormVerbalDestinationInstruction(Maneuver& maneuve
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.destination_verbal_subset.phrase(phrase_id);
 
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Replace phrase tags with values
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -891,11 +902,11 @@ std::string NarrativeBuilder::FormBecomesInstruction(Maneuver& maneuver, Maneuve
   uint8_t phrase_id = 0;
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.becomes_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.becomes_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kPreviousStreetNamesTag, prev_street_names);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  phrase.Render(instruction, {{PhraseTag::kPreviousStreetNames, prev_street_names},
+                              {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -926,11 +937,11 @@ std::string NarrativeBuilder::FormVerbalBecomesInstruction(Maneuver& maneuver,
   uint8_t phrase_id = 0;
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.becomes_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.becomes_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kPreviousStreetNamesTag, prev_street_names);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  phrase.Render(instruction, {{PhraseTag::kPreviousStreetNames, prev_street_names},
+                              {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -977,12 +988,12 @@ std::string NarrativeBuilder::FormContinueInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.continue_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1033,12 +1044,12 @@ std::string NarrativeBuilder::FormVerbalAlertContinueInstruction(Maneuver& maneu
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_verbal_alert_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.continue_verbal_alert_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1098,15 +1109,15 @@ std::string NarrativeBuilder::FormVerbalContinueInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.continue_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.continue_verbal_subset.metric_lengths,
-                                dictionary_.continue_verbal_subset.us_customary_lengths));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  const std::string length = FormLength(maneuver, dictionary_.continue_verbal_subset.metric_lengths,
+                                        dictionary_.continue_verbal_subset.us_customary_lengths);
+  phrase.Render(instruction, {{PhraseTag::kLength, length},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1183,15 +1194,16 @@ std::string NarrativeBuilder::FormTurnInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
+  const auto& phrase = subset->phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  const std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1291,15 +1303,16 @@ std::string NarrativeBuilder::FormVerbalTurnInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
+  const auto& phrase = subset->phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  const std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1361,16 +1374,16 @@ std::string NarrativeBuilder::FormUturnInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.uturn_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.uturn_subset.relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kCrossStreetNamesTag, cross_street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  const std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.uturn_subset.relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kCrossStreetNames, cross_street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1516,14 +1529,14 @@ std::string NarrativeBuilder::FormVerbalUturnInstruction(uint8_t phrase_id,
   instruction.reserve(kInstructionInitialCapacity);
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.uturn_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kCrossStreetNamesTag, cross_street_names);
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kCrossStreetNames, cross_street_names},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1570,12 +1583,12 @@ std::string NarrativeBuilder::FormRampStraightInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_straight_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.ramp_straight_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  phrase.Render(instruction, {{PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1675,12 +1688,12 @@ std::string NarrativeBuilder::FormVerbalRampStraightInstruction(uint8_t phrase_i
   instruction.reserve(kInstructionInitialCapacity);
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_straight_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.ramp_straight_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  phrase.Render(instruction, {{PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1749,15 +1762,15 @@ std::string NarrativeBuilder::FormRampInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.ramp_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.ramp_subset.relative_directions));
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  const std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.ramp_subset.relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1909,13 +1922,13 @@ std::string NarrativeBuilder::FormVerbalRampInstruction(uint8_t phrase_id,
   instruction.reserve(kInstructionInitialCapacity);
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.ramp_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1994,16 +2007,16 @@ std::string NarrativeBuilder::FormExitInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.exit_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.exit_subset.relative_directions));
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  const std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.exit_subset.relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2165,14 +2178,14 @@ std::string NarrativeBuilder::FormVerbalExitInstruction(uint8_t phrase_id,
   instruction.reserve(kInstructionInitialCapacity);
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.exit_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kBranchSign, exit_branch_sign},
+                              {PhraseTag::kTowardSign, exit_toward_sign},
+                              {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2254,15 +2267,15 @@ std::string NarrativeBuilder::FormKeepInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.keep_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeThreeDirection(maneuver.type(),
-                                                dictionary_.keep_subset.relative_directions));
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, toward_sign);
+  const std::string relative_direction =
+      FormRelativeThreeDirection(maneuver.type(), dictionary_.keep_subset.relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2445,13 +2458,13 @@ std::string NarrativeBuilder::FormVerbalKeepInstruction(uint8_t phrase_id,
   instruction.reserve(kInstructionInitialCapacity);
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.keep_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, toward_sign);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2504,15 +2517,16 @@ std::string NarrativeBuilder::FormKeepToStayOnInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_to_stay_on_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.keep_to_stay_on_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeThreeDirection(maneuver.type(), dictionary_.keep_to_stay_on_subset
-                                                                     .relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kTowardSignTag, toward_sign);
+  const std::string relative_direction =
+      FormRelativeThreeDirection(maneuver.type(),
+                                 dictionary_.keep_to_stay_on_subset.relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kTowardSign, toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2603,13 +2617,13 @@ std::string NarrativeBuilder::FormVerbalKeepToStayOnInstruction(uint8_t phrase_i
   instruction.reserve(kInstructionInitialCapacity);
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_to_stay_on_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.keep_to_stay_on_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kTowardSignTag, toward_sign);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kNumberSign, exit_number_sign},
+                              {PhraseTag::kTowardSign, toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2661,12 +2675,12 @@ std::string NarrativeBuilder::FormMergeInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.merge_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2736,12 +2750,12 @@ std::string NarrativeBuilder::FormVerbalMergeInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.merge_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2859,15 +2873,15 @@ std::string NarrativeBuilder::FormEnterRoundaboutInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.enter_roundabout_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
-  boost::replace_all(instruction, kRoundaboutExitStreetNamesTag, roundabout_exit_street_names);
-  boost::replace_all(instruction, kRoundaboutExitBeginStreetNamesTag,
-                     roundabout_exit_begin_street_names);
+  phrase.Render(instruction,
+                {{PhraseTag::kOrdinalValue, ordinal_value},
+                 {PhraseTag::kStreetNames, street_names},
+                 {PhraseTag::kTowardSign, guide_sign},
+                 {PhraseTag::kRoundaboutExitStreetNames, roundabout_exit_street_names},
+                 {PhraseTag::kRoundaboutExitBeginStreetNames, roundabout_exit_begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3011,15 +3025,15 @@ std::string NarrativeBuilder::FormVerbalEnterRoundaboutInstruction(Maneuver& man
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.enter_roundabout_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
-  boost::replace_all(instruction, kRoundaboutExitStreetNamesTag, roundabout_exit_street_names);
-  boost::replace_all(instruction, kRoundaboutExitBeginStreetNamesTag,
-                     roundabout_exit_begin_street_names);
+  phrase.Render(instruction,
+                {{PhraseTag::kOrdinalValue, ordinal_value},
+                 {PhraseTag::kStreetNames, street_names},
+                 {PhraseTag::kTowardSign, guide_sign},
+                 {PhraseTag::kRoundaboutExitStreetNames, roundabout_exit_street_names},
+                 {PhraseTag::kRoundaboutExitBeginStreetNames, roundabout_exit_begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3074,12 +3088,12 @@ std::string NarrativeBuilder::FormExitRoundaboutInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.exit_roundabout_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3138,12 +3152,12 @@ std::string NarrativeBuilder::FormVerbalExitRoundaboutInstruction(Maneuver& mane
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.exit_roundabout_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kBeginStreetNames, begin_street_names},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3188,12 +3202,12 @@ std::string NarrativeBuilder::FormEnterFerryInstruction(Maneuver& maneuver,
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_ferry_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.enter_ferry_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kFerryLabelTag, ferry_label);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kFerryLabel, ferry_label},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3255,12 +3269,12 @@ std::string NarrativeBuilder::FormVerbalEnterFerryInstruction(Maneuver& maneuver
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_ferry_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.enter_ferry_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kFerryLabelTag, ferry_label);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                              {PhraseTag::kFerryLabel, ferry_label},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3294,11 +3308,11 @@ std::string NarrativeBuilder::FormTransitConnectionStartInstruction(Maneuver& ma
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_start_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_connection_start_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3332,12 +3346,11 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionStartInstruction(Maneuv
   }
 
   // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_start_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_connection_start_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3371,11 +3384,11 @@ std::string NarrativeBuilder::FormTransitConnectionTransferInstruction(Maneuver&
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_transfer_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_connection_transfer_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3409,12 +3422,11 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionTransferInstruction(Man
   }
 
   // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_transfer_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_connection_transfer_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3448,12 +3460,11 @@ std::string NarrativeBuilder::FormTransitConnectionDestinationInstruction(Maneuv
   }
 
   // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_destination_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_connection_destination_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3487,12 +3498,11 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionDestinationInstruction(
   }
 
   // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_destination_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_connection_destination_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                              {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3516,12 +3526,13 @@ std::string NarrativeBuilder::FormDepartInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.depart_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.depart_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale()));
+  const std::string localized_time =
+      get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale());
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                              {PhraseTag::kTime, localized_time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3545,12 +3556,13 @@ std::string NarrativeBuilder::FormVerbalDepartInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.depart_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.depart_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale()));
+  const std::string localized_time =
+      get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale());
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                              {PhraseTag::kTime, localized_time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3574,12 +3586,13 @@ std::string NarrativeBuilder::FormArriveInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.arrive_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.arrive_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale()));
+  const std::string localized_time =
+      get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale());
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                              {PhraseTag::kTime, localized_time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3603,12 +3616,13 @@ std::string NarrativeBuilder::FormVerbalArriveInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.arrive_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.arrive_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale()));
+  const std::string localized_time =
+      get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale());
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                              {PhraseTag::kTime, localized_time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3636,15 +3650,16 @@ std::string NarrativeBuilder::FormTransitInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  const std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_subset.empty_transit_name_labels);
+  // TODO: locale specific numerals for the stop count
+  phrase.Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign},
+                              {PhraseTag::kTransitPlatformCount, std::to_string(stop_count)},
+                              {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3668,13 +3683,13 @@ std::string NarrativeBuilder::FormVerbalTransitInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_verbal_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  const std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_verbal_subset.empty_transit_name_labels);
+  phrase.Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3703,16 +3718,16 @@ std::string NarrativeBuilder::FormTransitRemainOnInstruction(Maneuver& maneuver)
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_remain_on_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_remain_on_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_remain_on_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  const std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_remain_on_subset.empty_transit_name_labels);
+  // TODO: locale specific numerals for the stop count
+  phrase.Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign},
+                              {PhraseTag::kTransitPlatformCount, std::to_string(stop_count)},
+                              {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3736,13 +3751,14 @@ std::string NarrativeBuilder::FormVerbalTransitRemainOnInstruction(Maneuver& man
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_remain_on_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_remain_on_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_remain_on_verbal_subset
-                                                   .empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  const std::string transit_name =
+      FormTransitName(maneuver,
+                      dictionary_.transit_remain_on_verbal_subset.empty_transit_name_labels);
+  phrase.Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3771,16 +3787,16 @@ std::string NarrativeBuilder::FormTransitTransferInstruction(Maneuver& maneuver)
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_transfer_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_transfer_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_transfer_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  const std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_transfer_subset.empty_transit_name_labels);
+  // TODO: locale specific numerals for the stop count
+  phrase.Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign},
+                              {PhraseTag::kTransitPlatformCount, std::to_string(stop_count)},
+                              {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3804,13 +3820,14 @@ std::string NarrativeBuilder::FormVerbalTransitTransferInstruction(Maneuver& man
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_transfer_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.transit_transfer_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_transfer_verbal_subset
-                                                   .empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  const std::string transit_name =
+      FormTransitName(maneuver,
+                      dictionary_.transit_transfer_verbal_subset.empty_transit_name_labels);
+  phrase.Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                              {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3852,13 +3869,14 @@ std::string NarrativeBuilder::FormVerbalPostTransitionInstruction(Maneuver& mane
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.post_transition_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.post_transition_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
-                                dictionary_.post_transition_verbal_subset.us_customary_lengths));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  const std::string length =
+      FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
+                 dictionary_.post_transition_verbal_subset.us_customary_lengths);
+  phrase.Render(instruction, {{PhraseTag::kLength, length},
+                              {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3880,13 +3898,12 @@ std::string NarrativeBuilder::FormVerbalPostTransitionTransitInstruction(Maneuve
                                                     .transit_stop_count_labels);
 
   // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.post_transition_transit_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.post_transition_transit_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // TODO: locale specific numerals for the stop count
+  phrase.Render(instruction, {{PhraseTag::kTransitPlatformCount, std::to_string(stop_count)},
+                              {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3931,13 +3948,13 @@ std::string NarrativeBuilder::FormVerbalSuccinctStartTransitionInstruction(Maneu
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.start_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
-                                dictionary_.start_verbal_subset.us_customary_lengths));
+  const std::string length = FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
+                                        dictionary_.start_verbal_subset.us_customary_lengths);
+  phrase.Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                              {PhraseTag::kLength, length}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3997,13 +4014,14 @@ NarrativeBuilder::FormVerbalSuccinctTurnTransitionInstruction(Maneuver& maneuver
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
+  const auto& phrase = subset->phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  const std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4043,14 +4061,15 @@ NarrativeBuilder::FormVerbalSuccinctUturnTransitionInstruction(Maneuver& maneuve
                                                maneuver.verbal_formatter(), &markup_formatter_);
   }
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.uturn_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.uturn_verbal_subset.relative_directions));
-  boost::replace_all(instruction, kJunctionNameTag, junction_name);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  const std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(),
+                               dictionary_.uturn_verbal_subset.relative_directions);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kJunctionName, junction_name},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4095,11 +4114,11 @@ NarrativeBuilder::FormVerbalSuccinctMergeTransitionInstruction(Maneuver& maneuve
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.merge_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4143,11 +4162,11 @@ std::string NarrativeBuilder::FormVerbalSuccinctEnterRoundaboutTransitionInstruc
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.enter_roundabout_verbal_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  phrase.Render(instruction, {{PhraseTag::kOrdinalValue, ordinal_value},
+                              {PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4179,9 +4198,10 @@ std::string NarrativeBuilder::FormVerbalSuccinctExitRoundaboutTransitionInstruct
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.exit_roundabout_verbal_subset.phrase(phrase_id);
 
-  boost::replace_all(instruction, kTowardSignTag, guide_sign);
+  // Replace phrase tags with values
+  phrase.Render(instruction, {{PhraseTag::kTowardSign, guide_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4208,10 +4228,10 @@ std::string NarrativeBuilder::FormElevatorInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.elevator_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.elevator_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kLevelTag, end_level);
+  phrase.Render(instruction, {{PhraseTag::kLevel, end_level}});
 
   return instruction;
 }
@@ -4233,10 +4253,10 @@ std::string NarrativeBuilder::FormStepsInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.steps_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.steps_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kLevelTag, end_level);
+  phrase.Render(instruction, {{PhraseTag::kLevel, end_level}});
 
   return instruction;
 }
@@ -4258,10 +4278,10 @@ std::string NarrativeBuilder::FormEscalatorInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.escalator_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.escalator_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kLevelTag, end_level);
+  phrase.Render(instruction, {{PhraseTag::kLevel, end_level}});
 
   return instruction;
 }
@@ -4285,10 +4305,10 @@ std::string NarrativeBuilder::FormEnterBuildingInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_building_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.enter_building_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  phrase.Render(instruction, {{PhraseTag::kStreetNames, street_names}});
 
   return instruction;
 }
@@ -4312,10 +4332,10 @@ std::string NarrativeBuilder::FormExitBuildingInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_building_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.exit_building_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  phrase.Render(instruction, {{PhraseTag::kStreetNames, street_names}});
 
   return instruction;
 }
@@ -4365,10 +4385,10 @@ std::string NarrativeBuilder::FormPassInstruction(Maneuver& maneuver) {
   }
 
   // Set instruction to the determined tagged phrase
-  instruction = dictionary_.pass_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.pass_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kObjectLabelTag, object_label);
+  phrase.Render(instruction, {{PhraseTag::kObjectLabel, object_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -4796,14 +4816,15 @@ std::string NarrativeBuilder::FormVerbalMultiCue(Maneuver& maneuver,
   if (maneuver.distant_verbal_multi_cue()) {
     phrase_id = 1;
   }
-  instruction = dictionary_.verbal_multi_cue_subset.phrases.at(std::to_string(phrase_id));
+  const auto& phrase = dictionary_.verbal_multi_cue_subset.phrase(phrase_id);
 
   // Replace phrase tags with values
-  boost::replace_all(instruction, kCurrentVerbalCueTag, first_verbal_cue);
-  boost::replace_all(instruction, kNextVerbalCueTag, second_verbal_cue);
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
-                                dictionary_.post_transition_verbal_subset.us_customary_lengths));
+  const std::string length =
+      FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
+                 dictionary_.post_transition_verbal_subset.us_customary_lengths);
+  phrase.Render(instruction, {{PhraseTag::kCurrentVerbalCue, first_verbal_cue},
+                              {PhraseTag::kNextVerbalCue, second_verbal_cue},
+                              {PhraseTag::kLength, length}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -40,7 +40,8 @@ std::string odin_worker_t::narrate(Api& request) const {
     odin::DirectionsBuilder().Build(request, markup_formatter_);
   } catch (...) { throw valhalla_exception_t{202}; }
 
-  // serialize those to the proper format
+  // serialize those to the proper format, timing that on its own
+  auto serialize = measure_scope_time(request, "tyr");
   return tyr::serializeDirections(request);
 }
 
@@ -62,7 +63,7 @@ odin_worker_t::work(const std::list<zmq::message_t>& job,
                     const std::function<void()>& interrupt_function) {
   auto& info = *static_cast<prime_server::http_request_info_t*>(request_info);
   LOG_INFO("Got Odin Request " + std::to_string(info.id));
-  Api request;
+  auto& request = request_arena.next();
   prime_server::worker_t::result_t result{false, {}, {}};
   try {
     // Set the interrupt function
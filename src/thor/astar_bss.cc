@@ -223,6 +223,7 @@ void AStarBSSAlgorithm::ExpandForward(GraphReader& graphreader,
                              baldr::kInvalidRestriction);
     *current_es = {EdgeSet::kTemporary, idx};
     adjacencylist_.add(idx);
+    ++counters_.edge_labels;
   }
 
   if (!from_bss && nodeinfo->type() == NodeType::kBikeShare) {
@@ -289,6 +290,7 @@ AStarBSSAlgorithm::GetBestPath(valhalla::Location& origin,
       LOG_ERROR("Route failed after iterations = " + std::to_string(edgelabels_.size()));
       return {};
     }
+    ++counters_.expanded_edges;
 
     // Copy the EdgeLabel for use in costing. Check if this is a destination
     // edge and potentially complete the path.
@@ -454,6 +456,7 @@ void AStarBSSAlgorithm::SetOrigin(GraphReader& graphreader,
     uint32_t idx = edgelabels_.size();
     edgelabels_.push_back(std::move(edge_label));
     adjacencylist_.add(idx);
+    ++counters_.edge_labels;
 
     // DO NOT SET EdgeStatus - it messes up trivial paths with oneways
   }
@@ -332,6 +332,7 @@ inline bool BidirectionalAStar::ExpandInner(baldr::GraphReader& graphreader,
                                          (costing_->is_hgv() && meta.edge->destonly_hgv()),
                                      meta.edge->forwardaccess() & kTruckAccess);
     adjacencylist_forward_.add(idx);
+    ++counters_.edge_labels;
   } else {
     idx = edgelabels_reverse_.size();
     if (hierarchy_limits_reverse_[meta.edge_id.level()].max_up_transitions != kUnlimitedTransitions) {
@@ -350,6 +351,7 @@ inline bool BidirectionalAStar::ExpandInner(baldr::GraphReader& graphreader,
                                          (costing_->is_hgv() && opp_edge->destonly_hgv()),
                                      opp_edge->forwardaccess() & kTruckAccess);
     adjacencylist_reverse_.add(idx);
+    ++counters_.edge_labels;
   }
 
   *meta.edge_status = {EdgeSet::kTemporary, idx};
@@ -567,6 +569,7 @@ BidirectionalAStar::GetBestPath(valhalla::Location& origin,
     if (expand_forward) {
       forward_pred_idx = adjacencylist_forward_.pop();
       if (forward_pred_idx != kInvalidLabel) {
+        ++counters_.expanded_edges;
         fwd_pred = edgelabels_forward_[forward_pred_idx];
 
         // Forward path to this edge can't be improved, so we can settle it right now.
@@ -616,6 +619,7 @@ BidirectionalAStar::GetBestPath(valhalla::Location& origin,
     if (expand_reverse) {
       reverse_pred_idx = adjacencylist_reverse_.pop();
       if (reverse_pred_idx != kInvalidLabel) {
+        ++counters_.expanded_edges;
         rev_pred = edgelabels_reverse_[reverse_pred_idx];
 
         // Reverse path to this edge can't be improved, so we can settle it right now.
@@ -1030,6 +1034,7 @@ void BidirectionalAStar::SetOrigin(GraphReader& graphreader,
                                          (costing_->is_hgv() && directededge->destonly_hgv()),
                                      directededge->forwardaccess() & kTruckAccess);
     adjacencylist_forward_.add(idx);
+    ++counters_.edge_labels;
 
     // setting this edge as reached
     if (expansion_callback_) {
@@ -1129,6 +1134,7 @@ void BidirectionalAStar::SetDestination(GraphReader& graphreader,
                                          (costing_->is_hgv() && directededge->destonly_hgv()),
                                      directededge->forwardaccess() & kTruckAccess);
     adjacencylist_reverse_.add(idx);
+    ++counters_.edge_labels;
 
     // setting this edge as reached, sending the opposing because this is the reverse tree
     if (expansion_callback_) {
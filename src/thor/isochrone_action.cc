@@ -1,3 +1,8 @@
+#include <atomic>
+#include <exception>
+#include <functional>
+
+#include "baldr/datetime.h"
 #include "midgard/util.h"
 #include "thor/worker.h"
 #include "tyr/serializers.h"
@@ -49,5 +54,85 @@ std::string thor_worker_t::isochrones(Api& request) {
   return ret;
 }
 
+std::vector<std::string> thor_worker_t::isochrones(Api& request,
+                                                  const std::vector<std::string>& date_times) {
+  // time this whole method and save that statistic
+  auto _ = measure_scope_time(request);
+
+  // every time gets its own copy of the request with the time set the same way as if it had been
+  // part of the original request
+  std::vector<Api> requests;
+  requests.reserve(date_times.size());
+  for (const auto& date_time : date_times) {
+    if (date_time != "current" && !DateTime::is_iso_valid(date_time)) {
+      throw valhalla_exception_t{162};
+    }
+    requests.emplace_back(request);
+    auto& options = *requests.back().mutable_options();
+    if (date_time == "current") {
+      options.set_date_time_type(Options::current);
+    } else if (options.date_time_type() == Options::no_time ||
+               options.date_time_type() == Options::current) {
+      options.set_date_time_type(Options::depart_at);
+    }
+    options.set_date_time(date_time);
+
+    auto& locations = *options.mutable_locations();
+    for (auto& location : locations) {
+      location.clear_date_time();
+    }
+    switch (options.date_time_type()) {
+      case Options::arrive_by:
+        locations.Mutable(locations.size() - 1)->set_date_time(date_time);
+        break;
+      case Options::invariant:
+        for (auto& location : locations) {
+          location.set_date_time(date_time);
+        }
+        break;
+      default:
+        locations.Mutable(0)->set_date_time(date_time);
+        break;
+    }
+  }
+
+  // the first time pays for warming up the tile cache and the label storage, the rest reuse it
+  std::vector<std::string> results(requests.size());
+  const size_t concurrency = std::min(max_isochrone_concurrency, requests.size());
+  if (concurrency < 2) {
+    for (size_t i = 0; i < requests.size(); ++i) {
+      // the expansion itself doesnt check the interrupt so we do it between times
+      if (interrupt) {
+        (*interrupt)();
+      }
+      results[i] = isochrones(requests[i]);
+      isochrone_gen.Clear();
+    }
+    return results;
+  }
+
+  // otherwise some auxiliary workers, which have their own reader, costing and expansion, each take
+  // the next time until there are none left while this one only watches the interrupt
+  std::vector<std::exception_ptr> errors(requests.size());
+  std::atomic<size_t> next_time(0);
+  std::function<void(thor_worker_t&)> expand_times = [&](thor_worker_t& worker) {
+    for (size_t i = next_time++; i < requests.size(); i = next_time++) {
+      try {
+        results[i] = worker.isochrones(requests[i]);
+      } catch (...) { errors[i] = std::current_exception(); }
+      worker.isochrone_gen.Clear();
+    }
+  };
+  run_aux_workers(concurrency, expand_times);
+
+  // the first failure is the one that would have happened serially
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return results;
+}
+
 } // namespace thor
 } // namespace valhalla
@@ -118,6 +118,7 @@ std::string thor_worker_t::matrix(Api& request) {
   if (algo->name() != "costmatrix") {
     algo->SourceToTarget(request, *reader, mode_costing, mode,
                          max_matrix_distance.find(costing)->second);
+    auto serialize = measure_scope_time(request, "tyr");
     return tyr::serializeMatrix(request);
   }
 
@@ -145,6 +146,8 @@ std::string thor_worker_t::matrix(Api& request) {
     add_warning(request, 400, get_unfound_indices(request.matrix().second_pass()));
   };
 
+  // time the serialization on its own
+  auto serialize = measure_scope_time(request, "tyr");
   return tyr::serializeMatrix(request);
 }
 } // namespace thor
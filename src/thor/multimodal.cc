@@ -187,6 +187,7 @@ MultiModalPathAlgorithm::GetBestPath(valhalla::Location& origin,
       LOG_ERROR("Route failed after iterations = " + std::to_string(edgelabels_.size()));
       return {};
     }
+    ++counters_.expanded_edges;
 
     // Copy the EdgeLabel for use in costing. Check if this is a destination
     // edge and potentially complete the path.
@@ -525,6 +526,7 @@ bool MultiModalPathAlgorithm::ExpandForward(GraphReader& graphreader,
                              path_dist, walking_distance, tripid, prior_stop, blockid, operator_id,
                              has_transit, transition_cost, baldr::kInvalidRestriction);
     adjacencylist_.add(idx);
+    ++counters_.edge_labels;
   }
 
   // Handle transitions - expand from the end node each transition
@@ -636,6 +638,7 @@ void MultiModalPathAlgorithm::SetOrigin(GraphReader& graphreader,
     uint32_t idx = edgelabels_.size();
     edgelabels_.push_back(std::move(edge_label));
     adjacencylist_.add(idx);
+    ++counters_.edge_labels;
 
     // DO NOT SET EdgeStatus - it messes up trivial paths with oneways
   }
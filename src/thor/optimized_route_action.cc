@@ -53,9 +53,15 @@ void thor_worker_t::optimized_route(Api& request) {
     time_costs.emplace_back(static_cast<float>(tds.Get(i)));
   }
 
-  Optimizer optimizer;
   // returns the optimal order of the path_locations
-  auto optimal_order = optimizer.Solve(correlated.size(), time_costs);
+  std::vector<uint32_t> optimal_order;
+  if (optimizer_annealing) {
+    Optimizer optimizer;
+    optimal_order = optimizer.Solve(correlated.size(), time_costs);
+  } else {
+    LocalSearchOptimizer optimizer(optimizer_time_budget, optimizer_concurrency);
+    optimal_order = optimizer.Solve(correlated.size(), time_costs);
+  }
   // put the optimal order into the locations array
   options.mutable_locations()->Clear();
   for (size_t i = 0; i < optimal_order.size(); i++) {
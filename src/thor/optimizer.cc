@@ -1,6 +1,303 @@
 #include "thor/optimizer.h"
 #include "midgard/logging.h"
 
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+namespace {
+
+// Number of nearest locations of each location the local search tries to connect it to
+constexpr uint32_t kNeighbors = 10;
+
+// Longest run of locations an Or-opt move relocates
+constexpr uint32_t kMaxSegment = 3;
+
+// A move has to save at least this much to be made, so rounding errors can't make moves cycle
+constexpr float kMinImprovement = 1e-3f;
+
+// Kicks in a row that don't improve the current tour before a search starts over on a new tour
+constexpr uint32_t kKicksPerRestart = 50;
+
+// A search is done once this many kicks per location in a row found no better tour
+constexpr uint32_t kStalledKicksPerLocation = 10;
+
+// Each kick costs about as much as the tour is long, so a search gets this many locations worth of
+// kicks in total but never fewer than kMinKicks
+constexpr uint32_t kKickedLocations = 15000;
+constexpr uint32_t kMinKicks = 50;
+
+// Number of nearest unvisited locations a randomized construction picks the next location from
+constexpr uint32_t kConstructionChoices = 3;
+
+// One local search over the tour, the first and last locations always stay in place
+class TourSearch {
+public:
+  TourSearch(const uint32_t count,
+             const std::vector<float>& costs,
+             const std::vector<std::vector<uint32_t>>& neighbors,
+             const uint32_t seed)
+      : count_(count), costs_(costs), neighbors_(neighbors), random_generator_(seed),
+        position_(count), forward_(count), backward_(count) {
+  }
+
+  // searches until kicking the best tour stops finding anything better or it has kicked enough,
+  // the deadline only cuts searches short that take far longer than they should
+  std::vector<uint32_t> Run(const std::chrono::steady_clock::time_point deadline,
+                            const bool greedy) {
+    greedy ? Greedy() : RandomNearest();
+    Improve();
+    auto current = tour_;
+    float current_cost = cost_;
+    auto best = tour_;
+    float best_cost = cost_;
+
+    const uint32_t max_kicks = std::max(kKickedLocations / count_, kMinKicks);
+    uint32_t kicks = 0, stalled = 0, unimproved = 0;
+    while (kicks++ < max_kicks && stalled < kStalledKicksPerLocation * count_ &&
+           std::chrono::steady_clock::now() < deadline) {
+      // kick the current tour out of its local optimum or start over if that keeps failing
+      bool restart = unimproved >= kKicksPerRestart;
+      if (restart) {
+        RandomNearest();
+        unimproved = 0;
+      } else {
+        tour_ = current;
+        Kick();
+      }
+      Improve();
+
+      if (restart || cost_ < current_cost - kMinImprovement) {
+        current = tour_;
+        current_cost = cost_;
+        unimproved = 0;
+      } else {
+        ++unimproved;
+      }
+      if (cost_ < best_cost - kMinImprovement) {
+        best = tour_;
+        best_cost = cost_;
+        stalled = 0;
+      } else {
+        ++stalled;
+      }
+    }
+    return best;
+  }
+
+protected:
+  uint32_t count_;
+  const std::vector<float>& costs_;
+  const std::vector<std::vector<uint32_t>>& neighbors_;
+  std::mt19937_64 random_generator_;
+
+  std::vector<uint32_t> tour_;     // Current tour (order of locations)
+  std::vector<uint32_t> position_; // Index of each location in the tour
+  std::vector<float> forward_;     // Cost of the tour up to each index
+  std::vector<float> backward_;    // Cost of the tour up to each index when traversed backwards
+  float cost_;                     // Cost of the current tour
+
+  float Cost(const uint32_t loc1, const uint32_t loc2) const {
+    return costs_[(loc1 * count_) + loc2];
+  }
+
+  // recomputes the positions and the running costs after the tour changed
+  void Update() {
+    for (uint32_t i = 0; i < count_; ++i) {
+      position_[tour_[i]] = i;
+    }
+    forward_[0] = backward_[0] = 0.f;
+    for (uint32_t i = 1; i < count_; ++i) {
+      forward_[i] = forward_[i - 1] + Cost(tour_[i - 1], tour_[i]);
+      backward_[i] = backward_[i - 1] + Cost(tour_[i], tour_[i - 1]);
+    }
+    cost_ = forward_[count_ - 1];
+  }
+
+  // builds the tour from the cheapest connections first, like a greedy matching that never gives a
+  // location two successors or two predecessors and never closes a loop
+  void Greedy() {
+    std::vector<uint32_t> arcs(count_ * count_);
+    std::iota(arcs.begin(), arcs.end(), 0);
+    std::sort(arcs.begin(), arcs.end(),
+              [this](const uint32_t a, const uint32_t b) { return costs_[a] < costs_[b]; });
+
+    constexpr auto kNone = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> next(count_, kNone), previous(count_, kNone), fragment(count_);
+    std::iota(fragment.begin(), fragment.end(), 0);
+    auto find = [&fragment](uint32_t loc) {
+      while (fragment[loc] != loc) {
+        loc = fragment[loc] = fragment[fragment[loc]];
+      }
+      return loc;
+    };
+
+    const uint32_t first = 0, last = count_ - 1;
+    uint32_t connected = 0;
+    for (auto arc : arcs) {
+      uint32_t from = arc / count_, to = arc % count_;
+      if (from == last || to == first || next[from] != kNone || previous[to] != kNone) {
+        continue;
+      }
+      auto from_fragment = find(from), to_fragment = find(to);
+      // the origin and destination only join up once all the other locations are between them
+      if (from_fragment == to_fragment ||
+          (connected + 2 < count_ && from_fragment == find(first) && to_fragment == find(last))) {
+        continue;
+      }
+      next[from] = to;
+      previous[to] = from;
+      fragment[from_fragment] = to_fragment;
+      if (++connected == count_ - 1) {
+        break;
+      }
+    }
+
+    tour_.clear();
+    for (auto loc = first; loc != kNone; loc = next[loc]) {
+      tour_.push_back(loc);
+    }
+    Update();
+  }
+
+  // builds the tour by going to one of the few nearest unvisited locations at random
+  void RandomNearest() {
+    std::vector<uint32_t> unvisited(count_ - 2);
+    std::iota(unvisited.begin(), unvisited.end(), 1);
+    tour_.assign(1, 0);
+    while (!unvisited.empty()) {
+      auto choices = std::min<size_t>(kConstructionChoices, unvisited.size());
+      auto from = tour_.back();
+      std::partial_sort(unvisited.begin(), unvisited.begin() + choices, unvisited.end(),
+                        [this, from](const uint32_t a, const uint32_t b) {
+                          return Cost(from, a) < Cost(from, b);
+                        });
+      auto pick = unvisited.begin() + random_generator_() % choices;
+      tour_.push_back(*pick);
+      unvisited.erase(pick);
+    }
+    tour_.push_back(count_ - 1);
+    Update();
+  }
+
+  // swaps two neighboring runs of locations picked at random (a double bridge move), which 2-opt
+  // and Or-opt can't easily undo
+  void Kick() {
+    uint32_t cuts[3];
+    std::uniform_int_distribution<uint32_t> cut(1, count_ - 1);
+    do {
+      for (auto& c : cuts) {
+        c = cut(random_generator_);
+      }
+      std::sort(std::begin(cuts), std::end(cuts));
+    } while (cuts[0] == cuts[1] || cuts[1] == cuts[2]);
+    std::rotate(tour_.begin() + cuts[0], tour_.begin() + cuts[1], tour_.begin() + cuts[2]);
+    Update();
+  }
+
+  // makes moves until none improves the tour
+  void Improve() {
+    bool improved = true;
+    while (improved) {
+      improved = TwoOpt();
+      improved = OrOpt() || improved;
+    }
+  }
+
+  // cost change of reversing the locations between tour indexes start and end
+  float ReverseDelta(const uint32_t start, const uint32_t end) const {
+    return Cost(tour_[start - 1], tour_[end]) + Cost(tour_[start], tour_[end + 1]) -
+           Cost(tour_[start - 1], tour_[start]) - Cost(tour_[end], tour_[end + 1]) +
+           (backward_[end] - backward_[start]) - (forward_[end] - forward_[start]);
+  }
+
+  // reverses a stretch of the tour so that a location connects to one of its neighbors
+  bool TwoOpt() {
+    bool improved = false;
+    for (uint32_t loc = 0; loc < count_; ++loc) {
+      for (auto neighbor : neighbors_[loc]) {
+        auto i = std::min(position_[loc], position_[neighbor]);
+        auto j = std::max(position_[loc], position_[neighbor]);
+        // either the stretch after the earlier one or before the later one is reversed
+        for (auto range : {std::make_pair(i + 1, j), std::make_pair(i, j - 1)}) {
+          if (range.first == 0 || range.first >= range.second || range.second + 1 >= count_) {
+            continue;
+          }
+          if (ReverseDelta(range.first, range.second) < -kMinImprovement) {
+            std::reverse(tour_.begin() + range.first, tour_.begin() + range.second + 1);
+            Update();
+            improved = true;
+            break;
+          }
+        }
+      }
+    }
+    return improved;
+  }
+
+  // moves a short run of locations, possibly reversed, next to a neighbor of either of its ends
+  bool OrOpt() {
+    bool improved = false;
+    for (uint32_t start = 1; start + 1 < count_; ++start) {
+      for (uint32_t end = start; end < start + kMaxSegment && end + 1 < count_; ++end) {
+        if (MoveSegment(start, end)) {
+          improved = true;
+          break;
+        }
+      }
+    }
+    return improved;
+  }
+
+  // moves the run of locations between tour indexes start and end if that improves the tour
+  bool MoveSegment(const uint32_t start, const uint32_t end) {
+    const float removed = Cost(tour_[start - 1], tour_[start]) + Cost(tour_[end], tour_[end + 1]) -
+                          Cost(tour_[start - 1], tour_[end + 1]);
+    const float reversal = (backward_[end] - backward_[start]) - (forward_[end] - forward_[start]);
+    for (auto loc : {tour_[start], tour_[end]}) {
+      for (auto neighbor : neighbors_[loc]) {
+        // the run goes in between the neighbor and the location before or after it
+        auto p = position_[neighbor];
+        for (auto at : {p, p - 1}) {
+          if (p == 0 && at == p - 1) {
+            continue;
+          }
+          if (at + 1 >= count_ || (at + 1 >= start && at <= end)) {
+            continue;
+          }
+          const float broken = Cost(tour_[at], tour_[at + 1]) + removed;
+          const float forward = Cost(tour_[at], tour_[start]) + Cost(tour_[end], tour_[at + 1]);
+          const float backward =
+              Cost(tour_[at], tour_[end]) + Cost(tour_[start], tour_[at + 1]) + reversal;
+          bool reverse = backward < forward;
+          if (std::min(forward, backward) - broken >= -kMinImprovement) {
+            continue;
+          }
+
+          // the run ends up right after the location at index at
+          uint32_t first;
+          if (at < start) {
+            std::rotate(tour_.begin() + at + 1, tour_.begin() + start, tour_.begin() + end + 1);
+            first = at + 1;
+          } else {
+            std::rotate(tour_.begin() + start, tour_.begin() + end + 1, tour_.begin() + at + 1);
+            first = at + start - end;
+          }
+          if (reverse) {
+            std::reverse(tour_.begin() + first, tour_.begin() + first + end - start + 1);
+          }
+          Update();
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+};
+
+} // namespace
+
 namespace valhalla {
 namespace thor {
 
@@ -178,5 +475,75 @@ float Optimizer::TourCost(const std::vector<float>& costs, const std::vector<uin
   return c;
 }
 
+// Optimize the tour with several local searches that each restart at random until they stop
+// finding better tours or have made enough kicks, or the time budget is spent.
+std::vector<uint32_t> LocalSearchOptimizer::Solve(const uint32_t count,
+                                                  const std::vector<float>& costs) const {
+  // Handle trivial cases.
+  if (count <= 3) {
+    std::vector<uint32_t> tour(count);
+    std::iota(tour.begin(), tour.end(), 0);
+    return tour;
+  } else if (count == 4) {
+    // Only one possible way to alter the path.
+    std::vector<uint32_t> tour1 = {0, 1, 2, 3};
+    std::vector<uint32_t> tour2 = {0, 2, 1, 3};
+    return (TourCost(count, costs, tour1) < TourCost(count, costs, tour2)) ? tour1 : tour2;
+  }
+
+  // The moves only try to connect each location to the ones nearest to it in either direction
+  std::vector<std::vector<uint32_t>> neighbors(count);
+  for (uint32_t loc = 0; loc < count; ++loc) {
+    auto& nearest = neighbors[loc];
+    for (uint32_t other = 0; other < count; ++other) {
+      if (other != loc) {
+        nearest.push_back(other);
+      }
+    }
+    auto closeness = [&costs, count, loc](const uint32_t other) {
+      return std::min(costs[loc * count + other], costs[other * count + loc]);
+    };
+    auto n = std::min<size_t>(kNeighbors, nearest.size());
+    std::partial_sort(nearest.begin(), nearest.begin() + n, nearest.end(),
+                      [&closeness](const uint32_t a, const uint32_t b) {
+                        return closeness(a) < closeness(b);
+                      });
+    nearest.resize(n);
+  }
+
+  // The first search starts from the greedy tour and the others from random ones
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(time_budget_);
+  std::vector<std::vector<uint32_t>> tours(concurrency_);
+  auto search = [&](const uint32_t i) {
+    tours[i] = TourSearch(count, costs, neighbors, seed_ + i).Run(deadline, i == 0);
+  };
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < concurrency_; ++i) {
+    threads.emplace_back(search, i);
+  }
+  search(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Return the best tour
+  auto best = std::min_element(tours.begin(), tours.end(), [&](const auto& a, const auto& b) {
+    return TourCost(count, costs, a) < TourCost(count, costs, b);
+  });
+  LOG_DEBUG("Best tour cost = " + std::to_string(TourCost(count, costs, *best)));
+  return *best;
+}
+
+// Get the cost for the specified tour (order of locations).
+float LocalSearchOptimizer::TourCost(const uint32_t count,
+                                     const std::vector<float>& costs,
+                                     const std::vector<uint32_t>& tour) {
+  float c = 0;
+  for (uint32_t i = 0; i + 1 < count; i++) {
+    c += costs[(tour[i] * count) + tour[i + 1]];
+  }
+  return c;
+}
+
 } // namespace thor
 } // namespace valhalla
@@ -1,5 +1,7 @@
 #include "thor/worker.h"
+#include <atomic>
 #include <cstdint>
+#include <functional>
 
 #include "baldr/attributes_controller.h"
 #include "baldr/datetime.h"
@@ -351,6 +353,81 @@ std::vector<std::vector<thor::PathInfo>> thor_worker_t::get_path(PathAlgorithm*
   return paths;
 }
 
+std::vector<std::vector<std::vector<thor::PathInfo>>>
+thor_worker_t::get_leg_paths(const Api& api,
+                             google::protobuf::RepeatedPtrField<valhalla::Location>& locations,
+                             const std::string& costing) {
+  // legs are only independent of one another if no time information or u-turn avoidance needs to
+  // flow from one leg into the next and if the algorithm doesnt need anything beyond the graph
+  std::vector<std::vector<std::vector<thor::PathInfo>>> leg_paths;
+  if (max_leg_concurrency < 2 || locations.size() < 3 || costing == "multimodal" ||
+      costing == "transit" || costing == "bikeshare") {
+    return leg_paths;
+  }
+  for (const auto& location : locations) {
+    if (!location.date_time().empty() || is_through_point(location)) {
+      return leg_paths;
+    }
+  }
+
+  // each worker has its own reader, costing and path algorithms so they dont share any state
+  const size_t leg_count = locations.size() - 1;
+  const size_t concurrency = std::min(max_leg_concurrency, leg_count);
+
+  // the second pass of a leg modifies its locations, so every leg works on its own copy
+  leg_paths.resize(leg_count);
+  std::vector<std::pair<valhalla::Location, valhalla::Location>> leg_locations;
+  leg_locations.reserve(leg_count);
+  for (size_t leg = 0; leg < leg_count; ++leg) {
+    leg_locations.emplace_back(locations.Get(leg), locations.Get(leg + 1));
+  }
+
+  std::atomic<size_t> next_leg(0);
+  std::function<void(thor_worker_t&)> route_legs = [&](thor_worker_t& worker) {
+    try {
+      worker.parse_costing(api);
+    } catch (const std::exception& e) {
+      LOG_WARN(std::string("Failed to prepare concurrent leg costing: ") + e.what());
+      return;
+    }
+    for (size_t leg = next_leg++; leg < leg_count; leg = next_leg++) {
+      auto& origin = leg_locations[leg].first;
+      auto& destination = leg_locations[leg].second;
+      try {
+        auto* path_algorithm = worker.get_path_algorithm(costing, origin, destination, api.options());
+        path_algorithm->Clear();
+        leg_paths[leg] = worker.get_path(path_algorithm, origin, destination, costing, api.options());
+      } catch (const std::exception& e) {
+        // we'll just redo it serially and let it fail there if it has to
+        LOG_WARN(std::string("Failed to compute leg concurrently: ") + e.what());
+        leg_paths[leg].clear();
+      }
+    }
+  };
+  // an interrupted leg looks like any other failed one, so rather than redoing it serially we let
+  // the interrupt throw here if thats why it failed
+  run_aux_workers(concurrency, route_legs);
+
+  // a leg which needed the second pass widened the candidates of its locations. serially the legs
+  // after it would have seen those so we keep the widened locations but redo those legs
+  bool widened = false;
+  for (size_t leg = 0; leg < leg_count; ++leg) {
+    if (widened) {
+      leg_paths[leg].clear();
+      continue;
+    }
+    for (auto* location : {&leg_locations[leg].first, &leg_locations[leg].second}) {
+      auto& correlated = *locations.Mutable(location == &leg_locations[leg].first ? leg : leg + 1);
+      if (location->correlation().edges_size() != correlated.correlation().edges_size()) {
+        *correlated.mutable_correlation() = location->correlation();
+        widened = true;
+      }
+    }
+  }
+
+  return leg_paths;
+}
+
 void thor_worker_t::path_arrive_by(Api& api, const std::string& costing) {
   // Things we'll need
   TripRoute* route = nullptr;
@@ -548,6 +625,8 @@ void thor_worker_t::path_depart_at(Api& api, const std::string& costing) {
   trip.mutable_routes()->Reserve(options.alternates() + 1);
 
   graph_tile_ptr tile = nullptr;
+  size_t leg = 0;
+  std::vector<std::vector<std::vector<thor::PathInfo>>> leg_paths;
   auto route_two_locations = [&, this](auto& origin, auto& destination) -> bool {
     // Get the algorithm type for this location pair
     thor::PathAlgorithm* path_algorithm =
@@ -562,8 +641,11 @@ void thor_worker_t::path_depart_at(Api& api, const std::string& costing) {
       remove_path_edges(*origin,
                         [&last_edge](const auto& edge) { return edge.graph_id() != last_edge; });
     }
-    // Get best path and keep it
-    auto temp_paths = this->get_path(path_algorithm, *origin, *destination, costing, options);
+    // Get best path and keep it, unless we already computed it concurrently
+    auto temp_paths =
+        leg < leg_paths.size() && !leg_paths[leg].empty()
+            ? std::move(leg_paths[leg])
+            : this->get_path(path_algorithm, *origin, *destination, costing, options);
     if (temp_paths.empty())
       return false;
 
@@ -650,11 +732,13 @@ void thor_worker_t::path_depart_at(Api& api, const std::string& costing) {
 
   auto correlated = options.locations();
   bool allow_retry = true;
+  leg_paths = get_leg_paths(api, correlated, costing);
 
   // For each pair of locations
   auto destination = ++correlated.begin();
   while (destination != correlated.end()) {
     auto origin = std::prev(destination);
+    leg = std::distance(correlated.begin(), origin);
     if (!route_two_locations(origin, destination)) {
       // if routing failed because an intermediate waypoint was snapped to the low reachability road
       // (such road lies in a small connectivity component that is not connected to other locations)
@@ -680,6 +764,7 @@ void thor_worker_t::path_depart_at(Api& api, const std::string& costing) {
         edge_trimming.clear();
         path.clear();
         algorithms.clear();
+        leg_paths.clear();
         trip.mutable_routes()->Clear();
         destination = ++correlated.begin();
         continue;
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <cmath>
 #include <cstdint>
 #include <string>
@@ -40,6 +42,262 @@ constexpr uint8_t kNotTagged = 0;
 constexpr uint8_t kTunnelTag = static_cast<uint8_t>(baldr::TaggedValue::kTunnel);
 constexpr uint8_t kBridgeTag = static_cast<uint8_t>(baldr::TaggedValue::kBridge);
 
+// The attributes the builder asks about, once per edge, intersecting edge or shape point. Asking
+// the controller hashes the key and asking about a category walks all of its keys, so the builder
+// evaluates them all into a bitmask once per leg instead
+enum class LegAttribute : uint8_t {
+  kEdgeNames,
+  kEdgeLength,
+  kEdgeSpeed,
+  kEdgeRoadClass,
+  kEdgeBeginHeading,
+  kEdgeEndHeading,
+  kEdgeBeginShapeIndex,
+  kEdgeEndShapeIndex,
+  kEdgeTraversability,
+  kEdgeUse,
+  kEdgeToll,
+  kEdgeUnpaved,
+  kEdgeTunnel,
+  kEdgeBridge,
+  kEdgeRoundabout,
+  kEdgeInternalIntersection,
+  kEdgeDriveOnRight,
+  kEdgeSurface,
+  kEdgeSignExitNumber,
+  kEdgeSignExitBranch,
+  kEdgeSignExitToward,
+  kEdgeSignExitName,
+  kEdgeSignGuideBranch,
+  kEdgeSignGuideToward,
+  kEdgeSignJunctionName,
+  kEdgeSignGuidanceViewJunction,
+  kEdgeSignGuidanceViewSignboard,
+  kEdgeTravelMode,
+  kEdgeVehicleType,
+  kEdgePedestrianType,
+  kEdgeBicycleType,
+  kEdgeTransitType,
+  kEdgeTransitRouteInfoOnestopId,
+  kEdgeTransitRouteInfoBlockId,
+  kEdgeTransitRouteInfoTripId,
+  kEdgeTransitRouteInfoShortName,
+  kEdgeTransitRouteInfoLongName,
+  kEdgeTransitRouteInfoHeadsign,
+  kEdgeTransitRouteInfoColor,
+  kEdgeTransitRouteInfoTextColor,
+  kEdgeTransitRouteInfoDescription,
+  kEdgeTransitRouteInfoOperatorOnestopId,
+  kEdgeTransitRouteInfoOperatorName,
+  kEdgeTransitRouteInfoOperatorUrl,
+  kEdgeId,
+  kEdgeWayId,
+  kEdgeWeightedGrade,
+  kEdgeMaxUpwardGrade,
+  kEdgeMaxDownwardGrade,
+  kEdgeMeanElevation,
+  kEdgeElevation,
+  kEdgeLaneCount,
+  kEdgeLaneConnectivity,
+  kEdgeCycleLane,
+  kEdgeBicycleNetwork,
+  kEdgeSacScale,
+  kEdgeShoulder,
+  kEdgeSidewalk,
+  kEdgeDensity,
+  kEdgeSpeedLimit,
+  kEdgeConditionalSpeedLimits,
+  kEdgeTruckSpeed,
+  kEdgeTruckRoute,
+  kEdgeDefaultSpeed,
+  kEdgeDestinationOnly,
+  kEdgeIsUrban,
+  kEdgeTaggedValues,
+  kEdgeIndoor,
+  kEdgeLandmarks,
+  kEdgeCountryCrossing,
+  kEdgeForward,
+  kEdgeLevels,
+  kNodeIntersectingEdgeBeginHeading,
+  kNodeIntersectingEdgeFromEdgeNameConsistency,
+  kNodeIntersectingEdgeToEdgeNameConsistency,
+  kNodeIntersectingEdgeDriveability,
+  kNodeIntersectingEdgeCyclability,
+  kNodeIntersectingEdgeWalkability,
+  kNodeIntersectingEdgeUse,
+  kNodeIntersectingEdgeRoadClass,
+  kNodeIntersectingEdgeLaneCount,
+  kNodeIntersectingEdgeSignInfo,
+  kNodeElapsedTime,
+  kNodeAdminIndex,
+  kNodeType,
+  kNodeFork,
+  kNodeTimeZone,
+  kNodeTransitionTime,
+  kOsmChangeset,
+  kAdminCountryCode,
+  kAdminCountryText,
+  kAdminStateCode,
+  kAdminStateText,
+  kShape,
+  kIncidents,
+  kShapeAttributesTime,
+  kShapeAttributesLength,
+  kShapeAttributesSpeed,
+  kShapeAttributesSpeedLimit,
+  kShapeAttributesClosure,
+  kAdminCategory,
+  kShapeAttributesCategory,
+  kCount
+};
+
+// The key of each attribute, in the order of the enum so that an attribute is its own index. The
+// categories are enabled when any of the keys under them is
+struct LegAttributeKey {
+  LegAttribute attribute;
+  const std::string* key;
+  bool category;
+};
+
+constexpr std::array<LegAttributeKey, static_cast<size_t>(LegAttribute::kCount)> kLegAttributeKeys{{
+    {LegAttribute::kEdgeNames, &kEdgeNames, false},
+    {LegAttribute::kEdgeLength, &kEdgeLength, false},
+    {LegAttribute::kEdgeSpeed, &kEdgeSpeed, false},
+    {LegAttribute::kEdgeRoadClass, &kEdgeRoadClass, false},
+    {LegAttribute::kEdgeBeginHeading, &kEdgeBeginHeading, false},
+    {LegAttribute::kEdgeEndHeading, &kEdgeEndHeading, false},
+    {LegAttribute::kEdgeBeginShapeIndex, &kEdgeBeginShapeIndex, false},
+    {LegAttribute::kEdgeEndShapeIndex, &kEdgeEndShapeIndex, false},
+    {LegAttribute::kEdgeTraversability, &kEdgeTraversability, false},
+    {LegAttribute::kEdgeUse, &kEdgeUse, false},
+    {LegAttribute::kEdgeToll, &kEdgeToll, false},
+    {LegAttribute::kEdgeUnpaved, &kEdgeUnpaved, false},
+    {LegAttribute::kEdgeTunnel, &kEdgeTunnel, false},
+    {LegAttribute::kEdgeBridge, &kEdgeBridge, false},
+    {LegAttribute::kEdgeRoundabout, &kEdgeRoundabout, false},
+    {LegAttribute::kEdgeInternalIntersection, &kEdgeInternalIntersection, false},
+    {LegAttribute::kEdgeDriveOnRight, &kEdgeDriveOnRight, false},
+    {LegAttribute::kEdgeSurface, &kEdgeSurface, false},
+    {LegAttribute::kEdgeSignExitNumber, &kEdgeSignExitNumber, false},
+    {LegAttribute::kEdgeSignExitBranch, &kEdgeSignExitBranch, false},
+    {LegAttribute::kEdgeSignExitToward, &kEdgeSignExitToward, false},
+    {LegAttribute::kEdgeSignExitName, &kEdgeSignExitName, false},
+    {LegAttribute::kEdgeSignGuideBranch, &kEdgeSignGuideBranch, false},
+    {LegAttribute::kEdgeSignGuideToward, &kEdgeSignGuideToward, false},
+    {LegAttribute::kEdgeSignJunctionName, &kEdgeSignJunctionName, false},
+    {LegAttribute::kEdgeSignGuidanceViewJunction, &kEdgeSignGuidanceViewJunction, false},
+    {LegAttribute::kEdgeSignGuidanceViewSignboard, &kEdgeSignGuidanceViewSignboard, false},
+    {LegAttribute::kEdgeTravelMode, &kEdgeTravelMode, false},
+    {LegAttribute::kEdgeVehicleType, &kEdgeVehicleType, false},
+    {LegAttribute::kEdgePedestrianType, &kEdgePedestrianType, false},
+    {LegAttribute::kEdgeBicycleType, &kEdgeBicycleType, false},
+    {LegAttribute::kEdgeTransitType, &kEdgeTransitType, false},
+    {LegAttribute::kEdgeTransitRouteInfoOnestopId, &kEdgeTransitRouteInfoOnestopId, false},
+    {LegAttribute::kEdgeTransitRouteInfoBlockId, &kEdgeTransitRouteInfoBlockId, false},
+    {LegAttribute::kEdgeTransitRouteInfoTripId, &kEdgeTransitRouteInfoTripId, false},
+    {LegAttribute::kEdgeTransitRouteInfoShortName, &kEdgeTransitRouteInfoShortName, false},
+    {LegAttribute::kEdgeTransitRouteInfoLongName, &kEdgeTransitRouteInfoLongName, false},
+    {LegAttribute::kEdgeTransitRouteInfoHeadsign, &kEdgeTransitRouteInfoHeadsign, false},
+    {LegAttribute::kEdgeTransitRouteInfoColor, &kEdgeTransitRouteInfoColor, false},
+    {LegAttribute::kEdgeTransitRouteInfoTextColor, &kEdgeTransitRouteInfoTextColor, false},
+    {LegAttribute::kEdgeTransitRouteInfoDescription, &kEdgeTransitRouteInfoDescription, false},
+    {LegAttribute::kEdgeTransitRouteInfoOperatorOnestopId, &kEdgeTransitRouteInfoOperatorOnestopId,
+     false},
+    {LegAttribute::kEdgeTransitRouteInfoOperatorName, &kEdgeTransitRouteInfoOperatorName, false},
+    {LegAttribute::kEdgeTransitRouteInfoOperatorUrl, &kEdgeTransitRouteInfoOperatorUrl, false},
+    {LegAttribute::kEdgeId, &kEdgeId, false},
+    {LegAttribute::kEdgeWayId, &kEdgeWayId, false},
+    {LegAttribute::kEdgeWeightedGrade, &kEdgeWeightedGrade, false},
+    {LegAttribute::kEdgeMaxUpwardGrade, &kEdgeMaxUpwardGrade, false},
+    {LegAttribute::kEdgeMaxDownwardGrade, &kEdgeMaxDownwardGrade, false},
+    {LegAttribute::kEdgeMeanElevation, &kEdgeMeanElevation, false},
+    {LegAttribute::kEdgeElevation, &kEdgeElevation, false},
+    {LegAttribute::kEdgeLaneCount, &kEdgeLaneCount, false},
+    {LegAttribute::kEdgeLaneConnectivity, &kEdgeLaneConnectivity, false},
+    {LegAttribute::kEdgeCycleLane, &kEdgeCycleLane, false},
+    {LegAttribute::kEdgeBicycleNetwork, &kEdgeBicycleNetwork, false},
+    {LegAttribute::kEdgeSacScale, &kEdgeSacScale, false},
+    {LegAttribute::kEdgeShoulder, &kEdgeShoulder, false},
+    {LegAttribute::kEdgeSidewalk, &kEdgeSidewalk, false},
+    {LegAttribute::kEdgeDensity, &kEdgeDensity, false},
+    {LegAttribute::kEdgeSpeedLimit, &kEdgeSpeedLimit, false},
+    {LegAttribute::kEdgeConditionalSpeedLimits, &kEdgeConditionalSpeedLimits, false},
+    {LegAttribute::kEdgeTruckSpeed, &kEdgeTruckSpeed, false},
+    {LegAttribute::kEdgeTruckRoute, &kEdgeTruckRoute, false},
+    {LegAttribute::kEdgeDefaultSpeed, &kEdgeDefaultSpeed, false},
+    {LegAttribute::kEdgeDestinationOnly, &kEdgeDestinationOnly, false},
+    {LegAttribute::kEdgeIsUrban, &kEdgeIsUrban, false},
+    {LegAttribute::kEdgeTaggedValues, &kEdgeTaggedValues, false},
+    {LegAttribute::kEdgeIndoor, &kEdgeIndoor, false},
+    {LegAttribute::kEdgeLandmarks, &kEdgeLandmarks, false},
+    {LegAttribute::kEdgeCountryCrossing, &kEdgeCountryCrossing, false},
+    {LegAttribute::kEdgeForward, &kEdgeForward, false},
+    {LegAttribute::kEdgeLevels, &kEdgeLevels, false},
+    {LegAttribute::kNodeIntersectingEdgeBeginHeading, &kNodeIntersectingEdgeBeginHeading, false},
+    {LegAttribute::kNodeIntersectingEdgeFromEdgeNameConsistency,
+     &kNodeIntersectingEdgeFromEdgeNameConsistency, false},
+    {LegAttribute::kNodeIntersectingEdgeToEdgeNameConsistency,
+     &kNodeIntersectingEdgeToEdgeNameConsistency, false},
+    {LegAttribute::kNodeIntersectingEdgeDriveability, &kNodeIntersectingEdgeDriveability, false},
+    {LegAttribute::kNodeIntersectingEdgeCyclability, &kNodeIntersectingEdgeCyclability, false},
+    {LegAttribute::kNodeIntersectingEdgeWalkability, &kNodeIntersectingEdgeWalkability, false},
+    {LegAttribute::kNodeIntersectingEdgeUse, &kNodeIntersectingEdgeUse, false},
+    {LegAttribute::kNodeIntersectingEdgeRoadClass, &kNodeIntersectingEdgeRoadClass, false},
+    {LegAttribute::kNodeIntersectingEdgeLaneCount, &kNodeIntersectingEdgeLaneCount, false},
+    {LegAttribute::kNodeIntersectingEdgeSignInfo, &kNodeIntersectingEdgeSignInfo, false},
+    {LegAttribute::kNodeElapsedTime, &kNodeElapsedTime, false},
+    {LegAttribute::kNodeAdminIndex, &kNodeAdminIndex, false},
+    {LegAttribute::kNodeType, &kNodeType, false},
+    {LegAttribute::kNodeFork, &kNodeFork, false},
+    {LegAttribute::kNodeTimeZone, &kNodeTimeZone, false},
+    {LegAttribute::kNodeTransitionTime, &kNodeTransitionTime, false},
+    {LegAttribute::kOsmChangeset, &kOsmChangeset, false},
+    {LegAttribute::kAdminCountryCode, &kAdminCountryCode, false},
+    {LegAttribute::kAdminCountryText, &kAdminCountryText, false},
+    {LegAttribute::kAdminStateCode, &kAdminStateCode, false},
+    {LegAttribute::kAdminStateText, &kAdminStateText, false},
+    {LegAttribute::kShape, &kShape, false},
+    {LegAttribute::kIncidents, &kIncidents, false},
+    {LegAttribute::kShapeAttributesTime, &kShapeAttributesTime, false},
+    {LegAttribute::kShapeAttributesLength, &kShapeAttributesLength, false},
+    {LegAttribute::kShapeAttributesSpeed, &kShapeAttributesSpeed, false},
+    {LegAttribute::kShapeAttributesSpeedLimit, &kShapeAttributesSpeedLimit, false},
+    {LegAttribute::kShapeAttributesClosure, &kShapeAttributesClosure, false},
+    {LegAttribute::kAdminCategory, &kAdminCategory, true},
+    {LegAttribute::kShapeAttributesCategory, &kShapeAttributesCategory, true},
+}};
+
+// an attribute added to the enum but not to the table, which leaves a default entry at the end,
+// or one out of its order fails to compile
+static_assert(kLegAttributeKeys.size() == static_cast<size_t>(LegAttribute::kCount));
+constexpr bool InEnumOrder() {
+  for (size_t i = 0; i < kLegAttributeKeys.size(); ++i) {
+    if (static_cast<size_t>(kLegAttributeKeys[i].attribute) != i) {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(InEnumOrder());
+
+class LegAttributeMask {
+public:
+  explicit LegAttributeMask(const AttributesController& controller) {
+    for (const auto& attribute : kLegAttributeKeys) {
+      mask_.set(static_cast<size_t>(attribute.attribute),
+                attribute.category ? controller.category_attribute_enabled(*attribute.key)
+                                   : controller(*attribute.key));
+    }
+  }
+
+  bool operator()(const LegAttribute attribute) const {
+    return mask_.test(static_cast<size_t>(attribute));
+  }
+
+private:
+  std::bitset<static_cast<size_t>(LegAttribute::kCount)> mask_;
+};
+
 uint32_t
 GetAdminIndex(const AdminInfo& admin_info,
               std::unordered_map<AdminInfo, uint32_t, AdminInfo::AdminInfoHasher>& admin_info_map,
@@ -66,32 +324,32 @@ GetAdminIndex(const AdminInfo& admin_info,
   return admin_index;
 }
 
-void AssignAdmins(const AttributesController& controller,
+void AssignAdmins(const LegAttributeMask& controller,
                   TripLeg& trip_path,
                   const std::vector<AdminInfo>& admin_info_list) {
-  if (controller.category_attribute_enabled(kAdminCategory)) {
+  if (controller(LegAttribute::kAdminCategory)) {
     // Assign the admins
     trip_path.mutable_admin()->Reserve(admin_info_list.size());
     for (const auto& admin_info : admin_info_list) {
       TripLeg_Admin* trip_admin = trip_path.add_admin();
 
       // Set country code if requested
-      if (controller(kAdminCountryCode)) {
+      if (controller(LegAttribute::kAdminCountryCode)) {
         trip_admin->set_country_code(admin_info.country_iso());
       }
 
       // Set country text if requested
-      if (controller(kAdminCountryText)) {
+      if (controller(LegAttribute::kAdminCountryText)) {
         trip_admin->set_country_text(admin_info.country_text());
       }
 
       // Set state code if requested
-      if (controller(kAdminStateCode)) {
+      if (controller(LegAttribute::kAdminStateCode)) {
         trip_admin->set_state_code(admin_info.state_iso());
       }
 
       // Set state text if requested
-      if (controller(kAdminStateText)) {
+      if (controller(LegAttribute::kAdminStateText)) {
         trip_admin->set_state_text(admin_info.state_text());
       }
     }
@@ -169,7 +427,9 @@ valhalla::TripLeg_Closure* fetch_or_create_closure_annotation(TripLeg& leg) {
  * such as time, distance, speed. Also updates the incidents list on the edge with their shape indices
  * @param controller
  * @param tile
+ * @param end_node_tile
  * @param edge
+ * @param edgeinfo
  * @param shape
  * @param shape_begin
  * @param leg
@@ -179,10 +439,11 @@ valhalla::TripLeg_Closure* fetch_or_create_closure_annotation(TripLeg& leg) {
  * @param cut_for_traffic
  * @param incidents
  */
-void SetShapeAttributes(const AttributesController& controller,
+void SetShapeAttributes(const LegAttributeMask& controller,
                         const graph_tile_ptr& tile,
                         const graph_tile_ptr& end_node_tile,
                         const DirectedEdge* edge,
+                        const EdgeInfo& edgeinfo,
                         std::vector<PointLL>& shape,
                         size_t shape_begin,
                         TripLeg& leg,
@@ -195,13 +456,13 @@ void SetShapeAttributes(const AttributesController& controller,
 
   // bail if nothing to do
   if (!cut_for_traffic && incidents.start_index == incidents.end_index &&
-      !controller.category_attribute_enabled(kShapeAttributesCategory)) {
+      !controller(LegAttribute::kShapeAttributesCategory)) {
     return;
   }
 
   // initialize shape_attributes once
   if (!leg.has_shape_attributes() &&
-      controller.category_attribute_enabled(kShapeAttributesCategory)) {
+      controller(LegAttribute::kShapeAttributesCategory)) {
     leg.mutable_shape_attributes();
   }
 
@@ -293,7 +554,6 @@ void SetShapeAttributes(const AttributesController& controller,
   }
 
   // Find the first cut to the right of where we start on this edge
-  auto edgeinfo = tile->edgeinfo(edge);
   double distance_total_pct = src_pct;
   auto cut_itr = std::find_if(cuts.cbegin(), cuts.cend(),
                               [distance_total_pct](const decltype(cuts)::value_type& s) {
@@ -301,22 +561,23 @@ void SetShapeAttributes(const AttributesController& controller,
                               });
   assert(cut_itr != cuts.cend());
 
-  // reservations
-  if (controller(kShapeAttributesTime)) {
+  // reservations, for the points of this edge and the ones the cuts may add
+  const auto added = shape.size() - shape_begin + cuts.size();
+  if (controller(LegAttribute::kShapeAttributesTime)) {
     leg.mutable_shape_attributes()->mutable_time()->Reserve(leg.shape_attributes().time_size() +
-                                                            shape.size() + cuts.size());
+                                                            added);
   }
-  if (controller(kShapeAttributesLength)) {
+  if (controller(LegAttribute::kShapeAttributesLength)) {
     leg.mutable_shape_attributes()->mutable_length()->Reserve(leg.shape_attributes().length_size() +
-                                                              shape.size() + cuts.size());
+                                                              added);
   }
-  if (controller(kShapeAttributesSpeed)) {
+  if (controller(LegAttribute::kShapeAttributesSpeed)) {
     leg.mutable_shape_attributes()->mutable_speed()->Reserve(leg.shape_attributes().speed_size() +
-                                                             shape.size() + cuts.size());
+                                                             added);
   }
-  if (controller(kShapeAttributesSpeedLimit)) {
+  if (controller(LegAttribute::kShapeAttributesSpeedLimit)) {
     leg.mutable_shape_attributes()->mutable_speed_limit()->Reserve(
-        leg.shape_attributes().speed_limit_size() + shape.size() + cuts.size());
+        leg.shape_attributes().speed_limit_size() + added);
   }
 
   // Set the shape attributes
@@ -335,7 +596,7 @@ void SetShapeAttributes(const AttributesController& controller,
       distance *= coef;
       shift = 1;
     }
-    if (controller(kShapeAttributesClosure)) {
+    if (controller(LegAttribute::kShapeAttributesClosure)) {
       // Process closure annotations
       if (cut_itr->closed) {
         // Found a closure. Fetch a new annotation, or the last closure
@@ -361,19 +622,19 @@ void SetShapeAttributes(const AttributesController& controller,
     }
 
     // Set shape attributes time per shape point if requested
-    if (controller(kShapeAttributesTime)) {
+    if (controller(LegAttribute::kShapeAttributesTime)) {
       // convert time to milliseconds and then round to an integer
       leg.mutable_shape_attributes()->add_time((time * kMillisecondPerSec) + 0.5);
     }
 
     // Set shape attributes length per shape point if requested
-    if (controller(kShapeAttributesLength)) {
+    if (controller(LegAttribute::kShapeAttributesLength)) {
       // convert length to decimeters and then round to an integer
       leg.mutable_shape_attributes()->add_length((distance * kDecimeterPerMeter) + 0.5);
     }
 
     // Set shape attributes speed per shape point if requested
-    if (controller(kShapeAttributesSpeed)) {
+    if (controller(LegAttribute::kShapeAttributesSpeed)) {
       // convert speed to decimeters per sec and then round to an integer
       double decimeters_sec = (distance * kDecimeterPerMeter / time) + 0.5;
       if (std::isnan(decimeters_sec) || time == 0.) { // avoid NaN
@@ -383,7 +644,7 @@ void SetShapeAttributes(const AttributesController& controller,
     }
 
     // Set the maxspeed if requested
-    if (controller(kShapeAttributesSpeedLimit)) {
+    if (controller(LegAttribute::kShapeAttributesSpeedLimit)) {
       leg.mutable_shape_attributes()->add_speed_limit(edgeinfo.speed_limit());
     }
 
@@ -471,17 +732,17 @@ void CopyLocations(TripLeg& trip_path,
  * @param  shape      Trip shape.
  */
 void SetHeadings(TripLeg_Edge* trip_edge,
-                 const AttributesController& controller,
+                 const LegAttributeMask& controller,
                  const DirectedEdge* edge,
                  const std::vector<PointLL>& shape,
                  const uint32_t begin_index) {
-  if (controller(kEdgeBeginHeading) || controller(kEdgeEndHeading)) {
+  if (controller(LegAttribute::kEdgeBeginHeading) || controller(LegAttribute::kEdgeEndHeading)) {
     float offset = GetOffsetForHeading(edge->classification(), edge->use());
-    if (controller(kEdgeBeginHeading)) {
+    if (controller(LegAttribute::kEdgeBeginHeading)) {
       trip_edge->set_begin_heading(
           std::round(PointLL::HeadingAlongPolyline(shape, offset, begin_index, shape.size() - 1)));
     }
-    if (controller(kEdgeEndHeading)) {
+    if (controller(LegAttribute::kEdgeEndHeading)) {
       trip_edge->set_end_heading(
           std::round(PointLL::HeadingAtEndOfPolyline(shape, offset, begin_index, shape.size() - 1)));
     }
@@ -499,11 +760,11 @@ void SetHeadings(TripLeg_Edge* trip_edge,
  */
 void AddLandmarks(const EdgeInfo& edgeinfo,
                   TripLeg_Edge* trip_edge,
-                  const AttributesController& controller,
+                  const LegAttributeMask& controller,
                   const DirectedEdge* edge,
                   const std::vector<PointLL>& shape,
                   const uint32_t begin_index) {
-  if (!controller(kEdgeLandmarks)) {
+  if (!controller(LegAttribute::kEdgeLandmarks)) {
     return;
   }
 
@@ -577,7 +838,7 @@ void PopulateSignElement(uint32_t sign_index,
 
 // Walk the edge_signs, add sign information onto the trip_sign, honoring which to
 // add per the attributes-controller.
-void AddSignInfo(const AttributesController& controller,
+void AddSignInfo(const LegAttributeMask& controller,
                  const std::vector<SignInfo>& edge_signs,
                  const LinguisticMap& linguistics,
                  valhalla::TripSign* trip_sign) {
@@ -587,56 +848,56 @@ void AddSignInfo(const AttributesController& controller,
     for (const auto& sign : edge_signs) {
       switch (sign.type()) {
         case valhalla::baldr::Sign::Type::kExitNumber: {
-          if (controller.attributes.at(kEdgeSignExitNumber)) {
+          if (controller(LegAttribute::kEdgeSignExitNumber)) {
             PopulateSignElement(sign_index, sign, linguistics,
                                 trip_sign->mutable_exit_numbers()->Add());
           }
           break;
         }
         case valhalla::baldr::Sign::Type::kExitBranch: {
-          if (controller.attributes.at(kEdgeSignExitBranch)) {
+          if (controller(LegAttribute::kEdgeSignExitBranch)) {
             PopulateSignElement(sign_index, sign, linguistics,
                                 trip_sign->mutable_exit_onto_streets()->Add());
           }
           break;
         }
         case valhalla::baldr::Sign::Type::kExitToward: {
-          if (controller.attributes.at(kEdgeSignExitToward)) {
+          if (controller(LegAttribute::kEdgeSignExitToward)) {
             PopulateSignElement(sign_index, sign, linguistics,
                                 trip_sign->mutable_exit_toward_locations()->Add());
           }
           break;
         }
         case valhalla::baldr::Sign::Type::kExitName: {
-          if (controller.attributes.at(kEdgeSignExitName)) {
+          if (controller(LegAttribute::kEdgeSignExitName)) {
             PopulateSignElement(sign_index, sign, linguistics,
                                 trip_sign->mutable_exit_names()->Add());
           }
           break;
         }
         case valhalla::baldr::Sign::Type::kGuideBranch: {
-          if (controller.attributes.at(kEdgeSignGuideBranch)) {
+          if (controller(LegAttribute::kEdgeSignGuideBranch)) {
             PopulateSignElement(sign_index, sign, linguistics,
                                 trip_sign->mutable_guide_onto_streets()->Add());
           }
           break;
         }
         case valhalla::baldr::Sign::Type::kGuideToward: {
-          if (controller.attributes.at(kEdgeSignGuideToward)) {
+          if (controller(LegAttribute::kEdgeSignGuideToward)) {
             PopulateSignElement(sign_index, sign, linguistics,
                                 trip_sign->mutable_guide_toward_locations()->Add());
           }
           break;
         }
         case valhalla::baldr::Sign::Type::kGuidanceViewJunction: {
-          if (controller.attributes.at(kEdgeSignGuidanceViewJunction)) {
+          if (controller(LegAttribute::kEdgeSignGuidanceViewJunction)) {
             PopulateSignElement(sign_index, sign, linguistics,
                                 trip_sign->mutable_guidance_view_junctions()->Add());
           }
           break;
         }
         case valhalla::baldr::Sign::Type::kGuidanceViewSignboard: {
-          if (controller.attributes.at(kEdgeSignGuidanceViewSignboard)) {
+          if (controller(LegAttribute::kEdgeSignGuidanceViewSignboard)) {
             PopulateSignElement(sign_index, sign, linguistics,
                                 trip_sign->mutable_guidance_view_signboards()->Add());
           }
@@ -681,8 +942,8 @@ void SetElevation(TripLeg_Edge* trip_edge,
                   const double end_pct,
                   const NodeInfo* start_node,
                   const DirectedEdge* edge,
-                  const graph_tile_ptr& tile,
-                  GraphReader& graphreader) {
+                  const EdgeInfo& edgeinfo,
+                  const graph_tile_ptr& end_tile) {
 
   // Lambda to get elevation at specified distance
   double interval = 0.0;
@@ -702,12 +963,11 @@ void SetElevation(TripLeg_Edge* trip_edge,
   float h1 = start_node->elevation();
 
   // Get encoded elevation from EdgeInfo edge
-  auto encoded = tile->edgeinfo(edge).encoded_elevation(edge->length(), interval);
+  auto encoded = edgeinfo.encoded_elevation(edge->length(), interval);
 
   // Get the end node and its elevation (if end tile is null just set elevation at
   // the end node to be same as at start node - this should be rare)
   float h2 = h1;
-  auto end_tile = graphreader.GetGraphTile(edge->endnode());
   if (end_tile != nullptr) {
     h2 = end_tile->node(edge->endnode())->elevation();
   }
@@ -786,7 +1046,7 @@ void ProcessNonTaggedValue(valhalla::StreetName* trip_edge_name,
  * @param  intersecting_de Intersecting directed edge. Will be nullptr except when
  *                         on the local hierarchy.
  */
-void AddTripIntersectingEdge(const AttributesController& controller,
+void AddTripIntersectingEdge(const LegAttributeMask& controller,
                              const graph_tile_ptr& graphtile,
                              const DirectedEdge* directededge,
                              const DirectedEdge* prev_de,
@@ -798,7 +1058,7 @@ void AddTripIntersectingEdge(const AttributesController& controller,
   TripLeg_IntersectingEdge* intersecting_edge = trip_node->add_intersecting_edge();
 
   // Set the heading for the intersecting edge if requested
-  if (controller(kNodeIntersectingEdgeBeginHeading)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeBeginHeading)) {
     intersecting_edge->set_begin_heading(nodeinfo->heading(local_edge_index));
   }
 
@@ -814,7 +1074,7 @@ void AddTripIntersectingEdge(const AttributesController& controller,
                          : Traversability::kNone;
   }
   // Set the walkability flag for the intersecting edge if requested
-  if (controller(kNodeIntersectingEdgeWalkability)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeWalkability)) {
     intersecting_edge->set_walkability(GetTripLegTraversability(traversability));
   }
 
@@ -828,30 +1088,30 @@ void AddTripIntersectingEdge(const AttributesController& controller,
                                                                          : Traversability::kNone;
   }
   // Set the cyclability flag for the intersecting edge if requested
-  if (controller(kNodeIntersectingEdgeCyclability)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeCyclability)) {
     intersecting_edge->set_cyclability(GetTripLegTraversability(traversability));
   }
 
   // Set the driveability flag for the intersecting edge if requested
-  if (controller(kNodeIntersectingEdgeDriveability)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeDriveability)) {
     intersecting_edge->set_driveability(
         GetTripLegTraversability(nodeinfo->local_driveability(local_edge_index)));
   }
 
   // Set the previous/intersecting edge name consistency if requested
-  if (controller(kNodeIntersectingEdgeFromEdgeNameConsistency)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeFromEdgeNameConsistency)) {
     bool name_consistency =
         (prev_de == nullptr) ? false : prev_de->name_consistency(local_edge_index);
     intersecting_edge->set_prev_name_consistency(name_consistency);
   }
 
   // Set the current/intersecting edge name consistency if requested
-  if (controller(kNodeIntersectingEdgeToEdgeNameConsistency)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeToEdgeNameConsistency)) {
     intersecting_edge->set_curr_name_consistency(directededge->name_consistency(local_edge_index));
   }
 
   // Add names to edge if requested
-  if (controller.attributes.at(kEdgeNames)) {
+  if (controller(LegAttribute::kEdgeNames)) {
 
     auto edgeinfo = graphtile->edgeinfo(intersecting_de);
     auto names_and_types = edgeinfo.GetNamesAndTypes(true);
@@ -880,22 +1140,22 @@ void AddTripIntersectingEdge(const AttributesController& controller,
   }
 
   // Set the use for the intersecting edge if requested
-  if (controller(kNodeIntersectingEdgeUse)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeUse)) {
     intersecting_edge->set_use(GetTripLegUse(intersecting_de->use()));
   }
 
   // Set the road class for the intersecting edge if requested
-  if (controller(kNodeIntersectingEdgeRoadClass)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeRoadClass)) {
     intersecting_edge->set_road_class(GetRoadClass(intersecting_de->classification()));
   }
 
   // Set the lane count for the intersecting edge if requested
-  if (controller(kNodeIntersectingEdgeLaneCount)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeLaneCount)) {
     intersecting_edge->set_lane_count(intersecting_de->lanecount());
   }
 
   // Set the sign info for the intersecting edge if requested
-  if (controller(kNodeIntersectingEdgeSignInfo)) {
+  if (controller(LegAttribute::kNodeIntersectingEdgeSignInfo)) {
     if (intersecting_de->sign()) {
       LinguisticMap linguistics;
       std::vector<SignInfo> edge_signs =
@@ -921,7 +1181,7 @@ void AddTripIntersectingEdge(const AttributesController& controller,
  * @param trip_node                pbf node in the pbf structure we are building
  * @param blind_instructions       whether instructions for blind users are requested
  */
-void AddIntersectingEdges(const AttributesController& controller,
+void AddIntersectingEdges(const LegAttributeMask& controller,
                           const graph_tile_ptr& start_tile,
                           const NodeInfo* node,
                           const DirectedEdge* directededge,
@@ -1055,7 +1315,7 @@ void ProcessTunnelBridgeTaggedValue(valhalla::StreetName* trip_edge_name,
  * @param  edgeinfo           EdgeInfo of the directed edge
  * @param  levels             level information of the edge
  */
-TripLeg_Edge* AddTripEdge(const AttributesController& controller,
+TripLeg_Edge* AddTripEdge(const LegAttributeMask& controller,
                           const GraphId& edge,
                           const std::vector<valhalla::thor::PathInfo>::const_iterator& edge_itr,
                           const uint32_t block_id,
@@ -1081,7 +1341,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   // Get the edgeinfo
 
   // Add names to edge if requested
-  if (controller(kEdgeNames)) {
+  if (controller(LegAttribute::kEdgeNames)) {
     auto names_and_types = edgeinfo.GetNamesAndTypes(true);
     if (blind_instructions)
       FilterUnneededStreetNumbers(names_and_types);
@@ -1113,7 +1373,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Add tagged names to the edge if requested
-  if (controller(kEdgeTaggedValues)) {
+  if (controller(LegAttribute::kEdgeTaggedValues)) {
     const auto& tagged_values_and_types = edgeinfo.GetTags();
     trip_edge->mutable_tagged_value()->Reserve(tagged_values_and_types.size());
     for (const auto& tagged_value_and_type : tagged_values_and_types) {
@@ -1150,7 +1410,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
       for (const auto& sign : node_signs) {
         switch (sign.type()) {
           case valhalla::baldr::Sign::Type::kJunctionName: {
-            if (controller.attributes.at(kEdgeSignJunctionName)) {
+            if (controller(LegAttribute::kEdgeSignJunctionName)) {
               PopulateSignElement(sign_index, sign, linguistics,
                                   trip_sign->mutable_junction_names()->Add());
             }
@@ -1175,13 +1435,13 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Set road class if requested
-  if (controller(kEdgeRoadClass)) {
+  if (controller(LegAttribute::kEdgeRoadClass)) {
     trip_edge->set_road_class(GetRoadClass(directededge->classification()));
   }
 
   // Set speed if requested
   // TODO: what to do about transit edges?
-  if (controller(kEdgeSpeed)) {
+  if (controller(LegAttribute::kEdgeSpeed)) {
     // TODO: could get better precision speed here by calling GraphTile::GetSpeed but we'd need to
     // know whether or not the costing actually cares about the speed of the edge. Perhaps a
     // refactor of costing to have a GetSpeed function which EdgeCost calls internally but which we
@@ -1201,16 +1461,16 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Set country crossing if requested
-  if (controller(kEdgeCountryCrossing)) {
+  if (controller(LegAttribute::kEdgeCountryCrossing)) {
     trip_edge->set_country_crossing(directededge->ctry_crossing());
   }
 
   // Set forward if requested
-  if (controller(kEdgeForward)) {
+  if (controller(LegAttribute::kEdgeForward)) {
     trip_edge->set_forward(directededge->forward());
   }
 
-  if (controller(kEdgeLevels)) {
+  if (controller(LegAttribute::kEdgeLevels)) {
     trip_edge->set_level_precision(std::max(static_cast<uint32_t>(1), levels.second));
     for (const auto& level : levels.first) {
       auto proto_level = trip_edge->mutable_levels()->Add();
@@ -1231,7 +1491,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   // Test whether edge is traversed forward or reverse
   if (directededge->forward()) {
     // Set traversability for forward directededge if requested
-    if (controller(kEdgeTraversability)) {
+    if (controller(LegAttribute::kEdgeTraversability)) {
       if ((directededge->forwardaccess() & kAccess) && (directededge->reverseaccess() & kAccess)) {
         trip_edge->set_traversability(TripLeg_Traversability::TripLeg_Traversability_kBoth);
       } else if ((directededge->forwardaccess() & kAccess) &&
@@ -1246,7 +1506,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   } else {
     // Set traversability for reverse directededge if requested
-    if (controller(kEdgeTraversability)) {
+    if (controller(LegAttribute::kEdgeTraversability)) {
       if ((directededge->forwardaccess() & kAccess) && (directededge->reverseaccess() & kAccess)) {
         trip_edge->set_traversability(TripLeg_Traversability::TripLeg_Traversability_kBoth);
       } else if (!(directededge->forwardaccess() & kAccess) &&
@@ -1271,56 +1531,56 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   trip_edge->set_has_time_restrictions(edge_itr->restriction_index != kInvalidRestriction);
 
   // Set the trip path use based on directed edge use if requested
-  if (controller(kEdgeUse)) {
+  if (controller(LegAttribute::kEdgeUse)) {
     trip_edge->set_use(GetTripLegUse(directededge->use()));
   }
 
   // Set toll flag if requested
-  if (directededge->toll() && controller(kEdgeToll)) {
+  if (directededge->toll() && controller(LegAttribute::kEdgeToll)) {
     trip_edge->set_toll(true);
   }
 
   // Set unpaved flag if requested
-  if (directededge->unpaved() && controller(kEdgeUnpaved)) {
+  if (directededge->unpaved() && controller(LegAttribute::kEdgeUnpaved)) {
     trip_edge->set_unpaved(true);
   }
 
   // Set tunnel flag if requested
-  if (directededge->tunnel() && controller(kEdgeTunnel)) {
+  if (directededge->tunnel() && controller(LegAttribute::kEdgeTunnel)) {
     trip_edge->set_tunnel(true);
   }
 
   // Set bridge flag if requested
-  if (directededge->bridge() && controller(kEdgeBridge)) {
+  if (directededge->bridge() && controller(LegAttribute::kEdgeBridge)) {
     trip_edge->set_bridge(true);
   }
 
   // Set roundabout flag if requested
-  if (directededge->roundabout() && controller(kEdgeRoundabout)) {
+  if (directededge->roundabout() && controller(LegAttribute::kEdgeRoundabout)) {
     trip_edge->set_roundabout(true);
   }
 
   // Set internal intersection flag if requested
-  if (directededge->internal() && controller(kEdgeInternalIntersection)) {
+  if (directededge->internal() && controller(LegAttribute::kEdgeInternalIntersection)) {
     trip_edge->set_internal_intersection(true);
   }
 
   // Set drive_on_right if requested
-  if (controller(kEdgeDriveOnRight)) {
+  if (controller(LegAttribute::kEdgeDriveOnRight)) {
     trip_edge->set_drive_on_left(!drive_on_right);
   }
 
   // Set surface if requested
-  if (controller(kEdgeSurface)) {
+  if (controller(LegAttribute::kEdgeSurface)) {
     trip_edge->set_surface(GetTripLegSurface(directededge->surface()));
   }
 
-  if (directededge->destonly() && controller(kEdgeDestinationOnly)) {
+  if (directededge->destonly() && controller(LegAttribute::kEdgeDestinationOnly)) {
     trip_edge->set_destination_only(directededge->destonly());
   }
 
   // Set indoor flag if requested
-  if (directededge->indoor() && controller(kEdgeIndoor)) {
+  if (directededge->indoor() && controller(LegAttribute::kEdgeIndoor)) {
     trip_edge->set_indoor(true);
   }
 
@@ -1328,64 +1588,64 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   if (mode == sif::TravelMode::kBicycle) {
     // Override bicycle mode with pedestrian if dismount flag or steps
     if (directededge->dismount() || directededge->use() == Use::kSteps) {
-      if (controller(kEdgeTravelMode)) {
+      if (controller(LegAttribute::kEdgeTravelMode)) {
         trip_edge->set_travel_mode(valhalla::TravelMode::kPedestrian);
       }
-      if (controller(kEdgePedestrianType)) {
+      if (controller(LegAttribute::kEdgePedestrianType)) {
         trip_edge->set_pedestrian_type(valhalla::PedestrianType::kFoot);
       }
     } else {
-      if (controller(kEdgeTravelMode)) {
+      if (controller(LegAttribute::kEdgeTravelMode)) {
         trip_edge->set_travel_mode(valhalla::TravelMode::kBicycle);
       }
-      if (controller(kEdgeBicycleType)) {
+      if (controller(LegAttribute::kEdgeBicycleType)) {
         trip_edge->set_bicycle_type(GetTripLegBicycleType(travel_type));
       }
     }
   } else if (mode == sif::TravelMode::kDrive) {
-    if (controller(kEdgeTravelMode)) {
+    if (controller(LegAttribute::kEdgeTravelMode)) {
       trip_edge->set_travel_mode(valhalla::TravelMode::kDrive);
     }
-    if (controller(kEdgeVehicleType)) {
+    if (controller(LegAttribute::kEdgeVehicleType)) {
       trip_edge->set_vehicle_type(GetTripLegVehicleType(travel_type));
     }
   } else if (mode == sif::TravelMode::kPedestrian) {
-    if (controller(kEdgeTravelMode)) {
+    if (controller(LegAttribute::kEdgeTravelMode)) {
       trip_edge->set_travel_mode(valhalla::TravelMode::kPedestrian);
     }
-    if (controller(kEdgePedestrianType)) {
+    if (controller(LegAttribute::kEdgePedestrianType)) {
       trip_edge->set_pedestrian_type(GetTripLegPedestrianType(travel_type));
     }
   } else if (mode == sif::TravelMode::kPublicTransit) {
-    if (controller(kEdgeTravelMode)) {
+    if (controller(LegAttribute::kEdgeTravelMode)) {
       trip_edge->set_travel_mode(valhalla::TravelMode::kTransit);
     }
   }
 
   // Set edge id (graphid value) if requested
-  if (controller(kEdgeId)) {
+  if (controller(LegAttribute::kEdgeId)) {
     trip_edge->set_id(edge.value);
   }
 
   // Set way id (base data id) if requested
-  if (controller(kEdgeWayId)) {
+  if (controller(LegAttribute::kEdgeWayId)) {
     trip_edge->set_way_id(edgeinfo.wayid());
   }
 
   // Set weighted grade if requested
-  if (controller(kEdgeWeightedGrade)) {
+  if (controller(LegAttribute::kEdgeWeightedGrade)) {
     trip_edge->set_weighted_grade((directededge->weighted_grade() - 6.f) / 0.6f);
   }
 
   // Set maximum upward and downward grade if requested (set to kNoElevationData if unavailable)
-  if (controller(kEdgeMaxUpwardGrade)) {
+  if (controller(LegAttribute::kEdgeMaxUpwardGrade)) {
     if (graphtile->header()->has_elevation()) {
       trip_edge->set_max_upward_grade(directededge->max_up_slope());
     } else {
       trip_edge->set_max_upward_grade(kNoElevationData);
     }
   }
-  if (controller(kEdgeMaxDownwardGrade)) {
+  if (controller(LegAttribute::kEdgeMaxDownwardGrade)) {
     if (graphtile->header()->has_elevation()) {
       trip_edge->set_max_downward_grade(directededge->max_down_slope());
     } else {
@@ -1394,15 +1654,15 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Set mean elevation if requested (will be kNoElevationData if unavailable)
-  if (controller(kEdgeMeanElevation)) {
+  if (controller(LegAttribute::kEdgeMeanElevation)) {
     trip_edge->set_mean_elevation(edgeinfo.mean_elevation());
   }
 
-  if (controller(kEdgeLaneCount)) {
+  if (controller(LegAttribute::kEdgeLaneCount)) {
     trip_edge->set_lane_count(directededge->lanecount());
   }
 
-  if (directededge->laneconnectivity() && controller(kEdgeLaneConnectivity)) {
+  if (directededge->laneconnectivity() && controller(LegAttribute::kEdgeLaneConnectivity)) {
     auto laneconnectivity = graphtile->GetLaneConnectivity(idx);
     trip_edge->mutable_lane_connectivity()->Reserve(laneconnectivity.size());
     for (const auto& l : laneconnectivity) {
@@ -1413,23 +1673,23 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   }
 
-  if (directededge->cyclelane() != CycleLane::kNone && controller(kEdgeCycleLane)) {
+  if (directededge->cyclelane() != CycleLane::kNone && controller(LegAttribute::kEdgeCycleLane)) {
     trip_edge->set_cycle_lane(GetTripLegCycleLane(directededge->cyclelane()));
   }
 
-  if (controller(kEdgeBicycleNetwork)) {
+  if (controller(LegAttribute::kEdgeBicycleNetwork)) {
     trip_edge->set_bicycle_network(directededge->bike_network());
   }
 
-  if (controller(kEdgeSacScale)) {
+  if (controller(LegAttribute::kEdgeSacScale)) {
     trip_edge->set_sac_scale(GetTripLegSacScale(directededge->sac_scale()));
   }
 
-  if (controller(kEdgeShoulder)) {
+  if (controller(LegAttribute::kEdgeShoulder)) {
     trip_edge->set_shoulder(directededge->shoulder());
   }
 
-  if (controller(kEdgeSidewalk)) {
+  if (controller(LegAttribute::kEdgeSidewalk)) {
     if (directededge->sidewalk_left() && directededge->sidewalk_right()) {
       trip_edge->set_sidewalk(TripLeg_Sidewalk::TripLeg_Sidewalk_kBothSides);
     } else if (directededge->sidewalk_left()) {
@@ -1439,20 +1699,20 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   }
 
-  if (controller(kEdgeDensity)) {
+  if (controller(LegAttribute::kEdgeDensity)) {
     trip_edge->set_density(directededge->density());
   }
 
-  if (controller(kEdgeIsUrban)) {
+  if (controller(LegAttribute::kEdgeIsUrban)) {
     bool is_urban = (directededge->density() > 8) ? true : false;
     trip_edge->set_is_urban(is_urban);
   }
 
-  if (controller(kEdgeSpeedLimit)) {
+  if (controller(LegAttribute::kEdgeSpeedLimit)) {
     trip_edge->set_speed_limit(edgeinfo.speed_limit());
   }
 
-  if (controller(kEdgeConditionalSpeedLimits)) {
+  if (controller(LegAttribute::kEdgeConditionalSpeedLimits)) {
     auto conditional_limits = edgeinfo.conditional_speed_limits();
     trip_edge->mutable_conditional_speed_limits()->Reserve(conditional_limits.size());
     for (const auto& limit : conditional_limits) {
@@ -1484,15 +1744,15 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   }
 
-  if (controller(kEdgeDefaultSpeed)) {
+  if (controller(LegAttribute::kEdgeDefaultSpeed)) {
     trip_edge->set_default_speed(directededge->speed());
   }
 
-  if (controller(kEdgeTruckSpeed)) {
+  if (controller(LegAttribute::kEdgeTruckSpeed)) {
     trip_edge->set_truck_speed(directededge->truck_speed());
   }
 
-  if (directededge->truck_route() && controller(kEdgeTruckRoute)) {
+  if (directededge->truck_route() && controller(LegAttribute::kEdgeTruckRoute)) {
     trip_edge->set_truck_route(true);
   }
 
@@ -1503,12 +1763,12 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     TransitRouteInfo* transit_route_info = trip_edge->mutable_transit_route_info();
 
     // Set block_id if requested
-    if (controller(kEdgeTransitRouteInfoBlockId)) {
+    if (controller(LegAttribute::kEdgeTransitRouteInfoBlockId)) {
       transit_route_info->set_block_id(block_id);
     }
 
     // Set trip_id if requested
-    if (controller(kEdgeTransitRouteInfoTripId)) {
+    if (controller(LegAttribute::kEdgeTransitRouteInfoTripId)) {
       transit_route_info->set_trip_id(edge_itr->trip_id);
     }
 
@@ -1519,7 +1779,8 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     if (transit_departure) {
 
       // Set headsign if requested
-      if (controller(kEdgeTransitRouteInfoHeadsign) && transit_departure->headsign_offset()) {
+      if (controller(LegAttribute::kEdgeTransitRouteInfoHeadsign) &&
+          transit_departure->headsign_offset()) {
         transit_route_info->set_headsign(graphtile->GetName(transit_departure->headsign_offset()));
       }
 
@@ -1527,55 +1788,61 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
 
       if (transit_route) {
         // Set transit type if requested
-        if (controller(kEdgeTransitType)) {
+        if (controller(LegAttribute::kEdgeTransitType)) {
           trip_edge->set_transit_type(GetTripLegTransitType(transit_route->route_type()));
         }
 
         // Set onestop_id if requested
-        if (controller(kEdgeTransitRouteInfoOnestopId) && transit_route->one_stop_offset()) {
+        if (controller(LegAttribute::kEdgeTransitRouteInfoOnestopId) &&
+            transit_route->one_stop_offset()) {
           transit_route_info->set_onestop_id(graphtile->GetName(transit_route->one_stop_offset()));
         }
 
         // Set short_name if requested
-        if (controller(kEdgeTransitRouteInfoShortName) && transit_route->short_name_offset()) {
+        if (controller(LegAttribute::kEdgeTransitRouteInfoShortName) &&
+            transit_route->short_name_offset()) {
           transit_route_info->set_short_name(graphtile->GetName(transit_route->short_name_offset()));
         }
 
         // Set long_name if requested
-        if (controller(kEdgeTransitRouteInfoLongName) && transit_route->long_name_offset()) {
+        if (controller(LegAttribute::kEdgeTransitRouteInfoLongName) &&
+            transit_route->long_name_offset()) {
           transit_route_info->set_long_name(graphtile->GetName(transit_route->long_name_offset()));
         }
 
         // Set color if requested
-        if (controller(kEdgeTransitRouteInfoColor)) {
+        if (controller(LegAttribute::kEdgeTransitRouteInfoColor)) {
           transit_route_info->set_color(transit_route->route_color());
         }
 
         // Set text_color if requested
-        if (controller(kEdgeTransitRouteInfoTextColor)) {
+        if (controller(LegAttribute::kEdgeTransitRouteInfoTextColor)) {
           transit_route_info->set_text_color(transit_route->route_text_color());
         }
 
         // Set description if requested
-        if (controller(kEdgeTransitRouteInfoDescription) && transit_route->desc_offset()) {
+        if (controller(LegAttribute::kEdgeTransitRouteInfoDescription) &&
+            transit_route->desc_offset()) {
           transit_route_info->set_description(graphtile->GetName(transit_route->desc_offset()));
         }
 
         // Set operator_onestop_id if requested
-        if (controller(kEdgeTransitRouteInfoOperatorOnestopId) &&
+        if (controller(LegAttribute::kEdgeTransitRouteInfoOperatorOnestopId) &&
             transit_route->op_by_onestop_id_offset()) {
           transit_route_info->set_operator_onestop_id(
               graphtile->GetName(transit_route->op_by_onestop_id_offset()));
         }
 
         // Set operator_name if requested
-        if (controller(kEdgeTransitRouteInfoOperatorName) && transit_route->op_by_name_offset()) {
+        if (controller(LegAttribute::kEdgeTransitRouteInfoOperatorName) &&
+            transit_route->op_by_name_offset()) {
           transit_route_info->set_operator_name(
               graphtile->GetName(transit_route->op_by_name_offset()));
         }
 
         // Set operator_url if requested
-        if (controller(kEdgeTransitRouteInfoOperatorUrl) && transit_route->op_by_website_offset()) {
+        if (controller(LegAttribute::kEdgeTransitRouteInfoOperatorUrl) &&
+            transit_route->op_by_website_offset()) {
           transit_route_info->set_operator_url(
               graphtile->GetName(transit_route->op_by_website_offset()));
         }
@@ -1696,6 +1963,9 @@ void TripLegBuilder::Build(
   // Remember what algorithms were used to create this leg
   *trip_path.mutable_algorithms() = {algorithms.begin(), algorithms.end()};
 
+  // Evaluate the attribute filter once rather than for every edge
+  const LegAttributeMask attributes(controller);
+
   // Set origin, any through locations, and destination. Origin and
   // destination are assumed to be breaks.
   CopyLocations(trip_path, origin, intermediates, dest, path_begin, path_end);
@@ -1789,7 +2059,9 @@ void TripLegBuilder::Build(
   uint64_t osmchangeset = 0;
   size_t edge_index = 0;
   const DirectedEdge* prev_de = nullptr;
+  // consecutive edges mostly share their tiles, so each lookup is hinted with the tile it had last
   graph_tile_ptr graphtile = nullptr;
+  graph_tile_ptr start_tile = nullptr;
   TimeInfo time_info = forward_time_info;
   // remember that MultimodalBuilder keeps 'time_info' as reference,
   // so we should care about 'time_info' updates during iterations
@@ -1832,14 +2104,13 @@ void TripLegBuilder::Build(
     }
 
     // Set node attributes - only set if they are true since they are optional
-    graph_tile_ptr start_tile = graphtile;
     graphreader.GetGraphTile(startnode, start_tile);
     if (start_tile == nullptr) {
       throw tile_gone_error_t("TripLegBuilder::Build failed", startnode);
     }
     const NodeInfo* node = start_tile->node(startnode);
 
-    if (osmchangeset == 0 && controller(kOsmChangeset)) {
+    if (osmchangeset == 0 && attributes(LegAttribute::kOsmChangeset)) {
       osmchangeset = start_tile->header()->dataset_id();
     }
 
@@ -1855,20 +2126,20 @@ void TripLegBuilder::Build(
     // Add a node to the trip path and set its attributes.
     TripLeg_Node* trip_node = trip_path.add_node();
 
-    if (controller(kNodeType)) {
+    if (attributes(LegAttribute::kNodeType)) {
       trip_node->set_type(GetTripLegNodeType(node->type()));
       if (node->traffic_signal())
         trip_node->set_traffic_signal(true);
     }
 
     if (node->intersection() == IntersectionType::kFork) {
-      if (controller(kNodeFork)) {
+      if (attributes(LegAttribute::kNodeFork)) {
         trip_node->set_fork(true);
       }
     }
 
     // Assign the elapsed time from the start of the leg
-    if (controller(kNodeElapsedTime)) {
+    if (attributes(LegAttribute::kNodeElapsedTime)) {
       if (edge_itr == path_begin) {
         trip_node->mutable_cost()->mutable_elapsed_cost()->set_seconds(0);
         trip_node->mutable_cost()->mutable_elapsed_cost()->set_cost(0);
@@ -1881,19 +2152,19 @@ void TripLegBuilder::Build(
     }
 
     // Assign the admin index
-    if (controller(kNodeAdminIndex)) {
+    if (attributes(LegAttribute::kNodeAdminIndex)) {
       trip_node->set_admin_index(
           GetAdminIndex(start_tile->admininfo(node->admin_index()), admin_info_map, admin_info_list));
     }
 
-    if (controller(kNodeTimeZone)) {
+    if (attributes(LegAttribute::kNodeTimeZone)) {
       auto tz = DateTime::get_tz_db().from_index(node->timezone());
       if (tz) {
         trip_node->set_time_zone(tz->name());
       }
     }
 
-    if (controller(kNodeTransitionTime)) {
+    if (attributes(LegAttribute::kNodeTransitionTime)) {
       trip_node->mutable_cost()->mutable_transition_cost()->set_seconds(
           edge_itr->transition_cost.secs);
       trip_node->mutable_cost()->mutable_transition_cost()->set_cost(edge_itr->transition_cost.cost);
@@ -1908,7 +2179,7 @@ void TripLegBuilder::Build(
     std::pair<std::vector<std::pair<float, float>>, uint32_t> levels = edgeinfo.levels();
     // Add edge to the trip node and set its attributes
     TripLeg_Edge* trip_edge =
-        AddTripEdge(controller, edge, edge_itr, multimodal_builder.block_id, mode, travel_type,
+        AddTripEdge(attributes, edge, edge_itr, multimodal_builder.block_id, mode, travel_type,
                     costing, directededge, node->drive_on_right(), trip_node, graphtile, time_info,
                     startnode.id(), node->named_intersection(), start_tile,
                     travel_type == PedestrianType::kBlind && mode == sif::TravelMode::kPedestrian,
@@ -2038,7 +2309,7 @@ void TripLegBuilder::Build(
     }
 
     // Set length if requested. Convert to km
-    if (controller(kEdgeLength)) {
+    if (attributes(LegAttribute::kEdgeLength)) {
       float km =
           std::max(directededge->length() * kKmPerMeter * (trim_end_pct - trim_start_pct), 0.0f);
       trip_edge->set_length_km(km);
@@ -2050,43 +2321,44 @@ void TripLegBuilder::Build(
       edge_seconds -= std::prev(edge_itr)->elapsed_cost.secs;
 
     // Set shape attributes, sending incidents enables them in the pbf
-    auto incidents = controller(kIncidents) ? graphreader.GetIncidents(edge_itr->edgeid, graphtile)
-                                            : valhalla::baldr::IncidentResult{};
+    auto incidents = attributes(LegAttribute::kIncidents)
+                         ? graphreader.GetIncidents(edge_itr->edgeid, graphtile)
+                         : valhalla::baldr::IncidentResult{};
 
     graph_tile_ptr end_node_tile = graphtile;
     graphreader.GetGraphTile(directededge->endnode(), end_node_tile);
-    SetShapeAttributes(controller, graphtile, end_node_tile, directededge, trip_shape, begin_index,
-                       trip_path, trim_start_pct, trim_end_pct, edge_seconds,
+    SetShapeAttributes(attributes, graphtile, end_node_tile, directededge, edgeinfo, trip_shape,
+                       begin_index, trip_path, trim_start_pct, trim_end_pct, edge_seconds,
                        costing->flow_mask() & kCurrentFlowMask, incidents);
 
     // Set begin shape index if requested
-    if (controller(kEdgeBeginShapeIndex)) {
+    if (attributes(LegAttribute::kEdgeBeginShapeIndex)) {
       trip_edge->set_begin_shape_index(begin_index);
     }
 
     // Set end shape index if requested
-    if (controller(kEdgeEndShapeIndex)) {
+    if (attributes(LegAttribute::kEdgeEndShapeIndex)) {
       trip_edge->set_end_shape_index(trip_shape.size() - 1);
     }
 
     // Set begin and end heading if requested. Uses trip_shape so
     // must be done after the edge's shape has been added.
-    SetHeadings(trip_edge, controller, directededge, trip_shape, begin_index);
+    SetHeadings(trip_edge, attributes, directededge, trip_shape, begin_index);
 
     // Add elevation along the edge if requested
-    if (controller(kEdgeElevation)) {
-      SetElevation(trip_edge, trim_start_pct, trim_end_pct, node, directededge, graphtile,
-                   graphreader);
+    if (attributes(LegAttribute::kEdgeElevation)) {
+      SetElevation(trip_edge, trim_start_pct, trim_end_pct, node, directededge, edgeinfo,
+                   end_node_tile);
     }
 
     // Add landmarks in the directededge to the trip leg
-    AddLandmarks(edgeinfo, trip_edge, controller, directededge, trip_shape, begin_index);
+    AddLandmarks(edgeinfo, trip_edge, attributes, directededge, trip_shape, begin_index);
 
     // Add the intersecting edges at the node. Skip it if the node was an inner node (excluding start
     // node and end node) of a shortcut that was recovered.
     if (startnode.Is_Valid() && !edge_itr->start_node_is_recovered) {
-      AddIntersectingEdges(controller, start_tile, node, directededge, prev_de, prior_opp_local_index,
-                           graphreader, trip_node,
+      AddIntersectingEdges(attributes, start_tile, node, directededge, prev_de,
+                           prior_opp_local_index, graphreader, trip_node,
                            travel_type == PedestrianType::kBlind &&
                                mode == sif::TravelMode::kPedestrian);
     }
@@ -2095,16 +2367,15 @@ void TripLegBuilder::Build(
 
     // Set the endnode of this directed edge as the startnode of the next edge.
     startnode = directededge->endnode();
+    start_tile = end_node_tile;
 
     // Save the opposing edge as the previous DirectedEdge (for name consistency)
     if (!directededge->IsTransitLine()) {
-      graph_tile_ptr t2 =
-          directededge->leaves_tile() ? graphreader.GetGraphTile(directededge->endnode()) : graphtile;
-      if (t2 == nullptr) {
+      if (end_node_tile == nullptr) {
         continue;
       }
-      GraphId oppedge = t2->GetOpposingEdgeId(directededge);
-      prev_de = t2->directededge(oppedge);
+      GraphId oppedge = end_node_tile->GetOpposingEdgeId(directededge);
+      prev_de = end_node_tile->directededge(oppedge);
     }
 
     // Save the index of the opposing local directed edge at the end node
@@ -2113,7 +2384,7 @@ void TripLegBuilder::Build(
 
   // Add the last node
   auto* node = trip_path.add_node();
-  if (controller(kNodeAdminIndex)) {
+  if (attributes(LegAttribute::kNodeAdminIndex)) {
     auto last_tile = graphreader.GetGraphTile(startnode);
     if (last_tile == nullptr) {
       throw tile_gone_error_t("TripLegBuilder::Build failed", startnode);
@@ -2122,17 +2393,17 @@ void TripLegBuilder::Build(
         GetAdminIndex(last_tile->admininfo(last_tile->node(startnode)->admin_index()), admin_info_map,
                       admin_info_list));
   }
-  if (controller(kNodeElapsedTime)) {
+  if (attributes(LegAttribute::kNodeElapsedTime)) {
     node->mutable_cost()->mutable_elapsed_cost()->set_seconds(std::prev(path_end)->elapsed_cost.secs);
     node->mutable_cost()->mutable_elapsed_cost()->set_cost(std::prev(path_end)->elapsed_cost.cost);
   }
 
-  if (controller(kNodeTransitionTime)) {
+  if (attributes(LegAttribute::kNodeTransitionTime)) {
     node->mutable_cost()->mutable_transition_cost()->set_seconds(0);
     node->mutable_cost()->mutable_transition_cost()->set_cost(0);
   }
 
-  if (controller(kShapeAttributesClosure)) {
+  if (attributes(LegAttribute::kShapeAttributesClosure)) {
     // Set the end shape index if we're ending on a closure as the last index is
     // not processed in SetShapeAttributes above
     valhalla::TripLeg_Closure* closure = fetch_last_closure_annotation(trip_path);
@@ -2142,17 +2413,17 @@ void TripLegBuilder::Build(
   }
 
   // Assign the admins
-  AssignAdmins(controller, trip_path, admin_info_list);
+  AssignAdmins(attributes, trip_path, admin_info_list);
 
   // Set the bounding box of the shape
   SetBoundingBox(trip_path, trip_shape);
 
   // Set shape if requested
-  if (controller(kShape)) {
+  if (attributes(LegAttribute::kShape)) {
     trip_path.set_shape(encode<std::vector<PointLL>>(trip_shape));
   }
 
-  if (osmchangeset != 0 && controller(kOsmChangeset)) {
+  if (osmchangeset != 0 && attributes(LegAttribute::kOsmChangeset)) {
     trip_path.set_osm_changeset(osmchangeset);
   }
 
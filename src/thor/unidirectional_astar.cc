@@ -304,6 +304,7 @@ inline bool UnidirectionalAStar<expansion_direction, FORWARD>::ExpandInner(
     }
 
     adjacencylist_.add(idx);
+    ++counters_.edge_labels;
     if (!dest_path_edge) {
       // only non-destination labels get an edge status!!!!!!
       *meta.edge_status = {EdgeSet::kTemporary, idx};
@@ -502,6 +503,7 @@ std::vector<std::vector<PathInfo>> UnidirectionalAStar<expansion_direction, FORW
       LOG_ERROR("Route failed after iterations = " + std::to_string(edgelabels_.size()));
       return {};
     }
+    ++counters_.expanded_edges;
 
     // Copy the EdgeLabel for use in costing. Check if this is a destination
     // edge and potentially complete the path.
@@ -793,6 +795,7 @@ void UnidirectionalAStar<expansion_direction, FORWARD>::SetOrigin(
       }
 
       adjacencylist_.add(idx);
+      ++counters_.edge_labels;
     };
 
     // add as normal edge, fixes #3585
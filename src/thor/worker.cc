@@ -1,6 +1,14 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <functional>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 
 #include "midgard/constants.h"
@@ -45,6 +53,12 @@ const std::unordered_map<std::string, float> kMaxDistances = {
 // a scale factor to apply to the score so that we bias towards closer results more
 constexpr float kDistanceScale = 10.f;
 
+// The tile cache size of a GraphReader whose config doesn't set one
+constexpr size_t kDefaultMaxCacheSize = 1073741824;
+
+// How often the request thread checks the interrupt while the auxiliary workers are busy
+constexpr std::chrono::milliseconds kAuxInterruptPoll(10);
+
 #ifdef ENABLE_SERVICES
 std::string serialize_to_pbf(Api& request) {
   std::string buf;
@@ -100,16 +114,143 @@ thor_worker_t::thor_worker_t(const boost::property_tree::ptree& config,
 
   costmatrix_allow_second_pass = config.get<bool>("thor.costmatrix_allow_second_pass", false);
 
+  // Optimized routes are ordered with local search unless the old simulated annealing is asked for
+  optimizer_annealing = config.get<std::string>("thor.optimizer", "local_search") == "annealing";
+  optimizer_time_budget = config.get<uint32_t>("thor.optimizer_time_budget", 100);
+  optimizer_concurrency = std::max(config.get<uint32_t>("thor.optimizer_concurrency", 1), 1u);
+
   max_timedep_distance =
       config.get<float>("service_limits.max_timedep_distance", kDefaultMaxTimeDependentDistance);
 
+  // Multi-leg routes and batches of isochrones can be computed concurrently by some extra workers,
+  // which we create lazily on first use. They must not try to spin up workers of their own
+  max_leg_concurrency = std::max(config.get<size_t>("thor.max_leg_concurrency", 1), size_t(1));
+  max_isochrone_concurrency =
+      std::max(config.get<size_t>("thor.max_isochrone_concurrency", 1), size_t(1));
+  if (max_leg_concurrency > 1 || max_isochrone_concurrency > 1) {
+    aux_worker_config = config;
+    aux_worker_config.put("thor.max_leg_concurrency", 1);
+    aux_worker_config.put("thor.max_isochrone_concurrency", 1);
+    // each has a tile cache of its own, together they get as much memory as ours
+    auto aux_count = std::max(max_leg_concurrency, max_isochrone_concurrency);
+    auto max_cache_size = config.get<size_t>("mjolnir.max_cache_size", kDefaultMaxCacheSize);
+    aux_worker_config.put("mjolnir.max_cache_size", max_cache_size / aux_count);
+  }
+
   // signal that the worker started successfully
   started();
 }
 
+struct thor_worker_t::aux_pool_t {
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable start;
+  std::condition_variable done;
+  const std::function<void(thor_worker_t&)>* work = nullptr;
+  size_t generation = 0; // Bumped for every run so that each thread takes part in it once
+  size_t count = 0;      // # of workers taking part in the run
+  size_t running = 0;    // # of them still working
+  bool stop = false;
+
+  // the auxiliary workers check this rather than the interrupt of the request
+  std::atomic<bool> cancelled{false};
+  const std::function<void()> interrupt = [this]() {
+    if (cancelled.load(std::memory_order_relaxed)) {
+      throw std::runtime_error("The request was cancelled");
+    }
+  };
+
+  // waits for the runs the worker at index takes part in until the pool is stopped
+  void serve(thor_worker_t& worker, const size_t index) {
+    size_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      start.wait(lock, [&]() { return stop || generation != seen; });
+      if (stop) {
+        return;
+      }
+      seen = generation;
+      if (index >= count) {
+        continue;
+      }
+      lock.unlock();
+      try {
+        (*work)(worker);
+      } catch (...) { LOG_ERROR("Auxiliary thor worker failed unexpectedly"); }
+      lock.lock();
+      if (--running == 0) {
+        done.notify_all();
+      }
+    }
+  }
+
+  ~aux_pool_t() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    start.notify_all();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+};
+
 thor_worker_t::~thor_worker_t() {
 }
 
+void thor_worker_t::run_aux_workers(const size_t count,
+                                    const std::function<void(thor_worker_t&)>& work) {
+  // dont bother starting anything if the request is already gone
+  if (interrupt) {
+    (*interrupt)();
+  }
+  if (!aux_pool) {
+    aux_pool.reset(new aux_pool_t);
+  }
+  auto& pool = *aux_pool;
+  while (aux_workers.size() < count) {
+    aux_workers.emplace_back(new thor_worker_t(aux_worker_config));
+  }
+  while (pool.threads.size() < count) {
+    auto index = pool.threads.size();
+    pool.threads.emplace_back(&aux_pool_t::serve, &pool, std::ref(*aux_workers[index]), index);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    aux_workers[i]->set_interrupt(&pool.interrupt);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.cancelled = false;
+    pool.work = &work;
+    pool.count = count;
+    pool.running = count;
+    ++pool.generation;
+  }
+  pool.start.notify_all();
+
+  // the interrupt may not be safe to call from other threads so only this one polls it
+  std::exception_ptr interrupted;
+  std::unique_lock<std::mutex> lock(pool.mutex);
+  while (!pool.done.wait_for(lock, kAuxInterruptPoll, [&pool]() { return pool.running == 0; })) {
+    if (interrupt && !interrupted) {
+      lock.unlock();
+      try {
+        (*interrupt)();
+      } catch (...) {
+        interrupted = std::current_exception();
+        pool.cancelled = true;
+      }
+      lock.lock();
+    }
+  }
+  lock.unlock();
+  if (interrupted) {
+    std::rethrow_exception(interrupted);
+  }
+}
+
 #ifdef ENABLE_SERVICES
 prime_server::worker_t::result_t
 thor_worker_t::work(const std::list<zmq::message_t>& job,
@@ -119,7 +260,7 @@ thor_worker_t::work(const std::list<zmq::message_t>& job,
   // get request info and make sure to record any metrics before we are done
   auto& info = *static_cast<prime_server::http_request_info_t*>(request_info);
   LOG_INFO("Got Thor Request " + std::to_string(info.id));
-  Api request;
+  auto& request = request_arena.next();
   prime_server::worker_t::result_t result{true, {}, {}};
   try {
     // crack open the original request
@@ -321,11 +462,33 @@ void thor_worker_t::cleanup() {
   if (reader->OverCommitted()) {
     reader->Trim();
   }
+  for (auto& aux_worker : aux_workers) {
+    aux_worker->cleanup();
+  }
 }
 
 void thor_worker_t::set_interrupt(const std::function<void()>* interrupt_function) {
   interrupt = interrupt_function;
   reader->SetInterrupt(interrupt);
 }
+
+work_counters_t thor_worker_t::counters() const {
+  work_counters_t counters;
+  std::tie(counters.tiles_fetched, counters.tile_cache_misses) = reader->GetTileCounts();
+  for (const PathAlgorithm* algorithm : std::initializer_list<const PathAlgorithm*>{
+           &bidir_astar, &bss_astar, &multi_modal_astar, &timedep_forward, &timedep_reverse}) {
+    counters.expanded_edges += algorithm->counters().expanded_edges;
+    counters.edge_labels += algorithm->counters().edge_labels;
+  }
+  // the legs or isochrones the auxiliary workers computed for the request count too
+  for (const auto& aux_worker : aux_workers) {
+    auto aux = aux_worker->counters();
+    counters.tiles_fetched += aux.tiles_fetched;
+    counters.tile_cache_misses += aux.tile_cache_misses;
+    counters.expanded_edges += aux.expanded_edges;
+    counters.edge_labels += aux.edge_labels;
+  }
+  return counters;
+}
 } // namespace thor
 } // namespace valhalla
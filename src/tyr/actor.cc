@@ -36,6 +36,7 @@ struct actor_t::pimpl_t {
   loki::loki_worker_t loki_worker;
   thor::thor_worker_t thor_worker;
   odin_worker_t odin_worker;
+  request_arena_t request_arena;
 };
 
 actor_t::actor_t(const boost::property_tree::ptree& config, bool auto_cleanup)
@@ -85,6 +86,15 @@ std::string actor_t::act(Api& api, const std::function<void()>* interrupt) {
   }
 }
 
+std::string actor_t::act(const char* pbf, size_t size, const std::function<void()>* interrupt) {
+  // the request goes from the bytes into the arena and through the stages without being copied
+  auto& api = pimpl->request_arena.next();
+  if (!api.ParseFromArray(pbf, static_cast<int>(size))) {
+    throw valhalla_exception_t{103};
+  }
+  return act(api, interrupt);
+}
+
 std::string
 actor_t::route(const std::string& request_str, const std::function<void()>* interrupt, Api* api) {
   // set the interrupts
@@ -102,6 +112,8 @@ actor_t::route(const std::string& request_str, const std::function<void()>* inte
   pimpl->thor_worker.route(*api);
   // get some directions back from them and serialize
   auto bytes = pimpl->odin_worker.narrate(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -122,6 +134,8 @@ actor_t::locate(const std::string& request_str, const std::function<void()>* int
   ParseApi(request_str, Options::locate, *api);
   // check the request and locate the locations in the graph
   auto json = pimpl->loki_worker.locate(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -144,6 +158,8 @@ actor_t::matrix(const std::string& request_str, const std::function<void()>* int
   pimpl->loki_worker.matrix(*api);
   // compute the matrix
   auto bytes = pimpl->thor_worker.matrix(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -169,6 +185,8 @@ std::string actor_t::optimized_route(const std::string& request_str,
   pimpl->thor_worker.optimized_route(*api);
   // get some directions back from them and serialize
   auto bytes = pimpl->odin_worker.narrate(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -191,6 +209,8 @@ actor_t::isochrone(const std::string& request_str, const std::function<void()>*
   pimpl->loki_worker.isochrones(*api);
   // compute the isochrones
   auto json = pimpl->thor_worker.isochrones(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -198,6 +218,56 @@ actor_t::isochrone(const std::string& request_str, const std::function<void()>*
   return json;
 }
 
+std::vector<std::string> actor_t::isochrone(const std::string& request_str,
+                                            const std::vector<std::string>& date_times,
+                                            const std::function<void()>* interrupt,
+                                            Api* api) {
+  // set the interrupts
+  pimpl->set_interrupts(interrupt);
+  // if the caller doesn't want a copy we'll use this dummy
+  Api dummy;
+  if (!api) {
+    api = &dummy;
+  }
+  // keep the options of a pbf request as they were in case we have to parse them again
+  Api timed;
+  if (request_str.empty()) {
+    *timed.mutable_options() = api->options();
+  }
+  // parse the request
+  ParseApi(request_str, Options::isochrone, *api);
+  // without a time of its own the request is time independent, which turns off the traffic of its
+  // costings, but each of the date_times gives it one so we parse its costings as if it had one
+  if (api->options().date_time_type() == Options::no_time) {
+    std::string timed_request;
+    if (!request_str.empty()) {
+      rapidjson::Document doc;
+      doc.Parse(request_str.c_str());
+      auto& allocator = doc.GetAllocator();
+      rapidjson::Value date_time(rapidjson::kObjectType);
+      date_time.AddMember("type", 0, allocator);
+      doc.RemoveMember("date_time");
+      doc.AddMember("date_time", date_time, allocator);
+      timed_request = rapidjson::to_string(doc);
+    } else {
+      timed.mutable_options()->set_date_time_type(Options::current);
+    }
+    ParseApi(timed_request, Options::isochrone, timed);
+    *api->mutable_options()->mutable_costings() = timed.options().costings();
+  }
+  // check the request and locate the locations in the graph
+  pimpl->loki_worker.isochrones(*api);
+  // compute the isochrones at each time
+  auto results = pimpl->thor_worker.isochrones(*api, date_times);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
+  // if they want you do to do the cleanup automatically
+  if (auto_cleanup) {
+    cleanup();
+  }
+  return results;
+}
+
 std::string actor_t::trace_route(const std::string& request_str,
                                  const std::function<void()>* interrupt,
                                  Api* api) {
@@ -216,6 +286,8 @@ std::string actor_t::trace_route(const std::string& request_str,
   pimpl->thor_worker.trace_route(*api);
   // get some directions back from them
   auto bytes = pimpl->odin_worker.narrate(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -239,6 +311,8 @@ std::string actor_t::trace_attributes(const std::string& request_str,
   pimpl->loki_worker.trace(*api);
   // get the path and turn it into attribution along it
   auto json = pimpl->thor_worker.trace_attributes(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -259,6 +333,8 @@ actor_t::height(const std::string& request_str, const std::function<void()>* int
   ParseApi(request_str, Options::height, *api);
   // get the height at each point
   auto json = pimpl->loki_worker.height(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -280,6 +356,8 @@ std::string actor_t::transit_available(const std::string& request_str,
   ParseApi(request_str, Options::transit_available, *api);
   // check the request and locate the locations in the graph
   auto json = pimpl->loki_worker.transit_available(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -308,6 +386,8 @@ actor_t::expansion(const std::string& request_str, const std::function<void()>*
   }
   // route between the locations in the graph to find the best path
   auto json = pimpl->thor_worker.expansion(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -332,6 +412,8 @@ actor_t::centroid(const std::string& request_str, const std::function<void()>* i
   pimpl->thor_worker.centroid(*api);
   // get some directions back from them and serialize
   auto bytes = pimpl->odin_worker.narrate(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
@@ -358,6 +440,8 @@ actor_t::status(const std::string& request_str, const std::function<void()>* int
   pimpl->odin_worker.status(*api);
   // get the json
   auto json = tyr::serializeStatus(*api);
+  // add the stats of the request to the metrics, if they are kept
+  record_metrics(*api);
   // if they want you do to do the cleanup automatically
   if (auto_cleanup) {
     cleanup();
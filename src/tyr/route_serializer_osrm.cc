@@ -230,35 +230,25 @@ void route_summary(json::MapPtr& route, const valhalla::Api& api, bool imperial,
 }
 
 // Generate full shape of the route.
-std::vector<PointLL> full_shape(const valhalla::DirectionsRoute& directions,
-                                const valhalla::Options& options) {
-  // If just one leg and it we want polyline6 then we just return the encoded leg shape
-  if (directions.legs().size() == 1 && options.shape_format() == polyline6) {
-    return midgard::decode<std::vector<PointLL>>(directions.legs().begin()->shape());
-  }
-  // TODO: there is a tricky way to do this... since the end of each leg is the same as the
-  // beginning we essentially could just peel off the first encoded shape point of all the legs (but
-  // the first) this way we wouldn't really have to do any decoding (would be far faster). it might
-  // even be the case that the string length of the first number is a fixed length (which would be
-  // great!) have to have a look should make this a function in midgard probably so the logic is all
-  // in the same place
-  std::vector<PointLL> decoded;
-  for (const auto& leg : directions.legs()) {
-    auto decoded_leg = midgard::decode<std::vector<PointLL>>(leg.shape());
-    decoded.insert(decoded.end(), decoded.size() ? decoded_leg.begin() + 1 : decoded_leg.begin(),
-                   decoded_leg.end());
+std::vector<PointLL> full_shape(const std::vector<std::vector<PointLL>>& leg_shapes) {
+  std::vector<PointLL> shape;
+  for (const auto& leg_shape : leg_shapes) {
+    shape.insert(shape.end(), shape.size() ? leg_shape.begin() + 1 : leg_shape.begin(),
+                 leg_shape.end());
   }
-  return decoded;
+  return shape;
 }
 
 // Generate simplified shape of the route.
-std::vector<PointLL> simplified_shape(const valhalla::DirectionsRoute& directions) {
+std::vector<PointLL> simplified_shape(const valhalla::DirectionsRoute& directions,
+                                      const std::vector<std::vector<PointLL>>& leg_shapes) {
   Coordinate south_west(std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
   Coordinate north_east(std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
   std::vector<PointLL> simple_shape;
   std::unordered_set<size_t> indices;
+  auto leg_shape = leg_shapes.begin();
   for (const auto& leg : directions.legs()) {
-    auto decoded_leg = midgard::decode<std::vector<PointLL>>(leg.shape());
+    const auto& decoded_leg = *leg_shape++;
     for (const auto& coord : decoded_leg) {
       south_west.lng = std::min(south_west.lng, toFixed(coord.lng()));
       south_west.lat = std::min(south_west.lat, toFixed(coord.lat()));
@@ -283,17 +273,28 @@ std::vector<PointLL> simplified_shape(const valhalla::DirectionsRoute& direction
 
 void route_geometry(json::MapPtr& route,
                     const valhalla::DirectionsRoute& directions,
+                    const std::vector<std::vector<PointLL>>& leg_shapes,
                     const valhalla::Options& options) {
   if (options.shape_format() == no_shape) {
     return;
   }
 
+  bool simplified = options.has_generalize_case() && options.generalize() == 0.0f;
+  bool full = !options.has_generalize_case() ||
+              (options.has_generalize_case() && options.generalize() > 0.0f);
+
+  // The full shape of a single leg is already encoded the way polyline6 wants it
+  if (full && directions.legs_size() == 1 && options.shape_format() == polyline6 &&
+      DIGITS_PRECISION == 6) {
+    route->emplace("geometry", directions.legs(0).shape());
+    return;
+  }
+
   std::vector<PointLL> shape;
-  if (options.has_generalize_case() && options.generalize() == 0.0f) {
-    shape = simplified_shape(directions);
-  } else if (!options.has_generalize_case() ||
-             (options.has_generalize_case() && options.generalize() > 0.0f)) {
-    shape = full_shape(directions, options);
+  if (simplified) {
+    shape = simplified_shape(directions, leg_shapes);
+  } else if (full) {
+    shape = full_shape(leg_shapes);
   }
   if (options.shape_format() == geojson) {
     route->emplace("geometry", geojson_shape(shape));
@@ -1418,7 +1419,19 @@ void maneuver_geometry(json::MapPtr& step,
                        bool is_arrive_maneuver,
                        const valhalla::Options& options) {
   // Must add one to the end range since maneuver end shape index is exclusive
-  std::vector<PointLL> maneuver_shape(shape.begin() + begin_idx, shape.begin() + end_idx + 1);
+  auto begin = shape.begin() + begin_idx;
+  auto end = shape.begin() + end_idx + 1;
+  int precision = options.shape_format() == polyline6 ? 1e6 : 1e5;
+
+  // Encode the slice of the leg shape directly unless it needs another point
+  if (!is_arrive_maneuver && options.shape_format() != geojson) {
+    std::string encoded;
+    midgard::encode(begin, end, encoded, precision);
+    step->emplace("geometry", std::move(encoded));
+    return;
+  }
+
+  std::vector<PointLL> maneuver_shape(begin, end);
   // Last maneuver shape is a linestring with two identical points at the destination
   if (is_arrive_maneuver) {
     maneuver_shape.push_back(shape.back());
@@ -1427,7 +1440,6 @@ void maneuver_geometry(json::MapPtr& step,
   if (options.shape_format() == geojson) {
     step->emplace("geometry", geojson_shape(maneuver_shape));
   } else {
-    int precision = options.shape_format() == polyline6 ? 1e6 : 1e5;
     step->emplace("geometry", midgard::encode(maneuver_shape, precision));
   }
 }
@@ -1695,6 +1707,7 @@ std::string get_pronunciations(const valhalla::DirectionsLeg::Maneuver& maneuver
 
 // Serialize each leg
 json::ArrayPtr serialize_legs(const google::protobuf::RepeatedPtrField<valhalla::DirectionsLeg>& legs,
+                              const std::vector<std::vector<PointLL>>& leg_shapes,
                               const std::vector<std::string>& leg_summaries,
                               google::protobuf::RepeatedPtrField<valhalla::TripLeg>& path_legs,
                               bool imperial,
@@ -1719,7 +1732,7 @@ json::ArrayPtr serialize_legs(const google::protobuf::RepeatedPtrField<valhalla:
 
     // Get the full shape for the leg. We want to use this for serializing
     // encoded shape for each step (maneuver) in OSRM output.
-    auto shape = midgard::decode<std::vector<PointLL>>(leg->shape());
+    const auto& shape = leg_shapes[leg_index];
 
     // #########################################################################
     //  Iterate through maneuvers - convert to OSRM steps
@@ -2139,14 +2152,22 @@ std::string serialize(valhalla::Api& api) {
     // Add linear references, if applicable
     route_references(route, api.trip().routes(i), options);
 
+    // Decode the shape of each leg once, the route geometry and the steps are all cut from it
+    const auto& directions = api.directions().routes(i);
+    std::vector<std::vector<PointLL>> leg_shapes;
+    leg_shapes.reserve(directions.legs_size());
+    for (const auto& leg : directions.legs()) {
+      leg_shapes.emplace_back(midgard::decode<std::vector<PointLL>>(leg.shape()));
+    }
+
     // Concatenated route geometry
-    route_geometry(route, api.directions().routes(i), options);
+    route_geometry(route, directions, leg_shapes, options);
 
     // Other route summary information
     route_summary(route, api, imperial, i);
 
     // Serialize route legs
-    route->emplace("legs", serialize_legs(api.directions().routes(i).legs(), route_leg_summaries[i],
+    route->emplace("legs", serialize_legs(directions.legs(), leg_shapes, route_leg_summaries[i],
                                           *api.mutable_trip()->mutable_routes(i)->mutable_legs(),
                                           imperial, options, controller));
 
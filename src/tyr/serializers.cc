@@ -125,12 +125,31 @@ std::string serializeStatus(Api& request) {
     status_doc.AddMember("osm_changeset",
                          rapidjson::Value().SetUint64(request.status().osm_changeset()), alloc);
 
+  if (request.status().has_warmup_progress_case())
+    status_doc.AddMember("warmup_progress",
+                         rapidjson::Value().SetDouble(request.status().warmup_progress()), alloc);
+
   rapidjson::Document bbox_doc;
   if (request.status().has_bbox_case()) {
     bbox_doc.Parse(request.status().bbox());
     rapidjson::SetValueByPointer(status_doc, "/bbox", bbox_doc, alloc);
   }
 
+  if (!request.status().metrics().empty()) {
+    rapidjson::Value metrics(rapidjson::kObjectType);
+    for (const auto& metric : request.status().metrics()) {
+      rapidjson::Value summary(rapidjson::kObjectType);
+      summary.AddMember("count", rapidjson::Value().SetUint64(metric.count()), alloc);
+      summary.AddMember("sum", rapidjson::Value().SetDouble(metric.sum()), alloc);
+      summary.AddMember("max", rapidjson::Value().SetDouble(metric.max()), alloc);
+      summary.AddMember("p50", rapidjson::Value().SetDouble(metric.p50()), alloc);
+      summary.AddMember("p90", rapidjson::Value().SetDouble(metric.p90()), alloc);
+      summary.AddMember("p99", rapidjson::Value().SetDouble(metric.p99()), alloc);
+      metrics.AddMember(rapidjson::Value().SetString(metric.key(), alloc), summary, alloc);
+    }
+    status_doc.AddMember("metrics", metrics, alloc);
+  }
+
   return rapidjson::to_string(status_doc);
 }
 
@@ -221,13 +240,11 @@ std::string serializePbf(Api& request) {
     }
   }
 
-  // if they dont want the options object but its a service request we have to work around it
+  // if they dont want the options object but its a service request we have to work around it. we
+  // take it out as is rather than swapping it, which would copy it if the request is in an arena
   bool skip_options = !request.options().pbf_field_selector().options() && request.has_info() &&
                       request.info().is_service();
-  Options dummy;
-  if (skip_options) {
-    request.mutable_options()->Swap(&dummy);
-  }
+  Options* options = skip_options ? request.unsafe_arena_release_options() : nullptr;
 
   // disable all the stuff we need to disable, options must be last since we are referencing it
   if (!selection.trip())
@@ -249,15 +266,15 @@ std::string serializePbf(Api& request) {
   auto bytes = request.SerializeAsString();
 
   // we do need to keep the options object though because downstream request handling relies on it
-  if (skip_options) {
-    request.mutable_options()->Swap(&dummy);
+  if (options) {
+    request.unsafe_arena_set_allocated_options(options);
   }
 
   return bytes;
 }
 
 // Generate leg shape in geojson format.
-baldr::json::MapPtr geojson_shape(const std::vector<midgard::PointLL> shape) {
+baldr::json::MapPtr geojson_shape(const std::vector<midgard::PointLL>& shape) {
   auto geojson = baldr::json::map({});
   auto coords = baldr::json::array({});
   coords->reserve(shape.size());
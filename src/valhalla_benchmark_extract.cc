@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <cxxopts.hpp>
+
+#include "baldr/graphreader.h"
+#include "filesystem.h"
+#include "midgard/logging.h"
+#include "tyr/actor.h"
+
+#include "argparse_utils.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace valhalla;
+
+namespace {
+
+// gets at the mapped extract so we can evict it
+class ExtractReader : public baldr::GraphReader {
+public:
+  using baldr::GraphReader::GraphReader;
+
+  bool HasExtract() const {
+    return tile_extract_->archive != nullptr;
+  }
+
+  // drops the extract from our mapping and from the page cache. the page cache only lets go of
+  // pages nobody has mapped, so our own mapping has to let go of them first
+  void EvictExtract() {
+    Clear();
+#ifdef __linux__
+    const auto& mm = tile_extract_->archive->mm;
+    madvise(mm.get(), mm.size(), MADV_DONTNEED);
+    auto fd = open(mm.name().c_str(), O_RDONLY);
+    if (fd != -1) {
+      posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      close(fd);
+    }
+#endif
+  }
+};
+
+long major_faults() {
+#ifndef _WIN32
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    return usage.ru_majflt;
+  }
+#endif
+  return 0;
+}
+
+struct result_t {
+  double ms;
+  long faults;
+};
+
+void summarize(const std::string& name, std::vector<result_t> results) {
+  if (results.empty()) {
+    return;
+  }
+  std::sort(results.begin(), results.end(),
+            [](const result_t& a, const result_t& b) { return a.ms < b.ms; });
+  auto percentile = [&results](double p) {
+    return results[std::min(results.size() - 1, static_cast<size_t>(p * results.size()))].ms;
+  };
+  auto total = std::accumulate(results.begin(), results.end(), result_t{0, 0},
+                               [](const result_t& a, const result_t& b) {
+                                 return result_t{a.ms + b.ms, a.faults + b.faults};
+                               });
+  std::cout << std::fixed << std::setprecision(2) << name << ": " << results.size()
+            << " routes, mean " << total.ms / results.size() << "ms, p50 " << percentile(.5)
+            << "ms, p90 " << percentile(.9) << "ms, p99 " << percentile(.99) << "ms, max "
+            << results.back().ms << "ms, " << static_cast<double>(total.faults) / results.size()
+            << " major page faults per route" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const auto program = filesystem::path(__FILE__).stem().string();
+  // args
+  std::vector<std::string> input_files;
+  bool cold = true;
+  boost::property_tree::ptree config;
+
+  try {
+    // clang-format off
+    cxxopts::Options options(
+      program,
+      program + " " + VALHALLA_VERSION + "\n\n"
+      "a program that measures route latency on a tile extract with a cold page cache, to compare\n"
+      "the tile orders of valhalla_build_extract --tile-order and mjolnir.extract_tile_order and\n"
+      "the mjolnir.tile_extract_advice and mjolnir.tile_extract_prefetch settings. Before each\n"
+      "route the extract is evicted from the page cache, then the same route is run again warm.\n"
+      "The input is a text file of one json route request per line.\n\n");
+
+    options.add_options()
+      ("h,help", "Print this help message.")
+      ("v,version", "Print the version of this software.")
+      ("c,config", "Path to the json configuration file.", cxxopts::value<std::string>())
+      ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>())
+      ("cold", "Evict the extract from the page cache before each route.", cxxopts::value<bool>(cold)->default_value("true"))
+      ("input_files", "positional arguments", cxxopts::value<std::vector<std::string>>(input_files));
+    // clang-format on
+
+    options.parse_positional({"input_files"});
+    options.positional_help("REQUESTS.TXT");
+    auto result = options.parse(argc, argv);
+    if (!parse_common_args(program, options, result, config, "loki.logging"))
+      return EXIT_SUCCESS;
+
+    if (!result.count("input_files")) {
+      throw cxxopts::exceptions::exception("Input file is required\n\n" + options.help());
+    }
+  } catch (cxxopts::exceptions::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+
+  ExtractReader reader(config.get_child("mjolnir"));
+  if (!reader.HasExtract()) {
+    LOG_ERROR("The benchmark needs a loadable mjolnir.tile_extract");
+    return EXIT_FAILURE;
+  }
+  tyr::actor_t actor(config, reader, true);
+
+  std::vector<result_t> cold_results, warm_results;
+  size_t failed = 0;
+  for (const auto& file : input_files) {
+    std::ifstream stream(file);
+    std::string request;
+    while (std::getline(stream, request)) {
+      if (request.empty()) {
+        continue;
+      }
+      if (cold) {
+        reader.EvictExtract();
+      }
+      for (auto* results : {&cold_results, &warm_results}) {
+        auto faults = major_faults();
+        auto start = std::chrono::steady_clock::now();
+        try {
+          actor.route(request);
+        } catch (const std::exception& e) {
+          LOG_WARN("Route failed: " + std::string(e.what()));
+          ++failed;
+          break;
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        results->push_back({elapsed.count(), major_faults() - faults});
+      }
+    }
+  }
+
+  summarize(cold ? "Cold" : "First", cold_results);
+  summarize("Warm", warm_results);
+  if (failed) {
+    std::cout << failed << " routes failed" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
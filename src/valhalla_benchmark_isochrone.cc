@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <cxxopts.hpp>
+
+#include "baldr/graphreader.h"
+#include "baldr/rapidjson_utils.h"
+#include "filesystem.h"
+#include "midgard/logging.h"
+#include "tyr/actor.h"
+
+#include "argparse_utils.h"
+
+using namespace valhalla;
+
+namespace {
+
+struct timing_t {
+  size_t requests = 0;
+  size_t times = 0;
+  double separate_ms = 0;
+  double batched_ms = 0;
+};
+
+// the request departing at the given time, the way a client without the batch would send it
+std::string with_date_time(const std::string& request, const std::string& date_time) {
+  rapidjson::Document doc;
+  doc.Parse(request.c_str());
+  if (doc.HasParseError() || !doc.IsObject()) {
+    throw std::runtime_error("Invalid json request");
+  }
+  auto& allocator = doc.GetAllocator();
+  rapidjson::Value value(rapidjson::kObjectType);
+  value.AddMember("type", 1, allocator);
+  value.AddMember("value", rapidjson::Value(date_time, allocator), allocator);
+  doc.RemoveMember("date_time");
+  doc.AddMember("date_time", value, allocator);
+  return rapidjson::to_string(doc);
+}
+
+void summarize(const std::string& name, const timing_t& timing) {
+  if (timing.times == 0) {
+    return;
+  }
+  std::cout << std::fixed << std::setprecision(3) << name << ": " << timing.requests
+            << " requests, " << timing.times << " times, " << timing.separate_ms / timing.times
+            << "ms per time as separate requests, " << timing.batched_ms / timing.times
+            << "ms batched, " << timing.separate_ms / timing.batched_ms << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const auto program = filesystem::path(__FILE__).stem().string();
+  // args
+  std::vector<std::string> input_files;
+  std::vector<std::string> date_times;
+  boost::property_tree::ptree config;
+
+  try {
+    // clang-format off
+    cxxopts::Options options(
+      program,
+      program + " " + VALHALLA_VERSION + "\n\n"
+      "a program that times computing the isochrones of a request at several departure times as\n"
+      "one request per time against one batch of all the times, which reuses the correlation of\n"
+      "the locations and is expanded on thor.max_isochrone_concurrency workers. The input files\n"
+      "are text files of one json isochrone request per line.\n\n");
+
+    options.add_options()
+      ("h,help", "Print this help message.")
+      ("v,version", "Print the version of this software.")
+      ("c,config", "Path to the json configuration file.", cxxopts::value<std::string>())
+      ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>())
+      ("d,date-times", "The departure times of each request.", cxxopts::value<std::vector<std::string>>(date_times)->default_value("2024-06-04T03:00,2024-06-04T08:00,2024-06-04T12:00,2024-06-04T17:30,2024-06-04T22:00"))
+      ("input_files", "positional arguments", cxxopts::value<std::vector<std::string>>(input_files));
+    // clang-format on
+
+    options.parse_positional({"input_files"});
+    options.positional_help("REQUESTS.TXT");
+    auto result = options.parse(argc, argv);
+    if (!parse_common_args(program, options, result, config, "thor.logging"))
+      return EXIT_SUCCESS;
+    if (input_files.empty()) {
+      throw cxxopts::exceptions::exception("Request files are required\n\n" + options.help());
+    }
+  } catch (cxxopts::exceptions::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+
+  baldr::GraphReader reader(config.get_child("mjolnir"));
+  tyr::actor_t actor(config, reader, true);
+  timing_t timing;
+  size_t failed = 0;
+  for (const auto& file : input_files) {
+    std::ifstream stream(file);
+    std::string request;
+    while (std::getline(stream, request)) {
+      if (request.empty()) {
+        continue;
+      }
+      try {
+        // the batch goes first so that it pays for reading in the tiles if anything does
+        auto start = std::chrono::steady_clock::now();
+        actor.isochrone(request, date_times);
+        std::chrono::duration<double, std::milli> batched =
+            std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (const auto& date_time : date_times) {
+          actor.isochrone(with_date_time(request, date_time));
+        }
+        std::chrono::duration<double, std::milli> separate =
+            std::chrono::steady_clock::now() - start;
+
+        ++timing.requests;
+        timing.times += date_times.size();
+        timing.batched_ms += batched.count();
+        timing.separate_ms += separate.count();
+      } catch (const std::exception& e) {
+        LOG_WARN("Isochrone failed: " + std::string(e.what()));
+        ++failed;
+      }
+    }
+  }
+  summarize("Requests", timing);
+  if (failed) {
+    std::cout << failed << " requests failed" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <cxxopts.hpp>
+
+#include "baldr/graphreader.h"
+#include "filesystem.h"
+#include "midgard/logging.h"
+#include "proto/api.pb.h"
+#include "tyr/actor.h"
+
+#include "argparse_utils.h"
+
+using namespace valhalla;
+
+namespace {
+
+struct timing_t {
+  size_t matrices = 0;
+  size_t cells = 0;
+  double ms = 0;
+};
+
+// runs the matrix request and adds its time and number of cells to the timing
+bool time_matrix(tyr::actor_t& actor, const std::string& request, timing_t& timing) {
+  Api api;
+  auto start = std::chrono::steady_clock::now();
+  try {
+    actor.matrix(request, nullptr, &api);
+  } catch (const std::exception& e) {
+    LOG_WARN("Matrix failed: " + std::string(e.what()));
+    return false;
+  }
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  actor.cleanup();
+  ++timing.matrices;
+  timing.cells += api.matrix().times_size();
+  timing.ms += elapsed.count();
+  return true;
+}
+
+void summarize(const std::string& name, const timing_t& timing) {
+  if (timing.matrices == 0) {
+    return;
+  }
+  std::cout << std::fixed << std::setprecision(3) << name << ": " << timing.matrices
+            << " matrices, " << timing.cells << " cells, " << timing.ms / timing.matrices
+            << "ms per matrix, " << 1000. * timing.cells / timing.ms << " cells per second"
+            << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const auto program = filesystem::path(__FILE__).stem().string();
+  // args
+  std::vector<std::string> input_files;
+  uint32_t iterations;
+  boost::property_tree::ptree config;
+
+  try {
+    // clang-format off
+    cxxopts::Options options(
+      program,
+      program + " " + VALHALLA_VERSION + "\n\n"
+      "a program that measures the throughput of matrix requests, time dependent ones (with a\n"
+      "date_time) over tiles with predicted speeds are the interesting ones. The input files are\n"
+      "text files of one json matrix request per line. All of them are computed once with the\n"
+      "tiles being read in, the cold run, and then the given number of times with the tiles and\n"
+      "the predicted speeds they have decompressed cached, the warm runs.\n\n");
+
+    options.add_options()
+      ("h,help", "Print this help message.")
+      ("v,version", "Print the version of this software.")
+      ("c,config", "Path to the json configuration file.", cxxopts::value<std::string>())
+      ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>())
+      ("n,iterations", "Number of warm runs of the requests.", cxxopts::value<uint32_t>(iterations)->default_value("5"))
+      ("input_files", "positional arguments", cxxopts::value<std::vector<std::string>>(input_files));
+    // clang-format on
+
+    options.parse_positional({"input_files"});
+    options.positional_help("REQUESTS.TXT");
+    auto result = options.parse(argc, argv);
+    if (!parse_common_args(program, options, result, config, "thor.logging"))
+      return EXIT_SUCCESS;
+    if (input_files.empty()) {
+      throw cxxopts::exceptions::exception("Request files are required\n\n" + options.help());
+    }
+  } catch (cxxopts::exceptions::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> requests;
+  for (const auto& file : input_files) {
+    std::ifstream stream(file);
+    std::string request;
+    while (std::getline(stream, request)) {
+      if (!request.empty()) {
+        requests.push_back(request);
+      }
+    }
+  }
+
+  baldr::GraphReader reader(config.get_child("mjolnir"));
+  tyr::actor_t actor(config, reader, true);
+
+  // the failed ones are left out of the warm runs so that both runs time the same matrices
+  timing_t cold;
+  std::vector<std::string> succeeded;
+  for (const auto& request : requests) {
+    if (time_matrix(actor, request, cold)) {
+      succeeded.push_back(request);
+    }
+  }
+  summarize("Cold", cold);
+
+  timing_t warm;
+  for (uint32_t i = 0; i < iterations; ++i) {
+    for (const auto& request : succeeded) {
+      time_matrix(actor, request, warm);
+    }
+  }
+  summarize("Warm", warm);
+
+  if (succeeded.size() != requests.size()) {
+    std::cout << requests.size() - succeeded.size() << " matrices failed" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
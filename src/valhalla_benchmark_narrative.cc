@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <cxxopts.hpp>
+
+#include "config.h"
+#include "filesystem.h"
+#include "odin/narrative_dictionary.h"
+#include "odin/util.h"
+
+using namespace valhalla::odin;
+
+namespace {
+
+// The capacity the narrative builder reserves for each instruction
+constexpr size_t kInstructionCapacity = 128;
+
+struct timing_t {
+  size_t phrases = 0;
+  double replace_ns = 0;
+  double render_ns = 0;
+};
+
+// the values of a turn instruction, the phrases of the other instructions keep their other tags
+const std::string kRelativeDirection = "left";
+const std::string kStreetNames = "Main Street";
+const std::string kBeginStreetNames = "First Street";
+const std::string kJunctionName = "Big Junction";
+const std::string kTowardSign = "Baltimore";
+
+// fills the phrase in the way the narrative builder used to, a boost::replace_all per tag
+size_t replace(const std::string& phrase) {
+  std::string instruction;
+  instruction.reserve(kInstructionCapacity);
+  instruction = phrase;
+  boost::replace_all(instruction, kRelativeDirectionTag, kRelativeDirection);
+  boost::replace_all(instruction, kStreetNamesTag, kStreetNames);
+  boost::replace_all(instruction, kBeginStreetNamesTag, kBeginStreetNames);
+  boost::replace_all(instruction, kJunctionNameTag, kJunctionName);
+  boost::replace_all(instruction, kTowardSignTag, kTowardSign);
+  return instruction.size();
+}
+
+// fills the phrase in the way the narrative builder does now, in one pass over its template
+size_t render(const PhraseTemplate& phrase) {
+  std::string instruction;
+  instruction.reserve(kInstructionCapacity);
+  phrase.Render(instruction, {{PhraseTag::kRelativeDirection, kRelativeDirection},
+                              {PhraseTag::kStreetNames, kStreetNames},
+                              {PhraseTag::kBeginStreetNames, kBeginStreetNames},
+                              {PhraseTag::kJunctionName, kJunctionName},
+                              {PhraseTag::kTowardSign, kTowardSign}});
+  return instruction.size();
+}
+
+// returns the mean nanoseconds it takes to fill in one of the phrases
+template <typename phrase_t, typename fill_t>
+double time_fill(const std::vector<phrase_t>& phrases,
+                 const fill_t& fill,
+                 const uint32_t iterations,
+                 size_t& checksum) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    for (const auto& phrase : phrases) {
+      checksum += fill(phrase);
+    }
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / (static_cast<double>(iterations) * phrases.size());
+}
+
+void summarize(const std::string& name, const timing_t& timing) {
+  std::cout << std::fixed << std::setprecision(1) << name << ": " << timing.phrases
+            << " phrases, " << timing.replace_ns << "ns per phrase with replace_all, "
+            << timing.render_ns << "ns with the template, "
+            << timing.replace_ns / timing.render_ns << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const auto program = filesystem::path(__FILE__).stem().string();
+  // args
+  std::vector<std::string> locales;
+  uint32_t iterations;
+
+  try {
+    // clang-format off
+    cxxopts::Options options(
+      program,
+      program + " " + VALHALLA_VERSION + "\n\n"
+      "a program that times filling in the tags of the narrative phrases of every locale, or of\n"
+      "the given ones, the way the narrative builder does it with the phrase templates made when\n"
+      "the locales are loaded against a boost::replace_all per tag. Each phrase is filled in with\n"
+      "the values of a turn instruction.\n\n");
+
+    options.add_options()
+      ("h,help", "Print this help message.")
+      ("v,version", "Print the version of this software.")
+      ("n,iterations", "Number of times each phrase is filled in.", cxxopts::value<uint32_t>(iterations)->default_value("1000"))
+      ("locales", "positional arguments", cxxopts::value<std::vector<std::string>>(locales));
+    // clang-format on
+
+    options.parse_positional({"locales"});
+    options.positional_help("[LOCALE...]");
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+      std::cout << options.help() << "\n";
+      return EXIT_SUCCESS;
+    }
+    if (result.count("version")) {
+      std::cout << program << " " << VALHALLA_VERSION << "\n";
+      return EXIT_SUCCESS;
+    }
+  } catch (cxxopts::exceptions::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+  iterations = std::max(iterations, 1u);
+
+  // the phrases of every instruction of each locale, sorted so the output is stable
+  std::map<std::string, std::vector<std::string>> locale_phrases;
+  for (const auto& locale : get_locales_json()) {
+    bool wanted = locales.empty() || std::find(locales.begin(), locales.end(), locale.first) !=
+                                         locales.end();
+    if (!wanted) {
+      continue;
+    }
+    std::stringstream json(locale.second);
+    boost::property_tree::ptree narrative;
+    boost::property_tree::read_json(json, narrative);
+    auto& phrases = locale_phrases[locale.first];
+    for (const auto& instruction : narrative.get_child("instructions")) {
+      auto instruction_phrases = instruction.second.get_child_optional("phrases");
+      if (!instruction_phrases) {
+        continue;
+      }
+      for (const auto& phrase : *instruction_phrases) {
+        phrases.push_back(phrase.second.get_value<std::string>());
+      }
+    }
+  }
+  if (locale_phrases.empty()) {
+    std::cerr << "No such locales" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  timing_t total;
+  size_t checksum = 0;
+  for (const auto& locale : locale_phrases) {
+    std::vector<PhraseTemplate> templates(locale.second.begin(), locale.second.end());
+    timing_t timing;
+    timing.phrases = locale.second.size();
+    timing.replace_ns = time_fill(locale.second, replace, iterations, checksum);
+    timing.render_ns = time_fill(templates, render, iterations, checksum);
+    summarize(locale.first, timing);
+
+    total.replace_ns += timing.replace_ns * timing.phrases;
+    total.render_ns += timing.render_ns * timing.phrases;
+    total.phrases += timing.phrases;
+  }
+  total.replace_ns /= total.phrases;
+  total.render_ns /= total.phrases;
+  summarize("All locales", total);
+
+  // keeps the filled in phrases from being optimized away
+  return checksum == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
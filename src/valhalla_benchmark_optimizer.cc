@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <cxxopts.hpp>
+
+#include "baldr/graphreader.h"
+#include "filesystem.h"
+#include "midgard/logging.h"
+#include "proto/api.pb.h"
+#include "thor/optimizer.h"
+#include "tyr/actor.h"
+
+#include "argparse_utils.h"
+
+using namespace valhalla;
+using namespace valhalla::thor;
+
+namespace {
+
+struct result_t {
+  double cost;
+  double ms;
+};
+
+struct comparison_t {
+  size_t matrices = 0;
+  result_t annealing{0, 0};
+  result_t local_search{0, 0};
+};
+
+template <typename optimizer_t>
+result_t run(optimizer_t& optimizer, const uint32_t count, const std::vector<float>& costs) {
+  auto start = std::chrono::steady_clock::now();
+  auto tour = optimizer.Solve(count, costs);
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+  return {LocalSearchOptimizer::TourCost(count, costs, tour), elapsed.count()};
+}
+
+void compare(comparison_t& comparison,
+             const uint32_t count,
+             const std::vector<float>& costs,
+             const uint32_t time_budget,
+             const uint32_t concurrency) {
+  Optimizer annealing;
+  auto annealed = run(annealing, count, costs);
+  LocalSearchOptimizer local_search(time_budget, concurrency);
+  auto searched = run(local_search, count, costs);
+  ++comparison.matrices;
+  comparison.annealing.cost += annealed.cost;
+  comparison.annealing.ms += annealed.ms;
+  comparison.local_search.cost += searched.cost;
+  comparison.local_search.ms += searched.ms;
+}
+
+void summarize(const std::string& name, const comparison_t& comparison) {
+  if (comparison.matrices == 0) {
+    return;
+  }
+  auto n = static_cast<double>(comparison.matrices);
+  std::cout << std::fixed << std::setprecision(2) << name << ": " << comparison.matrices
+            << " matrices, annealing mean cost " << comparison.annealing.cost / n << " in "
+            << comparison.annealing.ms / n << "ms, local_search mean cost "
+            << comparison.local_search.cost / n << " in " << comparison.local_search.ms / n
+            << "ms, "
+            << 100. * (1. - comparison.local_search.cost / comparison.annealing.cost)
+            << "% cheaper" << std::endl;
+}
+
+// asymmetric costs between random points, like driving times are
+std::vector<float> random_costs(const uint32_t count, std::mt19937& generator) {
+  std::uniform_real_distribution<float> distribution(0.f, 1000.f);
+  std::vector<std::pair<float, float>> points(count);
+  for (auto& point : points) {
+    point = {distribution(generator), distribution(generator)};
+  }
+  std::vector<float> costs(count * count);
+  for (uint32_t i = 0; i < count; ++i) {
+    for (uint32_t j = 0; j < count; ++j) {
+      costs[i * count + j] = std::hypot(points[i].first - points[j].first,
+                                        points[i].second - points[j].second) *
+                             (1.f + distribution(generator) / 3000.f);
+    }
+  }
+  return costs;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const auto program = filesystem::path(__FILE__).stem().string();
+  // args
+  std::vector<std::string> input_files;
+  std::vector<uint32_t> sizes;
+  uint32_t random_count;
+  boost::property_tree::ptree config;
+
+  try {
+    // clang-format off
+    cxxopts::Options options(
+      program,
+      program + " " + VALHALLA_VERSION + "\n\n"
+      "a program that compares the tour cost and solve time of the simulated annealing optimizer\n"
+      "with the local_search optimizer of optimized_route, which uses the\n"
+      "thor.optimizer_time_budget and thor.optimizer_concurrency of the config. It solves random\n"
+      "matrices of each size and the matrices of the requests in the input files, text files of\n"
+      "one json matrix request with the same sources and targets per line.\n\n");
+
+    options.add_options()
+      ("h,help", "Print this help message.")
+      ("v,version", "Print the version of this software.")
+      ("c,config", "Path to the json configuration file.", cxxopts::value<std::string>())
+      ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>())
+      ("s,sizes", "Numbers of locations of the random matrices.", cxxopts::value<std::vector<uint32_t>>(sizes)->default_value("10,30,50"))
+      ("n,random", "Number of random matrices of each size.", cxxopts::value<uint32_t>(random_count)->default_value("20"))
+      ("input_files", "positional arguments", cxxopts::value<std::vector<std::string>>(input_files));
+    // clang-format on
+
+    options.parse_positional({"input_files"});
+    options.positional_help("[REQUESTS.TXT]");
+    auto result = options.parse(argc, argv);
+    if (!parse_common_args(program, options, result, config, "thor.logging"))
+      return EXIT_SUCCESS;
+  } catch (cxxopts::exceptions::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+
+  const auto time_budget = config.get<uint32_t>("thor.optimizer_time_budget", 100);
+  const auto concurrency = std::max(config.get<uint32_t>("thor.optimizer_concurrency", 1), 1u);
+
+  std::mt19937 generator(random_count);
+  for (auto size : sizes) {
+    if (size < 2) {
+      continue;
+    }
+    comparison_t comparison;
+    for (uint32_t i = 0; i < random_count; ++i) {
+      compare(comparison, size, random_costs(size, generator), time_budget, concurrency);
+    }
+    summarize("Random " + std::to_string(size) + " locations", comparison);
+  }
+
+  if (input_files.empty()) {
+    return EXIT_SUCCESS;
+  }
+  baldr::GraphReader reader(config.get_child("mjolnir"));
+  tyr::actor_t actor(config, reader, true);
+  comparison_t comparison;
+  size_t failed = 0;
+  for (const auto& file : input_files) {
+    std::ifstream stream(file);
+    std::string request;
+    while (std::getline(stream, request)) {
+      if (request.empty()) {
+        continue;
+      }
+      Api api;
+      try {
+        actor.matrix(request, nullptr, &api);
+      } catch (const std::exception& e) {
+        LOG_WARN("Matrix failed: " + std::string(e.what()));
+        ++failed;
+        continue;
+      }
+      const auto count = static_cast<uint32_t>(api.options().sources_size());
+      const auto& times = api.matrix().times();
+      if (count < 2 || static_cast<uint32_t>(api.options().targets_size()) != count) {
+        LOG_WARN("Skipping a matrix whose sources and targets differ");
+        continue;
+      }
+      std::vector<float> costs(times.begin(), times.end());
+      compare(comparison, count, costs, time_budget, concurrency);
+    }
+  }
+  summarize("Requests", comparison);
+  if (failed) {
+    std::cout << failed << " matrices failed" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
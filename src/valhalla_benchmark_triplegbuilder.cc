@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+#include <cxxopts.hpp>
+
+#include "baldr/attributes_controller.h"
+#include "baldr/graphreader.h"
+#include "filesystem.h"
+#include "loki/worker.h"
+#include "midgard/logging.h"
+#include "proto/api.pb.h"
+#include "sif/costfactory.h"
+#include "thor/bidirectional_astar.h"
+#include "thor/triplegbuilder.h"
+#include "thor/unidirectional_astar.h"
+#include "worker.h"
+
+#include "argparse_utils.h"
+
+using namespace valhalla;
+using namespace valhalla::thor;
+
+namespace {
+
+struct timing_t {
+  size_t legs = 0;
+  size_t edges = 0;
+  double ms = 0;
+};
+
+// builds the leg the given number of times and returns the mean time of a build
+double time_build(const Options& options,
+                  const baldr::AttributesController& controller,
+                  baldr::GraphReader& reader,
+                  const sif::mode_costing_t& mode_costing,
+                  const std::vector<PathInfo>& path,
+                  const Location& origin,
+                  const Location& dest,
+                  const uint32_t iterations) {
+  std::chrono::duration<double, std::milli> elapsed{0};
+  for (uint32_t i = 0; i < iterations; ++i) {
+    auto leg_origin = origin;
+    auto leg_dest = dest;
+    TripLeg leg;
+    auto start = std::chrono::steady_clock::now();
+    TripLegBuilder::Build(options, controller, reader, mode_costing, path.begin(), path.end(),
+                          leg_origin, leg_dest, leg, {"benchmark"});
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+  return elapsed.count() / iterations;
+}
+
+void summarize(const std::string& name, const timing_t& timing) {
+  if (timing.legs == 0) {
+    return;
+  }
+  std::cout << std::fixed << std::setprecision(3) << name << ": " << timing.legs << " legs, "
+            << timing.edges << " edges, " << timing.ms / timing.legs << "ms per leg, "
+            << 1000. * timing.ms / timing.edges << "us per edge" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const auto program = filesystem::path(__FILE__).stem().string();
+  // args
+  std::vector<std::string> input_files;
+  uint32_t iterations;
+  boost::property_tree::ptree config;
+
+  try {
+    // clang-format off
+    cxxopts::Options options(
+      program,
+      program + " " + VALHALLA_VERSION + "\n\n"
+      "a program that times TripLegBuilder::Build on the paths of route requests, long cross\n"
+      "country routes are the interesting ones. The input files are text files of one json route\n"
+      "request per line, the first leg of each is routed once and then built with the default\n"
+      "attributes and with all the attributes enabled.\n\n");
+
+    options.add_options()
+      ("h,help", "Print this help message.")
+      ("v,version", "Print the version of this software.")
+      ("c,config", "Path to the json configuration file.", cxxopts::value<std::string>())
+      ("i,inline-config", "Inline JSON config", cxxopts::value<std::string>())
+      ("n,iterations", "Number of times each leg is built.", cxxopts::value<uint32_t>(iterations)->default_value("10"))
+      ("input_files", "positional arguments", cxxopts::value<std::vector<std::string>>(input_files));
+    // clang-format on
+
+    options.parse_positional({"input_files"});
+    options.positional_help("REQUESTS.TXT");
+    auto result = options.parse(argc, argv);
+    if (!parse_common_args(program, options, result, config, "thor.logging"))
+      return EXIT_SUCCESS;
+    if (input_files.empty()) {
+      throw cxxopts::exceptions::exception("Request files are required\n\n" + options.help());
+    }
+  } catch (cxxopts::exceptions::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+  iterations = std::max(iterations, 1u);
+
+  baldr::GraphReader reader(config.get_child("mjolnir"));
+  loki::loki_worker_t loki_worker(config);
+  BidirectionalAStar bidirectional(config.get_child("thor"));
+  TimeDepForward forward(config.get_child("thor"));
+  sif::CostFactory factory;
+
+  baldr::AttributesController defaults;
+  baldr::AttributesController all;
+  for (auto& attribute : all.attributes) {
+    attribute.second = true;
+  }
+
+  timing_t default_timing, all_timing;
+  size_t failed = 0;
+  for (const auto& file : input_files) {
+    std::ifstream stream(file);
+    std::string line;
+    while (std::getline(stream, line)) {
+      if (line.empty()) {
+        continue;
+      }
+      Api request;
+      try {
+        ParseApi(line, Options::route, request);
+        loki_worker.route(request);
+        const auto& options = request.options();
+        sif::TravelMode mode;
+        auto mode_costing = factory.CreateModeCosting(options, mode);
+        auto origin = options.locations(0);
+        auto dest = options.locations(1);
+        auto paths = bidirectional.GetBestPath(origin, dest, reader, mode_costing, mode, options);
+        bidirectional.Clear();
+        // the bidirectional search doesn't do trivial routes
+        if (paths.empty()) {
+          paths = forward.GetBestPath(origin, dest, reader, mode_costing, mode, options);
+          forward.Clear();
+        }
+        if (paths.empty()) {
+          throw std::runtime_error("No path");
+        }
+
+        const auto& path = paths.front();
+        auto default_ms =
+            time_build(options, defaults, reader, mode_costing, path, origin, dest, iterations);
+        auto all_ms =
+            time_build(options, all, reader, mode_costing, path, origin, dest, iterations);
+        ++default_timing.legs;
+        default_timing.edges += path.size();
+        default_timing.ms += default_ms;
+        ++all_timing.legs;
+        all_timing.edges += path.size();
+        all_timing.ms += all_ms;
+        std::cout << std::fixed << std::setprecision(3) << path.size() << " edges: " << default_ms
+                  << "ms with the default attributes, " << all_ms << "ms with all of them"
+                  << std::endl;
+      } catch (const std::exception& e) {
+        LOG_WARN("Route failed: " + std::string(e.what()));
+        ++failed;
+      }
+    }
+  }
+
+  summarize("Default attributes", default_timing);
+  summarize("All attributes", all_timing);
+  if (failed) {
+    std::cout << failed << " routes failed" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cctype>
+#include <map>
 #include <sstream>
 #include <typeinfo>
 #include <unordered_map>
@@ -8,6 +11,7 @@
 #include "loki/worker.h"
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "midgard/util.h"
 #include "odin/util.h"
 #include "odin/worker.h"
@@ -1339,6 +1343,60 @@ std::string serialize_error(const valhalla_exception_t& exception, Api& request)
   return body.str();
 }
 
+void record_metrics(const Api& api) {
+  if (!midgard::metrics::enabled() || !api.has_info())
+    return;
+  for (const auto& stat : api.info().statistics()) {
+    midgard::metrics::observe(stat.key(), stat.value());
+  }
+}
+
+std::string metrics_to_prometheus() {
+  // the series of each metric have to be written together, under its type
+  auto histograms = midgard::metrics::snapshot();
+  std::map<std::string, std::vector<std::pair<std::string, const midgard::metrics::histogram_t*>>>
+      metrics;
+  for (const auto& histogram : histograms) {
+    // action.level.worker.metric, the metric itself may have more dots
+    std::vector<std::string> parts;
+    size_t begin = 0, end;
+    while (parts.size() < 3 && (end = histogram.first.find('.', begin)) != std::string::npos) {
+      parts.emplace_back(histogram.first.substr(begin, end - begin));
+      begin = end + 1;
+    }
+    std::string name = parts.size() == 3 ? histogram.first.substr(begin) : histogram.first;
+    std::string labels = parts.size() == 3 ? "action=\"" + parts[0] + "\",level=\"" + parts[1] +
+                                                 "\",worker=\"" + parts[2] + "\""
+                                           : "";
+    std::replace_if(
+        name.begin(), name.end(), [](char c) { return !std::isalnum(c) && c != '_'; }, '_');
+    metrics["valhalla_" + name].emplace_back(std::move(labels), &histogram.second);
+  }
+
+  std::ostringstream text;
+  text.precision(15);
+  for (const auto& metric : metrics) {
+    text << "# TYPE " << metric.first << " histogram\n";
+    for (const auto& series : metric.second) {
+      const auto& labels = series.first;
+      const auto& histogram = *series.second;
+      const auto& bounds = midgard::metrics::bucket_bounds();
+      uint64_t cumulative = 0;
+      for (size_t i = 0; i < bounds.size(); ++i) {
+        cumulative += histogram.counts[i];
+        text << metric.first << "_bucket{" << labels << (labels.empty() ? "" : ",") << "le=\""
+             << bounds[i] << "\"} " << cumulative << '\n';
+      }
+      text << metric.first << "_bucket{" << labels << (labels.empty() ? "" : ",")
+           << "le=\"+Inf\"} " << histogram.count << '\n';
+      const auto braced = labels.empty() ? labels : "{" + labels + "}";
+      text << metric.first << "_sum" << braced << ' ' << histogram.sum << '\n';
+      text << metric.first << "_count" << braced << ' ' << histogram.count << '\n';
+    }
+  }
+  return text.str();
+}
+
 void ParseApi(const std::string& request, Options::Action action, valhalla::Api& api) {
   // maybe parse some json
   auto document = from_string(request, valhalla_exception_t{100});
@@ -1494,10 +1552,43 @@ struct statsd_client_t : public Statsd::StatsdClient {
   std::vector<std::string> tags;
 };
 
+namespace {
+// the blocks request arenas allocated on this thread past the ones they keep
+thread_local uint64_t arena_blocks_allocated = 0;
+
+void* allocate_arena_block(size_t size) {
+  ++arena_blocks_allocated;
+  return ::operator new(size);
+}
+
+void free_arena_block(void* block, size_t) {
+  ::operator delete(block);
+}
+} // namespace
+
+request_arena_t::request_arena_t(size_t block_size) : block(new char[block_size]) {
+  google::protobuf::ArenaOptions options;
+  options.initial_block = block.get();
+  options.initial_block_size = block_size;
+  options.block_alloc = &allocate_arena_block;
+  options.block_dealloc = &free_arena_block;
+  arena = std::make_unique<google::protobuf::Arena>(options);
+}
+
+Api& request_arena_t::next() {
+  // everything but the block we started with goes back to the heap
+  arena->Reset();
+  return *google::protobuf::Arena::Create<Api>(arena.get());
+}
+
 service_worker_t::service_worker_t(const boost::property_tree::ptree& conf) : interrupt(nullptr) {
   if (conf.count("statsd")) {
     statsd_client = std::make_unique<statsd_client_t>(conf);
   }
+  // the metrics are kept for the whole process once any worker is configured to keep them
+  if (conf.get<bool>("metrics.enabled", false)) {
+    midgard::metrics::enable(true);
+  }
 }
 service_worker_t::~service_worker_t() {
 }
@@ -1510,7 +1601,13 @@ void service_worker_t::cleanup() {
     statsd_client->flush();
   }
 }
+work_counters_t service_worker_t::counters() const {
+  return {};
+}
 void service_worker_t::enqueue_statistics(Api& api) const {
+  // the request is done so its stats go into the histograms of the process
+  record_metrics(api);
+
   // nothing to do without stats
   if (!statsd_client || !api.has_info() || api.info().statistics().empty())
     return;
@@ -1545,18 +1642,47 @@ void service_worker_t::enqueue_statistics(Api& api) const {
   }
 }
 
-midgard::Finally<std::function<void()>> service_worker_t::measure_scope_time(Api& api) const {
+midgard::Finally<std::function<void()>>
+service_worker_t::measure_scope_time(Api& api, const std::string& stage) const {
   // we copy the captures that could go out of scope
   auto start = std::chrono::steady_clock::now();
-  return midgard::Finally<std::function<void()>>([this, &api, start]() {
+  auto name = stage.empty() ? service_name() : stage;
+  auto* arena = stage.empty() ? api.GetArena() : nullptr;
+  auto arena_bytes = arena ? arena->SpaceUsed() : 0;
+  auto arena_blocks = arena_blocks_allocated;
+  // reading the counters is only worth it if they go anywhere
+  auto keep_counters = stage.empty() && midgard::metrics::enabled();
+  auto counters_start = keep_counters ? counters() : work_counters_t{};
+  return midgard::Finally<std::function<void()>>([this, &api, start, name, arena, arena_bytes,
+                                                  arena_blocks, keep_counters, counters_start]() {
     auto elapsed = std::chrono::steady_clock::now() - start;
     auto e = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(elapsed).count();
     const auto& action = Options_Action_Enum_Name(api.options().action());
+    auto add_stat = [&api, &action, &name](const char* metric, double value, StatisticType type) {
+      auto* stat = api.mutable_info()->mutable_statistics()->Add();
+      stat->set_key(action + ".info." + name + "." + metric);
+      stat->set_value(value);
+      stat->set_type(type);
+    };
+
+    add_stat("latency_ms", e, timing);
+
+    // how much the request grew in its arena in this stage and what that took from the heap
+    if (arena) {
+      add_stat("arena_bytes", arena->SpaceUsed() - arena_bytes, gauge);
+      add_stat("arena_blocks", arena_blocks_allocated - arena_blocks, count);
+    }
 
-    auto* stat = api.mutable_info()->mutable_statistics()->Add();
-    stat->set_key(action + ".info." + service_name() + ".latency_ms");
-    stat->set_value(e);
-    stat->set_type(timing);
+    // and the work it took to get there
+    if (keep_counters) {
+      auto counters_end = counters();
+      add_stat("tiles_fetched", counters_end.tiles_fetched - counters_start.tiles_fetched, count);
+      add_stat("tile_cache_misses",
+               counters_end.tile_cache_misses - counters_start.tile_cache_misses, count);
+      add_stat("expanded_edges", counters_end.expanded_edges - counters_start.expanded_edges,
+               count);
+      add_stat("edge_labels", counters_end.edge_labels - counters_start.edge_labels, count);
+    }
   });
 }
 
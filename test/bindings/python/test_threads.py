@@ -0,0 +1,94 @@
+# -*- coding: utf-8 -*-
+
+from concurrent.futures import ThreadPoolExecutor
+import json
+import os
+from pathlib import Path
+import tempfile
+import time
+import unittest
+from valhalla import Actor, get_config
+
+# routes between every two of a few places in utrecht
+PLACES = [
+    (52.0601766, 5.1005663),
+    (52.068882, 5.120852),
+    (52.0749799, 5.1141067),
+    (52.0763011, 5.1574637),
+    (52.0792731, 5.1343818),
+    (52.082829, 5.087129),
+    (52.08813, 5.03231),
+    (52.09987, 5.14913),
+]
+QUERIES = [
+    {"locations": [{"lat": a[0], "lon": a[1]}, {"lat": b[0], "lon": b[1]}], "costing": "auto"}
+    for a in PLACES
+    for b in PLACES
+    if a != b
+]
+
+
+class TestThreads(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        config = get_config(Path('test/data/utrecht_tiles'), Path('test/data/utrecht_tiles/tiles.tar'))
+        config['mjolnir']['logging']['type'] = ''
+        cls.config_file = tempfile.NamedTemporaryFile('w', suffix='.json', delete=False)
+        json.dump(config, cls.config_file)
+        cls.config_file.close()
+
+    @classmethod
+    def tearDownClass(cls):
+        os.remove(cls.config_file.name)
+
+    def test_batch(self):
+        actor = Actor(self.config_file.name, concurrency=4)
+        queries = QUERIES[:8] + [{"locations": [{"lat": 52.1, "lon": 5.1}], "costing": "auto"}]
+        results = actor.batch('route', queries)
+
+        # results come back in order with the same answers as one at a time, errors included
+        self.assertEqual(len(results), len(queries))
+        for query, result in zip(queries[:-1], results):
+            self.assertEqual(result, actor.route(query))
+        self.assertEqual(results[-1]['error_code'], 120)
+
+        # strings stay strings
+        str_results = actor.batch('route', [json.dumps(q) for q in queries[:2]])
+        self.assertEqual([json.loads(r) for r in str_results], results[:2])
+
+        with self.assertRaises(ValueError):
+            actor.batch('teleport', queries)
+        with self.assertRaises(ValueError):
+            actor.batch('route', [1])
+
+    def test_python_threads(self):
+        # the actors of the pool take turns between the threads that share them
+        actor = Actor(self.config_file.name, concurrency=2)
+        expected = [actor.route(query) for query in QUERIES[:16]]
+        with ThreadPoolExecutor(max_workers=8) as pool:
+            self.assertEqual(list(pool.map(actor.route, QUERIES[:16])), expected)
+
+    def test_scaling(self):
+        # not a pass/fail benchmark, it prints how the batch time and the python threads time go
+        # down with the concurrency, the answers have to be the same with any of them
+        expected = None
+        for concurrency in [1, 2, 4, 8]:
+            actor = Actor(self.config_file.name, concurrency=concurrency)
+            actor.batch('route', QUERIES)  # warm up the tile cache
+
+            start = time.perf_counter()
+            results = actor.batch('route', QUERIES)
+            batch_time = time.perf_counter() - start
+
+            start = time.perf_counter()
+            with ThreadPoolExecutor(max_workers=concurrency) as pool:
+                threaded = list(pool.map(actor.route, QUERIES))
+            thread_time = time.perf_counter() - start
+
+            expected = expected or results
+            self.assertEqual(results, expected)
+            self.assertEqual(threaded, expected)
+            print(
+                f'concurrency {concurrency}: {len(QUERIES)} routes in {batch_time * 1000:.0f}ms '
+                f'as a batch, {thread_time * 1000:.0f}ms from python threads'
+            )
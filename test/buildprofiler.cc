@@ -0,0 +1,108 @@
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "baldr/rapidjson_utils.h"
+#include "mjolnir/buildprofiler.h"
+
+#include "test.h"
+
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+
+namespace {
+
+const std::string report_file = "test/data/buildprofiler.json";
+
+rapidjson::Document report() {
+  std::stringstream json;
+  json << *BuildProfiler::Get().Report();
+  rapidjson::Document doc;
+  doc.Parse(json.str());
+  EXPECT_FALSE(doc.HasParseError());
+  return doc;
+}
+
+TEST(BuildProfiler, Disabled) {
+  auto& profiler = BuildProfiler::Get();
+  profiler.Enable("");
+  EXPECT_FALSE(profiler.enabled());
+  {
+    BuildProfiler::Stage stage(BuildStage::kBuild);
+    BuildProfiler::TileTimer timer(GraphId(1, 2, 0));
+  }
+  EXPECT_EQ(report()["stages"].Size(), 0);
+}
+
+TEST(BuildProfiler, Stages) {
+  auto& profiler = BuildProfiler::Get();
+  profiler.Enable(report_file);
+  ASSERT_TRUE(profiler.enabled());
+
+  // tiles outside of a stage are not counted
+  { BuildProfiler::TileTimer timer(GraphId(1, 2, 0)); }
+  { BuildProfiler::Stage stage(BuildStage::kParseWays); }
+  {
+    BuildProfiler::Stage stage(BuildStage::kEnhance);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+      threads.emplace_back([t]() {
+        for (uint32_t i = 0; i < 5; ++i) {
+          BuildProfiler::TileTimer timer(GraphId(t * 5 + i, 2, 0));
+          // make the last tile of the last thread the slowest by far
+          if (t == 3 && i == 4) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  auto doc = report();
+  const auto& stages = doc["stages"];
+  ASSERT_EQ(stages.Size(), 2);
+  EXPECT_EQ(std::string(stages[0]["stage"].GetString()), "parseways");
+  EXPECT_EQ(stages[0]["tiles"]["count"].GetUint64(), 0);
+  EXPECT_EQ(std::string(stages[1]["stage"].GetString()), "enhance");
+  EXPECT_GE(stages[1]["seconds"].GetDouble(), 0.02);
+  EXPECT_GT(stages[1]["peak_rss_bytes"].GetUint64(), 0);
+
+  const auto& tiles = stages[1]["tiles"];
+  EXPECT_EQ(tiles["count"].GetUint64(), 20);
+  uint64_t histogram_count = 0;
+  for (const auto& bucket : tiles["histogram"].GetArray()) {
+    histogram_count += bucket["count"].GetUint64();
+  }
+  EXPECT_EQ(histogram_count, 20);
+  ASSERT_EQ(tiles["slowest"].Size(), BuildProfiler::kSlowestTiles);
+  EXPECT_EQ(std::string(tiles["slowest"][0]["tile"].GetString()), "2/000/000/019.gph");
+  EXPECT_GE(tiles["slowest"][0]["seconds"].GetDouble(), 0.02);
+  ASSERT_EQ(tiles["threads"].Size(), 4);
+  for (const auto& thread : tiles["threads"].GetArray()) {
+    EXPECT_EQ(thread["tiles"].GetUint64(), 5);
+  }
+
+  // the report is written to the file we enabled it with
+  profiler.WriteReport();
+  std::ifstream file(report_file);
+  ASSERT_TRUE(file.is_open());
+  std::stringstream contents;
+  contents << file.rdbuf();
+  rapidjson::Document written;
+  written.Parse(contents.str());
+  ASSERT_FALSE(written.HasParseError());
+  EXPECT_EQ(written["stages"].Size(), 2);
+
+  profiler.Enable("");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -382,6 +382,26 @@ print 'do_polyline_pair(' + str(x).replace('[','{').replace(']','}') + ', \"' +
                    "zwI{{datFklv|wA~glffOgr``kD");
 }
 
+TEST(Encode, Range) {
+  const container_t points = {{-76.3002, 40.0433}, {-76.3036, 40.043}, {-76.3041, 40.0419},
+                              {-76.3102, 40.0401}, {-76.3131, 40.0392}};
+
+  // a slice encodes the same as a copy of it and gets appended to what is already there
+  for (int precision : {static_cast<int>(1e5), static_cast<int>(1e6)}) {
+    std::string encoded = "prefix";
+    encode(points.begin() + 1, points.begin() + 4, encoded, precision);
+    EXPECT_EQ(encoded,
+              "prefix" + encode(container_t(points.begin() + 1, points.begin() + 4), precision));
+  }
+  std::string encoded;
+  encode(points.begin(), points.begin(), encoded);
+  EXPECT_TRUE(encoded.empty());
+
+  // and decoding a 6 digit polyline and encoding it again gives back the same string
+  auto polyline6 = encode(points);
+  EXPECT_EQ(encode(decode<container_t>(polyline6)), polyline6);
+}
+
 TEST(Encode, VarInt) {
   do_varint_pair({{41.37084, -5.03016}, {76.8342, 42.01251}});
   do_varint_pair({{-86.36737, 90.75251},   {22.62106, 29.07404},    {-29.06206, -163.63365},
@@ -0,0 +1,92 @@
+#include "gurka.h"
+#include "midgard/metrics.h"
+
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+
+using namespace valhalla;
+
+TEST(Metrics, StagesStatusAndPrometheus) {
+  const std::string ascii_map = R"(
+    A----B----C
+         |
+         D----E
+  )";
+  const gurka::ways ways = {
+      {"ABC", {{"highway", "primary"}}},
+      {"BD", {{"highway", "residential"}}},
+      {"DE", {{"highway", "secondary"}}},
+  };
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, 100);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/gurka_metrics");
+  map.config.put("metrics.enabled", true);
+  map.config.put("service_limits.status.allow_verbose", true);
+  midgard::metrics::clear();
+
+  // every stage says what work it did for the request
+  auto result = gurka::do_action(Options::route, map, {"A", "E"}, "auto");
+  std::unordered_map<std::string, double> stats;
+  for (const auto& stat : result.info().statistics()) {
+    stats[stat.key()] = stat.value();
+  }
+  EXPECT_GT(stats["route.info.loki.tiles_fetched"], 0);
+  EXPECT_GT(stats["route.info.loki.tile_cache_misses"], 0);
+  EXPECT_GT(stats["route.info.thor.tiles_fetched"], 0);
+  EXPECT_GT(stats["route.info.thor.expanded_edges"], 0);
+  EXPECT_GE(stats["route.info.thor.edge_labels"], stats["route.info.thor.expanded_edges"]);
+  EXPECT_TRUE(stats.count("route.info.odin.latency_ms"));
+  EXPECT_TRUE(stats.count("route.info.tyr.latency_ms"));
+
+  // and those end up in the histograms the status returns
+  std::string json;
+  gurka::do_action(Options::status, map, R"({"verbose":true})", {}, &json);
+  rapidjson::Document status;
+  status.Parse(json.c_str());
+  ASSERT_TRUE(status.HasMember("metrics")) << json;
+  const auto& expanded = status["metrics"]["route.info.thor.expanded_edges"];
+  EXPECT_EQ(expanded["count"].GetUint64(), 1u);
+  EXPECT_DOUBLE_EQ(expanded["sum"].GetDouble(), stats["route.info.thor.expanded_edges"]);
+  EXPECT_DOUBLE_EQ(expanded["max"].GetDouble(), stats["route.info.thor.expanded_edges"]);
+  EXPECT_LE(expanded["p50"].GetDouble(), expanded["max"].GetDouble());
+
+  // not without verbose though
+  gurka::do_action(Options::status, map, "{}", {}, &json);
+  status.Parse(json.c_str());
+  EXPECT_FALSE(status.HasMember("metrics")) << json;
+
+  // and as prometheus text
+  auto text = metrics_to_prometheus();
+  EXPECT_NE(text.find("# TYPE valhalla_expanded_edges histogram\n"), std::string::npos) << text;
+  EXPECT_NE(text.find("valhalla_expanded_edges_bucket{action=\"route\",level=\"info\",worker="
+                      "\"thor\",le=\"+Inf\"} 1\n"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("valhalla_latency_ms_count{action=\"route\",level=\"info\",worker="
+                      "\"tyr\"} 1\n"),
+            std::string::npos)
+      << text;
+
+  midgard::metrics::enable(false);
+  midgard::metrics::clear();
+}
+
+TEST(Metrics, Disabled) {
+  // without the config the counters aren't read
+  const std::string ascii_map = R"(
+    A----B----C
+  )";
+  const gurka::ways ways = {{"ABC", {{"highway", "primary"}}}};
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, 100);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/gurka_metrics_disabled");
+  midgard::metrics::enable(false);
+
+  auto result = gurka::do_action(Options::route, map, {"A", "C"}, "auto");
+  bool latency = false;
+  for (const auto& stat : result.info().statistics()) {
+    EXPECT_EQ(stat.key().find("expanded_edges"), std::string::npos) << stat.key();
+    latency = latency || stat.key() == "route.info.thor.latency_ms";
+  }
+  EXPECT_TRUE(latency);
+  EXPECT_TRUE(midgard::metrics::snapshot().empty());
+}
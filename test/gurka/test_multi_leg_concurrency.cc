@@ -0,0 +1,67 @@
+#include "gurka.h"
+#include "test.h"
+
+#include <gtest/gtest.h>
+
+using namespace valhalla;
+
+class MultiLegConcurrency : public ::testing::Test {
+protected:
+  static gurka::map map;
+
+  static void SetUpTestSuite() {
+    const std::string ascii_map = R"(
+      A-----B-----C-----D
+      |     |     |     |
+      E-----F-----G-----H
+      |     |     |     |
+      I-----J-----K-----L
+      |     |     |     |
+      M-----N-----O-----P
+    )";
+
+    const gurka::ways ways = {
+        {"ABCD", {{"highway", "primary"}}},     {"EFGH", {{"highway", "residential"}}},
+        {"IJKL", {{"highway", "secondary"}}},   {"MNOP", {{"highway", "tertiary"}}},
+        {"AEIM", {{"highway", "residential"}}}, {"BFJN", {{"highway", "primary"}}},
+        {"CGKO", {{"highway", "tertiary"}}},    {"DHLP", {{"highway", "secondary"}}},
+    };
+    const auto layout = gurka::detail::map_to_coordinates(ascii_map, 100);
+    map = gurka::buildtiles(layout, ways, {}, {}, "test/data/multi_leg_concurrency");
+  }
+
+  // routes the waypoints once serially and once with the legs computed concurrently
+  static void expect_same_route(const std::vector<std::string>& waypoints) {
+    std::string serial_json, concurrent_json;
+    auto serial_map = map;
+    serial_map.config.put("thor.max_leg_concurrency", 1);
+    auto serial =
+        gurka::do_action(Options::route, serial_map, waypoints, "auto", {}, {}, &serial_json);
+
+    auto concurrent_map = map;
+    concurrent_map.config.put("thor.max_leg_concurrency", 4);
+    auto concurrent = gurka::do_action(Options::route, concurrent_map, waypoints, "auto", {}, {},
+                                       &concurrent_json);
+
+    const int leg_count = waypoints.size() - 1;
+    ASSERT_EQ(serial.trip().routes(0).legs_size(), leg_count);
+    ASSERT_EQ(concurrent.trip().routes(0).legs_size(), leg_count);
+    EXPECT_EQ(serial_json, concurrent_json);
+  }
+};
+
+gurka::map MultiLegConcurrency::map = {};
+
+TEST_F(MultiLegConcurrency, same_as_serial) {
+  expect_same_route({"A", "P"});
+  expect_same_route({"A", "G", "P"});
+  expect_same_route({"A", "G", "N", "D", "I", "P", "B", "L", "M", "C", "F"});
+}
+
+TEST_F(MultiLegConcurrency, more_legs_than_workers) {
+  std::vector<std::string> waypoints;
+  for (int i = 0; i < 25; ++i) {
+    waypoints.emplace_back(1, "AFKPDGJM"[i % 8]);
+  }
+  expect_same_route(waypoints);
+}
@@ -0,0 +1,129 @@
+#include <fstream>
+
+#include "baldr/graphreader.h"
+#include "baldr/tilehierarchy.h"
+#include "gurka.h"
+#include "mjolnir/osmchange.h"
+
+#include <gtest/gtest.h>
+
+using namespace valhalla;
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+
+const std::string workdir = "test/data/gurka_osmchange";
+
+class OSMChangeTest : public ::testing::Test {
+protected:
+  static gurka::map map;
+  static gurka::nodelayout layout;
+
+  static void SetUpTestSuite() {
+    // two roads far enough apart to land in different local tiles
+    const std::string ascii_map = R"(
+      A-B                                                            C-D
+    )";
+    const gurka::ways ways = {
+        {"AB", {{"highway", "residential"}, {"osm_id", "100"}}},
+        {"CD", {{"highway", "residential"}, {"osm_id", "200"}}},
+    };
+    layout = gurka::detail::map_to_coordinates(ascii_map, 1000, {0.1, 0.1});
+    map = gurka::buildtiles(layout, ways, {}, {}, workdir);
+  }
+};
+
+gurka::map OSMChangeTest::map = {};
+gurka::nodelayout OSMChangeTest::layout = {};
+
+TEST_F(OSMChangeTest, ParseOSMChange) {
+  const std::string file = workdir + "/changes.osc";
+  std::ofstream(file) << R"(<?xml version='1.0' encoding='UTF-8'?>
+<osmChange version="0.6" generator="test">
+  <modify>
+    <node id="12" version="2" lat="0.15" lon="0.2"/>
+    <way id="100" version="3"><nd ref="12"/><nd ref="13"/><tag k="highway" v="primary"/></way>
+  </modify>
+  <delete>
+    <node id="14" version="3"/>
+  </delete>
+  <create>
+    <relation id="7" version="1">
+      <member type="way" ref="102" role="from"/>
+      <member type="node" ref="15" role="via"/>
+    </relation>
+  </create>
+</osmChange>)";
+
+  OSMChange change;
+  ParseOSMChange(file, change);
+  EXPECT_EQ(change.nodes, (std::unordered_set<uint64_t>{12, 14, 15}));
+  EXPECT_EQ(change.ways, (std::unordered_set<uint64_t>{100, 102}));
+  EXPECT_EQ(change.relations, (std::unordered_set<uint64_t>{7}));
+  ASSERT_EQ(change.locations.size(), 1);
+  EXPECT_NEAR(change.locations.front().lng(), 0.2, 1e-6);
+  EXPECT_NEAR(change.locations.front().lat(), 0.15, 1e-6);
+
+  EXPECT_THROW(ParseOSMChange(workdir + "/missing.osc", change), std::runtime_error);
+}
+
+TEST_F(OSMChangeTest, AffectedTiles) {
+  GraphReader reader(map.config.get_child("mjolnir"));
+  const auto local_level = TileHierarchy::levels().back().level;
+  const auto ab_tile = TileHierarchy::GetGraphId(layout.at("A"), local_level);
+  const auto cd_tile = TileHierarchy::GetGraphId(layout.at("C"), local_level);
+  ASSERT_NE(ab_tile, cd_tile);
+
+  // a changed way affects its own tiles and the levels above them but not the other road
+  OSMChange change;
+  change.ways.insert(100);
+  auto tiles = AffectedTiles(reader, change);
+  EXPECT_TRUE(tiles.count(ab_tile));
+  EXPECT_TRUE(tiles.count(TileHierarchy::GetGraphId(layout.at("A"), 0)));
+  EXPECT_FALSE(tiles.count(cd_tile));
+
+  // a changed node affects the tile it is in
+  change = OSMChange{};
+  change.locations.push_back(layout.at("D"));
+  tiles = AffectedTiles(reader, change);
+  EXPECT_TRUE(tiles.count(cd_tile));
+  EXPECT_FALSE(tiles.count(ab_tile));
+
+  // nothing changed nothing affected
+  EXPECT_TRUE(AffectedTiles(reader, OSMChange{}).empty());
+}
+
+TEST_F(OSMChangeTest, AffectedTilesDensityRadius) {
+  GraphReader reader(map.config.get_child("mjolnir"));
+  const auto local_level = TileHierarchy::levels().back().level;
+
+  // a node changed about 1.7km from the next tile changes the road density in that tile too
+  OSMChange change;
+  change.locations.emplace_back(0.235, 0.1);
+  auto tiles = AffectedTiles(reader, change);
+  EXPECT_TRUE(tiles.count(TileHierarchy::GetGraphId({0.235, 0.1}, local_level)));
+  EXPECT_TRUE(tiles.count(TileHierarchy::GetGraphId({0.26, 0.1}, local_level)));
+  EXPECT_FALSE(tiles.count(TileHierarchy::GetGraphId({0.235, -0.1}, local_level)));
+}
+
+TEST_F(OSMChangeTest, ParsePreviousState) {
+  // osm ids are handed out to the nodes in name order, starting at 0
+  const uint64_t d_id = 3;
+  OSMChange change;
+  change.nodes.insert(d_id);
+  ParsePreviousState({workdir + "/map.pbf"}, change);
+
+  // the way using the node changes with it and we know where the node was
+  EXPECT_EQ(change.ways, (std::unordered_set<uint64_t>{200}));
+  ASSERT_EQ(change.locations.size(), 1);
+  EXPECT_NEAR(change.locations.front().lng(), layout.at("D").lng(), 1e-6);
+  EXPECT_NEAR(change.locations.front().lat(), layout.at("D").lat(), 1e-6);
+
+  // which is enough to find its tile even if the change file never said where the node was
+  GraphReader reader(map.config.get_child("mjolnir"));
+  const auto local_level = TileHierarchy::levels().back().level;
+  auto tiles = AffectedTiles(reader, change);
+  EXPECT_TRUE(tiles.count(TileHierarchy::GetGraphId(layout.at("C"), local_level)));
+  EXPECT_FALSE(tiles.count(TileHierarchy::GetGraphId(layout.at("A"), local_level)));
+
+  EXPECT_THROW(ParsePreviousState({workdir + "/missing.pbf"}, change), std::runtime_error);
+}
@@ -1177,3 +1177,122 @@ TEST_F(Rotary, EndOnRotary) {
   EXPECT_STREQ(primary_0["type"].GetString(), "rotary");
   ASSERT_TRUE(primary_0.HasMember("degrees"));
 }
+
+TEST(Standalone, NarrativeOnlyWhatTheFormatUses) {
+  const std::string ascii_map = R"(
+    A----B----C
+         |
+         D
+  )";
+  const gurka::ways ways = {
+      {"ABC", {{"highway", "primary"}, {"name", "Main Street"}}},
+      {"BD", {{"highway", "primary"}, {"name", "Side Street"}}},
+  };
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, 100);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/osrm_serializer_narrative");
+
+  // osrm without voice instructions only needs the text instructions
+  auto result = gurka::do_action(Options::route, map, {"A", "D"}, "auto", {{"/format", "osrm"}});
+  const auto& leg = result.directions().routes(0).legs(0);
+  ASSERT_GT(leg.maneuver_size(), 0);
+  for (const auto& maneuver : leg.maneuver()) {
+    EXPECT_FALSE(maneuver.text_instruction().empty());
+    EXPECT_TRUE(maneuver.verbal_pre_transition_instruction().empty());
+    EXPECT_TRUE(maneuver.verbal_post_transition_instruction().empty());
+  }
+
+  // with them and in valhalla's own format the verbal ones are there too
+  for (const auto& options : std::vector<std::unordered_map<std::string, std::string>>{
+           {{"/format", "osrm"}, {"/voice_instructions", "1"}}, {}}) {
+    result = gurka::do_action(Options::route, map, {"A", "D"}, "auto", options);
+    const auto& maneuver = result.directions().routes(0).legs(0).maneuver(0);
+    EXPECT_FALSE(maneuver.text_instruction().empty());
+    EXPECT_FALSE(maneuver.verbal_pre_transition_instruction().empty());
+  }
+
+  // and gpx has no use for any maneuvers
+  result = gurka::do_action(Options::route, map, {"A", "D"}, "auto", {{"/format", "gpx"}});
+  EXPECT_EQ(result.directions().routes(0).legs(0).maneuver_size(), 0);
+  EXPECT_GT(result.trip().routes(0).legs(0).node_size(), 0);
+}
+
+namespace {
+
+using shape_t = std::vector<midgard::PointLL>;
+
+// The geometries the osrm serializer made before it cut them from one decoded leg shape, each
+// step copied out of its own decoding of the leg and the route geometry decoded leg by leg
+void previous_geometries(const DirectionsRoute& directions,
+                         const std::string& format,
+                         rapidjson::Value& route,
+                         rapidjson::Document::AllocatorType& allocator) {
+  const int precision = format == "polyline6" ? 1e6 : 1e5;
+  shape_t route_shape;
+  if (directions.legs_size() == 1 && format == "polyline6") {
+    route_shape = midgard::decode<shape_t>(directions.legs(0).shape());
+  } else {
+    for (const auto& leg : directions.legs()) {
+      auto leg_shape = midgard::decode<shape_t>(leg.shape());
+      route_shape.insert(route_shape.end(),
+                         route_shape.size() ? leg_shape.begin() + 1 : leg_shape.begin(),
+                         leg_shape.end());
+    }
+  }
+  route["geometry"].SetString(midgard::encode(route_shape, precision), allocator);
+
+  for (rapidjson::SizeType i = 0; i < route["legs"].Size(); ++i) {
+    const auto& leg = directions.legs(i);
+    auto shape = midgard::decode<shape_t>(leg.shape());
+    auto& steps = route["legs"][i]["steps"];
+    ASSERT_EQ(steps.Size(), static_cast<rapidjson::SizeType>(leg.maneuver_size()));
+    for (rapidjson::SizeType j = 0; j < steps.Size(); ++j) {
+      const auto& maneuver = leg.maneuver(j);
+      shape_t maneuver_shape(shape.begin() + maneuver.begin_shape_index(),
+                             shape.begin() + maneuver.end_shape_index() + 1);
+      if (j == steps.Size() - 1) {
+        maneuver_shape.push_back(shape.back());
+      }
+      steps[j]["geometry"].SetString(midgard::encode(maneuver_shape, precision), allocator);
+    }
+  }
+}
+
+} // namespace
+
+TEST(Standalone, StepGeometriesMatchThePreviousSerializer) {
+  const std::string ascii_map = R"(
+    A----B----C
+         |    |
+         D----E----F
+  )";
+  const gurka::ways ways = {
+      {"ABC", {{"highway", "primary"}}},
+      {"BD", {{"highway", "primary"}}},
+      {"CE", {{"highway", "primary"}}},
+      {"DEF", {{"highway", "primary"}}},
+  };
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, 100);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/osrm_serializer_step_geometry");
+
+  const std::vector<std::vector<std::string>> requests = {{"A", "F"},
+                                                          {"A", "D", "F"},
+                                                          {"A", "C", "D", "F"}};
+  for (const auto& format : std::vector<std::string>{"polyline5", "polyline6"}) {
+    for (const auto& waypoints : requests) {
+      auto result = gurka::do_action(Options::route, map, waypoints, "auto",
+                                     {{"/shape_format", format}});
+      auto json = gurka::convert_to_json(result, Options::Format::Options_Format_osrm);
+      ASSERT_FALSE(json.HasParseError());
+      const auto& directions = result.directions().routes(0);
+      ASSERT_EQ(json["routes"][0]["legs"].Size(),
+                static_cast<rapidjson::SizeType>(directions.legs_size()));
+
+      // the whole response is the same as the one with the geometries made the previous way
+      rapidjson::Document expected;
+      expected.CopyFrom(json, expected.GetAllocator());
+      previous_geometries(directions, format, expected["routes"][0], expected.GetAllocator());
+      EXPECT_EQ(rapidjson::to_string(json), rapidjson::to_string(expected))
+          << format << " " << waypoints.size() - 1 << " legs";
+    }
+  }
+}
@@ -110,6 +110,8 @@ TEST(pbf_api, pbf_in_out) {
       EXPECT_FALSE(actual_slimmed.has_options());
       EXPECT_TRUE(actual_slimmed.has_trip() || action == Options::status ||
                   action == Options::sources_to_targets || action == Options::isochrone);
+      // the trip is the same without the maneuvers, down to the headings odin fixes up
+      EXPECT_EQ(actual_slimmed.trip().SerializeAsString(), expected_pbf.trip().SerializeAsString());
       EXPECT_FALSE(actual_slimmed.has_directions());
       EXPECT_FALSE(actual_slimmed.has_status());
       EXPECT_TRUE(actual_slimmed.has_info() || action == Options::status);
@@ -160,3 +162,63 @@ TEST(pbf_api, pbf_error) {
     api.mutable_options()->set_action(Options::route);
   }
 }
+
+TEST(pbf_api, pbf_arena) {
+  const std::string ascii_map = R"(
+    A----B----C
+         |
+         D----E)";
+  const gurka::ways ways = {
+      {"ABC", {{"highway", "primary"}}},
+      {"BD", {{"highway", "residential"}}},
+      {"DE", {{"highway", "secondary"}}},
+  };
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, 10);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/gurka_api_arena");
+
+  // a route request as a protobuf client would send it
+  std::string json, request_json;
+  gurka::do_action(Options::route, map, {"A", "E"}, "auto", {}, {}, &json, "break", &request_json);
+  Api request;
+  ParseApi(request_json, Options::route, request);
+  request.mutable_options()->clear_costings();
+  request.mutable_options()->set_format(Options::pbf);
+  auto request_bytes = request.SerializeAsString();
+
+  // the same request parsed into a message of its own
+  tyr::actor_t actor(map.config, true);
+  Api expected;
+  ASSERT_TRUE(expected.ParseFromString(request_bytes));
+  Api expected_response;
+  ASSERT_TRUE(expected_response.ParseFromString(actor.act(expected)));
+
+  // the arena is reused so the second time around the request fits in what it already has
+  for (int i = 0; i < 2; ++i) {
+    Api response;
+    ASSERT_TRUE(response.ParseFromString(actor.act(request_bytes.data(), request_bytes.size())));
+    EXPECT_EQ(response.directions().SerializeAsString(),
+              expected_response.directions().SerializeAsString());
+
+    // each stage says what it took from the arena
+    std::unordered_map<std::string, double> stats;
+    for (const auto& stat : response.info().statistics()) {
+      stats[stat.key()] = stat.value();
+    }
+    for (const auto& stage : {"loki", "thor", "odin"}) {
+      const auto prefix = std::string("route.info.") + stage;
+      ASSERT_TRUE(stats.count(prefix + ".arena_bytes")) << prefix;
+      ASSERT_TRUE(stats.count(prefix + ".arena_blocks")) << prefix;
+      EXPECT_GT(stats[prefix + ".arena_bytes"], 0) << prefix;
+      EXPECT_EQ(stats[prefix + ".arena_blocks"], 0) << prefix;
+    }
+  }
+
+  // which isn't there for requests that aren't in an arena
+  for (const auto& stat : expected_response.info().statistics()) {
+    EXPECT_EQ(stat.key().find("arena"), std::string::npos) << stat.key();
+  }
+
+  // bytes that aren't a request
+  const std::string garbage = "\xff\xff\xff";
+  EXPECT_THROW(actor.act(garbage.data(), garbage.size()), valhalla_exception_t);
+}
@@ -0,0 +1,221 @@
+#include "baldr/graphreader.h"
+#include "filesystem.h"
+#include "gurka.h"
+#include "midgard/sequence.h"
+#include "mjolnir/tileextractbuilder.h"
+#include "mjolnir/util.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+using namespace valhalla;
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+
+const std::string workdir = "test/data/gurka_tile_extract";
+
+namespace {
+
+// gets at the extract a reader uses
+class ExtractReader : public GraphReader {
+public:
+  using GraphReader::GraphReader;
+  using GraphReader::tile_extract_;
+};
+
+// a plain tar of the tiles without an index.bin
+void write_plain_tar(const boost::property_tree::ptree& config, const std::string& tar_file) {
+  GraphReader reader(config.get_child("mjolnir"));
+  std::ofstream out(tar_file, std::ios::binary | std::ios::trunc);
+  for (const auto& tile_id : reader.GetTileSet()) {
+    std::ifstream in(reader.tile_dir() + "/" + GraphTile::FileSuffix(tile_id), std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto name = GraphTile::FileSuffix(tile_id, SUFFIX_NON_COMPRESSED, false);
+    test::write_tar_entry(out, name, data, data.size());
+  }
+  out.write(std::string(2 * sizeof(midgard::tar::header_t), '\0').data(),
+            2 * sizeof(midgard::tar::header_t));
+}
+
+} // namespace
+
+class TileExtract : public ::testing::TestWithParam<std::string> {
+protected:
+  static gurka::map map;
+
+  static void SetUpTestSuite() {
+    const std::string ascii_map = R"(
+      A----B----C
+           |
+           D----E
+    )";
+    const gurka::ways ways = {
+        {"ABC", {{"highway", "primary"}}},
+        {"BD", {{"highway", "residential"}}},
+        {"DE", {{"highway", "motorway"}}},
+    };
+    // spread the map over a few tiles
+    const auto layout = gurka::detail::map_to_coordinates(ascii_map, 10000, {-0.3, -0.2});
+    map = gurka::buildtiles(layout, ways, {}, {}, workdir);
+  }
+};
+
+gurka::map TileExtract::map = {};
+
+TEST_P(TileExtract, MatchesTileDir) {
+  // pack the tiles with the last stage of the build
+  const auto extract = workdir + "/tiles_" + GetParam() + ".tar";
+  auto config = map.config;
+  config.put("mjolnir.tile_extract", extract);
+  config.put("mjolnir.build_extract", true);
+  config.put("mjolnir.extract_tile_order", GetParam());
+  ASSERT_TRUE(build_tile_set(config, {}, BuildStage::kCleanup, BuildStage::kCleanup));
+
+  GraphReader dir_reader(map.config.get_child("mjolnir"));
+  GraphReader tar_reader(config.get_child("mjolnir"));
+  ASSERT_EQ(tar_reader.GetTileSetLocation(), extract);
+  auto tiles = dir_reader.GetTileSet();
+  ASSERT_GT(tiles.size(), 1);
+  EXPECT_EQ(tar_reader.GetTileSet(), tiles);
+  for (const auto& tile_id : tiles) {
+    auto dir_tile = dir_reader.GetGraphTile(tile_id);
+    auto tar_tile = tar_reader.GetGraphTile(tile_id);
+    ASSERT_TRUE(tar_tile);
+    ASSERT_EQ(dir_tile->header()->end_offset(), tar_tile->header()->end_offset());
+    EXPECT_EQ(memcmp(dir_tile->header(), tar_tile->header(), dir_tile->header()->end_offset()), 0);
+  }
+
+  // every tile starts on a page and the tar is readable without the index
+  midgard::tar archive(extract);
+  EXPECT_EQ(archive.corrupt_blocks, 0);
+  std::map<const char*, GraphId> tar_order;
+  for (const auto& entry : archive.contents) {
+    if (entry.first == "index.bin") {
+      EXPECT_EQ(entry.second.second, tiles.size() * sizeof(tile_index_entry));
+      continue;
+    }
+    EXPECT_EQ((entry.second.first - archive.mm.get()) % TileExtractBuilder::kAlignment, 0);
+    tar_order.emplace(entry.second.first, GraphTile::GetTileId(entry.first));
+    EXPECT_TRUE(tiles.count(tar_order[entry.second.first]));
+  }
+  EXPECT_EQ(tar_order.size(), tiles.size());
+
+  // by id its one level after the other
+  if (GetParam() == std::string("id")) {
+    auto by_level = [](const auto& a, const auto& b) {
+      return std::make_pair(a.second.level(), a.second.tileid()) <
+             std::make_pair(b.second.level(), b.second.tileid());
+    };
+    EXPECT_TRUE(std::is_sorted(tar_order.begin(), tar_order.end(), by_level));
+  }
+
+  // and routes the same
+  auto reader = std::make_shared<GraphReader>(config.get_child("mjolnir"));
+  auto result = gurka::do_action(Options::route, map, {"A", "E"}, "auto", {}, reader);
+  gurka::assert::raw::expect_path(result, {"ABC", "BD", "DE"});
+}
+
+INSTANTIATE_TEST_SUITE_P(TileOrder, TileExtract, ::testing::Values("id", "hilbert", "hilbert_level"));
+
+TEST(TileExtractBuilder, HilbertIndex) {
+  // tiles next to each other are closer on the curve than tiles on the other side of the world
+  const auto& tiles = TileHierarchy::levels().back().tiles;
+  auto here = tiles.TileId(midgard::PointLL{5.1, 52.1});
+  auto next = tiles.TileId(midgard::PointLL{5.4, 52.1});
+  auto there = tiles.TileId(midgard::PointLL{-70.1, -33.4});
+  auto distance = [](uint64_t a, uint64_t b) { return a > b ? a - b : b - a; };
+  auto index = [](int32_t tile) { return TileExtractBuilder::HilbertIndex(GraphId(tile, 2, 0)); };
+  EXPECT_LT(distance(index(here), index(next)), distance(index(here), index(there)));
+
+  // the highway tile over an area sorts near the local tiles inside of it
+  auto highway = TileHierarchy::GetGraphId(midgard::PointLL{5.1, 52.1}, 0);
+  EXPECT_LT(distance(TileExtractBuilder::HilbertIndex(highway), index(here)),
+            distance(index(here), index(there)));
+}
+
+TEST(TileExtractWarmup, Status) {
+  const std::string ascii_map = R"(
+    A----B----C
+  )";
+  const gurka::ways ways = {{"ABC", {{"highway", "primary"}}}};
+  const auto layout = gurka::detail::map_to_coordinates(ascii_map, 100);
+  auto map = gurka::buildtiles(layout, ways, {}, {}, "test/data/gurka_tile_extract_warmup");
+  const auto extract = map.config.get<std::string>("mjolnir.tile_dir") + ".tar";
+  TileExtractBuilder::Build(map.config, extract);
+  map.config.put("mjolnir.tile_extract", extract);
+
+  // nothing to report without a warm-up
+  auto reader = std::make_shared<GraphReader>(map.config.get_child("mjolnir"));
+  EXPECT_FALSE(reader->GetExtractWarmupProgress());
+  std::string json;
+  gurka::do_action(Options::status, map, "{}", reader, &json);
+  EXPECT_EQ(json.find("warmup_progress"), std::string::npos);
+
+  // a blocking warm-up is done before the reader is, locking it implies one. if the memlock limit
+  // is too low the extract is still warmed up
+  for (const auto& option : {"tile_extract_warmup", "tile_extract_lock"}) {
+    auto config = map.config;
+    config.put(std::string("mjolnir.") + option,
+               std::string(option) == "tile_extract_lock" ? "true" : "blocking");
+    reader = std::make_shared<GraphReader>(config.get_child("mjolnir"));
+    ASSERT_TRUE(reader->GetExtractWarmupProgress());
+    EXPECT_EQ(*reader->GetExtractWarmupProgress(), 1.f);
+    gurka::do_action(Options::status, map, "{}", reader, &json);
+    EXPECT_NE(json.find(R"("warmup_progress":1)"), std::string::npos) << json;
+  }
+
+  // a background warm-up can go away with the reader while it's still running
+  auto config = map.config;
+  config.put("mjolnir.tile_extract_warmup", "background");
+  config.put("mjolnir.tile_extract_hugepages", true);
+  reader = std::make_shared<GraphReader>(config.get_child("mjolnir"));
+  auto progress = reader->GetExtractWarmupProgress();
+  ASSERT_TRUE(progress);
+  EXPECT_GE(*progress, 0.f);
+  EXPECT_LE(*progress, 1.f);
+  reader.reset();
+
+  config.put("mjolnir.tile_extract_warmup", "eventually");
+  EXPECT_THROW(GraphReader(config.get_child("mjolnir")), std::runtime_error);
+}
+
+TEST_F(TileExtract, SharedAndSideIndex) {
+  // readers of the same extract in a process share it
+  const auto extract = workdir + "/tiles_plain.tar";
+  write_plain_tar(map.config, extract);
+  auto config = map.config;
+  config.put("mjolnir.tile_extract", extract);
+  ExtractReader first(config.get_child("mjolnir"));
+  ExtractReader second(config.get_child("mjolnir"));
+  EXPECT_EQ(first.tile_extract_, second.tile_extract_);
+  ASSERT_GT(first.GetTileSet().size(), 1);
+  EXPECT_EQ(first.GetTileSet(), GraphReader(map.config.get_child("mjolnir")).GetTileSet());
+
+  // without an index.bin the tar is scanned once and an index of it is written to the side
+  const auto side_index = extract + ".index";
+  std::remove(side_index.c_str());
+  config.put("mjolnir.tile_extract_index", side_index);
+  ExtractReader scanned(config.get_child("mjolnir"));
+  EXPECT_NE(scanned.tile_extract_, first.tile_extract_);
+  EXPECT_EQ(scanned.GetTileSet(), first.GetTileSet());
+  ASSERT_TRUE(filesystem::exists(side_index));
+
+  // which another process then loads. cut it down to one tile to tell it's really used
+  {
+    std::fstream index(side_index, std::ios::binary | std::ios::in | std::ios::out);
+    uint64_t count = 1;
+    index.seekp(3 * sizeof(uint64_t));
+    index.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  }
+  config.put("mjolnir.max_cache_size", 1 << 20);
+  ExtractReader indexed(config.get_child("mjolnir"));
+  EXPECT_NE(indexed.tile_extract_, scanned.tile_extract_);
+  auto tiles = indexed.GetTileSet();
+  ASSERT_EQ(tiles.size(), 1);
+  EXPECT_TRUE(first.GetTileSet().count(*tiles.begin()));
+  EXPECT_TRUE(indexed.GetGraphTile(*tiles.begin()));
+}
@@ -1,6 +1,7 @@
 #include "test.h"
 
 #include "baldr/curl_tilegetter.h"
+#include "baldr/graphreader.h"
 #include "baldr/graphtile.h"
 #include "tyr/actor.h"
 #include "valhalla/tile_server.h"
@@ -8,6 +9,7 @@
 #include <prime_server/prime_server.hpp>
 
 #include <filesystem>
+#include <fstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -266,6 +268,72 @@ TEST(HttpTiles, test_interrupt) {
   }
 }
 
+void test_prefetch(const std::string& tile_dir, bool tile_url_gz, size_t concurrency) {
+  TestTileDownloadData params;
+  auto conf = make_conf(tile_dir, tile_url_gz, 2);
+  baldr::GraphReader reader(conf.get_child("mjolnir"));
+
+  // all but the non-existent tile should make it into the cache
+  auto tile_ids = params.test_tile_ids;
+  tile_ids.push_back(tile_ids.front());
+  EXPECT_EQ(reader.PrefetchTiles(tile_ids, concurrency), params.test_tile_ids.size() - 1);
+  for (const auto& id : params.test_tile_ids) {
+    auto tile = reader.GetGraphTile(id);
+    if (id == params.get_nonexistent_tile_id()) {
+      EXPECT_FALSE(tile) << "Expected no tile";
+      continue;
+    }
+    ASSERT_TRUE(tile);
+    EXPECT_EQ(tile->id(), id);
+    if (!tile_dir.empty()) {
+      auto suffix = baldr::GraphTile::FileSuffix(id, tile_url_gz ? baldr::SUFFIX_COMPRESSED
+                                                                 : baldr::SUFFIX_NON_COMPRESSED);
+      EXPECT_TRUE(std::filesystem::exists(tile_dir + "/" + suffix)) << suffix;
+    }
+  }
+
+  // a second round is served from memory
+  EXPECT_EQ(reader.PrefetchTiles(params.test_tile_ids, concurrency),
+            params.test_tile_ids.size() - 1);
+}
+
+TEST(HttpTiles, test_prefetch_no_cache) {
+  test_prefetch("", false, 3);
+  test_prefetch("", true, 1);
+}
+
+TEST_F(HttpTilesWithCache, test_prefetch_cache) {
+  test_prefetch("url_tile_cache", false, 4);
+}
+
+TEST_F(HttpTilesWithCache, test_prefetch_cache_gz) {
+  test_prefetch("url_tile_cache", true, 0);
+}
+
+TEST_F(HttpTilesWithCache, test_prefetch_unreadable_tile) {
+  // a tile on disk which cant be read is fetched from the url instead of given up on
+  TestTileDownloadData params;
+  const auto& id = params.test_tile_ids.front();
+  const std::string path = "url_tile_cache/" + baldr::GraphTile::FileSuffix(id);
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+  std::ofstream(path) << "not a tile";
+
+  auto conf = make_conf("url_tile_cache", false, 2);
+  baldr::GraphReader reader(conf.get_child("mjolnir"));
+  EXPECT_EQ(reader.PrefetchTiles({id}), 1);
+  auto tile = reader.GetGraphTile(id);
+  ASSERT_TRUE(tile);
+  EXPECT_EQ(tile->id(), id);
+}
+
+TEST(HttpTiles, test_prefetch_bbox) {
+  auto conf = make_conf("", false, 4);
+  baldr::GraphReader reader(conf.get_child("mjolnir"));
+  midgard::AABB2<midgard::PointLL> bbox{{5.11, 52.09}, {5.12, 52.10}};
+  EXPECT_GT(reader.PrefetchTiles(bbox), 0);
+  EXPECT_TRUE(reader.GetGraphTile(midgard::PointLL{5.11909, 52.09620}));
+}
+
 class HttpTilesEnv : public ::testing::Environment {
 public:
   void SetUp() override {
@@ -6,6 +6,7 @@
 #include "baldr/rapidjson_utils.h"
 #include "loki/worker.h"
 #include "thor/worker.h"
+#include "tyr/actor.h"
 
 #include "gurka/gurka.h"
 #include "test.h"
@@ -333,6 +334,73 @@ TEST(Isochrones, test_max_reserved_labels_count) {
   isochrone.Clear();
 }
 
+TEST(Isochrones, test_multiple_date_times) {
+  const std::vector<std::string> date_times = {"2024-06-04T03:00", "2024-06-04T08:00",
+                                               "2024-06-04T17:30", "2024-06-08T12:00"};
+  auto make_request = [](const std::string& date_time) {
+    return R"({"costing":"auto","locations":[{"lon":5.042799,"lat":52.093199}],)"
+           R"("contours":[{"time":5},{"time":10}],"date_time":{"type":1,"value":")" +
+           date_time + R"("}})";
+  };
+
+  // compute them one request at a time
+  loki_worker_t loki_worker(cfg);
+  thor_worker_t thor_worker(cfg);
+  std::vector<std::string> expected;
+  for (const auto& date_time : date_times) {
+    Api request;
+    ParseApi(make_request(date_time), Options::isochrone, request);
+    loki_worker.isochrones(request);
+    expected.push_back(thor_worker.isochrones(request));
+    loki_worker.cleanup();
+    thor_worker.cleanup();
+  }
+
+  // then all at once, both serially and concurrently
+  for (const auto* concurrency : {"1", "3"}) {
+    auto config = cfg;
+    config.put("thor.max_isochrone_concurrency", concurrency);
+    thor_worker_t batch_worker(config);
+    Api request;
+    ParseApi(make_request("2024-06-01T00:00"), Options::isochrone, request);
+    loki_worker.isochrones(request);
+    auto results = batch_worker.isochrones(request, date_times);
+    loki_worker.cleanup();
+    batch_worker.cleanup();
+    EXPECT_EQ(results, expected) << "max_isochrone_concurrency " << concurrency;
+  }
+
+  // a request without a date_time would be parsed without traffic, but the times give it some
+  const std::string untimed_request =
+      R"({"costing":"auto","locations":[{"lon":5.042799,"lat":52.093199}],)"
+      R"("contours":[{"time":5},{"time":10}]})";
+  for (const auto* concurrency : {"1", "3"}) {
+    auto config = cfg;
+    config.put("thor.max_isochrone_concurrency", concurrency);
+    actor_t actor(config, true);
+    auto results = actor.isochrone(untimed_request, date_times);
+    EXPECT_EQ(results, expected) << "max_isochrone_concurrency " << concurrency;
+  }
+
+  // a bad time fails the whole batch
+  Api request;
+  ParseApi(make_request(date_times.front()), Options::isochrone, request);
+  loki_worker.isochrones(request);
+  EXPECT_THROW(thor_worker.isochrones(request, {date_times.front(), "yesterday"}),
+               valhalla_exception_t);
+
+  // and so does cancelling it, whichever worker would have expanded the times
+  const std::function<void()> cancelled = []() { throw std::runtime_error("cancelled"); };
+  for (const auto* concurrency : {"1", "3"}) {
+    auto config = cfg;
+    config.put("thor.max_isochrone_concurrency", concurrency);
+    thor_worker_t batch_worker(config);
+    batch_worker.set_interrupt(&cancelled);
+    EXPECT_THROW(batch_worker.isochrones(request, date_times), std::runtime_error)
+        << "max_isochrone_concurrency " << concurrency;
+  }
+}
+
 #ifdef ENABLE_GDAL
 
 void check_raster_edges(size_t x, size_t y, uint16_t* data) {
@@ -1,10 +1,13 @@
 #include "midgard/logging.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <fstream>
 #include <future>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <thread>
 #include <vector>
@@ -89,6 +92,101 @@ TEST(Logging, FileLoggerTest) {
   EXPECT_EQ(custom, 8);
 }
 
+// keeps what it is asked to write and can be held up to fill the queue of an async logger
+class CaptureLogger : public logging::Logger {
+public:
+  using logging::Logger::Logger;
+  virtual void Write(const std::string& records) {
+    writing = true;
+    while (hold) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    written += records;
+  }
+  static std::atomic<bool> hold;
+  static std::atomic<bool> writing;
+  static std::string written;
+};
+std::atomic<bool> CaptureLogger::hold{false};
+std::atomic<bool> CaptureLogger::writing{false};
+std::string CaptureLogger::written;
+bool capture_registered =
+    logging::RegisterLogger("capture", [](const logging::LoggingConfig& config) {
+      logging::Logger* l = new CaptureLogger(config);
+      return l;
+    });
+
+size_t count(const std::string& haystack, const std::string& needle) {
+  size_t found = 0;
+  for (auto pos = haystack.find(needle); pos != std::string::npos;
+       pos = haystack.find(needle, pos + 1)) {
+    ++found;
+  }
+  return found;
+}
+
+TEST(Logging, AsyncLoggerDrops) {
+  CaptureLogger::written.clear();
+  CaptureLogger::hold = true;
+  CaptureLogger::writing = false;
+  std::unique_ptr<logging::Logger> logger(logging::GetFactory().Produce(
+      {{"type", "async"}, {"async_type", "capture"}, {"queue_size", "3"}, {"overflow", "drop"}}));
+
+  // once the writer is stuck on the first message the queue fills up, rounded up to 4 messages
+  logger->Log("first", logging::LogLevel::LogInfo);
+  while (!CaptureLogger::writing) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  for (size_t i = 0; i < 10; ++i) {
+    logger->Log("queued", logging::LogLevel::LogInfo);
+  }
+  EXPECT_EQ(logger->DroppedCount(), 6);
+
+  // and the writer says how many it lost once everything else is written
+  CaptureLogger::hold = false;
+  logger.reset();
+  EXPECT_EQ(count(CaptureLogger::written, " [INFO] first\n"), 1);
+  EXPECT_EQ(count(CaptureLogger::written, " [INFO] queued\n"), 4);
+  EXPECT_EQ(count(CaptureLogger::written,
+                  " [WARN] 6 log messages were dropped because the queue was full\n"),
+            1);
+}
+
+TEST(Logging, AsyncLoggerBlocks) {
+  CaptureLogger::written.clear();
+  CaptureLogger::hold = false;
+  std::unique_ptr<logging::Logger> logger(logging::GetFactory().Produce(
+      {{"type", "async"}, {"async_type", "capture"}, {"queue_size", "2"}, {"overflow", "block"}}));
+
+  // with backpressure nothing is lost however many threads outpace the writer
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([&logger]() {
+      for (size_t j = 0; j < 1000; ++j) {
+        logger->Log("message", " [CUSTOM] ");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  logger.reset();
+  EXPECT_EQ(count(CaptureLogger::written, " [CUSTOM] message\n"), 4000);
+  EXPECT_EQ(count(CaptureLogger::written, "\n"), 4000);
+}
+
+TEST(Logging, AsyncLoggerConfig) {
+  EXPECT_THROW(logging::GetFactory().Produce({{"type", "async"}, {"async_type", "async"}}),
+               std::runtime_error);
+  EXPECT_THROW(logging::GetFactory().Produce({{"type", "async"}, {"queue_size", "lots"}}),
+               std::runtime_error);
+  EXPECT_THROW(logging::GetFactory().Produce({{"type", "async"}, {"overflow", "sometimes"}}),
+               std::runtime_error);
+  EXPECT_THROW(logging::GetFactory().Produce({{"type", "async"}, {"async_type", "nope"}}),
+               std::runtime_error);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
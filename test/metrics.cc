@@ -0,0 +1,83 @@
+#include "midgard/metrics.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace valhalla::midgard;
+
+namespace {
+
+TEST(Metrics, BucketBounds) {
+  const auto& bounds = metrics::bucket_bounds();
+  EXPECT_DOUBLE_EQ(bounds.front(), 0.01);
+  EXPECT_DOUBLE_EQ(bounds[1], 0.02);
+  EXPECT_DOUBLE_EQ(bounds[2], 0.05);
+  EXPECT_DOUBLE_EQ(bounds[3], 0.1);
+  EXPECT_DOUBLE_EQ(bounds.back(), 1e7);
+  EXPECT_TRUE(std::is_sorted(bounds.cbegin(), bounds.cend()));
+}
+
+TEST(Metrics, Histogram) {
+  metrics::histogram_t histogram;
+  EXPECT_EQ(histogram.quantile(.5), 0);
+
+  // a value on a bound goes in the bucket of that bound, past the last one in the last bucket
+  histogram.observe(0.01);
+  histogram.observe(3);
+  histogram.observe(1e8);
+  EXPECT_EQ(histogram.counts.front(), 1u);
+  EXPECT_EQ(histogram.counts[8], 1u);
+  EXPECT_EQ(histogram.counts.back(), 1u);
+  EXPECT_EQ(histogram.count, 3u);
+  EXPECT_DOUBLE_EQ(histogram.sum, 1e8 + 3.01);
+  EXPECT_DOUBLE_EQ(histogram.max, 1e8);
+
+  // the percentiles land in the right buckets and never past the max
+  histogram = {};
+  for (int i = 1; i <= 100; ++i) {
+    histogram.observe(i);
+  }
+  EXPECT_GT(histogram.quantile(.5), 20);
+  EXPECT_LE(histogram.quantile(.5), 50);
+  EXPECT_GT(histogram.quantile(.99), 50);
+  EXPECT_LE(histogram.quantile(.99), 100);
+  EXPECT_DOUBLE_EQ(histogram.quantile(1), 100);
+  EXPECT_LE(histogram.quantile(.5), histogram.quantile(.9));
+}
+
+TEST(Metrics, Registry) {
+  // nothing is kept until they are turned on
+  metrics::clear();
+  metrics::enable(false);
+  metrics::observe("route.info.thor.latency_ms", 1);
+  EXPECT_TRUE(metrics::snapshot().empty());
+
+  // then every thread adds to the same histograms
+  metrics::enable(true);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 1000; ++j) {
+        metrics::observe("route.info.thor.latency_ms", j % 10);
+        metrics::observe("route.info.loki.latency_ms", 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto histograms = metrics::snapshot();
+  ASSERT_EQ(histograms.size(), 2);
+  EXPECT_EQ(histograms["route.info.thor.latency_ms"].count, 4000u);
+  EXPECT_DOUBLE_EQ(histograms["route.info.thor.latency_ms"].sum, 4 * 4500);
+  EXPECT_DOUBLE_EQ(histograms["route.info.loki.latency_ms"].max, 1);
+
+  metrics::clear();
+  EXPECT_TRUE(metrics::snapshot().empty());
+  metrics::enable(false);
+}
+
+} // namespace
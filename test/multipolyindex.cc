@@ -0,0 +1,103 @@
+#include "mjolnir/admin.h"
+
+#include <cmath>
+#include <iomanip>
+#include <random>
+
+#include "test.h"
+
+using namespace valhalla::mjolnir;
+
+namespace {
+
+// a closed, concave ring around a center, clockwise like boost wants outer rings
+polygon_type::ring_type
+star(double x, double y, double radius, size_t points, std::mt19937& gen, bool hole = false) {
+  std::uniform_real_distribution<double> scale(0.3, 1.0);
+  polygon_type::ring_type ring;
+  for (size_t i = 0; i < points; ++i) {
+    double angle = (hole ? 1 : -1) * 2 * M_PI * i / points;
+    double r = radius * scale(gen);
+    ring.emplace_back(x + r * std::cos(angle), y + r * std::sin(angle));
+  }
+  ring.push_back(ring.front());
+  return ring;
+}
+
+// polygons of all sizes around and across a tile, some with holes
+std::multimap<uint32_t, multi_polygon_type> make_polys(const AABB2<PointLL>& tile,
+                                                       std::mt19937& gen) {
+  std::uniform_real_distribution<double> x(tile.minx() - 1, tile.maxx() + 1);
+  std::uniform_real_distribution<double> y(tile.miny() - 1, tile.maxy() + 1);
+  std::uniform_real_distribution<double> radius(0.05, 2);
+  std::uniform_int_distribution<size_t> points(3, 400);
+  std::multimap<uint32_t, multi_polygon_type> polys;
+  for (uint32_t id = 1; id <= 20; ++id) {
+    multi_polygon_type multi;
+    for (int p = 0; p < 3; ++p) {
+      polygon_type polygon;
+      double cx = x(gen), cy = y(gen), r = radius(gen);
+      polygon.outer() = star(cx, cy, r, points(gen), gen);
+      if (p == 0) {
+        polygon.inners().push_back(star(cx, cy, r * 0.25, points(gen), gen, true));
+      }
+      multi.push_back(polygon);
+    }
+    polys.emplace(id, multi);
+  }
+  // and one that's not a ring
+  multi_polygon_type degenerate;
+  degenerate.resize(1);
+  degenerate.front().outer() = {{tile.minx(), tile.miny()}, {tile.maxx(), tile.maxy()}};
+  polys.emplace(21, degenerate);
+  return polys;
+}
+
+TEST(MultiPolyIndex, MatchesCoveredBy) {
+  std::mt19937 gen(42);
+  AABB2<PointLL> tile(PointLL{5.0, 52.0}, PointLL{5.25, 52.25});
+  auto polys = make_polys(tile, gen);
+  MultiPolyIndex index(polys, tile);
+  ASSERT_EQ(index.size(), polys.size());
+
+  // random points in and around the tile and the vertices of the polygons, which are on edges
+  std::vector<PointLL> points;
+  std::uniform_real_distribution<double> x(tile.minx() - 0.1, tile.maxx() + 0.1);
+  std::uniform_real_distribution<double> y(tile.miny() - 0.1, tile.maxy() + 0.1);
+  for (int i = 0; i < 5000; ++i) {
+    points.emplace_back(x(gen), y(gen));
+  }
+  for (const auto& poly : polys) {
+    for (const auto& polygon : poly.second) {
+      for (const auto& point : polygon.outer()) {
+        points.emplace_back(point.x(), point.y());
+      }
+    }
+  }
+  points.emplace_back(tile.minx(), tile.miny());
+  points.emplace_back(tile.maxx(), tile.maxy());
+
+  size_t covered = 0;
+  for (const auto& ll : points) {
+    size_t i = 0;
+    for (const auto& poly : polys) {
+      bool expected = bg::covered_by(point_type(ll.lng(), ll.lat()), poly.second,
+                                     bg::strategy::within::crossings_multiply<point_type>());
+      ASSERT_EQ(index.covers(i, ll), expected) << std::setprecision(17) << ll.lng() << ","
+                                                << ll.lat() << " poly " << poly.first;
+      EXPECT_EQ(index.id(i++), poly.first);
+      covered += expected;
+    }
+    EXPECT_EQ(GetMultiPolyId(index, ll), GetMultiPolyId(polys, ll));
+  }
+  // make sure we tested both cases
+  EXPECT_GT(covered, points.size() / 10);
+  EXPECT_LT(covered, points.size() * polys.size());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
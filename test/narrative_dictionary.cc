@@ -2,6 +2,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/algorithm/string/replace.hpp>
+
 #include "midgard/logging.h"
 #include "odin/narrative_dictionary.h"
 #include "odin/util.h"
@@ -397,11 +399,10 @@ void validate(const std::vector<std::string>& test_target, const std::vector<std
   }
 }
 
-void validate(const std::unordered_map<std::string, std::string>& test_target,
-              const std::map<std::string, std::string>& expected) {
+void validate(const PhraseSet& test_target, const std::map<std::string, std::string>& expected) {
 
   for (const auto& expected_phrase : expected) {
-    const auto& test_target_item = test_target.at(expected_phrase.first);
+    const auto& test_target_item = test_target.phrase(std::stoul(expected_phrase.first)).phrase();
     EXPECT_EQ(test_target_item, expected_phrase.second);
   }
 }
@@ -410,7 +411,7 @@ TEST(NarrativeDictionary, test_en_US_start) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate start phrases
-  validate(dictionary->start_subset.phrases, kExpectedStartPhrases);
+  validate(dictionary->start_subset, kExpectedStartPhrases);
 
   // cardinal_directions
   const auto& cardinal_directions = dictionary->start_subset.cardinal_directions;
@@ -425,7 +426,7 @@ TEST(NarrativeDictionary, test_en_US_start_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate start phrases
-  validate(dictionary->start_verbal_subset.phrases, kExpectedStartVerbalPhrases);
+  validate(dictionary->start_verbal_subset, kExpectedStartVerbalPhrases);
 
   // cardinal_directions
   const auto& cardinal_directions = dictionary->start_verbal_subset.cardinal_directions;
@@ -448,19 +449,19 @@ TEST(NarrativeDictionary, test_en_US_destination) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "You have arrived at your destination.",
-  const auto& phrase_0 = dictionary->destination_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->destination_subset.phrase(0).phrase();
   validate(phrase_0, "You have arrived at your destination.");
 
   // "1": "You have arrived at <DESTINATION>.",
-  const auto& phrase_1 = dictionary->destination_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->destination_subset.phrase(1).phrase();
   validate(phrase_1, "You have arrived at <DESTINATION>.");
 
   // "2": "Your destination is on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_2 = dictionary->destination_subset.phrases.at("2");
+  const auto& phrase_2 = dictionary->destination_subset.phrase(2).phrase();
   validate(phrase_2, "Your destination is on the <RELATIVE_DIRECTION>.");
 
   // "3": "<DESTINATION> is on the <RELATIVE_DIRECTION>."
-  const auto& phrase_3 = dictionary->destination_subset.phrases.at("3");
+  const auto& phrase_3 = dictionary->destination_subset.phrase(3).phrase();
   validate(phrase_3, "<DESTINATION> is on the <RELATIVE_DIRECTION>.");
 
   // relative_directions
@@ -472,19 +473,19 @@ TEST(NarrativeDictionary, test_en_US_destination_verbal_alert) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "You will arrive at your destination.",
-  const auto& phrase_0 = dictionary->destination_verbal_alert_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->destination_verbal_alert_subset.phrase(0).phrase();
   validate(phrase_0, "You will arrive at your destination.");
 
   // "1": "You will arrive at <DESTINATION>.",
-  const auto& phrase_1 = dictionary->destination_verbal_alert_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->destination_verbal_alert_subset.phrase(1).phrase();
   validate(phrase_1, "You will arrive at <DESTINATION>.");
 
   // "2": "Your destination will be on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_2 = dictionary->destination_verbal_alert_subset.phrases.at("2");
+  const auto& phrase_2 = dictionary->destination_verbal_alert_subset.phrase(2).phrase();
   validate(phrase_2, "Your destination will be on the <RELATIVE_DIRECTION>.");
 
   // "3": "<DESTINATION> will be on the <RELATIVE_DIRECTION>."
-  const auto& phrase_3 = dictionary->destination_verbal_alert_subset.phrases.at("3");
+  const auto& phrase_3 = dictionary->destination_verbal_alert_subset.phrase(3).phrase();
   validate(phrase_3, "<DESTINATION> will be on the <RELATIVE_DIRECTION>.");
 
   // relative_directions
@@ -496,19 +497,19 @@ TEST(NarrativeDictionary, test_en_US_destination_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "You have arrived at your destination.",
-  const auto& phrase_0 = dictionary->destination_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->destination_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "You have arrived at your destination.");
 
   // "1": "You have arrived at <DESTINATION>.",
-  const auto& phrase_1 = dictionary->destination_verbal_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->destination_verbal_subset.phrase(1).phrase();
   validate(phrase_1, "You have arrived at <DESTINATION>.");
 
   // "2": "Your destination is on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_2 = dictionary->destination_verbal_subset.phrases.at("2");
+  const auto& phrase_2 = dictionary->destination_verbal_subset.phrase(2).phrase();
   validate(phrase_2, "Your destination is on the <RELATIVE_DIRECTION>.");
 
   // "3": "<DESTINATION> is on the <RELATIVE_DIRECTION>."
-  const auto& phrase_3 = dictionary->destination_verbal_subset.phrases.at("3");
+  const auto& phrase_3 = dictionary->destination_verbal_subset.phrase(3).phrase();
   validate(phrase_3, "<DESTINATION> is on the <RELATIVE_DIRECTION>.");
 
   // relative_directions
@@ -520,7 +521,7 @@ TEST(NarrativeDictionary, test_en_US_becomes) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "<PREVIOUS_STREET_NAMES> becomes <STREET_NAMES>.",
-  const auto& phrase_0 = dictionary->becomes_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->becomes_subset.phrase(0).phrase();
   validate(phrase_0, "<PREVIOUS_STREET_NAMES> becomes <STREET_NAMES>.");
 }
 
@@ -528,7 +529,7 @@ TEST(NarrativeDictionary, test_en_US_becomes_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "<PREVIOUS_STREET_NAMES> becomes <STREET_NAMES>.",
-  const auto& phrase_0 = dictionary->becomes_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->becomes_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "<PREVIOUS_STREET_NAMES> becomes <STREET_NAMES>.");
 }
 
@@ -536,7 +537,7 @@ TEST(NarrativeDictionary, test_en_US_continue) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate continue phrases
-  validate(dictionary->continue_subset.phrases, kExpectedContinuePhrases);
+  validate(dictionary->continue_subset, kExpectedContinuePhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels = dictionary->continue_subset.empty_street_name_labels;
@@ -547,7 +548,7 @@ TEST(NarrativeDictionary, test_en_US_continue_verbal_alert) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate continue_verbal_alert phrases
-  validate(dictionary->continue_verbal_alert_subset.phrases, kExpectedContinueVerbalAlertPhrases);
+  validate(dictionary->continue_verbal_alert_subset, kExpectedContinueVerbalAlertPhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels =
@@ -559,7 +560,7 @@ TEST(NarrativeDictionary, test_en_US_continue_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate continue_verbal phrases
-  validate(dictionary->continue_verbal_subset.phrases, kExpectedContinueVerbalPhrases);
+  validate(dictionary->continue_verbal_subset, kExpectedContinueVerbalPhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels = dictionary->continue_verbal_subset.empty_street_name_labels;
@@ -578,7 +579,7 @@ TEST(NarrativeDictionary, test_en_US_bear) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate bear phrases
-  validate(dictionary->bear_subset.phrases, kExpectedBearPhrases);
+  validate(dictionary->bear_subset, kExpectedBearPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->bear_subset.relative_directions;
@@ -593,7 +594,7 @@ TEST(NarrativeDictionary, test_en_US_bear_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate bear_verbal phrases
-  validate(dictionary->bear_verbal_subset.phrases, kExpectedBearVerbalPhrases);
+  validate(dictionary->bear_verbal_subset, kExpectedBearVerbalPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->bear_verbal_subset.relative_directions;
@@ -608,7 +609,7 @@ TEST(NarrativeDictionary, test_en_US_turn) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate turn phrases
-  validate(dictionary->turn_subset.phrases, kExpectedTurnPhrases);
+  validate(dictionary->turn_subset, kExpectedTurnPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->turn_subset.relative_directions;
@@ -623,7 +624,7 @@ TEST(NarrativeDictionary, test_en_US_turn_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate turn_verbal phrases
-  validate(dictionary->turn_verbal_subset.phrases, kExpectedTurnVerbalPhrases);
+  validate(dictionary->turn_verbal_subset, kExpectedTurnVerbalPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->turn_verbal_subset.relative_directions;
@@ -638,7 +639,7 @@ TEST(NarrativeDictionary, test_en_US_sharp) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate sharp phrases
-  validate(dictionary->sharp_subset.phrases, kExpectedSharpPhrases);
+  validate(dictionary->sharp_subset, kExpectedSharpPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->sharp_subset.relative_directions;
@@ -653,7 +654,7 @@ TEST(NarrativeDictionary, test_en_US_sharp_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate sharp_verbal phrases
-  validate(dictionary->sharp_verbal_subset.phrases, kExpectedSharpVerbalPhrases);
+  validate(dictionary->sharp_verbal_subset, kExpectedSharpVerbalPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->sharp_verbal_subset.relative_directions;
@@ -668,7 +669,7 @@ TEST(NarrativeDictionary, test_en_US_uturn) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate uturn phrases
-  validate(dictionary->uturn_subset.phrases, kExpectedUturnPhrases);
+  validate(dictionary->uturn_subset, kExpectedUturnPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->uturn_verbal_subset.relative_directions;
@@ -683,7 +684,7 @@ TEST(NarrativeDictionary, test_en_US_uturn_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate uturn_verbal phrases
-  validate(dictionary->uturn_verbal_subset.phrases, kExpectedUturnVerbalPhrases);
+  validate(dictionary->uturn_verbal_subset, kExpectedUturnVerbalPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->uturn_verbal_subset.relative_directions;
@@ -698,23 +699,23 @@ TEST(NarrativeDictionary, test_en_US_ramp_straight) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   //  "0": "Stay straight to take the ramp.",
-  const auto& phrase_0 = dictionary->ramp_straight_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->ramp_straight_subset.phrase(0).phrase();
   validate(phrase_0, "Stay straight to take the ramp.");
 
   //  "1": "Stay straight to take the <BRANCH_SIGN> ramp.",
-  const auto& phrase_1 = dictionary->ramp_straight_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->ramp_straight_subset.phrase(1).phrase();
   validate(phrase_1, "Stay straight to take the <BRANCH_SIGN> ramp.");
 
   //  "2": "Stay straight to take the ramp toward <TOWARD_SIGN>.",
-  const auto& phrase_2 = dictionary->ramp_straight_subset.phrases.at("2");
+  const auto& phrase_2 = dictionary->ramp_straight_subset.phrase(2).phrase();
   validate(phrase_2, "Stay straight to take the ramp toward <TOWARD_SIGN>.");
 
   //  "3": "Stay straight to take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.",
-  const auto& phrase_3 = dictionary->ramp_straight_subset.phrases.at("3");
+  const auto& phrase_3 = dictionary->ramp_straight_subset.phrase(3).phrase();
   validate(phrase_3, "Stay straight to take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.");
 
   //  "4": "Stay straight to take the <NAME_SIGN> ramp."
-  const auto& phrase_4 = dictionary->ramp_straight_subset.phrases.at("4");
+  const auto& phrase_4 = dictionary->ramp_straight_subset.phrase(4).phrase();
   validate(phrase_4, "Stay straight to take the <NAME_SIGN> ramp.");
 }
 
@@ -722,23 +723,23 @@ TEST(NarrativeDictionary, test_en_US_ramp_straight_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   //  "0": "Stay straight to take the ramp.",
-  const auto& phrase_0 = dictionary->ramp_straight_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->ramp_straight_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "Stay straight to take the ramp.");
 
   //  "1": "Stay straight to take the <BRANCH_SIGN> ramp.",
-  const auto& phrase_1 = dictionary->ramp_straight_verbal_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->ramp_straight_verbal_subset.phrase(1).phrase();
   validate(phrase_1, "Stay straight to take the <BRANCH_SIGN> ramp.");
 
   //  "2": "Stay straight to take the ramp toward <TOWARD_SIGN>.",
-  const auto& phrase_2 = dictionary->ramp_straight_verbal_subset.phrases.at("2");
+  const auto& phrase_2 = dictionary->ramp_straight_verbal_subset.phrase(2).phrase();
   validate(phrase_2, "Stay straight to take the ramp toward <TOWARD_SIGN>.");
 
   //  "3": "Stay straight to take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.",
-  const auto& phrase_3 = dictionary->ramp_straight_verbal_subset.phrases.at("3");
+  const auto& phrase_3 = dictionary->ramp_straight_verbal_subset.phrase(3).phrase();
   validate(phrase_3, "Stay straight to take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.");
 
   //  "4": "Stay straight to take the <NAME_SIGN> ramp."
-  const auto& phrase_4 = dictionary->ramp_straight_verbal_subset.phrases.at("4");
+  const auto& phrase_4 = dictionary->ramp_straight_verbal_subset.phrase(4).phrase();
   validate(phrase_4, "Stay straight to take the <NAME_SIGN> ramp.");
 }
 
@@ -746,64 +747,64 @@ TEST(NarrativeDictionary, test_en_US_ramp) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "Take the ramp on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_0 = dictionary->ramp_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->ramp_subset.phrase(0).phrase();
   validate(phrase_0, "Take the ramp on the <RELATIVE_DIRECTION>.");
 
   // "1": "Take the <BRANCH_SIGN> ramp on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_1 = dictionary->ramp_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->ramp_subset.phrase(1).phrase();
   validate(phrase_1, "Take the <BRANCH_SIGN> ramp on the <RELATIVE_DIRECTION>.");
 
   // "2": "Take the ramp on the <RELATIVE_DIRECTION> toward <TOWARD_SIGN>.",
-  const auto& phrase_2 = dictionary->ramp_subset.phrases.at("2");
+  const auto& phrase_2 = dictionary->ramp_subset.phrase(2).phrase();
   validate(phrase_2, "Take the ramp on the <RELATIVE_DIRECTION> toward <TOWARD_SIGN>.");
 
   // "3": "Take the <BRANCH_SIGN> ramp on the <RELATIVE_DIRECTION> toward <TOWARD_SIGN>.",
-  const auto& phrase_3 = dictionary->ramp_subset.phrases.at("3");
+  const auto& phrase_3 = dictionary->ramp_subset.phrase(3).phrase();
   validate(phrase_3, "Take the <BRANCH_SIGN> ramp on the <RELATIVE_DIRECTION> toward <TOWARD_SIGN>.");
 
   // "4": "Take the <NAME_SIGN> ramp on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_4 = dictionary->ramp_subset.phrases.at("4");
+  const auto& phrase_4 = dictionary->ramp_subset.phrase(4).phrase();
   validate(phrase_4, "Take the <NAME_SIGN> ramp on the <RELATIVE_DIRECTION>.");
 
   // "5": "Turn <RELATIVE_DIRECTION> to take the ramp.",
-  const auto& phrase_5 = dictionary->ramp_subset.phrases.at("5");
+  const auto& phrase_5 = dictionary->ramp_subset.phrase(5).phrase();
   validate(phrase_5, "Turn <RELATIVE_DIRECTION> to take the ramp.");
 
   // "6": "Turn <RELATIVE_DIRECTION> to take the <BRANCH_SIGN> ramp.",
-  const auto& phrase_6 = dictionary->ramp_subset.phrases.at("6");
+  const auto& phrase_6 = dictionary->ramp_subset.phrase(6).phrase();
   validate(phrase_6, "Turn <RELATIVE_DIRECTION> to take the <BRANCH_SIGN> ramp.");
 
   // "7": "Turn <RELATIVE_DIRECTION> to take the ramp toward <TOWARD_SIGN>.",
-  const auto& phrase_7 = dictionary->ramp_subset.phrases.at("7");
+  const auto& phrase_7 = dictionary->ramp_subset.phrase(7).phrase();
   validate(phrase_7, "Turn <RELATIVE_DIRECTION> to take the ramp toward <TOWARD_SIGN>.");
 
   // "8": "Turn <RELATIVE_DIRECTION> to take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.",
-  const auto& phrase_8 = dictionary->ramp_subset.phrases.at("8");
+  const auto& phrase_8 = dictionary->ramp_subset.phrase(8).phrase();
   validate(phrase_8,
            "Turn <RELATIVE_DIRECTION> to take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.");
 
   // "9": "Turn <RELATIVE_DIRECTION> to take the <NAME_SIGN> ramp."
-  const auto& phrase_9 = dictionary->ramp_subset.phrases.at("9");
+  const auto& phrase_9 = dictionary->ramp_subset.phrase(9).phrase();
   validate(phrase_9, "Turn <RELATIVE_DIRECTION> to take the <NAME_SIGN> ramp.");
 
   // "10": "Take the ramp."
-  const auto& phrase_10 = dictionary->ramp_subset.phrases.at("10");
+  const auto& phrase_10 = dictionary->ramp_subset.phrase(10).phrase();
   validate(phrase_10, "Take the ramp.");
 
   // "11": "Take the <BRANCH_SIGN> ramp."
-  const auto& phrase_11 = dictionary->ramp_subset.phrases.at("11");
+  const auto& phrase_11 = dictionary->ramp_subset.phrase(11).phrase();
   validate(phrase_11, "Take the <BRANCH_SIGN> ramp.");
 
   // "12": "Take the ramp toward <TOWARD_SIGN>."
-  const auto& phrase_12 = dictionary->ramp_subset.phrases.at("12");
+  const auto& phrase_12 = dictionary->ramp_subset.phrase(12).phrase();
   validate(phrase_12, "Take the ramp toward <TOWARD_SIGN>.");
 
   // "13": "Take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>."
-  const auto& phrase_13 = dictionary->ramp_subset.phrases.at("13");
+  const auto& phrase_13 = dictionary->ramp_subset.phrase(13).phrase();
   validate(phrase_13, "Take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.");
 
   // "14": "Take the <NAME_SIGN> ramp."
-  const auto& phrase_14 = dictionary->ramp_subset.phrases.at("14");
+  const auto& phrase_14 = dictionary->ramp_subset.phrase(14).phrase();
   validate(phrase_14, "Take the <NAME_SIGN> ramp.");
 
   // relative_directions
@@ -815,64 +816,64 @@ TEST(NarrativeDictionary, test_en_US_ramp_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "Take the ramp on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_0 = dictionary->ramp_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->ramp_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "Take the ramp on the <RELATIVE_DIRECTION>.");
 
   // "1": "Take the <BRANCH_SIGN> ramp on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_1 = dictionary->ramp_verbal_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->ramp_verbal_subset.phrase(1).phrase();
   validate(phrase_1, "Take the <BRANCH_SIGN> ramp on the <RELATIVE_DIRECTION>.");
 
   // "2": "Take the ramp on the <RELATIVE_DIRECTION> toward <TOWARD_SIGN>.",
-  const auto& phrase_2 = dictionary->ramp_verbal_subset.phrases.at("2");
+  const auto& phrase_2 = dictionary->ramp_verbal_subset.phrase(2).phrase();
   validate(phrase_2, "Take the ramp on the <RELATIVE_DIRECTION> toward <TOWARD_SIGN>.");
 
   // "3": "Take the <BRANCH_SIGN> ramp on the <RELATIVE_DIRECTION> toward <TOWARD_SIGN>.",
-  const auto& phrase_3 = dictionary->ramp_verbal_subset.phrases.at("3");
+  const auto& phrase_3 = dictionary->ramp_verbal_subset.phrase(3).phrase();
   validate(phrase_3, "Take the <BRANCH_SIGN> ramp on the <RELATIVE_DIRECTION> toward <TOWARD_SIGN>.");
 
   // "4": "Take the <NAME_SIGN> ramp on the <RELATIVE_DIRECTION>.",
-  const auto& phrase_4 = dictionary->ramp_verbal_subset.phrases.at("4");
+  const auto& phrase_4 = dictionary->ramp_verbal_subset.phrase(4).phrase();
   validate(phrase_4, "Take the <NAME_SIGN> ramp on the <RELATIVE_DIRECTION>.");
 
   // "5": "Turn <RELATIVE_DIRECTION> to take the ramp.",
-  const auto& phrase_5 = dictionary->ramp_verbal_subset.phrases.at("5");
+  const auto& phrase_5 = dictionary->ramp_verbal_subset.phrase(5).phrase();
   validate(phrase_5, "Turn <RELATIVE_DIRECTION> to take the ramp.");
 
   // "6": "Turn <RELATIVE_DIRECTION> to take the <BRANCH_SIGN> ramp.",
-  const auto& phrase_6 = dictionary->ramp_verbal_subset.phrases.at("6");
+  const auto& phrase_6 = dictionary->ramp_verbal_subset.phrase(6).phrase();
   validate(phrase_6, "Turn <RELATIVE_DIRECTION> to take the <BRANCH_SIGN> ramp.");
 
   // "7": "Turn <RELATIVE_DIRECTION> to take the ramp toward <TOWARD_SIGN>.",
-  const auto& phrase_7 = dictionary->ramp_verbal_subset.phrases.at("7");
+  const auto& phrase_7 = dictionary->ramp_verbal_subset.phrase(7).phrase();
   validate(phrase_7, "Turn <RELATIVE_DIRECTION> to take the ramp toward <TOWARD_SIGN>.");
 
   // "8": "Turn <RELATIVE_DIRECTION> to take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.",
-  const auto& phrase_8 = dictionary->ramp_verbal_subset.phrases.at("8");
+  const auto& phrase_8 = dictionary->ramp_verbal_subset.phrase(8).phrase();
   validate(phrase_8,
            "Turn <RELATIVE_DIRECTION> to take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.");
 
   // "9": "Turn <RELATIVE_DIRECTION> to take the <NAME_SIGN> ramp."
-  const auto& phrase_9 = dictionary->ramp_verbal_subset.phrases.at("9");
+  const auto& phrase_9 = dictionary->ramp_verbal_subset.phrase(9).phrase();
   validate(phrase_9, "Turn <RELATIVE_DIRECTION> to take the <NAME_SIGN> ramp.");
 
   // "10": "Take the ramp."
-  const auto& phrase_10 = dictionary->ramp_verbal_subset.phrases.at("10");
+  const auto& phrase_10 = dictionary->ramp_verbal_subset.phrase(10).phrase();
   validate(phrase_10, "Take the ramp.");
 
   // "11": "Take the <BRANCH_SIGN> ramp."
-  const auto& phrase_11 = dictionary->ramp_verbal_subset.phrases.at("11");
+  const auto& phrase_11 = dictionary->ramp_verbal_subset.phrase(11).phrase();
   validate(phrase_11, "Take the <BRANCH_SIGN> ramp.");
 
   // "12": "Take the ramp toward <TOWARD_SIGN>."
-  const auto& phrase_12 = dictionary->ramp_verbal_subset.phrases.at("12");
+  const auto& phrase_12 = dictionary->ramp_verbal_subset.phrase(12).phrase();
   validate(phrase_12, "Take the ramp toward <TOWARD_SIGN>.");
 
   // "13": "Take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>."
-  const auto& phrase_13 = dictionary->ramp_verbal_subset.phrases.at("13");
+  const auto& phrase_13 = dictionary->ramp_verbal_subset.phrase(13).phrase();
   validate(phrase_13, "Take the <BRANCH_SIGN> ramp toward <TOWARD_SIGN>.");
 
   // "14": "Take the <NAME_SIGN> ramp."
-  const auto& phrase_14 = dictionary->ramp_verbal_subset.phrases.at("14");
+  const auto& phrase_14 = dictionary->ramp_verbal_subset.phrase(14).phrase();
   validate(phrase_14, "Take the <NAME_SIGN> ramp.");
 
   // relative_directions
@@ -884,7 +885,7 @@ TEST(NarrativeDictionary, test_en_US_exit) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate exit phrases
-  validate(dictionary->exit_subset.phrases, kExpectedExitPhrases);
+  validate(dictionary->exit_subset, kExpectedExitPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->exit_subset.relative_directions;
@@ -895,7 +896,7 @@ TEST(NarrativeDictionary, test_en_US_exit_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate exit_verbal phrases
-  validate(dictionary->exit_verbal_subset.phrases, kExpectedExitVerbalPhrases);
+  validate(dictionary->exit_verbal_subset, kExpectedExitVerbalPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->exit_subset.relative_directions;
@@ -906,14 +907,14 @@ TEST(NarrativeDictionary, test_en_US_exit_visual) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate exit_visual phrases
-  validate(dictionary->exit_visual_subset.phrases, kExpectedExitVisualPhrases);
+  validate(dictionary->exit_visual_subset, kExpectedExitVisualPhrases);
 }
 
 TEST(NarrativeDictionary, test_en_US_keep) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate keep phrases
-  validate(dictionary->keep_subset.phrases, kExpectedKeepPhrases);
+  validate(dictionary->keep_subset, kExpectedKeepPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->keep_subset.relative_directions;
@@ -928,7 +929,7 @@ TEST(NarrativeDictionary, test_en_US_keep_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate keep_verbal phrases
-  validate(dictionary->keep_verbal_subset.phrases, kExpectedKeepVerbalPhrases);
+  validate(dictionary->keep_verbal_subset, kExpectedKeepVerbalPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->keep_verbal_subset.relative_directions;
@@ -943,7 +944,7 @@ TEST(NarrativeDictionary, test_en_US_keep_to_stay_on) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate keep_to_stay_on phrases
-  validate(dictionary->keep_to_stay_on_subset.phrases, kExpectedKeepToStayOnPhrases);
+  validate(dictionary->keep_to_stay_on_subset, kExpectedKeepToStayOnPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->keep_to_stay_on_subset.relative_directions;
@@ -958,7 +959,7 @@ TEST(NarrativeDictionary, test_en_US_keep_to_stay_on_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate keep_to_stay_on_verbal phrases
-  validate(dictionary->keep_to_stay_on_verbal_subset.phrases, kExpectedKeepToStayOnVerbalPhrases);
+  validate(dictionary->keep_to_stay_on_verbal_subset, kExpectedKeepToStayOnVerbalPhrases);
 
   // relative_directions
   const auto& relative_directions = dictionary->keep_to_stay_on_verbal_subset.relative_directions;
@@ -974,7 +975,7 @@ TEST(NarrativeDictionary, test_en_US_merge) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate merge phrases
-  validate(dictionary->merge_subset.phrases, kExpectedMergePhrases);
+  validate(dictionary->merge_subset, kExpectedMergePhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels = dictionary->merge_subset.empty_street_name_labels;
@@ -985,7 +986,7 @@ TEST(NarrativeDictionary, test_en_US_merge_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate merge_verbal phrases
-  validate(dictionary->merge_verbal_subset.phrases, kExpectedMergeVerbalPhrases);
+  validate(dictionary->merge_verbal_subset, kExpectedMergeVerbalPhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels = dictionary->merge_verbal_subset.empty_street_name_labels;
@@ -996,7 +997,7 @@ TEST(NarrativeDictionary, test_en_US_enter_roundabout) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate enter_roundabout phrases
-  validate(dictionary->enter_roundabout_subset.phrases, kExpectedEnterRoundaboutPhrases);
+  validate(dictionary->enter_roundabout_subset, kExpectedEnterRoundaboutPhrases);
 
   // ordinal_values: "1st", "2nd", "3rd", "4th", "5th", "6th", "7th", "8th", "9th", "10th"
   const auto& ordinal_values = dictionary->enter_roundabout_subset.ordinal_values;
@@ -1007,7 +1008,7 @@ TEST(NarrativeDictionary, test_en_US_enter_roundabout_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate enter_roundabout_verbal phrases
-  validate(dictionary->enter_roundabout_verbal_subset.phrases, kExpectedEnterRoundaboutVerbalPhrases);
+  validate(dictionary->enter_roundabout_verbal_subset, kExpectedEnterRoundaboutVerbalPhrases);
 
   // ordinal_values: "1st", "2nd", "3rd", "4th", "5th", "6th", "7th", "8th", "9th", "10th"
   const auto& ordinal_values = dictionary->enter_roundabout_verbal_subset.ordinal_values;
@@ -1018,7 +1019,7 @@ TEST(NarrativeDictionary, test_en_US_exit_roundabout) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate exit_roundabout phrases
-  validate(dictionary->exit_roundabout_subset.phrases, kExpectedExitRoundaboutPhrases);
+  validate(dictionary->exit_roundabout_subset, kExpectedExitRoundaboutPhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels = dictionary->exit_roundabout_subset.empty_street_name_labels;
@@ -1029,7 +1030,7 @@ TEST(NarrativeDictionary, test_en_US_exit_roundabout_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate exit_roundabout_verbal phrases
-  validate(dictionary->exit_roundabout_verbal_subset.phrases, kExpectedExitRoundaboutVerbalPhrases);
+  validate(dictionary->exit_roundabout_verbal_subset, kExpectedExitRoundaboutVerbalPhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels =
@@ -1041,7 +1042,7 @@ TEST(NarrativeDictionary, test_en_US_enter_ferry) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate enter_ferry phrases
-  validate(dictionary->enter_ferry_subset.phrases, kExpectedEnterFerryPhrases);
+  validate(dictionary->enter_ferry_subset, kExpectedEnterFerryPhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels = dictionary->enter_ferry_subset.empty_street_name_labels;
@@ -1055,7 +1056,7 @@ TEST(NarrativeDictionary, test_en_US_enter_ferry_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate enter_ferry_verbal phrases
-  validate(dictionary->enter_ferry_verbal_subset.phrases, kExpectedEnterFerryVerbalPhrases);
+  validate(dictionary->enter_ferry_verbal_subset, kExpectedEnterFerryVerbalPhrases);
 
   // empty_street_name_labels "walkway", "cycleway", "mountain bike trail"
   const auto& empty_street_name_labels =
@@ -1070,7 +1071,7 @@ TEST(NarrativeDictionary, test_en_US_transit_connection_start) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate transit_connection_start phrases
-  validate(dictionary->transit_connection_start_subset.phrases,
+  validate(dictionary->transit_connection_start_subset,
            kExpectedTransitConnectionStartPhrases);
 
   // Station label
@@ -1081,7 +1082,7 @@ TEST(NarrativeDictionary, test_en_US_transit_connection_start_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate transit_connection_start_verbal phrases
-  validate(dictionary->transit_connection_start_verbal_subset.phrases,
+  validate(dictionary->transit_connection_start_verbal_subset,
            kExpectedTransitConnectionStartVerbalPhrases);
 
   // Station label
@@ -1092,7 +1093,7 @@ TEST(NarrativeDictionary, test_en_US_transit_connection_transfer) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate transit_connection_start phrases
-  validate(dictionary->transit_connection_transfer_subset.phrases,
+  validate(dictionary->transit_connection_transfer_subset,
            kExpectedTransitConnectionTransferPhrases);
 
   // Station label
@@ -1103,7 +1104,7 @@ TEST(NarrativeDictionary, test_en_US_transit_connection_transfer_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate transit_connection_start_verbal phrases
-  validate(dictionary->transit_connection_transfer_verbal_subset.phrases,
+  validate(dictionary->transit_connection_transfer_verbal_subset,
            kExpectedTransitConnectionTransferVerbalPhrases);
 
   // Station label
@@ -1115,7 +1116,7 @@ TEST(NarrativeDictionary, test_en_US_transit_connection_destination) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate transit_destination_start phrases
-  validate(dictionary->transit_connection_destination_subset.phrases,
+  validate(dictionary->transit_connection_destination_subset,
            kExpectedTransitConnectionDestinationPhrases);
 
   // Station label
@@ -1126,7 +1127,7 @@ TEST(NarrativeDictionary, test_en_US_transit_connection_destination_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate transit_destination_start_verbal phrases
-  validate(dictionary->transit_connection_destination_verbal_subset.phrases,
+  validate(dictionary->transit_connection_destination_verbal_subset,
            kExpectedTransitConnectionDestinationVerbalPhrases);
 
   // Station label
@@ -1138,37 +1139,37 @@ TEST(NarrativeDictionary, test_en_US_depart) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate depart phrases
-  validate(dictionary->depart_subset.phrases, kExpectedDepartPhrases);
+  validate(dictionary->depart_subset, kExpectedDepartPhrases);
 }
 
 TEST(NarrativeDictionary, test_en_US_depart_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate depart_verbal phrases
-  validate(dictionary->depart_verbal_subset.phrases, kExpectedDepartVerbalPhrases);
+  validate(dictionary->depart_verbal_subset, kExpectedDepartVerbalPhrases);
 }
 
 TEST(NarrativeDictionary, test_en_US_arrive) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate arrive phrases
-  validate(dictionary->arrive_subset.phrases, kExpectedArrivePhrases);
+  validate(dictionary->arrive_subset, kExpectedArrivePhrases);
 }
 
 TEST(NarrativeDictionary, test_en_US_arrive_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // Validate arrive_verbal phrases
-  validate(dictionary->arrive_verbal_subset.phrases, kExpectedArriveVerbalPhrases);
+  validate(dictionary->arrive_verbal_subset, kExpectedArriveVerbalPhrases);
 }
 
 TEST(NarrativeDictionary, test_en_US_transit) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
-  const auto& phrase_0 = dictionary->transit_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->transit_subset.phrase(0).phrase();
   validate(phrase_0, "Take the <TRANSIT_NAME>. (<TRANSIT_STOP_COUNT> <TRANSIT_STOP_COUNT_LABEL>)");
 
-  const auto& phrase_1 = dictionary->transit_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->transit_subset.phrase(1).phrase();
   validate(phrase_1, "Take the <TRANSIT_NAME> toward <TRANSIT_HEADSIGN>. (<TRANSIT_STOP_COUNT> "
                      "<TRANSIT_STOP_COUNT_LABEL>)");
 
@@ -1184,10 +1185,10 @@ TEST(NarrativeDictionary, test_en_US_transit) {
 TEST(NarrativeDictionary, test_en_US_transit_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
-  const auto& phrase_0 = dictionary->transit_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->transit_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "Take the <TRANSIT_NAME>.");
 
-  const auto& phrase_1 = dictionary->transit_verbal_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->transit_verbal_subset.phrase(1).phrase();
   validate(phrase_1, "Take the <TRANSIT_NAME> toward <TRANSIT_HEADSIGN>.");
 
   // empty_transit_name_labels
@@ -1198,11 +1199,11 @@ TEST(NarrativeDictionary, test_en_US_transit_verbal) {
 TEST(NarrativeDictionary, test_en_US_transit_remain_on) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
-  const auto& phrase_0 = dictionary->transit_remain_on_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->transit_remain_on_subset.phrase(0).phrase();
   validate(phrase_0,
            "Remain on the <TRANSIT_NAME>. (<TRANSIT_STOP_COUNT> <TRANSIT_STOP_COUNT_LABEL>)");
 
-  const auto& phrase_1 = dictionary->transit_remain_on_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->transit_remain_on_subset.phrase(1).phrase();
   validate(phrase_1, "Remain on the <TRANSIT_NAME> toward <TRANSIT_HEADSIGN>. "
                      "(<TRANSIT_STOP_COUNT> <TRANSIT_STOP_COUNT_LABEL>)");
 
@@ -1219,10 +1220,10 @@ TEST(NarrativeDictionary, test_en_US_transit_remain_on) {
 TEST(NarrativeDictionary, test_en_US_transit_remain_on_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
-  const auto& phrase_0 = dictionary->transit_remain_on_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->transit_remain_on_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "Remain on the <TRANSIT_NAME>.");
 
-  const auto& phrase_1 = dictionary->transit_remain_on_verbal_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->transit_remain_on_verbal_subset.phrase(1).phrase();
   validate(phrase_1, "Remain on the <TRANSIT_NAME> toward <TRANSIT_HEADSIGN>.");
 
   // empty_transit_name_labels
@@ -1233,11 +1234,11 @@ TEST(NarrativeDictionary, test_en_US_transit_remain_on_verbal) {
 TEST(NarrativeDictionary, test_en_US_transit_transfer) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
-  const auto& phrase_0 = dictionary->transit_transfer_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->transit_transfer_subset.phrase(0).phrase();
   validate(phrase_0,
            "Transfer to take the <TRANSIT_NAME>. (<TRANSIT_STOP_COUNT> <TRANSIT_STOP_COUNT_LABEL>)");
 
-  const auto& phrase_1 = dictionary->transit_transfer_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->transit_transfer_subset.phrase(1).phrase();
   validate(phrase_1, "Transfer to take the <TRANSIT_NAME> toward <TRANSIT_HEADSIGN>. "
                      "(<TRANSIT_STOP_COUNT> <TRANSIT_STOP_COUNT_LABEL>)");
 
@@ -1254,10 +1255,10 @@ TEST(NarrativeDictionary, test_en_US_transit_transfer) {
 TEST(NarrativeDictionary, test_en_US_transit_transfer_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
-  const auto& phrase_0 = dictionary->transit_transfer_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->transit_transfer_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "Transfer to take the <TRANSIT_NAME>.");
 
-  const auto& phrase_1 = dictionary->transit_transfer_verbal_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->transit_transfer_verbal_subset.phrase(1).phrase();
   validate(phrase_1, "Transfer to take the <TRANSIT_NAME> toward <TRANSIT_HEADSIGN>.");
 
   // empty_transit_name_labels
@@ -1269,11 +1270,11 @@ TEST(NarrativeDictionary, test_en_US_post_transition_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "Continue for <LENGTH>.",
-  const auto& phrase_0 = dictionary->post_transition_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->post_transition_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "Continue for <LENGTH>.");
 
   // "1": "Continue on <STREET_NAMES> for <LENGTH>."
-  const auto& phrase_1 = dictionary->post_transition_verbal_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->post_transition_verbal_subset.phrase(1).phrase();
   validate(phrase_1, "Continue on <STREET_NAMES> for <LENGTH>.");
 
   // metric_lengths
@@ -1294,7 +1295,7 @@ TEST(NarrativeDictionary, test_en_US_post_transition_transit_verbal) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "Continue for <LENGTH>.",
-  const auto& phrase_0 = dictionary->post_transition_transit_verbal_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->post_transition_transit_verbal_subset.phrase(0).phrase();
   validate(phrase_0, "Travel <TRANSIT_STOP_COUNT> <TRANSIT_STOP_COUNT_LABEL>.");
 
   // transit_stop_count_labels
@@ -1307,11 +1308,11 @@ TEST(NarrativeDictionary, test_en_US_verbal_multi_cue) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "<CURRENT_VERBAL_CUE> Then <NEXT_VERBAL_CUE>"
-  const auto& phrase_0 = dictionary->verbal_multi_cue_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->verbal_multi_cue_subset.phrase(0).phrase();
   validate(phrase_0, "<CURRENT_VERBAL_CUE> Then <NEXT_VERBAL_CUE>");
 
   // "1": "<CURRENT_VERBAL_CUE> Then, in <LENGTH>, <NEXT_VERBAL_CUE>"
-  const auto& phrase_1 = dictionary->verbal_multi_cue_subset.phrases.at("1");
+  const auto& phrase_1 = dictionary->verbal_multi_cue_subset.phrase(1).phrase();
   validate(phrase_1, "<CURRENT_VERBAL_CUE> Then, in <LENGTH>, <NEXT_VERBAL_CUE>");
 
   // metric_lengths
@@ -1327,7 +1328,7 @@ TEST(NarrativeDictionary, test_en_US_approach_verbal_alert) {
   std::shared_ptr<NarrativeDictionary> dictionary = GetNarrativeDictionary("en-US");
 
   // "0": "In <LENGTH>, <CURRENT_VERBAL_CUE>"
-  const auto& phrase_0 = dictionary->approach_verbal_alert_subset.phrases.at("0");
+  const auto& phrase_0 = dictionary->approach_verbal_alert_subset.phrase(0).phrase();
   validate(phrase_0, "In <LENGTH>, <CURRENT_VERBAL_CUE>");
 
   // metric_lengths
@@ -1339,6 +1340,139 @@ TEST(NarrativeDictionary, test_en_US_approach_verbal_alert) {
   validate(us_customary_lengths, kExpectedUsCustomaryLengths);
 }
 
+// The values the tags of every phrase are filled in with
+const std::vector<std::pair<std::string, std::string>> kTagValues = {
+    {kCardinalDirectionTag, "north"},
+    {kRelativeDirectionTag, "left"},
+    {kOrdinalValueTag, "2nd"},
+    {kStreetNamesTag, "Main Street"},
+    {kPreviousStreetNamesTag, "Old Street"},
+    {kBeginStreetNamesTag, "First Street"},
+    {kCrossStreetNamesTag, "Cross Street"},
+    {kRoundaboutExitStreetNamesTag, "Exit Street"},
+    {kRoundaboutExitBeginStreetNamesTag, "Exit Begin Street"},
+    {kRampExitNumbersVisualTag, "42"},
+    {kObjectLabelTag, "the gate"},
+    {kLengthTag, "2 kilometers"},
+    {kDestinationTag, "Home"},
+    {kCurrentVerbalCueTag, "Turn left."},
+    {kNextVerbalCueTag, "Turn right."},
+    {kNumberSignTag, "12A"},
+    {kBranchSignTag, "I 95 North"},
+    {kTowardSignTag, "Baltimore"},
+    {kNameSignTag, "Gateway"},
+    {kJunctionNameTag, "Big Junction"},
+    {kFerryLabelTag, "Ferry"},
+    {kTransitPlatformTag, "Union Station"},
+    {kStationLabelTag, "Station"},
+    {kTimeTag, "8:00 AM"},
+    {kTransitNameTag, "Red Line"},
+    {kTransitHeadSignTag, "Downtown"},
+    {kTransitPlatformCountTag, "3"},
+    {kTransitPlatformCountLabelTag, "stops"},
+    {kLevelTag, "Level 2"},
+};
+
+std::string render(const PhraseTemplate& phrase) {
+  std::string output = "left over";
+  phrase.Render(output, {{PhraseTag::kCardinalDirection, "north"},
+                         {PhraseTag::kRelativeDirection, "left"},
+                         {PhraseTag::kOrdinalValue, "2nd"},
+                         {PhraseTag::kStreetNames, "Main Street"},
+                         {PhraseTag::kPreviousStreetNames, "Old Street"},
+                         {PhraseTag::kBeginStreetNames, "First Street"},
+                         {PhraseTag::kCrossStreetNames, "Cross Street"},
+                         {PhraseTag::kRoundaboutExitStreetNames, "Exit Street"},
+                         {PhraseTag::kRoundaboutExitBeginStreetNames, "Exit Begin Street"},
+                         {PhraseTag::kRampExitNumbersVisual, "42"},
+                         {PhraseTag::kObjectLabel, "the gate"},
+                         {PhraseTag::kLength, "2 kilometers"},
+                         {PhraseTag::kDestination, "Home"},
+                         {PhraseTag::kCurrentVerbalCue, "Turn left."},
+                         {PhraseTag::kNextVerbalCue, "Turn right."},
+                         {PhraseTag::kNumberSign, "12A"},
+                         {PhraseTag::kBranchSign, "I 95 North"},
+                         {PhraseTag::kTowardSign, "Baltimore"},
+                         {PhraseTag::kNameSign, "Gateway"},
+                         {PhraseTag::kJunctionName, "Big Junction"},
+                         {PhraseTag::kFerryLabel, "Ferry"},
+                         {PhraseTag::kTransitPlatform, "Union Station"},
+                         {PhraseTag::kStationLabel, "Station"},
+                         {PhraseTag::kTime, "8:00 AM"},
+                         {PhraseTag::kTransitName, "Red Line"},
+                         {PhraseTag::kTransitHeadSign, "Downtown"},
+                         {PhraseTag::kTransitPlatformCount, "3"},
+                         {PhraseTag::kTransitPlatformCountLabel, "stops"},
+                         {PhraseTag::kLevel, "Level 2"}});
+  return output;
+}
+
+TEST(NarrativeDictionary, test_phrase_templates) {
+  for (const auto& locale : get_locales()) {
+    const auto& dictionary = *locale.second;
+    const std::vector<const PhraseSet*> phrase_sets = {
+        &dictionary.start_subset, &dictionary.start_verbal_subset, &dictionary.destination_subset,
+        &dictionary.destination_verbal_alert_subset, &dictionary.destination_verbal_subset,
+        &dictionary.becomes_subset, &dictionary.becomes_verbal_subset, &dictionary.continue_subset,
+        &dictionary.continue_verbal_alert_subset, &dictionary.continue_verbal_subset,
+        &dictionary.bear_subset, &dictionary.bear_verbal_subset, &dictionary.turn_subset,
+        &dictionary.turn_verbal_subset, &dictionary.sharp_subset, &dictionary.sharp_verbal_subset,
+        &dictionary.uturn_subset, &dictionary.uturn_verbal_subset, &dictionary.ramp_straight_subset,
+        &dictionary.ramp_straight_verbal_subset, &dictionary.ramp_subset,
+        &dictionary.ramp_verbal_subset, &dictionary.exit_subset, &dictionary.exit_verbal_subset,
+        &dictionary.exit_visual_subset, &dictionary.keep_subset, &dictionary.keep_verbal_subset,
+        &dictionary.keep_to_stay_on_subset, &dictionary.keep_to_stay_on_verbal_subset,
+        &dictionary.merge_subset, &dictionary.merge_verbal_subset,
+        &dictionary.enter_roundabout_subset, &dictionary.enter_roundabout_verbal_subset,
+        &dictionary.exit_roundabout_subset, &dictionary.exit_roundabout_verbal_subset,
+        &dictionary.enter_ferry_subset, &dictionary.enter_ferry_verbal_subset,
+        &dictionary.transit_connection_start_subset,
+        &dictionary.transit_connection_start_verbal_subset,
+        &dictionary.transit_connection_transfer_subset,
+        &dictionary.transit_connection_transfer_verbal_subset,
+        &dictionary.transit_connection_destination_subset,
+        &dictionary.transit_connection_destination_verbal_subset, &dictionary.depart_subset,
+        &dictionary.depart_verbal_subset, &dictionary.arrive_subset,
+        &dictionary.arrive_verbal_subset, &dictionary.transit_subset,
+        &dictionary.transit_verbal_subset, &dictionary.transit_remain_on_subset,
+        &dictionary.transit_remain_on_verbal_subset, &dictionary.transit_transfer_subset,
+        &dictionary.transit_transfer_verbal_subset, &dictionary.post_transition_verbal_subset,
+        &dictionary.post_transition_transit_verbal_subset, &dictionary.verbal_multi_cue_subset,
+        &dictionary.approach_verbal_alert_subset, &dictionary.pass_subset,
+        &dictionary.elevator_subset, &dictionary.steps_subset, &dictionary.escalator_subset,
+        &dictionary.enter_building_subset, &dictionary.exit_building_subset};
+
+    for (const auto* phrase_set : phrase_sets) {
+      ASSERT_FALSE(phrase_set->templates.empty());
+      for (const auto& phrase : phrase_set->templates) {
+        // Filling the tags in one pass gives what replacing them one after another did
+        const auto& text = phrase.second.phrase();
+        std::string expected = text;
+        for (const auto& tag : kTagValues) {
+          boost::replace_all(expected, tag.first, tag.second);
+        }
+        EXPECT_EQ(render(phrase.second), expected) << locale.first << " " << text;
+
+        // And the tags without values are left alone
+        std::string output;
+        phrase.second.Render(output, {});
+        EXPECT_EQ(output, text);
+      }
+    }
+  }
+}
+
+TEST(NarrativeDictionary, test_phrase_template_text) {
+  // Text that only looks like a tag is kept as it is
+  PhraseTemplate phrase("<LENGTH> <<CARDINAL_DIRECTION> on <STREET_NAME> <STREET_NAMES> < >");
+  std::string output;
+  phrase.Render(output, {{PhraseTag::kLength, "1 km"},
+                         {PhraseTag::kCardinalDirection, "north"},
+                         {PhraseTag::kStreetNames, "Main"},
+                         {PhraseTag::kStreetNames, "Second"}});
+  EXPECT_EQ(output, "1 km <north on <STREET_NAME> Main < >");
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
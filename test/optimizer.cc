@@ -1,6 +1,11 @@
 #include "thor/optimizer.h"
 #include "config.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
 #include <vector>
 
 #include "test.h"
@@ -33,6 +38,83 @@ TEST(Optimizer, Basic) {
                               2068, 1133, 1754, 2704, 2193, 1102, 2230, 2937, 854,  2000, 0};
   std::vector<uint32_t> expected_order = {0, 3, 7, 4, 6, 2, 8, 5, 9, 1, 10};
   TryOptimizer(11, costs, expected_order);
+
+  // local search finds a tour at least as good
+  LocalSearchOptimizer local_search;
+  local_search.Seed(111111);
+  auto order = local_search.Solve(11, costs);
+  EXPECT_LE(LocalSearchOptimizer::TourCost(11, costs, order),
+            LocalSearchOptimizer::TourCost(11, costs, expected_order));
+}
+
+// asymmetric costs between random points
+std::vector<float> RandomCosts(const uint32_t count, const uint32_t seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<float> distribution(0.f, 1000.f);
+  std::vector<std::pair<float, float>> points(count);
+  for (auto& point : points) {
+    point = {distribution(generator), distribution(generator)};
+  }
+  std::vector<float> costs(count * count);
+  for (uint32_t i = 0; i < count; ++i) {
+    for (uint32_t j = 0; j < count; ++j) {
+      costs[i * count + j] = std::hypot(points[i].first - points[j].first,
+                                        points[i].second - points[j].second) *
+                             (1.f + distribution(generator) / 3000.f);
+    }
+  }
+  return costs;
+}
+
+TEST(LocalSearchOptimizer, Optimal) {
+  // small enough to try every order
+  constexpr uint32_t count = 8;
+  for (uint32_t seed = 0; seed < 20; ++seed) {
+    auto costs = RandomCosts(count, seed);
+    std::vector<uint32_t> tour(count);
+    std::iota(tour.begin(), tour.end(), 0);
+    float best = std::numeric_limits<float>::max();
+    do {
+      best = std::min(best, LocalSearchOptimizer::TourCost(count, costs, tour));
+    } while (std::next_permutation(tour.begin() + 1, tour.end() - 1));
+
+    LocalSearchOptimizer optimizer(1000);
+    optimizer.Seed(seed);
+    EXPECT_NEAR(LocalSearchOptimizer::TourCost(count, costs, optimizer.Solve(count, costs)), best,
+                0.01f);
+  }
+}
+
+TEST(LocalSearchOptimizer, Concurrent) {
+  // every location is visited once with the origin and destination in place
+  constexpr uint32_t count = 50;
+  auto costs = RandomCosts(count, 50);
+  LocalSearchOptimizer optimizer(100, 4);
+  auto order = optimizer.Solve(count, costs);
+  ASSERT_EQ(order.size(), count);
+  EXPECT_EQ(order.front(), 0);
+  EXPECT_EQ(order.back(), count - 1);
+  std::sort(order.begin(), order.end());
+  for (uint32_t i = 0; i < count; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+
+  // and a single search is repeatable once it stops on its own
+  LocalSearchOptimizer single(60000);
+  single.Seed(7);
+  EXPECT_EQ(single.Solve(count, costs), single.Solve(count, costs));
+}
+
+TEST(LocalSearchOptimizer, Repeatable) {
+  // two requests with the same costs get the same order without seeding anything, the budget is
+  // only there so a slow machine can't cut the searches short
+  for (uint32_t count : {20, 100, 200}) {
+    auto costs = RandomCosts(count, count);
+    for (uint32_t concurrency : {1, 4}) {
+      auto order = LocalSearchOptimizer(60000, concurrency).Solve(count, costs);
+      EXPECT_EQ(LocalSearchOptimizer(60000, concurrency).Solve(count, costs), order);
+    }
+  }
 }
 
 } // namespace
@@ -0,0 +1,112 @@
+#include "../src/mjolnir/osmnodestore.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+using namespace valhalla::mjolnir;
+constexpr uint64_t kMaxId = 40000;
+
+namespace {
+
+OSMNode make_node(const uint64_t id) {
+  OSMNode node{id};
+  node.set_latlng(static_cast<double>(id % 360) - 180.0, static_cast<double>(id % 180) - 90.0);
+  return node;
+}
+
+} // namespace
+
+TEST(OSMNodeStore, ReferenceIntersection) {
+  OSMNodeStore store("test/data/osmnodestore_reference", 1, kMaxId);
+  store.reference(3);
+  store.reference(7);
+  store.reference(7);
+  store.reference(64, true);
+  store.reference(kMaxId);
+
+  EXPECT_TRUE(store.referenced(3));
+  EXPECT_FALSE(store.intersection(3));
+  EXPECT_TRUE(store.referenced(7));
+  EXPECT_TRUE(store.intersection(7));
+  EXPECT_TRUE(store.referenced(64));
+  EXPECT_TRUE(store.intersection(64));
+  EXPECT_TRUE(store.referenced(kMaxId));
+  EXPECT_FALSE(store.referenced(4));
+  EXPECT_FALSE(store.intersection(4));
+  EXPECT_FALSE(store.referenced(kMaxId * 1000));
+  EXPECT_FALSE(store.referenced(0));
+  EXPECT_FALSE(store.referenced(static_cast<uint64_t>(-7)));
+
+  store.freeze();
+  EXPECT_EQ(store.size(), 4);
+}
+
+TEST(OSMNodeStore, Random) {
+  // randomly reference some ids and store nodes for some of those
+  OSMNodeStore store("test/data/osmnodestore_random", 1, kMaxId);
+  std::unordered_map<uint64_t, bool> referenced;
+  for (uint64_t i = 0; i < kMaxId; ++i) {
+    uint64_t r = rand() % kMaxId + 1;
+    if (rand() % 2) {
+      referenced[r] = false;
+      store.reference(r);
+    }
+  }
+  store.freeze();
+  EXPECT_EQ(store.size(), referenced.size());
+
+  for (auto& id : referenced) {
+    if (rand() % 4) {
+      id.second = true;
+      store.set(make_node(id.first));
+    }
+  }
+
+  for (uint64_t i = 1; i <= kMaxId; ++i) {
+    auto found = referenced.find(i);
+    const auto* node = store.get(i);
+    if (found == referenced.end() || !found->second) {
+      EXPECT_EQ(node, nullptr);
+      continue;
+    }
+    ASSERT_NE(node, nullptr);
+    EXPECT_EQ(node->osmid_, i);
+    EXPECT_EQ(node->latlng(), make_node(i).latlng());
+  }
+}
+
+TEST(OSMNodeStore, OffsetRange) {
+  // ids in a planet sized range only cost bits from the smallest one up
+  constexpr uint64_t kMinId = 11000000000;
+  OSMNodeStore store("test/data/osmnodestore_offset", kMinId, kMinId + kMaxId);
+  store.reference(kMinId);
+  store.reference(kMinId + 65);
+  store.reference(kMinId + kMaxId);
+  store.freeze();
+  EXPECT_EQ(store.size(), 3);
+
+  EXPECT_FALSE(store.referenced(kMinId - 1));
+  EXPECT_FALSE(store.referenced(65));
+  EXPECT_FALSE(store.referenced(kMinId + kMaxId + 1));
+  for (uint64_t id : {kMinId, kMinId + 65, kMinId + kMaxId}) {
+    EXPECT_TRUE(store.referenced(id));
+    EXPECT_EQ(store.get(id), nullptr);
+    store.set(make_node(id));
+  }
+  for (uint64_t id : {kMinId, kMinId + 65, kMinId + kMaxId}) {
+    ASSERT_NE(store.get(id), nullptr);
+    EXPECT_EQ(store.get(id)->osmid_, id);
+  }
+  EXPECT_EQ(store.get(kMinId + 64), nullptr);
+}
+
+TEST(OSMNodeStore, InvalidRange) {
+  // negative osm ids come to us as huge unsigned ones which have no place in the store
+  EXPECT_THROW(OSMNodeStore("test/data/osmnodestore_invalid", 1, static_cast<uint64_t>(-1)),
+               std::invalid_argument);
+  EXPECT_THROW(OSMNodeStore("test/data/osmnodestore_invalid", 10, 9), std::invalid_argument);
+}
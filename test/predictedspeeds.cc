@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "baldr/predictedspeeds.h"
+#include "midgard/constants.h"
 #include "midgard/util.h"
 
 #include "test.h"
@@ -254,6 +255,77 @@ TEST(PredictedSpeeds, test_compress_decompress_accuracy) {
   EXPECT_LE(max_diff, 2.f) << "Low decompression accuracy"; // <= 2 KPH
 }
 
+TEST(PredictedSpeeds, test_decompress_matches_reference) {
+  std::array<float, kBucketsPerWeek> speeds;
+  for (uint32_t i = 0; i < kBucketsPerWeek; ++i)
+    speeds[i] = roundf(40.f + 20.f * cos(i / 35.f));
+  auto compressed_speeds = compress_speed_buckets(speeds.data());
+
+  // straight forward double precision DCT-III to compare the vectorized one against
+  for (uint32_t b = 0; b < kBucketsPerWeek; ++b) {
+    double expected = compressed_speeds[0] / std::sqrt(2.0);
+    for (uint32_t c = 1; c < kCoefficientCount; ++c)
+      expected += compressed_speeds[c] * std::cos(M_PI / kBucketsPerWeek * (b + 0.5) * c);
+    expected *= std::sqrt(2.0 / kBucketsPerWeek);
+    ASSERT_NEAR(decompress_speed_bucket(compressed_speeds.data(), b), expected, 1e-3) << b;
+  }
+}
+
+TEST(PredictedSpeeds, test_compress_rounding) {
+  // scaling the first coefficient once at the end rounds differently than scaling every term, this
+  // profile is one where that changes the compressed value so we pin what it always compressed to
+  std::array<float, kBucketsPerWeek> speeds;
+  for (uint32_t i = 0; i < kBucketsPerWeek; ++i)
+    speeds[i] = i % 5 == 0 ? 6.f : 5.f;
+  EXPECT_EQ(compress_speed_buckets(speeds.data())[0], 233);
+}
+
+TEST(PredictedSpeeds, test_speed_cache) {
+  // two edges with different profiles and one edge sharing a profile
+  std::array<float, kBucketsPerWeek> speeds;
+  std::vector<int16_t> profiles;
+  for (uint32_t p = 0; p < 2; ++p) {
+    for (uint32_t i = 0; i < kBucketsPerWeek; ++i)
+      speeds[i] = roundf(30.f + 15.f * sin(i / (10.f + 10.f * p)));
+    auto compressed = compress_speed_buckets(speeds.data());
+    profiles.insert(profiles.end(), compressed.begin(), compressed.end());
+  }
+  uint32_t offsets[] = {0, kCoefficientCount, 0};
+
+  PredictedSpeeds uncached;
+  uncached.set_offset(offsets);
+  uncached.set_profiles(profiles.data());
+
+  // a tiny cache so that we get lots of collisions
+  PredictedSpeeds cached;
+  cached.set_offset(offsets);
+  cached.set_profiles(profiles.data());
+  cached.reserve_cache(1);
+
+  // the cached values must always be exactly what decompressing would give, hit or miss
+  for (int pass = 0; pass < 2; ++pass) {
+    for (uint32_t secs = 0; secs < kSecondsPerWeek; secs += 7 * 60) {
+      for (uint32_t idx = 0; idx < 3; ++idx) {
+        ASSERT_EQ(cached.speed(idx, secs), uncached.speed(idx, secs)) << idx << " " << secs;
+      }
+    }
+  }
+}
+
+TEST(PredictedSpeeds, test_speed_cache_size) {
+  // the tile cache counts this memory so it has to be what was really allocated
+  PredictedSpeeds speeds;
+  EXPECT_EQ(speeds.cache_size(), 0);
+  speeds.reserve_cache(1);
+  EXPECT_EQ(speeds.cache_size(), 2 * sizeof(uint64_t));
+  speeds.reserve_cache(100);
+  EXPECT_EQ(speeds.cache_size(), 256 * sizeof(uint64_t));
+  speeds.reserve_cache(1000000);
+  EXPECT_EQ(speeds.cache_size(), 8192);
+  speeds.reserve_cache(0);
+  EXPECT_EQ(speeds.cache_size(), 0);
+}
+
 struct EncoderDecoderTest : public ::testing::Test {
   EncoderDecoderTest() {
     // fill in coefficients
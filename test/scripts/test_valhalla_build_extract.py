@@ -139,6 +139,27 @@ class TestBuildExtract(unittest.TestCase):
         gj_fp.unlink()
         gj_dir.rmdir()
 
+    def test_tile_order(self):
+        tile_dir = Path("/foo/")
+        here = str(tile_base_to_path(5, 52, 2, tile_dir))
+        next_to_here = str(tile_base_to_path(5.25, 52, 2, tile_dir))
+        above_here = str(tile_base_to_path(4, 50, 0, tile_dir))
+        far_away = str(tile_base_to_path(-70, -33.5, 2, tile_dir))
+
+        # neighbours are closer on the curve than tiles on the other side of the world, across levels too
+        key = valhalla_build_extract.get_tile_order_key
+        for other in (next_to_here, above_here):
+            self.assertLess(abs(key(here, 'hilbert') - key(other, 'hilbert')),
+                            abs(key(here, 'hilbert') - key(far_away, 'hilbert')))
+
+        # per level the levels stay apart
+        self.assertLess(key(above_here, 'hilbert_level'), key(far_away, 'hilbert_level'))
+
+        # by id its all of one level and then the next, in the order of the tile ids
+        self.assertLess(key(above_here, 'id'), key(far_away, 'id'))
+        self.assertLess(key(far_away, 'id'), key(here, 'id'))
+        self.assertLess(key(here, 'id'), key(next_to_here, 'id'))
+
     def test_create_extracts(self):
         config = {"mjolnir": {"tile_dir": str(TILE_PATH), "tile_extract": str(EXTRACT_PATH),
                               "traffic_extract": str(TRAFFIC_PATH)}}
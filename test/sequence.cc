@@ -1,5 +1,8 @@
 #include "midgard/sequence.h"
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 
 #include "test.h"
 
@@ -70,6 +73,51 @@ TEST(Sequence, Iterator) {
   EXPECT_EQ(i.position(), 0) << "Pre-decrement operator wasn't right";
 }
 
+TEST(Tar, ParallelScan) {
+  // big enough to be split up, with the data of the large entries being a tar itself which the
+  // threads landing in it will take for headers at first
+  const std::string file_name = "parallel_scan.tar";
+  {
+    std::ofstream nested_tar("nested.tar", std::ios::binary);
+    for (int i = 0; i < 64; ++i) {
+      test::write_tar_entry(nested_tar, "nested/" + std::to_string(i), std::string(2048, 'n'),
+                            1 << 19);
+    }
+  }
+  std::ifstream nested_in("nested.tar", std::ios::binary);
+  std::string nested((std::istreambuf_iterator<char>(nested_in)), std::istreambuf_iterator<char>());
+  {
+    std::ofstream out(file_name, std::ios::binary);
+    for (int i = 0; i < 100; ++i) {
+      test::write_tar_entry(out, "before/" + std::to_string(i), std::string(i, 'b'), i);
+    }
+    for (int i = 0; i < 3; ++i) {
+      test::write_tar_entry(out, "big/" + std::to_string(i), nested, 48 << 20);
+      test::write_tar_entry(out, "after/" + std::to_string(i), "a", 1 << 20);
+    }
+    // some garbage and then the end of the archive
+    out.write(std::string(sizeof(tar::header_t), 'x').data(), sizeof(tar::header_t));
+    out.write(std::string(2 * sizeof(tar::header_t), '\0').data(), 2 * sizeof(tar::header_t));
+  }
+
+  tar serial(file_name);
+  EXPECT_EQ(serial.contents.size(), 106);
+  EXPECT_EQ(serial.corrupt_blocks, 1);
+  for (unsigned int concurrency : {2, 3, 7, 16}) {
+    tar parallel(file_name, true, true, nullptr, POSIX_MADV_NORMAL, concurrency);
+    EXPECT_EQ(parallel.corrupt_blocks, serial.corrupt_blocks);
+    ASSERT_EQ(parallel.contents.size(), serial.contents.size());
+    for (const auto& entry : serial.contents) {
+      auto found = parallel.contents.find(entry.first);
+      ASSERT_NE(found, parallel.contents.cend()) << entry.first;
+      EXPECT_EQ(found->second.first - parallel.mm.get(), entry.second.first - serial.mm.get());
+      EXPECT_EQ(found->second.second, entry.second.second);
+    }
+  }
+  std::remove(file_name.c_str());
+  std::remove("nested.tar");
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -5,9 +5,13 @@
 #include "baldr/predictedspeeds.h"
 #include "baldr/rapidjson_utils.h"
 #include "baldr/traffictile.h"
+#include "midgard/sequence.h"
 #include "mjolnir/graphtilebuilder.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -415,6 +419,28 @@ make_clean_graphreader(const boost::property_tree::ptree& mjolnir_conf) {
   return std::make_shared<ResettingGraphReader>(mjolnir_conf);
 }
 
+void write_tar_entry(std::ostream& out,
+                     const std::string& name,
+                     const std::string& data,
+                     size_t size) {
+  valhalla::midgard::tar::header_t header{};
+  memcpy(header.name, name.data(), std::min(name.size(), sizeof(header.name)));
+  snprintf(header.mode, sizeof(header.mode), "%07o", 0644);
+  snprintf(header.size, sizeof(header.size), "%011llo", static_cast<unsigned long long>(size));
+  header.typeflag = '0';
+  memcpy(header.magic, "ustar", 6);
+  memset(header.chksum, ' ', sizeof(header.chksum));
+  unsigned checksum = 0;
+  for (size_t i = 0; i < sizeof(header); ++i) {
+    checksum += reinterpret_cast<const unsigned char*>(&header)[i];
+  }
+  snprintf(header.chksum, sizeof(header.chksum), "%06o", checksum);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(data.data(), data.size());
+  out.seekp((size + sizeof(header) - 1) / sizeof(header) * sizeof(header) - data.size(),
+            std::ios::cur);
+}
+
 /** Copy of raw header for use with sizeof() **/
 typedef struct {
   char name[100];
@@ -9,6 +9,7 @@
 #include "mjolnir/graphtilebuilder.h"
 
 #include <cmath>
+#include <ostream>
 #include <random>
 #include <string>
 #ifndef _MSC_VER
@@ -78,6 +79,20 @@ encoded_shape_equality(const std::string& expected, const std::string& actual, d
 std::shared_ptr<valhalla::baldr::GraphReader>
 make_clean_graphreader(const boost::property_tree::ptree& mjolnir_conf);
 
+/**
+ * Appends a ustar entry to a tar being written. The entry claims size bytes of which only data is
+ * written, the rest up to the next 512 byte block is skipped so that big entries stay sparse
+ *
+ * @param out   the stream the tar is written to
+ * @param name  the path of the entry within the tar
+ * @param data  the leading bytes of the entry
+ * @param size  the size of the entry, at least data.size()
+ */
+void write_tar_entry(std::ostream& out,
+                     const std::string& name,
+                     const std::string& data,
+                     size_t size);
+
 /*************************************************************/
 // Creates an empty traffic file
 //
@@ -0,0 +1,73 @@
+#include "mjolnir/textlistbuilder.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace valhalla::mjolnir;
+
+namespace {
+
+std::string text_at(const TextListBuilder& text_list, const uint32_t offset) {
+  return std::string(text_list.data() + offset);
+}
+
+TEST(TextListBuilder, AddDeduplicates) {
+  TextListBuilder text_list;
+  EXPECT_EQ(text_list.size(), 1);
+  EXPECT_EQ(text_list.Add(""), 0);
+
+  auto main_street = text_list.Add("Main Street");
+  auto i95 = text_list.Add("I-95");
+  EXPECT_EQ(main_street, 1);
+  EXPECT_EQ(i95, 13);
+  EXPECT_EQ(text_list.Add("Main Street"), main_street);
+  EXPECT_EQ(text_list.Add("I-95"), i95);
+  EXPECT_NE(text_list.Add("I-9"), i95);
+  EXPECT_EQ(text_list.size(), 22);
+  EXPECT_EQ(text_at(text_list, main_street), "Main Street");
+  EXPECT_EQ(text_at(text_list, i95), "I-95");
+
+  // embedded nulls (tagged values) are their own entries
+  std::string tagged("\0ab", 3);
+  auto tagged_offset = text_list.Add(tagged);
+  EXPECT_EQ(std::string(text_list.data() + tagged_offset, 3), tagged);
+  EXPECT_EQ(text_list.Add(tagged), tagged_offset);
+}
+
+TEST(TextListBuilder, Grow) {
+  // enough to rehash the table several times
+  TextListBuilder text_list;
+  std::vector<uint32_t> offsets;
+  for (int i = 0; i < 10000; ++i) {
+    offsets.push_back(text_list.Add("name " + std::to_string(i)));
+  }
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_EQ(text_list.Add("name " + std::to_string(i)), offsets[i]);
+    EXPECT_EQ(text_at(text_list, offsets[i]), "name " + std::to_string(i));
+  }
+}
+
+TEST(TextListBuilder, AssignIndex) {
+  const char tile_text[] = "\0First\0Second\0";
+  TextListBuilder text_list;
+  text_list.Assign(tile_text, sizeof(tile_text) - 1);
+  text_list.Index(0, 0);
+  text_list.Index(1, 5);
+  text_list.Index(7, 6);
+  EXPECT_EQ(text_list.size(), sizeof(tile_text) - 1);
+
+  EXPECT_EQ(text_list.Add("First"), 1);
+  EXPECT_EQ(text_list.Add("Second"), 7);
+  EXPECT_EQ(text_list.Add("Third"), sizeof(tile_text) - 1);
+  EXPECT_THROW(text_list.Index(20, 10), std::runtime_error);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
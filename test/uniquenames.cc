@@ -1,4 +1,6 @@
 #include <cstdint>
+#include <thread>
+#include <vector>
 
 #include "mjolnir/uniquenames.h"
 
@@ -45,6 +47,89 @@ TEST(UniqueNames, TestAddAndIndex) {
   EXPECT_EQ(names.name(index6), "I-95 N");
 }
 
+TEST(UniqueNames, Concurrent) {
+  UniqueNames names;
+  constexpr uint32_t kThreads = 4;
+  constexpr uint32_t kNames = 10000;
+
+  // every thread adds all the names, in a different order, and checks each one right away
+  std::vector<std::vector<uint32_t>> indexes(kThreads, std::vector<uint32_t>(kNames));
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&names, &indexes, t]() {
+      for (uint32_t i = 0; i < kNames; ++i) {
+        uint32_t n = (i * 7 + t * 1000) % kNames;
+        auto name = "Street " + std::to_string(n);
+        indexes[t][n] = names.index(name);
+        EXPECT_EQ(names.name(indexes[t][n]), name);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // everyone got the same index for the same name and the indexes are dense
+  EXPECT_EQ(names.Size(), kNames);
+  for (uint32_t t = 1; t < kThreads; ++t) {
+    EXPECT_EQ(indexes[t], indexes[0]);
+  }
+  for (uint32_t n = 0; n < kNames; ++n) {
+    EXPECT_GT(indexes[0][n], 0);
+    EXPECT_LE(indexes[0][n], kNames);
+    EXPECT_EQ(names.name(indexes[0][n]), "Street " + std::to_string(n));
+  }
+  EXPECT_GT(names.MemoryUsage(), 0);
+}
+
+TEST(UniqueNames, MemoryUsageWhileAdding) {
+  UniqueNames names;
+  const size_t empty = names.MemoryUsage();
+
+  // measuring while another thread adds names must be safe and never shrink
+  std::thread adder([&names]() {
+    for (uint32_t i = 0; i < 20000; ++i) {
+      names.index("A name long enough to need its own allocation " + std::to_string(i));
+    }
+  });
+  size_t last = empty;
+  for (int i = 0; i < 100; ++i) {
+    const size_t usage = names.MemoryUsage();
+    EXPECT_GE(usage, last);
+    last = usage;
+  }
+  adder.join();
+  EXPECT_GE(names.MemoryUsage(), last);
+  EXPECT_GT(names.MemoryUsage(), empty);
+}
+
+TEST(UniqueNames, ReadWhileAdding) {
+  UniqueNames names;
+  constexpr uint32_t kNames = 20000;
+
+  // a name that can be looked up by its index has all of its bytes, even while names are added
+  std::thread adder([&names]() {
+    for (uint32_t i = 0; i < kNames; ++i) {
+      names.index("Road number " + std::to_string(i));
+    }
+  });
+  size_t seen = 0;
+  while (seen < kNames) {
+    seen = names.Size();
+    for (uint32_t index = 1; index <= seen; ++index) {
+      auto name = names.view(index);
+      if (!name.empty()) {
+        ASSERT_EQ(name, "Road number " + std::to_string(index - 1));
+      }
+    }
+  }
+  adder.join();
+  for (uint32_t index = 1; index <= kNames; ++index) {
+    EXPECT_EQ(names.view(index), names.name(index));
+  }
+  EXPECT_EQ(names.view(kNames + 1), "");
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -733,6 +733,29 @@ TEST(UtilMidgard, SequenceSort) {
   EXPECT_TRUE(std::equal(in_mem.begin(), in_mem.end(), standard.begin()));
 }
 
+TEST(UtilMidgard, SequenceSortConcurrent) {
+  std::vector<uint32_t> in_mem;
+  for (int i = 0; i < 100000; ++i) {
+    in_mem.push_back(static_cast<uint32_t>(rand() % 5000));
+  }
+  auto expected = in_mem;
+  std::sort(expected.begin(), expected.end());
+
+  // several chunks per thread, one chunk per thread and chunks which fit in memory entirely
+  for (size_t buffer_size : {size_t(1327), size_t(100000), size_t(200000)}) {
+    for (size_t concurrency : {1, 2, 3, 8}) {
+      valhalla::midgard::sequence<uint32_t> seq("uint_sequence_test_concurrent.bin", true);
+      for (auto n : in_mem) {
+        seq.push_back(n);
+      }
+      seq.sort([](uint32_t a, uint32_t b) { return a < b; }, buffer_size, concurrency);
+      ASSERT_EQ(seq.size(), expected.size());
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(), seq.begin()))
+          << "buffer_size " << buffer_size << " concurrency " << concurrency;
+    }
+  }
+}
+
 TEST(UtilMidgard, TriangleContains) {
   PointLL a = {1, 1}, b = {2, 1}, c = {2, 2};
 
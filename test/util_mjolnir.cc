@@ -1,3 +1,4 @@
+#include <array>
 #include <filesystem>
 #include <sstream>
 
@@ -91,6 +92,68 @@ TEST(UtilMjolnir, TileManifestLogToFile) {
   EXPECT_EQ(read.tileset[GraphId{5970554}], manifest.tileset[GraphId{5970554}]);
 }
 
+TEST(UtilMjolnir, SplitCsvRow) {
+  auto split = [](const std::string& row) {
+    std::array<std::pair<const char*, const char*>, 4> fields;
+    size_t count = mjolnir::split_csv_row(row.data(), row.data() + row.size(), fields.data(), 4);
+    std::vector<std::string> columns;
+    for (size_t i = 0; i < count; ++i)
+      columns.emplace_back(fields[i].first, fields[i].second);
+    return columns;
+  };
+  using columns_t = std::vector<std::string>;
+  EXPECT_EQ(split("1/2/3,40,30,abc"), (columns_t{"1/2/3", "40", "30", "abc"}));
+  // empty columns are skipped rather than returned
+  EXPECT_EQ(split("1/2/3,,40,,30,"), (columns_t{"1/2/3", "40", "30"}));
+  EXPECT_EQ(split(",,1/2/3,40"), (columns_t{"1/2/3", "40"}));
+  EXPECT_EQ(split(",,,"), columns_t{});
+  EXPECT_EQ(split(""), columns_t{});
+  // anything past the max columns is ignored
+  EXPECT_EQ(split("a,b,c,d,e,f"), (columns_t{"a", "b", "c", "d"}));
+}
+
+TEST(UtilMjolnir, ParseGraphId) {
+  auto parse = [](const std::string& column, uint32_t& id) {
+    return mjolnir::parse_graph_id(column.data(), column.data() + column.size(), id);
+  };
+  uint32_t id = 0;
+  EXPECT_TRUE(parse("2/37741/5", id));
+  EXPECT_EQ(id, 5);
+  // leading plus signs and whitespace are fine just like they were with stoul
+  EXPECT_TRUE(parse("+2/+37741/+7", id));
+  EXPECT_EQ(id, 7);
+  EXPECT_TRUE(parse(" 2/ 37741/ 9", id));
+  EXPECT_EQ(id, 9);
+  // but nothing may follow the id
+  id = 0;
+  for (const auto* bad : {"2/37741/5x", "2/37741/5 ", "2/37741/5/1", "2/37741", "2/37741/", "",
+                          "-2/37741/5", "2//5", "+/37741/5", "++2/37741/5", "8/37741/5"}) {
+    EXPECT_FALSE(parse(bad, id)) << bad;
+    EXPECT_EQ(id, 0) << bad;
+  }
+}
+
+TEST(UtilMjolnir, ParseSpeed) {
+  auto parse = [](const std::string& column, uint8_t& speed) {
+    return mjolnir::parse_speed(column.data(), column.data() + column.size(), speed);
+  };
+  uint8_t speed = 0;
+  EXPECT_TRUE(parse("42", speed));
+  EXPECT_EQ(speed, 42);
+  // like stoi leading whitespace and a plus sign are fine and trailing characters are ignored
+  EXPECT_TRUE(parse("+43", speed));
+  EXPECT_EQ(speed, 43);
+  EXPECT_TRUE(parse("  44", speed));
+  EXPECT_EQ(speed, 44);
+  EXPECT_TRUE(parse("45kph", speed));
+  EXPECT_EQ(speed, 45);
+  speed = 0;
+  for (const auto* bad : {"", " ", "+", "+-1", "kph", "++5"}) {
+    EXPECT_FALSE(parse(bad, speed)) << bad;
+    EXPECT_EQ(speed, 0) << bad;
+  }
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -28,6 +29,13 @@ struct tile_gone_error_t : public std::runtime_error {
   tile_gone_error_t(std::string prefix, baldr::GraphId edgeid);
 };
 
+// An entry of the index.bin file at the start of a tile extract, describing where one tile is
+struct tile_index_entry {
+  uint64_t offset;  // byte offset from the beginning of the tar
+  uint32_t tile_id; // just level and tileindex hence fitting in 32bits
+  uint32_t size;    // size of the tile in bytes
+};
+
 struct IncidentResult {
   std::shared_ptr<const IncidentsTile> tile;
   // Index into the Location array
@@ -467,6 +475,22 @@ public:
     return !tile_extract_->traffic_tiles.empty();
   }
 
+  /**
+   * How far reading the tile and traffic extracts into memory ahead of use has come, see
+   * mjolnir.tile_extract_warmup.
+   * @return the fraction of the extracts read so far or nothing if they are not warmed up
+   */
+  std::optional<float> GetExtractWarmupProgress() const;
+
+  /**
+   * How many tiles this reader was asked for by id over its life and how many of those weren't in
+   * its cache. What a request fetched is how much these went up while it ran
+   * @return the number of tiles asked for and the number of cache misses among them
+   */
+  std::pair<uint64_t, uint64_t> GetTileCounts() const {
+    return {tiles_fetched_, tile_cache_misses_};
+  }
+
   /**
    * Get a pointer to a graph tile object given a GraphId.
    * @param graphid  the graphid of the tile
@@ -507,6 +531,29 @@ public:
     return GetGraphTile(pointll, TileHierarchy::levels().back().level);
   }
 
+  /**
+   * Warms up the reader by loading a batch of tiles into the tile cache ahead of time. Tiles which
+   * are not on disk, or cannot be read from it, are fetched from the tile_url concurrently, at
+   * most concurrency at a time. Each fetched tile is validated before it is written to the tile_dir
+   * (if any) and inserted into the cache, tiles which could not be found are remembered just like
+   * GetGraphTile would. The cache is trimmed as it fills so a large batch cannot overcommit it.
+   * @param  tile_ids     the ids of the tiles to load, duplicates and non base ids are fine
+   * @param  concurrency  how many tiles to fetch in parallel, 0 means MaxConcurrentUsers()
+   * @return the number of requested tiles which were loaded, some of them may have since been
+   *         trimmed from the cache if the batch is larger than the cache
+   */
+  size_t PrefetchTiles(const std::vector<GraphId>& tile_ids, size_t concurrency = 0);
+
+  /**
+   * Warms up the reader with all of the tiles, at every level, which intersect the bounding box
+   * @param  bbox         the bounding box of the region to load
+   * @param  concurrency  how many tiles to fetch in parallel, 0 means MaxConcurrentUsers()
+   * @return the number of tiles in the region which are now available in the cache
+   */
+  size_t PrefetchTiles(const midgard::AABB2<midgard::PointLL>& bbox, size_t concurrency = 0) {
+    return PrefetchTiles(TileHierarchy::GetGraphIds(bbox), concurrency);
+  }
+
   /**
    * Clears the cache
    */
@@ -971,6 +1018,9 @@ public:
   IncidentResult GetIncidents(const GraphId& edge_id, graph_tile_ptr& edge_tile);
 
 protected:
+  // reads the extracts into memory ahead of use, shared by the readers of a process
+  struct extract_warmup_t;
+
   // (Tar) extract of tiles - the contents are empty if not being used
   struct tile_extract_t {
     tile_extract_t(const boost::property_tree::ptree& pt, bool traffic_readonly = true);
@@ -980,10 +1030,14 @@ protected:
     std::shared_ptr<midgard::tar> archive;
     std::shared_ptr<midgard::tar> traffic_archive;
     uint64_t checksum;
+    // whether to ask the kernel to read in a whole tile as soon as it is first used
+    bool prefetch;
+    // reading of the extracts ahead of use, null unless configured
+    std::shared_ptr<extract_warmup_t> warmup;
   };
   std::shared_ptr<const tile_extract_t> tile_extract_;
   static std::shared_ptr<const GraphReader::tile_extract_t>
-  get_extract_instance(const boost::property_tree::ptree& pt);
+  get_extract_instance(const boost::property_tree::ptree& pt, bool traffic_readonly = true);
 
   // Information about where the tiles are kept
   const std::string tile_dir_;
@@ -999,6 +1053,10 @@ protected:
   std::unique_ptr<TileCache> cache_;
 
   bool enable_incidents_;
+
+  // see GetTileCounts
+  uint64_t tiles_fetched_ = 0;
+  uint64_t tile_cache_misses_ = 0;
 };
 
 // Given the Location relation, return the full metadata
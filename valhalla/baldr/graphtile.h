@@ -151,6 +151,15 @@ public:
     return header_;
   }
 
+  /**
+   * Gets the bytes of memory the tile needs beyond its data, which is what the speeds it caches
+   * once they are decompressed take up.
+   * @return  Returns the size of the memory the tile allocates for itself.
+   */
+  size_t overhead_size() const {
+    return predictedspeeds_.cache_size();
+  }
+
   /**
    * Get a pointer to a node.
    * @return  Returns a pointer to the node.
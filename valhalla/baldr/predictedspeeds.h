@@ -2,6 +2,10 @@
 #define VALHALLA_BALDR_PREDICTEDSPEEDS_H_
 
 #include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <valhalla/midgard/util.h>
 
 namespace valhalla {
@@ -75,25 +79,71 @@ public:
     profiles_ = profiles;
   }
 
+  /**
+   * Allocates the cache of decompressed speed buckets. Time dependent searches (matrices in
+   * particular) cost the same edges at the same time of day over and over again, so rather than
+   * doing the inverse DCT every time we remember the speeds in a small direct mapped cache. The
+   * cache is keyed by edge index and bucket and lives as long as the tile so it never goes stale.
+   * @param  profile_count  The number of speed profiles in the tile, 0 disables the cache.
+   */
+  void reserve_cache(const uint32_t profile_count);
+
   /**
    * Get the speed given the edge Id and the seconds of the week.
    * @param  idx  Directed edge index.
    * @param  seconds_of_week  Seconds from start of the week (local time).
    */
   float speed(const uint32_t idx, const uint32_t seconds_of_week) const {
-    // Get a pointer to the compressed speed profile for this edge. Assume the edge Id is valid
-    // (otherwise an exception would be thrown when getting the directed edge) and the profile
-    // offset is valid. If there is no predicted speed profile this method will not be called due
-    // to DirectedEdge::has_predicted_speed being false.
-    const int16_t* coefficients = profiles_ + offset_[idx];
+    const uint32_t bucket = seconds_of_week / kSpeedBucketSizeSeconds;
+    if (cache_) {
+      // Each cache entry packs the key (edge index and bucket) and the speed into a single word so
+      // that the cache can be read and written from multiple threads without any locking
+      const uint32_t key = (idx << kBucketBits) | bucket;
+      const auto& entry = cache_[(key * kCacheHashMultiplier) >> (32 - cache_bits_)];
+      uint64_t cached = entry.load(std::memory_order_relaxed);
+      if (static_cast<uint32_t>(cached >> 32) == key) {
+        float speed;
+        uint32_t speed_bits = static_cast<uint32_t>(cached);
+        std::memcpy(&speed, &speed_bits, sizeof(speed));
+        return speed;
+      }
+    }
+    return decompress_speed(idx, bucket);
+  }
 
-    return decompress_speed_bucket(coefficients, seconds_of_week / kSpeedBucketSizeSeconds);
+  /**
+   * Get the bytes of memory the cache of decompressed speed buckets takes up.
+   * @return  The size of the cache, 0 if there is none.
+   */
+  size_t cache_size() const {
+    return cache_ ? sizeof(std::atomic<uint64_t>) << cache_bits_ : 0;
   }
 
 protected:
+  /**
+   * Decompresses the speed of the edge in the bucket and remembers it in the cache if there is one.
+   * @param  idx     Directed edge index.
+   * @param  bucket  Index of the bucket we want the speed of.
+   */
+  float decompress_speed(const uint32_t idx, const uint32_t bucket) const;
+
+  // Bits needed for a bucket index, the rest of the 32 bit cache key is the edge index
+  static constexpr uint32_t kBucketBits = 11;
+  static_assert(kBucketsPerWeek <= (1u << kBucketBits), "Buckets must fit in the cache key");
+  // Largest cache is 2^kMaxCacheBits entries of 8 bytes each (8KB per tile)
+  static constexpr uint32_t kMaxCacheBits = 10;
+  // Fibonacci hashing to spread the keys over the cache
+  static constexpr uint32_t kCacheHashMultiplier = 2654435769u;
+  // No valid key has all its bits set because bucket indices never reach 2^kBucketBits - 1
+  static constexpr uint64_t kEmptyCacheEntry = std::numeric_limits<uint64_t>::max();
+
   const uint32_t* offset_;  // Offset into the array of compressed speed profiles
                             // for each directed edge
   const int16_t* profiles_; // Compressed speed profiles
+
+  // Cache of decompressed speeds, each entry is the key in the high and the speed in the low bits
+  std::unique_ptr<std::atomic<uint64_t>[]> cache_;
+  uint32_t cache_bits_ = 0;
 };
 
 } // namespace baldr
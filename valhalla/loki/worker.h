@@ -113,6 +113,7 @@ private:
   std::string service_name() const override {
     return "loki";
   }
+  work_counters_t counters() const override;
 };
 } // namespace loki
 } // namespace valhalla
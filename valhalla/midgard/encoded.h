@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -158,21 +159,22 @@ container_t decode7(const std::string& encoded, const double precision = DECODE_
 }
 
 /**
- * Polyline encode a container of points into a string suitable for web use
- * Note: newer versions of this algorithm allow one to specify a zoom level
- * which allows displaying simplified versions of the encoded linestring
+ * Polyline encode a range of points onto the end of a string. This lets a part of a shape be
+ * encoded without copying its points out first, or into a string that is already allocated
  *
- * @param points    the list of points to encode
+ * @param begin     the first point to encode
+ * @param end       one past the last point to encode
+ * @param output    the string to append the encoded points to
  * @param precision Precision of the encoded polyline. Defaults to 6 digit precision.
- * @return string   the encoded container of points
  */
-template <class container_t>
-std::string encode(const container_t& points, const int precision = ENCODE_PRECISION) {
-  // a place to keep the output
-  std::string output;
+template <class iterator_t>
+void encode(iterator_t begin,
+            iterator_t end,
+            std::string& output,
+            const int precision = ENCODE_PRECISION) {
   // unless the shape is very course you should probably only need about 3 bytes
   // per coord, which is 6 bytes with 2 coords, so we overshoot to 8 just in case
-  output.reserve(points.size() * 8);
+  output.reserve(output.size() + std::distance(begin, end) * 8);
 
   // handy lambda to turn an integer into an encoded string
   auto serialize = [&output](int number) {
@@ -192,10 +194,10 @@ std::string encode(const container_t& points, const int precision = ENCODE_PRECI
   // this is an offset encoding so we remember the last point we saw
   int last_lon = 0, last_lat = 0;
   // for each point
-  for (const auto& p : points) {
+  for (auto p = begin; p != end; ++p) {
     // shift the decimal point 5 places to the right and truncate
-    int lon = static_cast<int>(round(static_cast<double>(p.first) * precision));
-    int lat = static_cast<int>(round(static_cast<double>(p.second) * precision));
+    int lon = static_cast<int>(round(static_cast<double>(p->first) * precision));
+    int lat = static_cast<int>(round(static_cast<double>(p->second) * precision));
     // encode each coordinate, lat first for some reason
     serialize(lat - last_lat);
     serialize(lon - last_lon);
@@ -203,6 +205,22 @@ std::string encode(const container_t& points, const int precision = ENCODE_PRECI
     last_lon = lon;
     last_lat = lat;
   }
+}
+
+/**
+ * Polyline encode a container of points into a string suitable for web use
+ * Note: newer versions of this algorithm allow one to specify a zoom level
+ * which allows displaying simplified versions of the encoded linestring
+ *
+ * @param points    the list of points to encode
+ * @param precision Precision of the encoded polyline. Defaults to 6 digit precision.
+ * @return string   the encoded container of points
+ */
+template <class container_t>
+std::string encode(const container_t& points, const int precision = ENCODE_PRECISION) {
+  // a place to keep the output
+  std::string output;
+  encode(points.begin(), points.end(), output, precision);
   return output;
 }
 
@@ -23,6 +23,9 @@ public:
 // register your custom loggers here
 bool RegisterLogger(const std::string& name, LoggerCreator function_ptr);
 
+// the factory of all the registered loggers, to produce loggers besides the one GetLogger returns
+LoggerFactory& GetFactory();
+
 // the Log levels we support
 enum class LogLevel : char { LogTrace, LogDebug, LogInfo, LogWarn, LogError };
 
@@ -34,6 +37,11 @@ public:
   virtual ~Logger();
   virtual void Log(const std::string&, const LogLevel);
   virtual void Log(const std::string&, const std::string& custom_directive = " [TRACE] ");
+  // writes records that already carry their time stamp, level and newline. the async logger
+  // formats records on the calling thread and hands them to the logger it wraps this way
+  virtual void Write(const std::string& records);
+  // how many messages the logger had to throw away, only loggers that queue messages drop any
+  virtual size_t DroppedCount() const;
 
 protected:
   std::mutex lock;
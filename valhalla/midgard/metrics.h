@@ -0,0 +1,54 @@
+#ifndef VALHALLA_MIDGARD_METRICS_H_
+#define VALHALLA_MIDGARD_METRICS_H_
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace valhalla {
+namespace midgard {
+
+// the histograms are globals of the process. they only hold what the requests that finished in
+// it recorded, so they cover all the stages only when those all run in one process, as they do in
+// valhalla_service. with the stages in processes of their own each one has its own partial set
+namespace metrics {
+
+// the upper bounds of the buckets of a histogram go 1, 2, 5 from one decade to the next, from
+// hundredths of a millisecond up to tens of millions of edges expanded
+constexpr size_t kBucketCount = 28;
+const std::array<double, kBucketCount>& bucket_bounds();
+
+// a histogram of the values of one metric. the last count is of the values past the last bound
+struct histogram_t {
+  std::array<uint64_t, kBucketCount + 1> counts{};
+  uint64_t count = 0;
+  double sum = 0;
+  double max = 0;
+
+  void observe(double value);
+
+  // estimates the value below which the given fraction of the values fall, by interpolating
+  // inside the bucket it lands in. it's 0 without any values
+  double quantile(double fraction) const;
+};
+
+// the metrics are only kept once something turns them on, until then observe does nothing
+void enable(bool enabled);
+bool enabled();
+
+// adds the value to the histogram of the metric with the given key. safe to call from any thread
+void observe(const std::string& key, double value);
+
+// a copy of the histograms of all the metrics kept so far, by their keys
+std::map<std::string, histogram_t> snapshot();
+
+// forgets all the histograms
+void clear();
+
+} // namespace metrics
+
+} // namespace midgard
+} // namespace valhalla
+
+#endif // VALHALLA_MIDGARD_METRICS_H_
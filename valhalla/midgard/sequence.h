@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cmath>
 #include <cstdint>
@@ -10,9 +11,11 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <queue>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -68,7 +71,9 @@
 #define MAP_ANONYMOUS 0x20
 #define MAP_FAILED (reinterpret_cast<void*>(static_cast<LONG_PTR>(-1)))
 #define POSIX_MADV_NORMAL 0     // ignored
+#define POSIX_MADV_RANDOM 1     // ignored
 #define POSIX_MADV_SEQUENTIAL 2 // ignored
+#define POSIX_MADV_WILLNEED 3   // ignored
 
 inline void* mmap(void* addr, size_t length, int prot, int flags, int fd, long long offset) {
   (void)addr; // ignored
@@ -149,8 +154,12 @@ public:
     unmap();
   }
 
-  // create a new file to map with a given size
-  void create(const std::string& new_file_name, size_t new_count, int advice = POSIX_MADV_NORMAL) {
+  // create a new file to map with a given size. the file is sparse unless it is allocated, then
+  // running out of disk space throws here rather than being a SIGBUS when the map is written to
+  void create(const std::string& new_file_name,
+              size_t new_count,
+              int advice = POSIX_MADV_NORMAL,
+              bool allocate = false) {
     decltype(stat::st_size) target_size = new_count * sizeof(T);
     struct stat s;
     if (stat(new_file_name.c_str(), &s) || s.st_size != target_size) {
@@ -160,6 +169,22 @@ public:
       f.seekp(new_count * sizeof(T) - 1);
       f.write("\0", 1);
     }
+#ifdef __linux__
+    if (allocate && new_count > 0) {
+      auto fd = open(new_file_name.c_str(), O_RDWR, 0);
+      if (fd == -1) {
+        throw std::runtime_error(new_file_name + "(open): " + strerror(errno));
+      }
+      // it returns the error rather than setting errno
+      auto error = posix_fallocate(fd, 0, target_size);
+      close(fd);
+      if (error) {
+        throw std::runtime_error(new_file_name + "(posix_fallocate): " + strerror(error));
+      }
+    }
+#else
+    (void)allocate;
+#endif
     // map it
     map(new_file_name, new_count, advice);
   }
@@ -209,6 +234,42 @@ public:
     map(new_file_name, new_count, advice, true /* readonly */);
   }
 
+  // tell the kernel how a range of the map is going to be used, the range is widened to whole pages
+  void advise(size_t offset, size_t length, int advice) const {
+#ifndef _WIN32
+    if (!ptr || length == 0) {
+      return;
+    }
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t begin = offset * sizeof(T) / page_size * page_size;
+    size_t end = std::min((offset + length) * sizeof(T), count * sizeof(T));
+    posix_madvise(static_cast<char*>(ptr) + begin, end - begin, advice);
+#else
+    (void)offset;
+    (void)length;
+    (void)advice;
+#endif
+  }
+
+  // start writing a range of the map back to the file and drop its pages from memory, they are
+  // read back in if they are used again. the range is widened to whole pages, the map is shared so
+  // any of them still being written to keep their changes
+  void release(size_t offset, size_t length) const {
+#ifndef _WIN32
+    if (!ptr || length == 0) {
+      return;
+    }
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t begin = offset * sizeof(T) / page_size * page_size;
+    size_t end = std::min((offset + length) * sizeof(T), count * sizeof(T));
+    msync(static_cast<char*>(ptr) + begin, end - begin, MS_ASYNC);
+    madvise(static_cast<char*>(ptr) + begin, end - begin, MADV_DONTNEED);
+#else
+    (void)offset;
+    (void)length;
+#endif
+  }
+
   // drop the map
   void unmap() {
     // has to be something to unmap
@@ -260,6 +321,10 @@ template <class T> class sequence {
 public:
   // static_assert(std::is_pod<T>::value, "sequence requires POD types for now");
   static const size_t npos = -1;
+  // how many elements are sorted in memory at once before they are merged
+  static constexpr size_t sort_buffer_size = 1024 * 1024 * 512 / sizeof(T);
+  // how many elements a merge writes before it lets go of the memory of what it has merged
+  static constexpr size_t release_size = 1024 * 1024 * 64 / sizeof(T);
 
   using value_type = T;
 
@@ -322,13 +387,17 @@ public:
     return npos;
   }
 
-  // sort the file based on the predicate, and outputs to output_seq
+  // sort the file based on the predicate
   //
-  // Strategy is to first sort sub-ranges of length buffer_size in place.
-  // These should all fit in memory. Then, merge the sub-ranges into the
-  // output sequence via priority queue.
-  void sort(const std::function<bool(const T&, const T&)>& predicate,
-            size_t buffer_size = 1024 * 1024 * 512 / sizeof(T)) {
+  // Strategy is to first sort sub-ranges of length buffer_size in place, concurrency many at a time.
+  // These should all fit in memory. Then, the sorted sub-ranges are cut at the same values into
+  // concurrency many slices of about the same size and each slice is merged, via loser tree,
+  // straight into its place in a memory mapped output file. The predicate is taken by type so that
+  // it can be inlined into the sorting and merging loops.
+  template <class predicate_t>
+  void sort(const predicate_t& predicate,
+            size_t buffer_size = sort_buffer_size,
+            size_t concurrency = 1) {
     flush();
     // if no elements we are done
     if (memmap.size() == 0) {
@@ -336,43 +405,77 @@ public:
     }
 
     // If there wont be any merging we may as well take the simple approach
-    if (buffer_size > memmap.size() + write_buffer.size()) {
+    concurrency = std::max(concurrency, static_cast<size_t>(1));
+    if (buffer_size > memmap.size() && concurrency == 1) {
       std::sort(static_cast<T*>(memmap), static_cast<T*>(memmap) + memmap.size(), predicate);
       return;
     }
 
+    // Sort the subsections, when we have the threads we make sure they all get one to work on. The
+    // threads share the buffer so that the memory they use at once doesnt grow with their number
+    buffer_size = std::max(std::min(buffer_size / concurrency,
+                                    (memmap.size() + concurrency - 1) / concurrency),
+                           size_t(1));
+    std::vector<std::pair<T*, T*>> runs;
+    for (size_t i = 0; i < memmap.size(); i += buffer_size) {
+      runs.emplace_back(static_cast<T*>(memmap) + i,
+                        static_cast<T*>(memmap) + std::min(memmap.size(), i + buffer_size));
+    }
+    parallel_for(runs.size(), concurrency, [&](size_t i) {
+      std::sort(runs[i].first, runs[i].second, predicate);
+      memmap.release(runs[i].first - static_cast<T*>(memmap), runs[i].second - runs[i].first);
+    });
+    if (runs.size() == 1) {
+      return;
+    }
+
+    // Pick the values at which to slice the runs so that each merge has about the same amount of
+    // work. We sample each run evenly and take the quantiles of the sorted samples
+    std::vector<T> splitters;
+    if (concurrency > 1) {
+      std::vector<T> samples;
+      for (const auto& run : runs) {
+        for (size_t i = 1; i < concurrency; ++i) {
+          samples.push_back(*(run.first + (run.second - run.first) * i / concurrency));
+        }
+      }
+      std::sort(samples.begin(), samples.end(), predicate);
+      for (size_t i = 1; i < concurrency; ++i) {
+        splitters.push_back(samples[samples.size() * i / concurrency]);
+      }
+    }
+
+    // Every run is cut at each splitter so slice i gets everything between splitter i-1 and i
+    std::vector<std::vector<std::pair<const T*, const T*>>> slices(splitters.size() + 1);
+    std::vector<size_t> offsets(slices.size() + 1, 0);
+    for (const auto& run : runs) {
+      const T* begin = run.first;
+      for (size_t i = 0; i < slices.size(); ++i) {
+        const T* end = i < splitters.size()
+                           ? std::lower_bound(begin, static_cast<const T*>(run.second),
+                                              splitters[i], predicate)
+                           : run.second;
+        slices[i].emplace_back(begin, end);
+        offsets[i + 1] += end - begin;
+        begin = end;
+      }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
     auto tmp_path = filesystem::path(file_name).replace_filename(
         filesystem::path(file_name).filename().string() + ".tmp");
     {
-      // we need a temporary sequence to merge the sorted subsections into
-      sequence<T> output_seq(tmp_path.string(), true);
-
-      // Comparator needs to be inverted for pq to provide constant time *smallest* lookup
-      // Pq keeps track of element and its index.
-      auto cmp = [&predicate](const std::pair<T, size_t>& a, std::pair<T, size_t>& b) {
-        return predicate(b.first, a.first);
-      };
-      std::priority_queue<std::pair<T, size_t>, std::vector<std::pair<T, size_t>>, decltype(cmp)> pq(
-          cmp);
-
-      // Sort the subsections
-      for (size_t i = 0; i < memmap.size(); i += buffer_size) {
-        std::sort(static_cast<T*>(memmap) + i,
-                  static_cast<T*>(memmap) + std::min(memmap.size(), i + buffer_size), predicate);
-        pq.emplace(*at(i), i);
+      // we need a temporary file to merge the sorted subsections into, with the disk space for it
+      mem_map<T> output;
+      try {
+        output.create(tmp_path.string(), memmap.size(), POSIX_MADV_SEQUENTIAL, true);
+      } catch (...) {
+        filesystem::remove(tmp_path);
+        throw;
       }
-
-      // Perform the merge
-      while (!pq.empty()) {
-        auto tmp = pq.top();
-        pq.pop();
-        output_seq.push_back(tmp.first);
-        size_t new_idx = tmp.second + 1;
-        if (new_idx % buffer_size != 0 && new_idx < memmap.size()) {
-          pq.emplace(*at(new_idx), new_idx);
-        }
-      }
-      output_seq.flush();
+      parallel_for(slices.size(), concurrency, [&](size_t i) {
+        merge(slices[i], memmap, output, offsets[i], predicate);
+      });
     }
 
     // Forget about this file for a second so we can swap in the temp file
@@ -584,6 +687,106 @@ public:
   }
 
 protected:
+  // calls work with every index in [0, count) using up to concurrency threads
+  template <class work_t> static void parallel_for(size_t count, size_t concurrency, work_t work) {
+    concurrency = std::min(concurrency, count);
+    if (concurrency < 2) {
+      for (size_t i = 0; i < count; ++i) {
+        work(i);
+      }
+      return;
+    }
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+      for (size_t i = next++; i < count; i = next++) {
+        work(i);
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(concurrency - 1);
+    for (size_t i = 1; i < concurrency; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  // merges the sorted ranges of the input into the output at offset using a loser tree. Each
+  // internal node of the tree keeps the range which lost the comparison there so replacing the
+  // winner costs exactly one comparison per level, half of what a binary heap needs. What has been
+  // merged is released every so often so it doesnt pile up in memory
+  template <class predicate_t>
+  static void merge(std::vector<std::pair<const T*, const T*>> ranges,
+                    const mem_map<T>& input,
+                    const mem_map<T>& output,
+                    size_t offset,
+                    const predicate_t& predicate) {
+    // remember where each range started so we know what of it we are done with
+    std::vector<const T*> released;
+    released.reserve(ranges.size());
+    for (const auto& range : ranges) {
+      released.push_back(range.first);
+    }
+    const T* in = input.get();
+    T* out = output.get() + offset;
+    auto release = [&]() {
+      for (size_t i = 0; i < released.size(); ++i) {
+        input.release(released[i] - in, ranges[i].first - released[i]);
+        released[i] = ranges[i].first;
+      }
+      output.release(offset, out - (output.get() + offset));
+      offset = out - output.get();
+    };
+
+    // pad the leaves to a power of 2 with empty ranges, empty ranges lose against everything
+    size_t leaves = 1;
+    while (leaves < ranges.size()) {
+      leaves <<= 1;
+    }
+    ranges.resize(leaves, {nullptr, nullptr});
+    auto before = [&ranges, &predicate](size_t a, size_t b) {
+      if (ranges[a].first == ranges[a].second) {
+        return false;
+      }
+      return ranges[b].first == ranges[b].second || predicate(*ranges[a].first, *ranges[b].first);
+    };
+
+    // play the initial tournament bottom up, tree[0] holds the overall winner
+    std::vector<size_t> tree(leaves), winners(leaves * 2);
+    for (size_t i = 0; i < leaves; ++i) {
+      winners[leaves + i] = i;
+    }
+    for (size_t node = leaves - 1; node > 0; --node) {
+      size_t a = winners[node * 2], b = winners[node * 2 + 1];
+      if (before(b, a)) {
+        std::swap(a, b);
+      }
+      winners[node] = a;
+      tree[node] = b;
+    }
+    tree[0] = winners[1];
+
+    // take the winner and replay its path to the root with the next element from its range
+    size_t until_release = release_size;
+    while (ranges[tree[0]].first != ranges[tree[0]].second) {
+      size_t winner = tree[0];
+      *out++ = *ranges[winner].first++;
+      for (size_t node = (winner + leaves) / 2; node > 0; node /= 2) {
+        if (before(tree[node], winner)) {
+          std::swap(tree[node], winner);
+        }
+      }
+      tree[0] = winner;
+      if (--until_release == 0) {
+        release();
+        until_release = release_size;
+      }
+    }
+    release();
+  }
+
   std::shared_ptr<std::fstream> file;
   std::string file_name;
   std::vector<T> write_buffer;
@@ -669,7 +872,9 @@ struct tar {
       bool readonly = true,
       bool regular_files_only = true,
       const std::function<decltype(contents)(const std::string&, const char*, const char*, size_t)>&
-          from_index = nullptr)
+          from_index = nullptr,
+      int advice = POSIX_MADV_NORMAL,
+      unsigned int concurrency = 1)
       : tar_file(tar_file), corrupt_blocks(0) {
     // get the file size
     struct stat s;
@@ -682,23 +887,50 @@ struct tar {
     }
 
     // map the file
-    mm.map(tar_file, s.st_size, POSIX_MADV_NORMAL, readonly);
+    mm.map(tar_file, s.st_size, advice, readonly);
 
+    // the caller may be able to construct the contents via an index header let them try
+    const char* position = mm.get();
+    const char* end = mm.get() + mm.size();
+    if (from_index != nullptr) {
+      position = walk(position, end, regular_files_only, 1, contents, corrupt_blocks);
+      if (!contents.empty()) {
+        const auto& first = *contents.begin();
+        auto indexed = from_index(first.first, first.second.first, mm.get(), first.second.second);
+        // if it was able to initialize from an index we bail
+        if (!indexed.empty()) {
+          contents = std::move(indexed);
+          return;
+        }
+      }
+    }
+
+    // otherwise we just get each item at a time
+    scan(position, end, regular_files_only, concurrency);
+  }
+
+protected:
+  // rip through the tar from position to see whats in it noting that most tars end with 2 empty
+  // blocks but we can concatenate tars and get empty blocks in between so we'll just be pretty
+  // lax about it and we'll count the ones we cant make sense of. stops at the first header at or
+  // past end or after max_entries recorded entries and returns where it stopped
+  const char* walk(const char* position,
+                   const char* end,
+                   bool regular_files_only,
+                   size_t max_entries,
+                   decltype(contents)& found,
+                   size_t& corrupt) const {
     // determine opposite of preferred path separator (needed to update OS-specific path separator)
     const char opp_sep = filesystem::path::preferred_separator == '/' ? '\\' : '/';
 
-    // rip through the tar to see whats in it noting that most tars end with 2 empty blocks
-    // but we can concatenate tars and get empty blocks in between so we'll just be pretty
-    // lax about it and we'll count the ones we cant make sense of
-    bool tried_index = false;
-    const char* position = mm.get();
-    while (position < mm.get() + mm.size()) {
+    size_t entries = 0;
+    while (position < end && entries < max_entries) {
       // get the header for this file
       const header_t* h = static_cast<const header_t*>(static_cast<const void*>(position));
       position += sizeof(header_t);
       // if it doesnt checkout ignore it and move on one block at a time
       if (!h->verify()) {
-        corrupt_blocks += !h->blank();
+        corrupt += !h->blank();
         continue;
       }
       auto size = h->get_file_size();
@@ -707,23 +939,75 @@ struct tar {
         // tar doesn't automatically update path separators based on OS, so we need to do it...
         std::string name{h->name};
         std::replace(name.begin(), name.end(), opp_sep, filesystem::path::preferred_separator);
-        // the caller may be able to construct the contents via an index header let them try
-        if (!tried_index && from_index != nullptr) {
-          tried_index = true;
-          contents = from_index(name, position, mm.get(), size);
-          // if it was able to initialize from an index we bail
-          if (!contents.empty()) {
-            return;
-          }
-        }
-        // otherwise we just get each item at a time
-        contents.emplace(std::piecewise_construct, std::forward_as_tuple(name),
-                         std::forward_as_tuple(position, size));
+        found.emplace(std::piecewise_construct, std::forward_as_tuple(name),
+                      std::forward_as_tuple(position, size));
+        ++entries;
       }
       // every entry's data is rounded to the nearst header_t sized "block"
       auto blocks = static_cast<size_t>(std::ceil(static_cast<double>(size) / sizeof(header_t)));
       position += blocks * sizeof(header_t);
     }
+    return position;
+  }
+
+  // the headers of a tar form a chain so they can't be walked in parallel as such. instead each
+  // thread takes a chunk of the file and walks from the first block in it that passes as a header.
+  // when the previous chunk ends up exactly there, which it does unless some file data happened to
+  // look like a header, the chunk is used as is. otherwise it is walked again from the right spot
+  void scan(const char* position,
+            const char* end,
+            bool regular_files_only,
+            unsigned int concurrency) {
+    // below this much per thread the threads cost more than they save
+    constexpr size_t kMinChunkSize = 64 * 1024 * 1024;
+    const size_t block_count = (end - position) / sizeof(header_t);
+    const size_t chunk_count =
+        std::min<size_t>(concurrency, block_count * sizeof(header_t) / kMinChunkSize);
+    if (chunk_count < 2) {
+      walk(position, end, regular_files_only, -1, contents, corrupt_blocks);
+      return;
+    }
+
+    struct chunk_t {
+      const char* begin;
+      const char* end;
+      const char* stop;
+      decltype(contents) found;
+      size_t corrupt = 0;
+    };
+    std::vector<chunk_t> chunks(chunk_count);
+    std::vector<std::thread> threads;
+    threads.reserve(chunk_count);
+    for (size_t i = 0; i < chunk_count; ++i) {
+      chunks[i].begin = position + block_count * i / chunk_count * sizeof(header_t);
+      chunks[i].end = position + block_count * (i + 1) / chunk_count * sizeof(header_t);
+      threads.emplace_back([this, &chunks, i, end, regular_files_only]() {
+        auto& chunk = chunks[i];
+        // only the first chunk is known to start at a header
+        while (i > 0 && chunk.begin < end &&
+               !static_cast<const header_t*>(static_cast<const void*>(chunk.begin))->verify()) {
+          chunk.begin += sizeof(header_t);
+        }
+        chunk.stop =
+            walk(chunk.begin, chunk.end, regular_files_only, -1, chunk.found, chunk.corrupt);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // stitch the chunks together in order, earlier entries win if a name is in there twice
+    for (auto& chunk : chunks) {
+      if (position <= chunk.begin) {
+        // whatever is between is no header, only count the corrupt blocks
+        walk(position, chunk.begin, regular_files_only, -1, contents, corrupt_blocks);
+        contents.insert(chunk.found.begin(), chunk.found.end());
+        corrupt_blocks += chunk.corrupt;
+        position = chunk.stop;
+      } else {
+        position = walk(position, chunk.end, regular_files_only, -1, contents, corrupt_blocks);
+      }
+    }
   }
 };
 
@@ -8,8 +8,10 @@
 #include <boost/geometry/multi/geometries/multi_polygon.hpp>
 
 #include <cstdint>
+#include <map>
 #include <sqlite3.h>
 #include <unordered_map>
+#include <vector>
 #include <valhalla/baldr/graphconstants.h>
 #include <valhalla/midgard/aabb2.h>
 #include <valhalla/midgard/pointll.h>
@@ -31,6 +33,85 @@ typedef bg::index::rtree<
     bg::index::rstar<16>>
     language_poly_index;
 
+/**
+ * Answers which admin or timezone polygons cover the points of one tile. It gives the same answers
+ * as bg::covered_by with the crossings_multiply strategy but only looks at the few polygon edges
+ * near a point. Edges west of the tile can't be crossed by a ray going east from a point inside of
+ * it so they are dropped. Edges east of the tile are always crossed when they span the point's
+ * latitude so they are only counted. The rest are put into latitude bands over the tile.
+ * Points outside of the tile are tested against the whole polygons. The index only refers to the
+ * polygons, they have to outlive it. It isn't modified after it's built so threads can share it.
+ */
+class MultiPolyIndex {
+public:
+  /**
+   * Prepares the polygons for the points of a tile.
+   * @param  polys   the polygons by their admin or timezone index
+   * @param  bounds  the bounding box of the tile
+   */
+  MultiPolyIndex(const std::multimap<uint32_t, multi_polygon_type>& polys,
+                 const AABB2<PointLL>& bounds);
+
+  /**
+   * @return the number of polygons, in the order of the multimap they came from
+   */
+  size_t size() const {
+    return multi_polygons_.size();
+  }
+
+  /**
+   * @param  index  which polygon
+   * @return the admin or timezone index of the polygon
+   */
+  uint32_t id(size_t index) const {
+    return multi_polygons_[index].id;
+  }
+
+  /**
+   * Checks if a polygon covers a point.
+   * @param  index  which polygon
+   * @param  ll     the point
+   * @return true if the point is covered by the polygon
+   */
+  bool covers(size_t index, const PointLL& ll) const;
+
+protected:
+  struct edge_t {
+    double x0, y0, x1, y1;
+  };
+  struct ring_t {
+    // there are too few points to make a ring, it covers nothing
+    bool degenerate;
+    // the edges east of the tile as sorted lists of their min and max latitudes
+    uint32_t east_begin, east_end;
+    // the offsets into the edges of each band, band_count + 1 of them
+    uint32_t bands_begin, band_count;
+    double band_height;
+  };
+  struct polygon_t {
+    double minx, miny, maxx, maxy;
+    // the outer ring followed by the holes
+    uint32_t rings_begin, rings_end;
+  };
+  struct multi_polygon_t {
+    uint32_t id;
+    const multi_polygon_type* geometry;
+    uint32_t polygons_begin, polygons_end;
+  };
+
+  void add_ring(const polygon_type::ring_type& ring);
+  bool ring_covers(const ring_t& ring, double x, double y) const;
+
+  double minx_, miny_, maxx_, maxy_;
+  std::vector<multi_polygon_t> multi_polygons_;
+  std::vector<polygon_t> polygons_;
+  std::vector<ring_t> rings_;
+  std::vector<uint32_t> band_offsets_;
+  std::vector<edge_t> edges_;
+  std::vector<double> east_mins_;
+  std::vector<double> east_maxs_;
+};
+
 /**
  * Get the dbhandle of a sqlite db.  Used for timezones and admins DBs.
  * @param  database   db file location.
@@ -56,6 +137,22 @@ uint32_t GetMultiPolyId(const std::multimap<uint32_t, multi_polygon_type>& polys
  */
 uint32_t GetMultiPolyId(const std::multimap<uint32_t, multi_polygon_type>& polys, const PointLL& ll);
 
+/**
+ * Get the polygon index like above but using the polygons prepared for the tile the point is in.
+ * @param  polys      polys prepared for the tile.
+ * @param  ll         point that needs to be checked.
+ * @param  graphtile  graphtilebuilder that is used to determine if we are a country poly or not.
+ */
+uint32_t
+GetMultiPolyId(const MultiPolyIndex& polys, const PointLL& ll, GraphTileBuilder& graphtile);
+
+/**
+ * Get the polygon index like above but using the polygons prepared for the tile the point is in.
+ * @param  polys      polys prepared for the tile.
+ * @param  ll         point that needs to be checked.
+ */
+uint32_t GetMultiPolyId(const MultiPolyIndex& polys, const PointLL& ll);
+
 /**
  * Get the vector of languages for this LL.  Used by admin areas.  Checks if the pointLL is covered_by
  * the poly.
@@ -0,0 +1,148 @@
+#ifndef VALHALLA_MJOLNIR_BUILDPROFILER_H_
+#define VALHALLA_MJOLNIR_BUILDPROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <valhalla/baldr/graphid.h>
+#include <valhalla/baldr/json.h>
+#include <valhalla/mjolnir/util.h>
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * Collects how long and with what resources each stage of build_tile_set runs and how long each
+ * tile takes within the stages that work tile by tile, per thread. It is process wide and does
+ * nothing until enabled with the path of the json report, which is what mjolnir.build_profile does.
+ */
+class BuildProfiler {
+public:
+  /**
+   * @return the profiler of this process
+   */
+  static BuildProfiler& Get();
+
+  /**
+   * Enables or disables profiling and forgets anything profiled so far.
+   * @param report_file  where to write the json report, empty disables profiling
+   */
+  void Enable(const std::string& report_file);
+
+  bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Records the time one tile took within the current stage on the calling thread.
+   * @param tile_id      the tile that was processed
+   * @param seconds      wall time it took
+   * @param cpu_seconds  cpu time the calling thread spent on it
+   */
+  void RecordTile(const baldr::GraphId& tile_id, const double seconds, const double cpu_seconds);
+
+  /**
+   * @return the report of all the stages profiled since it was enabled
+   */
+  baldr::json::MapPtr Report() const;
+
+  /**
+   * Writes the report to the file given when enabling, if enabled.
+   */
+  void WriteReport() const;
+
+  /**
+   * Profiles one stage for as long as it is in scope.
+   */
+  class Stage {
+  public:
+    explicit Stage(const BuildStage stage);
+    ~Stage();
+    Stage(const Stage&) = delete;
+    Stage& operator=(const Stage&) = delete;
+
+  private:
+    bool enabled_;
+  };
+
+  /**
+   * Times processing one tile for as long as it is in scope.
+   */
+  class TileTimer {
+  public:
+    explicit TileTimer(const baldr::GraphId& tile_id);
+    ~TileTimer();
+    TileTimer(const TileTimer&) = delete;
+    TileTimer& operator=(const TileTimer&) = delete;
+
+  private:
+    baldr::GraphId tile_id_;
+    bool enabled_;
+    std::chrono::steady_clock::time_point start_;
+    double cpu_start_;
+  };
+
+  // tile times are bucketed by powers of 2 milliseconds, the first bucket is under 1ms and the
+  // last one holds everything from 2^(kHistogramBuckets - 2) ms on
+  static constexpr size_t kHistogramBuckets = 24;
+  // how many of the slowest tiles are kept per stage
+  static constexpr size_t kSlowestTiles = 10;
+
+protected:
+  BuildProfiler() = default;
+
+  struct ThreadProfile {
+    size_t index = 0;
+    uint64_t tiles = 0;
+    double seconds = 0;
+    double cpu_seconds = 0;
+  };
+
+  // counters of the whole process
+  struct Resources {
+    double wall_seconds = 0;
+    double user_seconds = 0;
+    double system_seconds = 0;
+    uint64_t peak_rss_bytes = 0;
+    uint64_t read_bytes = 0;
+    uint64_t write_bytes = 0;
+    uint64_t read_chars = 0;
+    uint64_t written_chars = 0;
+  };
+
+  struct StageProfile {
+    BuildStage stage;
+    Resources start;
+    Resources end;
+    uint64_t tiles = 0;
+    double tile_seconds = 0;
+    std::array<uint64_t, kHistogramBuckets> histogram{};
+    // a min heap of the slowest tiles
+    std::vector<std::pair<double, baldr::GraphId>> slowest;
+    std::unordered_map<std::thread::id, ThreadProfile> threads;
+  };
+
+  static Resources Measure(const bool reset_peak);
+
+  void StartStage(const BuildStage stage);
+  void EndStage();
+
+  std::atomic<bool> enabled_{false};
+  std::string report_file_;
+  mutable std::mutex mutex_;
+  std::vector<StageProfile> stages_;
+  bool in_stage_ = false;
+};
+
+} // namespace mjolnir
+} // namespace valhalla
+
+#endif // VALHALLA_MJOLNIR_BUILDPROFILER_H_
@@ -2,11 +2,18 @@
 #define VALHALLA_MJOLNIR_GRAPHENHANCER_H
 
 #include <boost/property_tree/ptree.hpp>
+#include <cstdint>
 #include <valhalla/mjolnir/osmdata.h>
 
 namespace valhalla {
 namespace mjolnir {
 
+// Number of tries when determining not thru edges
+constexpr uint32_t kMaxNoThruTries = 256;
+
+// Radius (km) to use for density
+constexpr float kDensityRadius = 2.0f;
+
 /**
  * Class used to enhance graph tile information at the local level.
  */
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <cstdint>
+#include <deque>
 #include <list>
 #include <memory>
 #include <string>
@@ -27,6 +28,7 @@
 #include <valhalla/mjolnir/directededgebuilder.h>
 #include <valhalla/mjolnir/edgeinfobuilder.h>
 #include <valhalla/mjolnir/landmarks.h>
+#include <valhalla/mjolnir/textlistbuilder.h>
 
 namespace valhalla {
 namespace mjolnir {
@@ -604,15 +606,13 @@ protected:
   std::unordered_map<edge_tuple, size_t, EdgeTupleHasher> edge_offset_map_;
   std::unordered_map<uint32_t, EdgeInfoBuilder*> edgeinfo_offset_map_;
 
-  // The edgeinfo list
-  std::list<EdgeInfoBuilder> edgeinfo_list_;
+  // The edgeinfo list, a deque so the edgeinfo builders never move once added and dont each need a
+  // list node. They stay builders rather than bytes in an arena because elevation and landmarks are
+  // set on them after they are added
+  std::deque<EdgeInfoBuilder> edgeinfo_list_;
 
-  // Text list offset and map
-  uint32_t text_list_offset_ = 0;
-  std::unordered_map<std::string, uint32_t> text_offset_map_;
-
-  // Text list. List of names used within this tile
-  std::list<std::string> textlistbuilder_;
+  // Text list. Unique names used within this tile, as they are stored in the tile
+  TextListBuilder textlistbuilder_;
 
   // List of lane connectivity records.
   std::vector<LaneConnectivity> lane_connectivity_builder_;
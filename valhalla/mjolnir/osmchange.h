@@ -0,0 +1,68 @@
+#ifndef VALHALLA_MJOLNIR_OSMCHANGE_H_
+#define VALHALLA_MJOLNIR_OSMCHANGE_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <valhalla/baldr/graphid.h>
+#include <valhalla/baldr/graphreader.h>
+#include <valhalla/midgard/pointll.h>
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * The OSM objects touched by one or more OSM change (.osc) files, whether they were created,
+ * modified or deleted.
+ */
+struct OSMChange {
+  std::unordered_set<uint64_t> nodes;
+  std::unordered_set<uint64_t> ways;
+  std::unordered_set<uint64_t> relations;
+  // where the created and modified nodes are now and, see ParsePreviousState, where the changed
+  // nodes were before the change
+  std::vector<midgard::PointLL> locations;
+};
+
+/**
+ * Adds the contents of an OSM change file to the change. Ways and nodes that are members of a
+ * changed relation are counted as changed as well since the relation (restriction, route etc.) is
+ * applied to them during graph building.
+ * @param  file    path to the uncompressed .osc file
+ * @param  change  the change to add to
+ * @throws std::runtime_error when the file can't be read
+ */
+void ParseOSMChange(const std::string& file, OSMChange& change);
+
+/**
+ * Adds what the OSM data from before the change knew about the changed nodes. A change file only
+ * says where a modified node is now and often not where a deleted one was, nor which ways use
+ * them, so the previous locations of the changed nodes are added to the locations and the ways
+ * using any of them count as changed, since their shapes and edges change with the nodes.
+ * @param  files   the pbf files the tileset was built from, before the change was applied
+ * @param  change  the change, with its change files already added
+ * @throws std::runtime_error when a file can't be read
+ */
+void ParsePreviousState(const std::vector<std::string>& files, OSMChange& change);
+
+/**
+ * Finds the tiles of an existing tileset that a rebuild with the change applied can alter. These
+ * are the tiles with edges of changed ways, the tiles around changed node locations, the tiles
+ * within reach of the graph enhancer from those (the road density radius and the not thru search),
+ * the tiles of the other hierarchy levels covering any of those (nodes and shortcuts move between
+ * levels) and the tiles with edges, shortcuts or transitions that lead into them, since those refer
+ * to graph ids that may have moved. For the full picture the change should include the previous
+ * state of its nodes, see ParsePreviousState.
+ * @param  reader  graph reader over the tileset built before the change
+ * @param  change  the changed OSM objects
+ * @return the ids of the affected tiles, at every level but the transit level
+ */
+std::unordered_set<baldr::GraphId> AffectedTiles(baldr::GraphReader& reader,
+                                                 const OSMChange& change);
+
+} // namespace mjolnir
+} // namespace valhalla
+
+#endif // VALHALLA_MJOLNIR_OSMCHANGE_H_
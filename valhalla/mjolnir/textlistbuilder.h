@@ -0,0 +1,84 @@
+#ifndef VALHALLA_MJOLNIR_TEXTLISTBUILDER_H_
+#define VALHALLA_MJOLNIR_TEXTLISTBUILDER_H_
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * Builds the text list of a tile. The text is kept in one buffer laid out exactly like it is stored
+ * in the tile (null terminated strings back to back) so that it can be written out as is, and each
+ * distinct string is only stored once. Finding a string that was already added goes through an open
+ * addressing table of offsets into the buffer rather than a map holding a copy of every string.
+ */
+class TextListBuilder {
+public:
+  /**
+   * Constructor. The text list starts with the empty string at offset 0.
+   */
+  TextListBuilder();
+
+  /**
+   * Replaces the text list with that of an existing tile. Only the strings that are indexed with
+   * Index afterwards can be found by Add.
+   * @param  text  Text list of the tile.
+   * @param  size  Size of the text list in bytes.
+   */
+  void Assign(const char* text, const size_t size);
+
+  /**
+   * Makes a string already in the text list findable by Add.
+   * @param  offset  Offset of the string in the text list.
+   * @param  length  Length of the string, not counting its null terminator.
+   */
+  void Index(const uint32_t offset, const uint32_t length);
+
+  /**
+   * Add text to the text list unless it is already there.
+   * @param  text  Text to add.
+   * @return Returns the offset (bytes) of the text in the text list.
+   */
+  uint32_t Add(const std::string_view text);
+
+  /**
+   * @return Returns the text list as it should be stored in the tile.
+   */
+  const char* data() const {
+    return text_.data();
+  }
+
+  /**
+   * @return Returns the size of the text list in bytes.
+   */
+  uint32_t size() const {
+    return static_cast<uint32_t>(text_.size());
+  }
+
+protected:
+  struct Slot {
+    uint32_t offset;
+    uint32_t length;
+    uint32_t hash;
+  };
+  static constexpr uint32_t kEmpty = 0xffffffff;
+
+  static uint32_t Hash(const std::string_view text);
+
+  // returns the slot holding the text or the empty slot where it should go
+  Slot& Find(const std::string_view text, const uint32_t hash);
+
+  // inserts into an empty slot, growing the table if it gets too full
+  void Insert(Slot& slot, const uint32_t offset, const uint32_t length, const uint32_t hash);
+
+  std::vector<char> text_;
+  std::vector<Slot> slots_;
+  uint32_t count_;
+};
+
+} // namespace mjolnir
+} // namespace valhalla
+
+#endif // VALHALLA_MJOLNIR_TEXTLISTBUILDER_H_
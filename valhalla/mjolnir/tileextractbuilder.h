@@ -0,0 +1,63 @@
+#ifndef VALHALLA_MJOLNIR_TILEEXTRACTBUILDER_H
+#define VALHALLA_MJOLNIR_TILEEXTRACTBUILDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "baldr/graphid.h"
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * Class used to pack the graph tiles of the tile_dir into a tar extract that GraphReader can map.
+ */
+class TileExtractBuilder {
+public:
+  // tile data in the extract starts at multiples of this so each tile begins on its own page
+  static constexpr size_t kAlignment = 4096;
+
+  // how the tiles are ordered in the extract
+  enum class TileOrder : uint8_t {
+    kGraphId = 0,         // by graph id, so by level and then row by row
+    kHilbert = 1,         // along a hilbert curve with the tiles of all levels mixed together
+    kHilbertPerLevel = 2, // along a hilbert curve within each level, one level after the other
+  };
+
+  /**
+   * @brief Parses the name of a tile order as it is used in the config.
+   * @param name  one of id, hilbert or hilbert_level
+   * @return the tile order, throws if the name is unknown
+   */
+  static TileOrder ParseTileOrder(const std::string& name);
+
+  /**
+   * @brief Writes the tiles of mjolnir.tile_dir to a tar together with its index.bin. The index is
+   *        filled in the same pass as the tiles are appended, and the tar only replaces an existing
+   *        extract once it is complete.
+   * @param config         Config with the mjolnir.tile_dir to read the tiles from
+   * @param extract_file   Where to write the tar
+   * @param order          How to order the tiles in the tar. Along a hilbert curve tiles near each
+   *                       other on the map are near each other in the tar
+   * @return the number of tiles written
+   */
+  static size_t Build(const boost::property_tree::ptree& config,
+                      const std::string& extract_file,
+                      const TileOrder order = TileOrder::kGraphId);
+
+  /**
+   * @brief The position of a tile along a hilbert curve over the world, where the tiles of all
+   *        levels covering the same area are close together.
+   * @param tile_id  The tile
+   * @return the distance along the curve of the center of the tile
+   */
+  static uint64_t HilbertIndex(const baldr::GraphId& tile_id);
+};
+
+} // namespace mjolnir
+} // namespace valhalla
+
+#endif // VALHALLA_MJOLNIR_TILEEXTRACTBUILDER_H
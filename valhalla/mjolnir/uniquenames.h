@@ -2,65 +2,100 @@
 #define VALHALLA_MJOLNIR_UNIQUENAMES_H
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace valhalla {
 namespace mjolnir {
 
-using NamesMap = std::unordered_map<std::string, uint32_t>;
-
 /**
- * Class to hold a list of unique names and indexes to them.
+ * Class to hold a list of unique names and indexes to them. Names can be added and looked up from
+ * multiple threads at once. The names are spread over a number of shards, each guarded by its own
+ * lock, and the bytes of each name are stored in an arena of the shard it is keyed in, which is
+ * never moved once allocated, so indexes and views of names stay valid while other threads keep
+ * adding names. Note that when names are added from multiple threads the order, and so the index,
+ * they get depends on the timing of the threads; only a single thread gives reproducible indexes.
  */
 class UniqueNames {
 public:
   /**
    * Constructor.
    */
-  UniqueNames() {
+  UniqueNames() : state_(new State()) {
     // Insert dummy so index 0 is never used
     index("");
   }
 
+  UniqueNames(UniqueNames&&) = default;
+  UniqueNames& operator=(UniqueNames&&) = default;
+
   /**
    * Get an index for the specified name. If the name is not already used
    * it is added to the name map.
    * @param  name  Name.
    * @return  Returns an index into the unique list of names.
    */
-  uint32_t index(const std::string& name) {
+  uint32_t index(const std::string_view name) {
+    auto& shard = state_->shards[std::hash<std::string_view>{}(name) % kShardCount];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
     // Find the name in the map. If it is there return the index.
-    auto it = names_.find(name);
-    if (it != names_.end()) {
+    auto it = shard.names.find(name);
+    if (it != shard.names.end()) {
       return it->second;
-    } else {
-      // Not in the map, add index and update
-      it = names_.insert(it, NamesMap::value_type(name, 0));
-      indexes_.push_back(it);
-      uint32_t index = indexes_.size() - 1;
-      it->second = index;
-      return index;
     }
+
+    // Not in the map, store the bytes in the arena and key the map with a view of them. Only once
+    // they are written is the name published in its slot for readers of the index
+    const char* stored = shard.store(name);
+    uint32_t index = state_->count.fetch_add(1, std::memory_order_relaxed);
+    shard.names.emplace(std::string_view(stored + sizeof(uint32_t), name.size()), index);
+    slot(index).store(stored, std::memory_order_release);
+    return index;
   }
 
   /**
-   * Get a name given an index. Returns an empty string if the index is out of range.
+   * Get a view of the name given an index. The view is valid as long as the names are not cleared.
+   * Returns an empty view if the index is out of range or its name is still being added.
    * @param  index  Index into the unique name list.
    * @return  Returns the name
    */
-  const std::string& name(const uint32_t index) const {
-    return (index < (uint32_t)indexes_.size()) ? indexes_[index]->first : indexes_[0]->first;
+  std::string_view view(const uint32_t index) const {
+    if (index >= state_->count.load(std::memory_order_acquire)) {
+      return {};
+    }
+    const auto* slot = find_slot(index);
+    const char* stored = slot ? slot->load(std::memory_order_acquire) : nullptr;
+    if (stored == nullptr) {
+      return {};
+    }
+    uint32_t length;
+    std::memcpy(&length, stored, sizeof(length));
+    return {stored + sizeof(length), length};
   }
 
   /**
-   * Clear the names and indexes.
+   * Get a name given an index. Returns an empty string if the index is out of range.
+   * @param  index  Index into the unique name list.
+   * @return  Returns a copy of the name
+   */
+  std::string name(const uint32_t index) const {
+    return std::string(view(index));
+  }
+
+  /**
+   * Clear the names and indexes. This must not be called while other threads use the names.
    */
   void Clear() {
-    names_.clear();
-    indexes_.clear();
+    state_.reset(new State());
   }
 
   /**
@@ -69,16 +104,128 @@ public:
    * @return  Returns the number of unique names.
    */
   size_t Size() const {
-    return names_.size() - 1;
+    return state_->count.load() - 1;
+  }
+
+  /**
+   * Get an estimate of the memory used to hold the names, their storage and the maps to them. This
+   * takes the lock of each shard in turn, so it may be called while other threads add names and
+   * then counts some of the names they added while it ran.
+   * @return  Returns the approximate number of bytes used.
+   */
+  size_t MemoryUsage() const {
+    size_t bytes = sizeof(State);
+    for (uint32_t block = 0; block < kBlockCount; ++block) {
+      if (state_->blocks[block].load() == nullptr) {
+        break;
+      }
+      bytes += block_size(block) * sizeof(std::atomic<const char*>);
+    }
+    // the arena of a shard only grows under its lock
+    for (auto& shard : state_->shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      bytes += shard.names.bucket_count() * sizeof(void*) +
+               shard.names.size() * (sizeof(std::string_view) + sizeof(uint32_t) + sizeof(void*) * 2);
+      bytes += shard.arena_bytes + shard.chunks.capacity() * sizeof(std::unique_ptr<char[]>);
+    }
+    return bytes;
   }
 
 protected:
-  // Map of names to indexes
-  NamesMap names_;
+  // Shards of the map, a power of 2 that is comfortably larger than the number of parsing threads
+  static constexpr uint32_t kShardCount = 64;
+
+  // The arena of a shard grows by chunks of this many bytes, longer names get a chunk of their own
+  static constexpr size_t kChunkSize = 64 * 1024;
+
+  // The slots of the names are stored in blocks, the first holding 1024 and each next one twice as
+  // many as the one before it, which is more than enough blocks for any uint32_t index
+  static constexpr uint32_t kFirstBlockBits = 10;
+  static constexpr uint32_t kBlockCount = 32 - kFirstBlockBits + 1;
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string_view, uint32_t> names;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* free = nullptr;  // Where the next name goes in the last chunk
+    size_t free_bytes = 0; // How much room is left after it
+    size_t arena_bytes = 0;
+
+    // copies the length and the bytes of the name into the arena and returns where they start
+    const char* store(const std::string_view name) {
+      const size_t size = sizeof(uint32_t) + name.size();
+      if (size > free_bytes) {
+        const size_t chunk_size = std::max(size, kChunkSize);
+        chunks.emplace_back(new char[chunk_size]);
+        free = chunks.back().get();
+        free_bytes = chunk_size;
+        arena_bytes += chunk_size;
+      }
+      char* stored = free;
+      const uint32_t length = name.size();
+      std::memcpy(stored, &length, sizeof(length));
+      std::memcpy(stored + sizeof(length), name.data(), name.size());
+      free += size;
+      free_bytes -= size;
+      return stored;
+    }
+  };
+
+  struct State {
+    std::array<Shard, kShardCount> shards;
+    std::array<std::atomic<std::atomic<const char*>*>, kBlockCount> blocks{};
+    std::mutex blocks_mutex;
+    std::atomic<uint32_t> count{0};
+
+    ~State() {
+      for (auto& block : blocks) {
+        delete[] block.load();
+      }
+    }
+  };
+
+  static uint64_t block_size(const uint32_t block) {
+    return uint64_t(1) << (block + kFirstBlockBits);
+  }
+
+  // which block the index is in and where in that block
+  static std::pair<uint32_t, uint64_t> locate(const uint32_t index) {
+    const uint64_t biased = uint64_t(index) + block_size(0);
+    uint32_t high_bit = 63;
+    while (!(biased >> high_bit)) {
+      --high_bit;
+    }
+    return {high_bit - kFirstBlockBits, biased - (uint64_t(1) << high_bit)};
+  }
+
+  // the slot of the index, allocating its block if need be
+  std::atomic<const char*>& slot(const uint32_t index) {
+    auto location = locate(index);
+    auto& block = state_->blocks[location.first];
+    auto* slots = block.load(std::memory_order_acquire);
+    if (slots == nullptr) {
+      std::lock_guard<std::mutex> lock(state_->blocks_mutex);
+      slots = block.load(std::memory_order_acquire);
+      if (slots == nullptr) {
+        slots = new std::atomic<const char*>[block_size(location.first)];
+        for (uint64_t i = 0; i < block_size(location.first); ++i) {
+          slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        block.store(slots, std::memory_order_release);
+      }
+    }
+    return slots[location.second];
+  }
+
+  // the slot of the index, or nullptr if its block hasnt been allocated yet
+  const std::atomic<const char*>* find_slot(const uint32_t index) const {
+    auto location = locate(index);
+    const auto* slots = state_->blocks[location.first].load(std::memory_order_acquire);
+    return slots ? slots + location.second : nullptr;
+  }
 
-  // List of entries into the map
-  using nameiter = NamesMap::iterator;
-  std::vector<nameiter> indexes_;
+  // Everything lives behind a pointer so that the names can be moved even though locks can't
+  std::unique_ptr<State> state_;
 };
 
 } // namespace mjolnir
@@ -120,6 +120,40 @@ std::vector<std::string> GetTagTokens(const std::string& tag_value, const std::s
  */
 std::string remove_double_quotes(const std::string& s);
 
+/**
+ * Splits a row of csv into its columns in place. Like a tokenizer that drops empty tokens, empty
+ * columns are skipped rather than returned.
+ * @param  begin       the start of the row
+ * @param  end         the end of the row, not including any line ending
+ * @param  fields      where to store the begin and end of each non empty column
+ * @param  max_fields  the most columns to return, any after those are ignored
+ * @return the number of columns that were stored
+ */
+size_t split_csv_row(const char* begin,
+                     const char* end,
+                     std::pair<const char*, const char*>* fields,
+                     size_t max_fields);
+
+/**
+ * Parses a level/tileid/id graph id from a csv column. Like stoul, leading whitespace and plus
+ * signs are allowed in each part but unlike it nothing may follow the id.
+ * @param  begin  the start of the column
+ * @param  end    the end of the column
+ * @param  id     the id of the edge within its tile, only set if the graph id was valid
+ * @return true if the column held a valid graph id
+ */
+bool parse_graph_id(const char* begin, const char* end, uint32_t& id);
+
+/**
+ * Parses a speed from a csv column, like stoi leading whitespace and a plus sign are allowed and
+ * anything after the leading digits is ignored.
+ * @param  begin  the start of the column
+ * @param  end    the end of the column
+ * @param  speed  the parsed speed, only set if the column held one
+ * @return true if the column started with a number
+ */
+bool parse_speed(const char* begin, const char* end, uint8_t& speed);
+
 /**
  * Do the 2 supplied shape vectors match (either direction).
  * @param shape1 First shape vector.
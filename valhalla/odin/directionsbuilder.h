@@ -29,6 +29,22 @@ public:
    */
   static void Build(Api& api, const MarkupFormatter& markup_formatter);
 
+  /**
+   * Returns true if the response to the request has maneuvers. Responses in gpx and pbf ones
+   * without the directions are made from the trip alone.
+   *
+   * @param options  the options of the request
+   */
+  static bool HasManeuvers(const Options& options);
+
+  /**
+   * Returns true if the response to the request has verbal instructions. OSRM responses only
+   * have them as voice instructions, so they are not formed unless those are requested.
+   *
+   * @param options  the options of the request
+   */
+  static bool HasVerbalInstructions(const Options& options);
+
 protected:
   /**
    * Update the heading of ~0 length edges.
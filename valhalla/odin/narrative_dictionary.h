@@ -1,9 +1,13 @@
 #ifndef VALHALLA_ODIN_NARRATIVE_DICTIONARY_H_
 #define VALHALLA_ODIN_NARRATIVE_DICTIONARY_H_
 
+#include <cstdint>
+#include <initializer_list>
 #include <locale>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/property_tree/ptree.hpp>
@@ -174,8 +178,87 @@ constexpr auto kLevelTag = "<LEVEL>";
 namespace valhalla {
 namespace odin {
 
+// The tags of the phrases that the narrative replaces with values
+enum class PhraseTag : uint8_t {
+  kCardinalDirection,
+  kRelativeDirection,
+  kOrdinalValue,
+  kStreetNames,
+  kPreviousStreetNames,
+  kBeginStreetNames,
+  kCrossStreetNames,
+  kRoundaboutExitStreetNames,
+  kRoundaboutExitBeginStreetNames,
+  kRampExitNumbersVisual,
+  kObjectLabel,
+  kLength,
+  kDestination,
+  kCurrentVerbalCue,
+  kNextVerbalCue,
+  kNumberSign,
+  kBranchSign,
+  kTowardSign,
+  kNameSign,
+  kJunctionName,
+  kFerryLabel,
+  kTransitPlatform,
+  kStationLabel,
+  kTime,
+  kTransitName,
+  kTransitHeadSign,
+  kTransitPlatformCount,
+  kTransitPlatformCountLabel,
+  kLevel,
+  kNone // Literal text
+};
+
+/**
+ * A phrase split into its literal text and its tags when the dictionary is loaded, so that
+ * forming an instruction from it is a single pass instead of a search and replace per tag.
+ */
+class PhraseTemplate {
+public:
+  PhraseTemplate() = default;
+  explicit PhraseTemplate(const std::string& phrase);
+
+  /**
+   * Sets the output to the phrase with its tags replaced by the given values. A tag that is
+   * given more than once takes the first value and a tag without a value is kept as it is.
+   *
+   * @param  output  the string to set to the filled in phrase.
+   * @param  values  the values of the tags.
+   */
+  void Render(std::string& output,
+              std::initializer_list<std::pair<PhraseTag, std::string_view>> values) const;
+
+  /**
+   * Returns the phrase as it is in the language file.
+   *
+   * @return the phrase as it is in the language file.
+   */
+  const std::string& phrase() const {
+    return phrase_;
+  }
+
+protected:
+  struct Piece {
+    uint32_t offset; // Into the phrase
+    uint32_t length;
+    PhraseTag tag;
+  };
+
+  std::string phrase_;
+  std::vector<Piece> pieces_;
+};
+
 struct PhraseSet {
-  std::unordered_map<std::string, std::string> phrases;
+  // The phrases split at their tags, by their ids. Each still has the phrase as it is in the
+  // language file, which is the only copy of it kept.
+  std::unordered_map<uint32_t, PhraseTemplate> templates;
+
+  const PhraseTemplate& phrase(uint32_t phrase_id) const {
+    return templates.at(phrase_id);
+  }
 };
 
 struct StartSubset : PhraseSet {
@@ -71,6 +71,24 @@ public:
   }
 
 protected:
+  /////////////////////////////////////////////////////////////////////////////
+  /**
+   * Sets the instruction of the maneuver and the depart and arrive ones of transit maneuvers.
+   *
+   * @param maneuver       The maneuver to set the instructions of.
+   * @param prev_maneuver  The maneuver before it, if there is one.
+   */
+  void FormInstructions(Maneuver& maneuver, Maneuver* prev_maneuver);
+
+  /**
+   * Sets the verbal instructions of the maneuver. Some of them reuse its instruction so that has
+   * to be set first.
+   *
+   * @param maneuver       The maneuver to set the verbal instructions of.
+   * @param prev_maneuver  The maneuver before it, if there is one.
+   */
+  void FormVerbalInstructions(Maneuver& maneuver, Maneuver* prev_maneuver);
+
   /////////////////////////////////////////////////////////////////////////////
   std::string FormStartInstruction(Maneuver& maneuver);
 
@@ -661,6 +679,7 @@ protected:
   const NarrativeDictionary& dictionary_;
   MarkupFormatter markup_formatter_; // No ref - need our own non-const copy
   bool articulated_preposition_enabled_;
+  bool verbal_instructions_; // Whether the response has the verbal instructions
 };
 
 ///////////////////////////////////////////////////////////////////////////////
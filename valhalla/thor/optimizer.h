@@ -123,11 +123,12 @@ protected:
 
   /**
    * Get a random location. Makes sure it isn't the first or last location
-   * (which are fixed).
+   * (which are fixed). The float distribution can round up to 1, so the
+   * index is capped below the last location.
    * @return  Returns the index of a random location.
    */
   uint32_t get_random_location() {
-    return static_cast<uint32_t>(r01() * (count_ - 2) + 1);
+    return std::min(static_cast<uint32_t>(r01() * (count_ - 2) + 1), count_ - 2);
   }
 
   /**
@@ -139,6 +140,66 @@ protected:
   }
 };
 
+// Seed of the local search unless another one is given, so the same costs give the same tour
+constexpr uint32_t kLocalSearchSeed = 111111;
+
+/**
+ * Optimization method using local search. A tour is built greedily, improved with 2-opt and Or-opt
+ * moves among the nearest neighbors of each location until no move helps, then kicked out of that
+ * local optimum and improved again. Several searches with their own random restarts can run on
+ * threads of their own until they stop finding better tours or have kicked the tour a set number
+ * of times. Like the Optimizer the first location (origin) and last location (destination) remain
+ * fixed and the costs may be asymmetric.
+ */
+class LocalSearchOptimizer {
+public:
+  /**
+   * @param  time_budget  Milliseconds after which the searches are cut short and the best tour so
+   *                      far is returned. Only very large tours should take that long.
+   * @param  concurrency  Number of searches to run at once, each on a thread of its own.
+   */
+  LocalSearchOptimizer(const uint32_t time_budget = 100, const uint32_t concurrency = 1)
+      : time_budget_(time_budget), concurrency_(std::max(concurrency, 1u)),
+        seed_(kLocalSearchSeed) {
+  }
+
+  /**
+   * Optimize the tour through a set of locations given the cost matrix
+   * among all locations. The first location (origin) and last location
+   * (destination) remain fixed in the tour.
+   * @param  count  Number of locations.
+   * @param  costs  2-D cost matrix.
+   * @return Returns the tour as an updated order of locations visited to
+   *         complete the tour.
+   */
+  std::vector<uint32_t> Solve(const uint32_t count, const std::vector<float>& costs) const;
+
+  /**
+   * Seed the random number generators of the searches. The tour only depends on the seed and the
+   * costs unless the time budget cuts the searches short.
+   * @param  seed  Seed to use for the random number generators.
+   */
+  void Seed(const uint32_t seed) {
+    seed_ = seed;
+  }
+
+  /**
+   * Get the cost for the specified tour (order of locations).
+   * @param  count  Number of locations.
+   * @param  costs  2-D cost array between locations.
+   * @param  tour   Order that locations are traversed.
+   * @return Returns the total cost for the tour.
+   */
+  static float TourCost(const uint32_t count,
+                        const std::vector<float>& costs,
+                        const std::vector<uint32_t>& tour);
+
+protected:
+  uint32_t time_budget_; // Milliseconds to search for at most
+  uint32_t concurrency_; // # of searches to run at once
+  uint32_t seed_;        // Seed of the first search, the others use the ones after it
+};
+
 } // namespace thor
 } // namespace valhalla
 
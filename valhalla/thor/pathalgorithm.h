@@ -135,6 +135,18 @@ public:
     expansion_callback_ = expansion_callback;
   }
 
+  /**
+   * Counts of the work done by the algorithm over its life, Clear doesn't reset them. What a
+   * request took is how much they went up while it ran
+   */
+  struct counters_t {
+    uint64_t expanded_edges = 0; // labels taken off the adjacency list to expand from
+    uint64_t edge_labels = 0;    // labels put on the adjacency list
+  };
+  const counters_t& counters() const {
+    return counters_;
+  }
+
 protected:
   const std::function<void()>* interrupt;
 
@@ -152,6 +164,8 @@ protected:
 
   // if `true` clean reserved memory for edge labels
   bool clear_reserved_memory_;
+
+  counters_t counters_;
 };
 
 /**
@@ -1,6 +1,8 @@
 #ifndef __VALHALLA_THOR_SERVICE_H__
 #define __VALHALLA_THOR_SERVICE_H__
 
+#include <functional>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -57,6 +59,18 @@ public:
   std::string matrix(Api& request);
   void optimized_route(Api& request);
   std::string isochrones(Api& request);
+  /**
+   * Computes the isochrones of the request once for each of the given date_times. The costing,
+   * the tile cache and the expansion memory are reused from one time to the next and if
+   * thor.max_isochrone_concurrency allows it the times are expanded concurrently. The interrupt is
+   * checked between the times, or while the auxiliary workers expand them. The costings of a
+   * request without a date_time must already use the traffic they would have if it had one, the
+   * actor parses them that way
+   * @param request     the request to compute the isochrones for, already correlated by loki
+   * @param date_times  the departure (or arrival for arrive_by/reverse requests) times
+   * @return one serialized set of contours per date_time in the same order
+   */
+  std::vector<std::string> isochrones(Api& request, const std::vector<std::string>& date_times);
   void trace_route(Api& request);
   std::string trace_attributes(Api& request);
   std::string expansion(Api& request);
@@ -90,6 +104,21 @@ protected:
 
   void path_arrive_by(Api& api, const std::string& costing);
   void path_depart_at(Api& api, const std::string& costing);
+  /**
+   * Computes the paths for all of the legs of a multi-leg route concurrently, using a small pool
+   * of auxiliary workers. This is only possible when the legs do not depend on one another, ie.
+   * there are no through locations and no date_times (so only for depart_at routes). Legs which
+   * could not be computed this way are left empty so that the caller can fall back to computing
+   * them serially. An interrupted request throws rather than being redone serially.
+   * @param api        the request whose legs we want to compute
+   * @param locations  the correlated locations of the request
+   * @param costing    the name of the costing in use
+   * @return one set of paths per leg, indexed by the leg origin, or nothing if not applicable
+   */
+  std::vector<std::vector<std::vector<PathInfo>>>
+  get_leg_paths(const Api& api,
+                google::protobuf::RepeatedPtrField<valhalla::Location>& locations,
+                const std::string& costing);
   void parse_measurements(const Api& request);
   std::string parse_costing(const Api& request);
 
@@ -130,15 +159,39 @@ protected:
   std::unordered_map<std::string, float> max_matrix_distance;
   SOURCE_TO_TARGET_ALGORITHM source_to_target_algorithm;
   bool costmatrix_allow_second_pass;
+  bool optimizer_annealing;
+  uint32_t optimizer_time_budget;
+  uint32_t optimizer_concurrency;
   std::shared_ptr<baldr::GraphReader> reader;
   meili::MapMatcherFactory matcher_factory;
   baldr::AttributesController controller;
   Centroid centroid_gen;
 
+  // Auxiliary workers used to compute the legs of a multi-leg route or isochrones concurrently
+  size_t max_leg_concurrency;
+  size_t max_isochrone_concurrency;
+  boost::property_tree::ptree aux_worker_config;
+  std::vector<std::unique_ptr<thor_worker_t>> aux_workers;
+
+  /**
+   * Runs the work on the first count auxiliary workers at once and returns when they are all done.
+   * The workers and their threads are made on first use and then wait for work until this worker
+   * is destroyed. Only the calling thread polls the interrupt, the auxiliary workers instead see a
+   * flag that is set once it throws. Then the workers are waited for and the interrupt rethrown.
+   * @param count  the number of auxiliary workers to run the work on
+   * @param work   what each of them runs, it must not throw
+   */
+  void run_aux_workers(const size_t count, const std::function<void(thor_worker_t&)>& work);
+
+  // The threads of the auxiliary workers and what they need to take work and be cancelled
+  struct aux_pool_t;
+  std::unique_ptr<aux_pool_t> aux_pool;
+
 private:
   std::string service_name() const override {
     return "thor";
   }
+  work_counters_t counters() const override;
 };
 
 } // namespace thor
@@ -3,6 +3,8 @@
 
 #include <boost/property_tree/ptree.hpp>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <valhalla/baldr/graphreader.h>
 #include <valhalla/proto/api.pb.h>
@@ -44,6 +46,19 @@ public:
    */
   std::string act(Api& api, const std::function<void()>* interrupt = nullptr);
 
+  /**
+   * Perform the action specified in the options of a serialized Api request, for clients that speak
+   * protobuf rather than json. The request is parsed straight from the bytes into an arena that the
+   * actor reuses from one call to the next and it stays there through all the stages. With pbf
+   * output the statistics in the info of the response include the arena_bytes and arena_blocks
+   * each stage took from the arena
+   * @param pbf        the serialized request
+   * @param size       the number of bytes of the serialized request
+   * @param interrupt  allows the underlying computation to be aborted via the functor throwing
+   * @return json or pbf bytes depending on what was specified in the options object
+   */
+  std::string act(const char* pbf, size_t size, const std::function<void()>* interrupt = nullptr);
+
   /**
    * Perform the route action and return json or protobuf depending on which was requested. The
    * request may either be in the form of a json string provided by the request_str parameter or
@@ -114,6 +129,24 @@ public:
                         const std::function<void()>* interrupt = nullptr,
                         Api* api = nullptr);
 
+  /**
+   * Perform the isochrone action once for each of the given date_times, reusing the correlation of
+   * the locations and the warmed up graph and expansion for all of them. The request may either be
+   * in the form of a json string provided by the request_str parameter or contained in the api
+   * parameter as a deserialized protobuf object
+   * @param request_str  json string if json input is being used empty otherwise
+   * @param date_times   the times at which to compute the isochrone, these replace the date_time
+   *                     of the request
+   * @param interrupt    allows the underlying computation to be aborted via the functor throwing
+   * @param api          protobuffer object which can contain the input request via the options object
+   *                     and will be filled out as the request is processed
+   * @return json or pbf bytes depending on what was specified in the options object, one per time
+   */
+  std::vector<std::string> isochrone(const std::string& request_str,
+                                     const std::vector<std::string>& date_times,
+                                     const std::function<void()>* interrupt = nullptr,
+                                     Api* api = nullptr);
+
   /**
    * Perform the trace_route action and return json or protobuf depending on which was requested. The
    * request may either be in the form of a json string provided by the request_str parameter or
@@ -130,7 +130,7 @@ baldr::json::ArrayPtr serializeWarnings(const valhalla::Api& api);
  * @param shape  The points making up the line.
  * @returns The GeoJSON geometry of the LineString
  */
-baldr::json::MapPtr geojson_shape(const std::vector<midgard::PointLL> shape);
+baldr::json::MapPtr geojson_shape(const std::vector<midgard::PointLL>& shape);
 
 // Elevation serialization support
 
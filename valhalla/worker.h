@@ -1,5 +1,6 @@
 #ifndef __VALHALLA_SERVICE_H__
 #define __VALHALLA_SERVICE_H__
+#include <memory>
 #include <string>
 
 #include <valhalla/baldr/json.h>
@@ -14,6 +15,7 @@
 #endif
 
 #include <boost/property_tree/ptree.hpp>
+#include <google/protobuf/arena.h>
 
 namespace valhalla {
 
@@ -75,6 +77,24 @@ void ParseApi(const prime_server::http_request_t& http_request, Api& api);
 
 std::string serialize_error(const valhalla_exception_t& exception, Api& options);
 
+/**
+ * Adds the statistics of a finished request to the histograms of the metrics of the process, if
+ * they are kept, see metrics.enabled
+ *
+ * @param api  the request whose statistics to add
+ */
+void record_metrics(const Api& api);
+
+/**
+ * The histograms of the metrics of the process in the prometheus text format. The statistic keys
+ * of the form action.level.worker.metric become metrics named valhalla_metric with the action,
+ * level and worker as their labels. Only loki serves them, so they cover every stage only when
+ * all of them run in its process, like in valhalla_service
+ *
+ * @return the text to expose to prometheus
+ */
+std::string metrics_to_prometheus();
+
 /**
  * Adds a warning to the request PBF object.
  *
@@ -94,6 +114,7 @@ const content_type JSON_MIME{"Content-type", "application/json;charset=utf-8"};
 const content_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
 const content_type PBF_MIME{"Content-type", "application/x-protobuf"};
 const content_type GPX_MIME{"Content-type", "application/gpx+xml;charset=utf-8"};
+const content_type PROMETHEUS_MIME{"Content-type", "text/plain;version=0.0.4;charset=utf-8"};
 } // namespace worker
 
 prime_server::worker_t::result_t to_response(const std::string& data,
@@ -101,6 +122,41 @@ prime_server::worker_t::result_t to_response(const std::string& data,
                                              const Api& options);
 #endif
 
+/**
+ * An arena for the Api of one request at a time to live in through all the stages that handle it.
+ * The arena starts out in a block which it keeps from one request to the next so that the requests
+ * which fit in it don't allocate the message at all. The blocks it allocates past that one show up
+ * in the arena_blocks statistic of the stage that needed them
+ */
+class request_arena_t {
+public:
+  /**
+   * @param block_size  the size of the block the arena keeps between requests
+   */
+  request_arena_t(size_t block_size = 1 << 18);
+
+  /**
+   * Frees the previous request and makes an empty one in the arena
+   * @return the request, valid until the next call
+   */
+  Api& next();
+
+protected:
+  std::unique_ptr<char[]> block;
+  std::unique_ptr<google::protobuf::Arena> arena;
+};
+
+/**
+ * Counts of the work a worker has done over its life, like the tiles it fetched or the edges its
+ * algorithms expanded. What an action took is how much these went up while it ran
+ */
+struct work_counters_t {
+  uint64_t tiles_fetched = 0;     // tiles asked of the graph reader
+  uint64_t tile_cache_misses = 0; // of those, the ones which weren't in its cache
+  uint64_t expanded_edges = 0;    // labels the path algorithms expanded from
+  uint64_t edge_labels = 0;       // labels they put on their adjacency lists
+};
+
 struct statsd_client_t;
 class service_worker_t {
 public:
@@ -151,14 +207,25 @@ protected:
    */
   virtual std::string service_name() const = 0;
 
+  /**
+   * Returns the counts of the work done so far, which are only read when metrics are kept
+   */
+  virtual work_counters_t counters() const;
+
   /**
    * Used to measure the time it takes to do an action in the current stage of the pipeline.
-   * This should be called at the top of the scope in each major action of each worker
+   * This should be called at the top of the scope in each major action of each worker. If the
+   * request lives in an arena it also records how many bytes of the arena and how many newly
+   * allocated blocks of it the action took. If metrics are kept it records how much each of the
+   * work counters went up too
    *
-   * @param api  The request object where we store the timing information
+   * @param api    The request object where we store the timing information
+   * @param stage  The name of the stage to record the time under, the worker's by default. The
+   *               work counters are only recorded for the worker's own stage
    * @return an object whose destructor records the elapsed time since construction as a stat
    */
-  midgard::Finally<std::function<void()>> measure_scope_time(Api& api) const;
+  midgard::Finally<std::function<void()>> measure_scope_time(Api& api,
+                                                             const std::string& stage = "") const;
 
   /**
    * Signals the start of the worker, sends statsd message if so configured
@@ -167,6 +234,8 @@ protected:
 
   const std::function<void()>* interrupt;
   std::unique_ptr<statsd_client_t> statsd_client;
+  // the requests of the jobs are made in here, one after the other
+  request_arena_t request_arena;
 };
 } // namespace valhalla
 